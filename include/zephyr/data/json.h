@@ -700,6 +700,118 @@ int json_arr_separate_object_parse_init(struct json_obj *json, char *payload, si
 int json_arr_separate_parse_object(struct json_obj *json, const struct json_obj_descr *descr,
 				   size_t descr_len, void *val);
 
+#if defined(CONFIG_JSON_PUSH_PARSER) || defined(__DOXYGEN__)
+
+/** @cond INTERNAL_HIDDEN */
+struct json_push_frame {
+	/* Fields of the object or elements of the array, NULL if skipped */
+	const struct json_obj_descr *descr;
+	/* Number of fields of the object or maximum number of elements */
+	size_t descr_len;
+	/* Decoded object or first element of the array */
+	void *val;
+	/* Number of decoded elements of the array */
+	size_t *count;
+	size_t elem_size;
+	/* Bitmap of the decoded fields of the object */
+	int64_t decoded;
+	/* Field of the object the current value is decoded to, or -1 */
+	int field;
+	bool array;
+};
+/** @endcond */
+
+/**
+ * @brief State of an incremental JSON parser.
+ *
+ * The members are internal to the parser, see json_push_parser_init().
+ */
+struct json_push_parser {
+	/** @cond INTERNAL_HIDDEN */
+	struct json_push_frame frames[CONFIG_JSON_PUSH_PARSER_MAX_DEPTH];
+	char *buf;
+	size_t buf_size;
+	size_t buf_used;
+	size_t tok_len;
+	int64_t decoded;
+	int depth;
+	int error;
+	uint8_t state;
+	uint8_t lex;
+	uint8_t hex_left;
+	uint8_t lit_match;
+	bool escape;
+	bool tok_key;
+	bool tok_store;
+	bool tok_number;
+	bool tok_truncated;
+	/** @endcond */
+};
+
+/**
+ * @brief Initialize an incremental parser of a JSON-encoded object.
+ *
+ * The object is then fed to json_push_parser_feed() in chunks of any size, for
+ * instance as they are received from the network, and decoded on the fly
+ * according to the descriptor pointed to by @a descr, as json_obj_parse()
+ * does. The values of JSON_TOK_STRING, JSON_TOK_OPAQUE and JSON_TOK_FLOAT
+ * fields point to a copy kept in @a buf until the end of the parsing, so @a buf
+ * has to outlive @a val. The token being parsed is kept after them, so @a buf
+ * has to fit all these values, each with a null character, plus the longest
+ * field name or value decoded. The values of unknown fields are skipped
+ * whatever their size, without being kept in @a buf.
+ *
+ * Fields of type JSON_TOK_OBJ_ARRAY, JSON_TOK_ENCODED_OBJ and
+ * JSON_TOK_MIXED_ARRAY, which refer to raw JSON data, are not supported. Null
+ * values are only accepted for unknown fields, as json_obj_parse() does not
+ * decode them.
+ *
+ * @param parser Parser state
+ * @param descr Pointer to the descriptor array
+ * @param descr_len Number of elements in the descriptor array. Must be less
+ * than 63.
+ * @param val Pointer to the struct to hold the decoded values
+ * @param buf Buffer holding the token being parsed and the decoded strings
+ * @param buf_size Size of @a buf
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if @a buf is too small.
+ */
+int json_push_parser_init(struct json_push_parser *parser, const struct json_obj_descr *descr,
+			  size_t descr_len, void *val, char *buf, size_t buf_size);
+
+/**
+ * @brief Feed a chunk of a JSON-encoded object to an incremental parser.
+ *
+ * The chunk can end anywhere, in the middle of a string or a number for
+ * instance. It is not referenced after the call.
+ *
+ * @param parser Parser state
+ * @param data Chunk of the JSON-encoded object
+ * @param len Length of the chunk
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if the data is not a valid object or does not match the
+ * descriptor.
+ * @retval -ENOSPC if an array, the nesting depth or @a buf overflows.
+ * @retval -ENOTSUP if a field type is not supported.
+ * @return Other negative values if a value cannot be decoded. Once an error
+ * is returned, it is returned by all the next calls.
+ */
+int json_push_parser_feed(struct json_push_parser *parser, const char *data, size_t len);
+
+/**
+ * @brief Complete the incremental parsing of a JSON-encoded object.
+ *
+ * @param parser Parser state
+ *
+ * @return < 0 if error or if the object is not complete, bitmap of decoded
+ * fields on success, as returned by json_obj_parse().
+ */
+int64_t json_push_parser_finish(struct json_push_parser *parser);
+
+#endif /* CONFIG_JSON_PUSH_PARSER || __DOXYGEN__ */
+
 /**
  * @brief Escapes the string so it can be used to encode JSON objects
  *
@@ -62,6 +62,18 @@ struct nvs_fs {
 #if CONFIG_NVS_LOOKUP_CACHE
 	uint32_t lookup_cache[CONFIG_NVS_LOOKUP_CACHE_SIZE];
 #endif
+#if CONFIG_NVS_ATE_INDEX
+	/** IDs of the ATE index entries */
+	uint16_t ate_index_id[CONFIG_NVS_ATE_INDEX_SIZE];
+	/** Address of the most recent ATE of each ID of the ATE index */
+	uint32_t ate_index_addr[CONFIG_NVS_ATE_INDEX_SIZE];
+	/** Bloom filter of the IDs stored in the file system */
+	uint32_t ate_index_bloom[CONFIG_NVS_ATE_INDEX_BLOOM_BITS / 32];
+	/** Number of IDs in the ATE index */
+	uint16_t ate_index_count;
+	/** Some IDs were left out of the ATE index as it was full */
+	bool ate_index_full;
+#endif
 };
 
 /**
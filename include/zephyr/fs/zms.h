@@ -31,6 +31,17 @@ extern "C" {
  * @{
  */
 
+/**
+ * @brief ID type used in the ZMS API.
+ *
+ * @note The width of this type depends on @kconfig{CONFIG_ZMS_ID_64BIT}.
+ */
+#if CONFIG_ZMS_ID_64BIT
+typedef uint64_t zms_id_t;
+#else
+typedef uint32_t zms_id_t;
+#endif
+
 /** Zephyr Memory Storage file system structure */
 struct zms_fs {
 	/** File system offset in flash */
@@ -65,6 +76,34 @@ struct zms_fs {
 	/** Lookup table used to cache ATE addresses of written IDs */
 	uint64_t lookup_cache[CONFIG_ZMS_LOOKUP_CACHE_SIZE];
 #endif
+#if CONFIG_ZMS_ATE_INDEX
+	/** IDs of the ATE index entries */
+	zms_id_t ate_index_id[CONFIG_ZMS_ATE_INDEX_SIZE];
+	/** Address of the most recent ATE of each ID of the ATE index */
+	uint64_t ate_index_addr[CONFIG_ZMS_ATE_INDEX_SIZE];
+	/** Bloom filter of the IDs stored in the storage system */
+	uint32_t ate_index_bloom[CONFIG_ZMS_ATE_INDEX_BLOOM_BITS / 32];
+	/** Number of IDs in the ATE index */
+	uint32_t ate_index_count;
+	/** Some IDs were left out of the ATE index as it was full */
+	bool ate_index_full;
+#endif
+#if CONFIG_ZMS_GC_INCREMENTAL
+	/** Address of the next ATE to collect by the pending garbage collection */
+	uint64_t gc_addr;
+	/** Address of the last ATE to collect by the pending garbage collection */
+	uint64_t gc_stop_addr;
+	/** Space of the active sector reserved for the pending garbage collection */
+	uint32_t gc_reserved;
+	/** Cycle counter of the sector being garbage collected */
+	uint8_t gc_cycle;
+	/** State of the pending garbage collection */
+	uint8_t gc_state;
+#endif
+#if CONFIG_ZMS_GC_WORKQUEUE
+	/** Work item running the pending garbage collection */
+	struct k_work gc_work;
+#endif
 };
 
 /**
@@ -77,17 +116,6 @@ struct zms_fs {
  * @{
  */
 
-/**
- * @brief ID type used in the ZMS API.
- *
- * @note The width of this type depends on @kconfig{CONFIG_ZMS_ID_64BIT}.
- */
-#if CONFIG_ZMS_ID_64BIT
-typedef uint64_t zms_id_t;
-#else
-typedef uint32_t zms_id_t;
-#endif
-
 /**
  * @brief Mount a ZMS file system onto the device specified in `fs`.
  *
@@ -257,6 +285,32 @@ ssize_t zms_active_sector_free_space(struct zms_fs *fs);
  */
 int zms_sector_use_next(struct zms_fs *fs);
 
+/**
+ * @brief Run a slice of the pending garbage collection.
+ *
+ * When @kconfig{CONFIG_ZMS_GC_INCREMENTAL} is enabled, a write which fills the active sector
+ * only starts the garbage collection of the next sector. The space it needs is reserved in
+ * the new active sector and the entries are moved by this routine, typically called from a
+ * low priority work item. With @kconfig{CONFIG_ZMS_GC_WORKQUEUE}, ZMS calls it from its own
+ * work queue, otherwise the application must call it until it returns 0. A write which does
+ * not fit next to the reserved space completes the garbage collection first.
+ *
+ * At least one entry is moved per call, and the erase of the collected sector is done in a
+ * single step, so a call may last longer than `budget_us`.
+ *
+ * @param fs Pointer to the file system.
+ * @param budget_us Time after which the garbage collection is interrupted, in microseconds.
+ * 0 runs it to completion.
+ *
+ * @retval 0 if no garbage collection is pending anymore.
+ * @retval 1 if garbage collection work is left.
+ * @retval -EACCES if ZMS is still not initialized.
+ * @retval -ENXIO if there is a device error.
+ * @retval -EIO if there is a memory read/write error.
+ * @retval -EINVAL if `fs` is NULL.
+ */
+int zms_gc_step(struct zms_fs *fs, uint32_t budget_us);
+
 /**
  * @}
  */
@@ -5249,6 +5249,37 @@ __syscall int k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t time
  */
 __syscall int k_msgq_put_front(struct k_msgq *msgq, const void *data);
 
+/**
+ * @brief Send several messages to the end of a message queue.
+ *
+ * This routine sends up to @a num_msgs messages, stored back to back at
+ * @a data, to message queue @a q. The messages are moved under a single
+ * lock acquisition and the waiting threads are rescheduled once, which is
+ * cheaper than calling k_msgq_put() for each message.
+ *
+ * If the queue is full, the routine waits until the first message can be
+ * sent, then sends as many of the remaining messages as fit without
+ * waiting again.
+ *
+ * @note The message content is copied from @a data into @a msgq and the @a data
+ * pointer is not retained, so the message content will not be modified
+ * by this function.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param data Pointer to the messages.
+ * @param num_msgs Number of messages at @a data.
+ * @param timeout Waiting period to add the first message, or one of the
+ *                special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of messages sent, which can be less than @a num_msgs.
+ * @retval -ENOMSG Returned without waiting or queue purged.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_msgq_put_many(struct k_msgq *msgq, const void *data, uint32_t num_msgs,
+			      k_timeout_t timeout);
+
 /**
  * @brief Receive a message from a message queue.
  *
@@ -5271,6 +5302,37 @@ __syscall int k_msgq_put_front(struct k_msgq *msgq, const void *data);
  */
 __syscall int k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout);
 
+/**
+ * @brief Receive several messages from a message queue.
+ *
+ * This routine receives up to @a num_msgs messages from message queue @a q
+ * in a "first in, first out" manner, and stores them back to back at
+ * @a data. The messages are moved under a single lock acquisition and the
+ * waiting threads are rescheduled once, which is cheaper than calling
+ * k_msgq_get() for each message.
+ *
+ * If the queue is empty, the routine waits until the first message is
+ * received, then receives as many of the queued messages as requested
+ * without waiting again.
+ *
+ * @note @a timeout must be set to K_NO_WAIT if called from ISR.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param data Address of area to hold @a num_msgs messages.
+ * @param num_msgs Maximum number of messages to receive.
+ * @param timeout Waiting period to receive the first message,
+ *                or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @return Number of messages received, which can be less than @a num_msgs.
+ * @retval -ENOMSG Returned without waiting or queue purged.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_msgq_get_many(struct k_msgq *msgq, void *data, uint32_t num_msgs,
+			      k_timeout_t timeout);
+
 /**
  * @brief Peek/read a message from a message queue.
  *
@@ -5539,6 +5601,8 @@ __syscall void k_pipe_init(struct k_pipe *pipe, uint8_t *buffer, size_t buffer_s
 enum pipe_flags {
 	PIPE_FLAG_OPEN = BIT(0),
 	PIPE_FLAG_RESET = BIT(1),
+	PIPE_FLAG_WRITE_CLAIM = BIT(2),
+	PIPE_FLAG_READ_CLAIM = BIT(3),
 };
 
 struct k_pipe {
@@ -5629,6 +5693,99 @@ __syscall int k_pipe_write(struct k_pipe *pipe, const uint8_t *data, size_t len,
 __syscall int k_pipe_read(struct k_pipe *pipe, uint8_t *data, size_t len,
 			  k_timeout_t timeout);
 
+/**
+ * @brief Claim a region of a pipe's buffer for writing
+ *
+ * This routine gives direct access to a contiguous region of up to @a len
+ * bytes of free space in the pipe's ring buffer, avoiding the copy done by
+ * k_pipe_write(..). If the pipe is full, or another region is claimed for
+ * writing, the routine will block until space can be claimed or the timeout
+ * expires. The region can be smaller than requested when the free space
+ * wraps around the end of the buffer.
+ *
+ * The data written to the region is only made available to readers once
+ * k_pipe_write_commit(..) is called. Until then, no other region can be
+ * claimed for writing and k_pipe_write(..) only hands data over to
+ * waiting readers directly.
+ *
+ * @note Can only be called from supervisor mode, and only for pipes with a
+ *       ring buffer.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Set to the address of the claimed region.
+ * @param len Requested number of bytes to claim.
+ * @param timeout Waiting period to wait for space to be claimed.
+ *
+ * @retval number of bytes claimed on success
+ * @retval -EINVAL if @a len is zero or the pipe has no ring buffer
+ * @retval -EAGAIN if no space could be claimed before the timeout expired
+ * @retval -ECANCELED if the claim was interrupted by k_pipe_reset(..)
+ * @retval -EPIPE if the pipe was closed
+ */
+int k_pipe_write_claim(struct k_pipe *pipe, uint8_t **data, size_t len, k_timeout_t timeout);
+
+/**
+ * @brief Commit data written to a claimed region of a pipe
+ *
+ * This routine makes the first @a len bytes of the region claimed with
+ * k_pipe_write_claim(..) available to readers and releases the claim. The
+ * rest of the region is returned to the free space of the pipe.
+ *
+ * @param pipe Address of the pipe.
+ * @param len Number of bytes written to the claimed region.
+ *
+ * @retval number of bytes committed on success
+ * @retval -EINVAL if @a len exceeds the claimed region, or no region is
+ *         claimed, e.g. after k_pipe_reset(..)
+ * @retval -EPIPE if the pipe was closed, the claimed region is discarded
+ */
+int k_pipe_write_commit(struct k_pipe *pipe, size_t len);
+
+/**
+ * @brief Claim a region of a pipe's buffer for reading
+ *
+ * This routine gives direct access to a contiguous region of up to @a len
+ * bytes of data in the pipe's ring buffer, avoiding the copy done by
+ * k_pipe_read(..). If the pipe is empty, or another region is claimed for
+ * reading, the routine will block until data can be claimed or the timeout
+ * expires. The region can be smaller than requested when the data wraps
+ * around the end of the buffer.
+ *
+ * The region stays valid until k_pipe_read_release(..) is called, which
+ * frees its space for writers.
+ *
+ * @note Can only be called from supervisor mode, and only for pipes with a
+ *       ring buffer.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Set to the address of the claimed region.
+ * @param len Requested number of bytes to claim.
+ * @param timeout Waiting period to wait for data to be claimed.
+ *
+ * @retval number of bytes claimed on success
+ * @retval -EINVAL if @a len is zero or the pipe has no ring buffer
+ * @retval -EAGAIN if no data could be claimed before the timeout expired
+ * @retval -ECANCELED if the claim was interrupted by k_pipe_reset(..)
+ * @retval -EPIPE if the pipe was closed and is empty
+ */
+int k_pipe_read_claim(struct k_pipe *pipe, uint8_t **data, size_t len, k_timeout_t timeout);
+
+/**
+ * @brief Release data read from a claimed region of a pipe
+ *
+ * This routine consumes the first @a len bytes of the region claimed with
+ * k_pipe_read_claim(..) and releases the claim. The rest of the region
+ * stays in the pipe and is read next.
+ *
+ * @param pipe Address of the pipe.
+ * @param len Number of bytes consumed from the claimed region.
+ *
+ * @retval number of bytes released on success
+ * @retval -EINVAL if @a len exceeds the claimed region, or no region is
+ *         claimed, e.g. after k_pipe_reset(..)
+ */
+int k_pipe_read_release(struct k_pipe *pipe, size_t len);
+
 /**
  * @brief Reset a pipe
  * This routine resets the pipe, discarding any unread data and unblocking any threads waiting to
@@ -5661,14 +5818,31 @@ struct k_mem_slab_info {
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	uint32_t max_used;
 #endif
+#ifdef CONFIG_MEM_SLAB_PERCPU_CACHE
+	uint32_t cache_hits;
+	uint32_t cache_misses;
+#endif
 };
 
+#ifdef CONFIG_MEM_SLAB_PERCPU_CACHE
+struct k_mem_slab_cpu_cache {
+	struct k_spinlock lock;
+	char *free_list;
+	uint32_t count;
+	uint32_t hits;
+};
+#endif
+
 struct k_mem_slab {
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
 	char *buffer;
 	char *free_list;
 	struct k_mem_slab_info info;
+#ifdef CONFIG_MEM_SLAB_PERCPU_CACHE
+	atomic_t cache_waiters;
+	struct k_mem_slab_cpu_cache cpu_cache[CONFIG_MP_MAX_NUM_CPUS];
+#endif
 
 	SYS_PORT_TRACING_TRACKING_FIELD(k_mem_slab)
 
@@ -5867,6 +6041,12 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem,
  */
 void k_mem_slab_free(struct k_mem_slab *slab, void *mem);
 
+#ifdef CONFIG_MEM_SLAB_PERCPU_CACHE
+/** @cond INTERNAL_HIDDEN */
+uint32_t z_mem_slab_num_used_get(struct k_mem_slab *slab);
+/** @endcond */
+#endif
+
 /**
  * @brief Get the number of used blocks in a memory slab.
  *
@@ -5881,7 +6061,11 @@ void k_mem_slab_free(struct k_mem_slab *slab, void *mem);
  */
 static inline uint32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
 {
+#ifdef CONFIG_MEM_SLAB_PERCPU_CACHE
+	return z_mem_slab_num_used_get(slab);
+#else
 	return slab->info.num_used;
+#endif
 }
 
 /**
@@ -5920,7 +6104,7 @@ static inline uint32_t k_mem_slab_max_used_get(struct k_mem_slab *slab)
  */
 static inline uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 {
-	return slab->info.num_blocks - slab->info.num_used;
+	return slab->info.num_blocks - k_mem_slab_num_used_get(slab);
 }
 
 /**
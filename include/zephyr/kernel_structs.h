@@ -140,6 +140,15 @@ struct _ready_q {
 #elif defined(CONFIG_SCHED_MULTIQ)
 	struct _priq_mq runq;
 #endif
+
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	/* number of threads in runq, used to find the busiest queue */
+	unsigned int count;
+	/* priority of the head of runq regardless of CPU masks, INT_MAX
+	 * when empty: lets other CPUs skip this queue without walking it
+	 */
+	int head_prio;
+#endif
 };
 
 typedef struct _ready_q _ready_q_t;
@@ -157,7 +166,7 @@ struct _cpu {
 	/* one assigned idle thread per CPU */
 	struct k_thread *idle_thread;
 
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || defined(CONFIG_SCHED_CPU_RUNQ)
 	struct _ready_q ready_q;
 #endif
 
@@ -216,7 +225,7 @@ struct z_kernel {
 	 * ready queue: can be big, keep after small fields, since some
 	 * assembly (e.g. ARC) are limited in the encoding of the offset
 	 */
-#ifndef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if !defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) && !defined(CONFIG_SCHED_CPU_RUNQ)
 	struct _ready_q ready_q;
 #endif
 
@@ -261,6 +261,12 @@ struct net_msghdr {
 	int               msg_flags;      /**< Flags on received message */
 };
 
+/** Message header for batched send and receive (sendmmsg/recvmmsg) */
+struct net_mmsghdr {
+	struct net_msghdr msg_hdr; /**< Message header */
+	unsigned int      msg_len; /**< Number of bytes transferred */
+};
+
 /** Control message ancillary data */
 struct net_cmsghdr {
 	net_socklen_t cmsg_len;    /**< Number of bytes, including header */
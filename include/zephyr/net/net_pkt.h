@@ -2167,6 +2167,29 @@ struct net_pkt *net_pkt_rx_alloc_with_buffer(struct net_if *iface,
  */
 void net_pkt_append_buffer(struct net_pkt *pkt, struct net_buf *buffer);
 
+#if defined(CONFIG_NET_BUF_EXTERNAL_REF) || defined(__DOXYGEN__)
+/**
+ * @brief Append external memory to a packet without copying it
+ *
+ * Appends buffers referencing @p len bytes of the external memory
+ * described by @p ext to the packet, taking a reference to @p ext for
+ * each of them. The memory is released once the packet, and any clone of
+ * it, has been freed. The cursor of the packet is not moved.
+ *
+ * @kconfig_dep{CONFIG_NET_BUF_EXTERNAL_REF}
+ *
+ * @param pkt     Network packet where to append the data
+ * @param ext     External memory descriptor
+ * @param data    Start of the data, inside the external memory
+ * @param len     Length of the data
+ * @param timeout Maximum time to wait for a buffer
+ *
+ * @return 0 on success, negative errno code otherwise.
+ */
+int net_pkt_append_ext(struct net_pkt *pkt, struct net_buf_ext *ext,
+		       const void *data, size_t len, k_timeout_t timeout);
+#endif
+
 /**
  * @brief Get available buffer space from a pkt
  *
@@ -2549,6 +2572,26 @@ static inline int net_pkt_write_le16(struct net_pkt *pkt, uint16_t data)
  */
 size_t net_pkt_remaining_data(struct net_pkt *pkt);
 
+/**
+ * @brief Describe the data from current cursor position as an I/O vector
+ *
+ * @details Fills @p iov with pointers into the packet fragments, so that the
+ *          packet data can be accessed in place without copying it. The
+ *          cursor is not moved. The returned pointers are valid as long as
+ *          the caller holds a reference to the packet and does not modify it.
+ *
+ * @param pkt    Network packet
+ * @param iov    I/O vector to fill
+ * @param iovcnt Number of elements available in @p iov
+ * @param len    Set to the amount of data described by @p iov
+ *
+ * @return Number of @p iov elements used. If the data is spread over more
+ *         than @p iovcnt fragments, only the first @p iovcnt ones are
+ *         described and @p len is smaller than net_pkt_remaining_data().
+ */
+size_t net_pkt_remaining_iov(struct net_pkt *pkt, struct net_iovec *iov,
+			     size_t iovcnt, size_t *len);
+
 /**
  * @brief Get the total amount of bytes stored in a packet.
  *
@@ -78,6 +78,8 @@ extern "C" {
 #define ZSOCK_MSG_DONTWAIT 0x40
 /** zsock_recv: block until the full amount of data can be returned */
 #define ZSOCK_MSG_WAITALL 0x100
+/** zsock_recvmmsg: block only until the first message has been received */
+#define ZSOCK_MSG_WAITFORONE 0x10000
 /** @} */
 
 /**
@@ -538,6 +540,111 @@ __syscall ssize_t zsock_recvfrom(int sock, void *buf, size_t max_len,
  */
 __syscall ssize_t zsock_recvmsg(int sock, struct net_msghdr *msg, int flags);
 
+/** Maximum number of messages zsock_sendmmsg() and zsock_recvmmsg() handle per call */
+#define ZSOCK_MMSG_MAX 1024
+
+/**
+ * @brief Send multiple messages on a socket
+ *
+ * @details
+ * Equivalent to calling zsock_sendmsg() for each of the @a vlen
+ * messages in @a msgvec, but the socket is looked up and locked only
+ * once for the whole batch.  The number of bytes sent for each message
+ * is stored in its @c msg_len field.  At most @ref ZSOCK_MMSG_MAX
+ * messages are sent per call.
+ * This function is also exposed as `sendmmsg()`
+ * if @kconfig{CONFIG_POSIX_API} is defined.
+ *
+ * @return Number of messages sent, or -1 with errno set if the first
+ *         one could not be sent.
+ */
+__syscall int zsock_sendmmsg(int sock, struct net_mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
+/**
+ * @brief Receive multiple messages from a socket
+ *
+ * @details
+ * Equivalent to calling zsock_recvmsg() for each of the @a vlen
+ * messages in @a msgvec, but the socket is looked up and locked only
+ * once for the whole batch.  The number of bytes received for each
+ * message is stored in its @c msg_len field.  With
+ * @ref ZSOCK_MSG_WAITFORONE, only the first message is waited for and
+ * the call returns as soon as no more messages are queued.  At most
+ * @ref ZSOCK_MMSG_MAX messages are received per call.
+ * This function is also exposed as `recvmmsg()`
+ * if @kconfig{CONFIG_POSIX_API} is defined.
+ *
+ * @return Number of messages received, or -1 with errno set if the
+ *         first one could not be received.
+ */
+__syscall int zsock_recvmmsg(int sock, struct net_mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
+#if defined(CONFIG_NET_SOCKETS_RX_VIEW) || defined(__DOXYGEN__)
+/**
+ * @brief Read-only view over received data, lent by zsock_recv_view()
+ */
+struct zsock_rx_view {
+	/** Fragments holding the received data */
+	struct net_iovec iov[CONFIG_NET_SOCKETS_RX_VIEW_IOV_MAX];
+	/** Number of valid entries in @a iov */
+	size_t iovcnt;
+	/** Total number of bytes described by @a iov */
+	size_t len;
+	/** ZSOCK_MSG_TRUNC if a datagram did not fit into @a iov */
+	int flags;
+	/** Source address of a datagram, as returned by zsock_recvfrom() */
+	struct net_sockaddr_storage src_addr;
+	/** Length of @a src_addr, 0 for a stream socket */
+	net_socklen_t addrlen;
+	/** @cond INTERNAL_HIDDEN */
+	void *handle;
+	/** @endcond */
+};
+
+/**
+ * @brief Receive data without copying it
+ *
+ * @details
+ * Instead of copying the received data into a caller supplied buffer,
+ * the socket lends the caller a read-only view over the network buffers
+ * holding it.  For a datagram socket the view covers one datagram; if it
+ * is spread over more than @kconfig{CONFIG_NET_SOCKETS_RX_VIEW_IOV_MAX}
+ * fragments, the remainder is discarded on release and
+ * @ref ZSOCK_MSG_TRUNC is set in @a view->flags.  The source address of
+ * the datagram is stored in @a view->src_addr so that the caller can reply
+ * to it.  For a stream socket the view covers the data of the first queued
+ * segment, and zero length means the peer has closed the connection.
+ *
+ * The view must be handed back with zsock_recv_view_release() before
+ * any other receive call is made on the socket and before it is closed.
+ * Only supported by native IPv4/IPv6 sockets and not available from
+ * user mode threads.
+ *
+ * @param sock Socket to receive from
+ * @param view View to fill
+ * @param flags @ref ZSOCK_MSG_DONTWAIT, other flags are ignored
+ *
+ * @return Number of bytes described by the view, or -1 with errno set.
+ */
+ssize_t zsock_recv_view(int sock, struct zsock_rx_view *view, int flags);
+
+/**
+ * @brief Hand a view obtained with zsock_recv_view() back to the socket
+ *
+ * @details
+ * The network buffers are returned to their pool and, for a stream
+ * socket, the receive window is opened by the amount of data consumed.
+ *
+ * @param sock Socket the view was received from
+ * @param view View to release
+ *
+ * @return 0 on success, or -1 with errno set.
+ */
+int zsock_recv_view_release(int sock, struct zsock_rx_view *view);
+#endif /* CONFIG_NET_SOCKETS_RX_VIEW */
+
 /**
  * @brief Receive data from a connected peer
  *
@@ -943,6 +1050,11 @@ int zsock_getnameinfo(const struct net_sockaddr *addr, net_socklen_t addrlen,
 #define ZSOCK_TCP_KEEPINTVL 3
 /** Number of keepalives before dropping connection */
 #define ZSOCK_TCP_KEEPCNT 4
+/** Name of the congestion control algorithm, for example "cubic" */
+#define ZSOCK_TCP_CONGESTION 5
+
+/** Maximum length of a congestion control algorithm name */
+#define ZSOCK_TCP_CA_NAME_MAX 16
 
 /** @} */
 
@@ -61,6 +61,7 @@ struct zperf_upload_params {
 	struct {
 		uint8_t tos;
 		int tcp_nodelay;
+		char tcp_congestion[ZSOCK_TCP_CA_NAME_MAX];
 		int priority;
 #ifdef CONFIG_ZPERF_SESSION_PER_THREAD
 		int thread_priority;
@@ -996,6 +996,81 @@ static inline void net_buf_simple_restore(struct net_buf_simple *buf,
  */
 #define NET_BUF_EXTERNAL_DATA  BIT(0)
 
+struct net_buf_ext;
+
+/**
+ * @brief Release callback of external network buffer memory.
+ *
+ * Called once the last reference to the external memory has been dropped,
+ * after which the memory may be reused or freed.
+ *
+ * @param ext External memory descriptor.
+ */
+typedef void (*net_buf_ext_release_t)(struct net_buf_ext *ext);
+
+/**
+ * @brief Reference counted external memory.
+ *
+ * Descriptor of memory which is not owned by a network buffer pool, and
+ * which network buffers created with net_buf_alloc_with_ext() reference
+ * without copying it. It is typically embedded in a structure of the
+ * owner of the memory, retrieved with CONTAINER_OF() in the release
+ * callback.
+ */
+struct net_buf_ext {
+	/** Reference count. */
+	atomic_t ref;
+
+	/** Called when the reference count drops to zero. */
+	net_buf_ext_release_t release;
+};
+
+/**
+ * @brief Initialize external network buffer memory.
+ *
+ * The descriptor starts with a single reference, held by the owner of the
+ * memory and dropped with net_buf_ext_unref() once it has been given to
+ * the network buffers.
+ *
+ * @param ext External memory descriptor.
+ * @param release Callback called when the last reference is dropped.
+ */
+static inline void net_buf_ext_init(struct net_buf_ext *ext, net_buf_ext_release_t release)
+{
+	atomic_set(&ext->ref, 1);
+	ext->release = release;
+}
+
+/**
+ * @brief Take a reference to external network buffer memory.
+ *
+ * @param ext External memory descriptor.
+ *
+ * @return @p ext
+ */
+static inline struct net_buf_ext *net_buf_ext_ref(struct net_buf_ext *ext)
+{
+	atomic_inc(&ext->ref);
+
+	return ext;
+}
+
+/**
+ * @brief Drop a reference to external network buffer memory.
+ *
+ * Calls the release callback of @p ext if this was the last reference.
+ *
+ * @param ext External memory descriptor.
+ */
+static inline void net_buf_ext_unref(struct net_buf_ext *ext)
+{
+	__ASSERT(atomic_get(&ext->ref) > 0, "ext %p double release", ext);
+
+	if (atomic_dec(&ext->ref) == 1) {
+		ext->release(ext);
+	}
+}
+
 /**
  * @brief Network buffer representation.
  *
@@ -1049,6 +1124,11 @@ struct net_buf {
 		/** @endcond */
 	};
 
+#if defined(CONFIG_NET_BUF_EXTERNAL_REF) || defined(__DOXYGEN__)
+	/** External memory referenced by the data of this buffer, if any. */
+	struct net_buf_ext *ext;
+#endif
+
 	/** System metadata for this buffer. Cleared on allocation. */
 	uint8_t user_data[] __net_buf_align;
 };
@@ -1069,6 +1149,14 @@ struct net_buf_data_alloc {
 	size_t alignment;
 };
 
+#if defined(CONFIG_NET_BUF_POOL_PERCPU_CACHE)
+struct net_buf_pool_cpu_cache {
+	struct k_spinlock lock;
+	sys_slist_t free;
+	uint16_t count;
+};
+#endif
+
 /** @endcond */
 
 /**
@@ -1114,6 +1202,13 @@ struct net_buf_pool {
 
 	/** Start of buffer storage array */
 	struct net_buf * const __bufs;
+
+#if defined(CONFIG_NET_BUF_POOL_PERCPU_CACHE)
+	/** @cond INTERNAL_HIDDEN */
+	atomic_t cache_waiters;
+	struct net_buf_pool_cpu_cache cpu_cache[CONFIG_MP_MAX_NUM_CPUS];
+	/** @endcond */
+#endif
 };
 
 /** @cond INTERNAL_HIDDEN */
@@ -1503,6 +1598,41 @@ struct net_buf * __must_check net_buf_alloc_with_data(struct net_buf_pool *pool,
 						      k_timeout_t timeout);
 #endif
 
+#if defined(CONFIG_NET_BUF_EXTERNAL_REF) || defined(__DOXYGEN__)
+/**
+ * @brief Allocate a new buffer from a pool referencing external memory.
+ *
+ * Allocate a new buffer from a pool, whose data is @p len bytes of the
+ * external memory described by @p ext. The buffer holds a reference to
+ * @p ext until it is destroyed, and clones of the buffer share the data
+ * and take their own reference. The data is not written through the
+ * buffer, so it may be read-only memory.
+ *
+ * @kconfig_dep{CONFIG_NET_BUF_EXTERNAL_REF}
+ *
+ * @param pool Which pool to allocate the buffer from.
+ * @param ext External memory descriptor.
+ * @param data Start of the data, inside the external memory.
+ * @param len Length of the data.
+ * @param timeout Affects the action taken should the pool be empty.
+ *        If K_NO_WAIT, then return immediately. If K_FOREVER, then
+ *        wait as long as necessary. Otherwise, wait until the specified
+ *        timeout.
+ *
+ * @return New buffer or NULL if out of buffers.
+ */
+struct net_buf * __must_check net_buf_alloc_with_ext(struct net_buf_pool *pool,
+						     struct net_buf_ext *ext,
+						     const void *data, size_t len,
+						     k_timeout_t timeout);
+#endif
+
+#if defined(CONFIG_NET_BUF_POOL_PERCPU_CACHE)
+/** @cond INTERNAL_HIDDEN */
+void net_buf_pool_cache_put(struct net_buf_pool *pool, struct net_buf *buf);
+/** @endcond */
+#endif
+
 /**
  * @brief Destroy buffer from custom destroy callback
  *
@@ -1523,7 +1653,18 @@ static inline void net_buf_destroy(struct net_buf *buf)
 		buf->__buf = NULL;
 	}
 
+#if defined(CONFIG_NET_BUF_EXTERNAL_REF)
+	if (buf->ext) {
+		net_buf_ext_unref(buf->ext);
+		buf->ext = NULL;
+	}
+#endif
+
+#if defined(CONFIG_NET_BUF_POOL_PERCPU_CACHE)
+	net_buf_pool_cache_put(pool, buf);
+#else
 	k_lifo_put(&pool->free, buf);
+#endif
 }
 
 /**
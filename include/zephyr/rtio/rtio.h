@@ -37,6 +37,7 @@
 #include <zephyr/sys/mem_blocks.h>
 #include <zephyr/sys/util.h>
 #include <zephyr/sys/iterable_sections.h>
+#include <zephyr/sys/math_extras.h>
 #include <zephyr/sys/mpsc_lockfree.h>
 
 #ifdef __cplusplus
@@ -398,10 +399,13 @@ struct rtio_sqe_pool {
 	struct rtio_iodev_sqe *pool;
 };
 
+/* CQEs are allocated by every thread completing requests, the free ones are
+ * tracked in an atomic bitmap so that allocations may run concurrently.
+ */
 struct rtio_cqe_pool {
-	struct mpsc free_q;
+	atomic_t *free_mask;
 	const uint16_t pool_size;
-	uint16_t pool_free;
+	atomic_t pool_free;
 	struct rtio_cqe *pool;
 };
 
@@ -841,26 +845,37 @@ static inline void rtio_sqe_pool_free(struct rtio_sqe_pool *pool, struct rtio_io
 
 static inline struct rtio_cqe *rtio_cqe_pool_alloc(struct rtio_cqe_pool *pool)
 {
-	struct mpsc_node *node = mpsc_pop(&pool->free_q);
+	for (size_t i = 0; i < ATOMIC_BITMAP_SIZE(pool->pool_size); i++) {
+		atomic_val_t free = atomic_get(&pool->free_mask[i]);
 
-	if (node == NULL) {
-		return NULL;
-	}
+		/* Claim the lowest free CQE of the word, retrying if another
+		 * thread changed the word meanwhile.
+		 */
+		while (free != 0) {
+			unsigned int bit = u64_count_trailing_zeros((unsigned long)free);
 
-	struct rtio_cqe *cqe = CONTAINER_OF(node, struct rtio_cqe, q);
+			if (atomic_cas(&pool->free_mask[i], free, free & ~ATOMIC_MASK(bit))) {
+				struct rtio_cqe *cqe = &pool->pool[i * ATOMIC_BITS + bit];
 
-	memset(cqe, 0, sizeof(struct rtio_cqe));
+				memset(cqe, 0, sizeof(struct rtio_cqe));
 
-	pool->pool_free--;
+				atomic_dec(&pool->pool_free);
 
-	return cqe;
+				return cqe;
+			}
+
+			free = atomic_get(&pool->free_mask[i]);
+		}
+	}
+
+	return NULL;
 }
 
 static inline void rtio_cqe_pool_free(struct rtio_cqe_pool *pool, struct rtio_cqe *cqe)
 {
-	mpsc_push(&pool->free_q, &cqe->q);
+	atomic_inc(&pool->pool_free);
 
-	pool->pool_free++;
+	atomic_set_bit(pool->free_mask, cqe - pool->pool);
 }
 
 static inline int rtio_block_pool_alloc(struct rtio *r, size_t min_sz,
@@ -945,10 +960,11 @@ static inline void rtio_block_pool_free(struct rtio *r, void *buf, uint32_t buf_
 
 #define Z_RTIO_CQE_POOL_DEFINE(name, sz)			\
 	static struct rtio_cqe CONCAT(_cqe_pool_, name)[sz];	\
+	static ATOMIC_DEFINE(CONCAT(_cqe_pool_free_, name), sz);	\
 	STRUCT_SECTION_ITERABLE(rtio_cqe_pool, name) = {	\
-		.free_q = MPSC_INIT((name.free_q)),	\
+		.free_mask = CONCAT(_cqe_pool_free_, name),	\
 		.pool_size = sz,				\
-		.pool_free = sz,				\
+		.pool_free = ATOMIC_INIT(sz),			\
 		.pool = CONCAT(_cqe_pool_, name),		\
 	}
 
@@ -11,6 +11,7 @@
 #include <zephyr/device.h>
 #include <zephyr/rtio/rtio.h>
 #include <zephyr/sys/p4wq.h>
+#include <zephyr/sys/slist.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -42,6 +43,25 @@ struct rtio_work_req {
 	 * This is filled inside @ref rtio_work_req_submit.
 	 */
 	rtio_work_submit_t handler;
+
+#if defined(CONFIG_RTIO_WORKQ_IODEV_QUEUES) || defined(__DOXYGEN__)
+	/** Node in the queue of the IODEV. */
+	sys_snode_t node;
+#endif
+};
+
+/**
+ * @brief RTIO Work-queues statistics.
+ *
+ * The mean number of work items handled per wakeup of the threads
+ * is @p reqs / @p wakeups.
+ */
+struct rtio_work_stats {
+	/** Number of wakeups of the threads of the pool. */
+	uint32_t wakeups;
+
+	/** Number of work items handled. */
+	uint32_t reqs;
 };
 
 /**
@@ -73,6 +93,17 @@ void rtio_work_req_submit(struct rtio_work_req *req,
  */
 uint32_t rtio_work_req_used_count_get(void);
 
+#if defined(CONFIG_RTIO_WORKQ_STATS) || defined(__DOXYGEN__)
+/**
+ * @brief Obtain the statistics of the RTIO Work-queues.
+ *
+ * @kconfig_dep{CONFIG_RTIO_WORKQ_STATS}
+ *
+ * @param stats Filled with the statistics since boot.
+ */
+void rtio_work_stats_get(struct rtio_work_stats *stats);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
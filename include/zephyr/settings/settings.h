@@ -410,6 +410,56 @@ int settings_commit(void);
  */
 int settings_commit_subtree(const char *subtree);
 
+/**
+ * Settings item of a batch saved by @ref settings_save_batch.
+ */
+struct settings_batch_entry {
+	/** Name/key of the settings item. */
+	const char *name;
+	/** Pointer to the value of the settings item, NULL to delete it. */
+	const void *value;
+	/** Length of the value, 0 to delete the settings item. */
+	size_t val_len;
+};
+
+#if defined(CONFIG_SETTINGS_SAVE_BATCH) || defined(__DOXYGEN__)
+/**
+ * Write several serialized values to persisted storage at once.
+ *
+ * Back-ends supporting batches (NVS and ZMS) store the settings items saved
+ * in batches in records of @kconfig{CONFIG_SETTINGS_SAVE_BATCH_BUF_SIZE}
+ * bytes, each holding several settings items, instead of one or two entries
+ * per settings item. A batch writes the records holding the settings items
+ * already stored that way along with its own ones, then commits them with a
+ * single record, so that each of its values is written once and a reset
+ * leaves either none or all of its settings items. Other back-ends save the
+ * items one after another, without atomicity guarantee.
+ *
+ * Since every batch rewrites the settings items stored in the records, it
+ * suits saving a configuration as a whole. A settings item saved with
+ * @ref settings_save_one afterwards is written in its own entries, which take
+ * precedence over the records, while deleting a settings item stored in the
+ * records saves a batch. A batch of a single settings item is written in its
+ * own entries.
+ *
+ * If a settings item appears several times in the batch, the last value is
+ * persisted.
+ *
+ * @param entries Array of settings items to write.
+ * @param count Number of settings items in @p entries.
+ *
+ * @retval 0 on success.
+ * @retval -E2BIG if a settings item does not fit in
+ * @kconfig{CONFIG_SETTINGS_SAVE_BATCH_BUF_SIZE} or the settings items stored
+ * in records need more than @kconfig{CONFIG_SETTINGS_SAVE_BATCH_RECORDS}
+ * records, in which case nothing is written.
+ * @retval -ENOENT if no settings destination is registered.
+ * @retval -EINVAL if an entry has no name.
+ * @return other negative values on back-end errors.
+ */
+int settings_save_batch(const struct settings_batch_entry *entries, size_t count);
+#endif
+
 #if defined(CONFIG_SETTINGS_SAVE_SINGLE_SUBTREE_WITHOUT_MODIFICATION) || defined(__DOXYGEN__)
 /**
  * Save a single currently running serialized value to persisted storage (if it has changed
@@ -541,6 +591,18 @@ struct settings_store_itf {
 	int (*csi_save)(struct settings_store *cs, const char *name, const char *value,
 			size_t val_len);
 
+	/**
+	 * @brief Save several key-value pairs to storage at once.
+	 *
+	 * If NULL then the key-value pairs are saved one by one with csi_save.
+	 *
+	 * @param[in] cs Corresponding backend handler node
+	 * @param[in] entries Array of key-value pairs
+	 * @param[in] count Number of key-value pairs in entries
+	 */
+	int (*csi_save_batch)(struct settings_store *cs,
+			      const struct settings_batch_entry *entries, size_t count);
+
 	/**
 	 * @brief Handler called after an export operation.
 	 *
@@ -65,6 +65,23 @@ struct z_heap_stress_result {
 	uint32_t successful_allocs;
 	uint32_t total_frees;
 	uint64_t accumulated_in_use_bytes;
+	uint32_t elapsed_cycles;
+};
+
+struct k_thread;
+
+/** @brief Threads used by sys_heap_stress_mt() */
+struct z_heap_stress_mt_config {
+	/** Array of @a num_threads threads */
+	struct k_thread *threads;
+	/** Stacks defined with K_THREAD_STACK_ARRAY_DEFINE() */
+	void *stacks;
+	/** Distance in bytes between two stacks, i.e. sizeof(stacks[0]) */
+	size_t stack_stride;
+	/** Size of each stack, i.e. K_THREAD_STACK_SIZEOF(stacks[0]) */
+	size_t stack_size;
+	/** Number of worker threads */
+	int num_threads;
 };
 
 /**
@@ -278,6 +295,37 @@ void sys_heap_stress(void *(*alloc_fn)(void *arg, size_t bytes),
 		     int target_percent,
 		     struct z_heap_stress_result *result);
 
+/** @brief Multithreaded sys_heap stress test rig
+ *
+ * Same as sys_heap_stress(), but runs @a config->num_threads worker
+ * threads concurrently, at the priority of the caller, each doing its
+ * share of @a op_count operations while seeking @a target_percent of
+ * its share of @a total_bytes.  The callbacks must therefore be
+ * thread safe.  Results are summed over all workers, and
+ * elapsed_cycles measures the wall clock time of the whole run, which
+ * makes this suitable to measure allocator throughput under
+ * contention.
+ *
+ * @param alloc_fn Thread safe allocation callback
+ * @param free_fn Thread safe free callback
+ * @param arg Context handle to pass back to the callbacks
+ * @param total_bytes Size of the byte array the heap was initialized in
+ * @param op_count How many iterations to test, over all threads
+ * @param scratch_mem Scratch memory, split between the threads
+ * @param scratch_bytes Size of the memory pointed to by @a scratch_mem
+ * @param target_percent Percentage fill value (1-100)
+ * @param config Worker threads and their stacks
+ * @param result Struct into which to store test results.
+ */
+void sys_heap_stress_mt(void *(*alloc_fn)(void *arg, size_t bytes),
+			void (*free_fn)(void *arg, void *p),
+			void *arg, size_t total_bytes,
+			uint32_t op_count,
+			void *scratch_mem, size_t scratch_bytes,
+			int target_percent,
+			const struct z_heap_stress_mt_config *config,
+			struct z_heap_stress_result *result);
+
 /** @brief Print heap internal structure information to the console
  *
  * Print information on the heap structure such as its size, chunk buckets,
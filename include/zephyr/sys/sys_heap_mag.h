@@ -0,0 +1,158 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_SYS_HEAP_MAG_H_
+#define ZEPHYR_INCLUDE_SYS_SYS_HEAP_MAG_H_
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/sys_heap.h>
+#include <zephyr/sys/mem_stats.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup sys_heap_mag Heap Magazines
+ * @ingroup heaps
+ * @{
+ */
+
+/** Size in bytes of the smallest magazine size class */
+#define SYS_HEAP_MAG_MIN_BYTES 16
+
+/** Size in bytes of the largest magazine size class */
+#define SYS_HEAP_MAG_MAX_BYTES \
+	(SYS_HEAP_MAG_MIN_BYTES << (CONFIG_SYS_HEAP_MAGAZINE_CLASSES - 1))
+
+/** @cond INTERNAL_HIDDEN */
+struct sys_heap_mag_class {
+	unsigned int count;
+	void *blocks[CONFIG_SYS_HEAP_MAGAZINE_DEPTH];
+};
+
+struct sys_heap_mag_cpu {
+	struct k_spinlock lock;
+	struct sys_heap_mag_class classes[CONFIG_SYS_HEAP_MAGAZINE_CLASSES];
+	uint32_t hits;
+	uint32_t misses;
+	size_t cached_bytes;
+};
+/** @endcond */
+
+/**
+ * @brief Per-CPU magazine front-end of a sys_heap
+ *
+ * A sys_heap_mag keeps, for each CPU, a small stack ("magazine") of
+ * recently freed blocks for each power-of-two size class between
+ * SYS_HEAP_MAG_MIN_BYTES and SYS_HEAP_MAG_MAX_BYTES.  Small
+ * allocations are served from, and small frees go to, the magazine of
+ * the current CPU without taking the lock that serializes access to
+ * the backing heap.  Only misses (empty or full magazine, large or
+ * aligned requests, user mode callers) need to go to the heap itself.
+ *
+ * Cached blocks remain allocated from the point of view of the heap,
+ * so sys_heap_validate() is unaffected, and
+ * sys_heap_mag_runtime_stats_get() reports them as free.
+ */
+struct sys_heap_mag {
+	struct sys_heap *heap;
+	struct sys_heap_mag_cpu cpus[CONFIG_MP_MAX_NUM_CPUS];
+};
+
+/** @brief Magazine hit/miss statistics */
+struct sys_heap_mag_stats {
+	/** Allocations and frees served by a magazine */
+	uint32_t hits;
+	/** Allocations and frees that had to go to the heap */
+	uint32_t misses;
+	/** Bytes of heap memory currently held by the magazines */
+	size_t cached_bytes;
+};
+
+/**
+ * @brief Initialize heap magazines
+ *
+ * @param mag Magazines to initialize
+ * @param heap Initialized heap the magazines sit in front of
+ */
+void sys_heap_mag_init(struct sys_heap_mag *mag, struct sys_heap *heap);
+
+/**
+ * @brief Allocate a small block from the current CPU's magazine
+ *
+ * Does not need the heap lock.  On NULL return the caller should
+ * allocate sys_heap_mag_alloc_size() bytes from the heap itself, so
+ * that the block can be cached once freed.
+ *
+ * @param mag Heap magazines
+ * @param bytes Number of bytes requested
+ * @return Pointer to memory, or NULL on a miss
+ */
+void *sys_heap_mag_alloc(struct sys_heap_mag *mag, size_t bytes);
+
+/**
+ * @brief Size to request from the heap after a magazine miss
+ *
+ * @param bytes Number of bytes requested
+ * @return @a bytes rounded up to its size class, or @a bytes if too
+ *         large to be cached
+ */
+size_t sys_heap_mag_alloc_size(size_t bytes);
+
+/**
+ * @brief Free a block to the current CPU's magazine
+ *
+ * Does not need the heap lock.  On false return the caller must free
+ * the block to the heap itself.
+ *
+ * @param mag Heap magazines
+ * @param mem Block allocated from the heap behind @a mag (or NULL)
+ * @return true if the block was cached (or @a mem is NULL)
+ */
+bool sys_heap_mag_free(struct sys_heap_mag *mag, void *mem);
+
+/**
+ * @brief Return every cached block to the heap
+ *
+ * Must be called with the heap lock held, e.g. before walking the heap
+ * or to give memory back after an allocation failure.
+ *
+ * @param mag Heap magazines
+ */
+void sys_heap_mag_flush(struct sys_heap_mag *mag);
+
+/**
+ * @brief Get magazine hit/miss statistics, summed over all CPUs
+ *
+ * @param mag Heap magazines
+ * @param stats Structure to fill
+ */
+void sys_heap_mag_stats_get(struct sys_heap_mag *mag, struct sys_heap_mag_stats *stats);
+
+#if defined(CONFIG_SYS_HEAP_RUNTIME_STATS) || defined(__DOXYGEN__)
+/**
+ * @brief Get the runtime statistics of the heap behind magazines
+ *
+ * Same as sys_heap_runtime_stats_get() but accounts blocks held in
+ * the magazines as free.  Must be called with the heap lock held.
+ *
+ * @param mag Heap magazines
+ * @param stats Pointer to struct to copy statistics into
+ * @return -EINVAL if null pointers, otherwise 0
+ */
+int sys_heap_mag_runtime_stats_get(struct sys_heap_mag *mag, struct sys_memory_stats *stats);
+#endif
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_SYS_HEAP_MAG_H_ */
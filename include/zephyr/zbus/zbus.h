@@ -41,11 +41,31 @@ struct zbus_channel_data {
 	 */
 	int16_t observers_end_idx;
 
+#if defined(CONFIG_ZBUS_CHANNEL_ID_INDEX) || defined(__DOXYGEN__)
+	/** Section index of the channel whose identifier has the same rank as this channel's
+	 * section index. Used for the identifier lookups.
+	 */
+	uint16_t id_order;
+#endif /* CONFIG_ZBUS_CHANNEL_ID_INDEX */
+
 	/** Access control semaphore. Points to the semaphore used to avoid race conditions
 	 * for accessing the channel.
 	 */
 	struct k_sem sem;
 
+#if defined(CONFIG_ZBUS_CHANNEL_SEQLOCK) || defined(__DOXYGEN__)
+	/** Message sequence counter of lock-free channels. It is odd while the message is
+	 * being written. Readers retry when it is odd or changes during their copy.
+	 */
+	atomic_t seq;
+
+	/** Lock-free flag. Readers of the channel do not take the semaphore.
+	 *
+	 * @see ZBUS_CHAN_DEFINE_SEQLOCK
+	 */
+	bool seqlock;
+#endif /* CONFIG_ZBUS_CHANNEL_SEQLOCK */
+
 #if defined(CONFIG_ZBUS_PRIORITY_BOOST)
 	/** Highest observer priority. Indicates the priority that the VDED will use to boost the
 	 * notification process avoiding preemptions.
@@ -285,11 +305,12 @@ struct zbus_channel_observation {
 #define _ZBUS_MESSAGE_NAME(_name) _CONCAT(_zbus_message_, _name)
 
 /* clang-format off */
-#define _ZBUS_CHAN_DEFINE(_name, _id, _type, _validator, _user_data)                               \
+#define _ZBUS_CHAN_DEFINE(_name, _id, _type, _validator, _user_data, _seqlock)                     \
 	static struct zbus_channel_data _CONCAT(_zbus_chan_data_, _name) = {                       \
 		.observers_start_idx = -1,                                                         \
 		.observers_end_idx = -1,                                                           \
 		.sem = Z_SEM_INITIALIZER(_CONCAT(_zbus_chan_data_, _name).sem, 1, 1),              \
+		IF_ENABLED(CONFIG_ZBUS_CHANNEL_SEQLOCK, (.seqlock = _seqlock,))                    \
 		IF_ENABLED(CONFIG_ZBUS_PRIORITY_BOOST,                                             \
 			   (.highest_observer_priority = ZBUS_MIN_THREAD_PRIORITY,))               \
 		 IF_ENABLED(CONFIG_ZBUS_RUNTIME_OBSERVERS,                                         \
@@ -397,7 +418,7 @@ struct zbus_channel_observation {
  */
 #define ZBUS_CHAN_DEFINE(_name, _type, _validator, _user_data, _observers, _init_val)              \
 	static _type _ZBUS_MESSAGE_NAME(_name) = _init_val;                                        \
-	_ZBUS_CHAN_DEFINE(_name, ZBUS_CHAN_ID_INVALID, _type, _validator, _user_data);             \
+	_ZBUS_CHAN_DEFINE(_name, ZBUS_CHAN_ID_INVALID, _type, _validator, _user_data, false);      \
 	/* Extern declaration of observers */                                                      \
 	ZBUS_OBS_DECLARE(_observers);                                                              \
 	/* Create all channel observations from observers list */                                  \
@@ -421,7 +442,42 @@ struct zbus_channel_observation {
  */
 #define ZBUS_CHAN_DEFINE_WITH_ID(_name, _id, _type, _validator, _user_data, _observers, _init_val) \
 	static _type _ZBUS_MESSAGE_NAME(_name) = _init_val;                                        \
-	_ZBUS_CHAN_DEFINE(_name, _id, _type, _validator, _user_data);                              \
+	_ZBUS_CHAN_DEFINE(_name, _id, _type, _validator, _user_data, false);                       \
+	/* Extern declaration of observers */                                                      \
+	ZBUS_OBS_DECLARE(_observers);                                                              \
+	/* Create all channel observations from observers list */                                  \
+	FOR_EACH_FIXED_ARG_NONEMPTY_TERM(_ZBUS_CHAN_OBSERVATION, (;), _name, _observers)
+
+/**
+ * @brief Zbus lock-free channel definition.
+ *
+ * This macro defines a channel whose readers do not lock it. The message is protected by a
+ * sequence counter instead of the channel semaphore: zbus_chan_read copies the message without
+ * taking the semaphore and retries when a publication happened during the copy. Publishers,
+ * claims and notifications still serialize on the semaphore, so the publisher never waits on
+ * readers and the observers are notified exactly as on regular channels.
+ *
+ * Readers only wait when they find the message in the middle of a write. Claiming such a channel
+ * counts as writing the message, so keep the claims short.
+ *
+ * @note It requires the @kconfig{CONFIG_ZBUS_CHANNEL_SEQLOCK}. It is meant for channels published
+ * at a high rate and read by many threads, like sensor samples.
+ *
+ * @param _name The channel's name.
+ * @param _type The Message type. It must be a struct or union.
+ * @param _validator The validator function.
+ * @param _user_data A pointer to the user data.
+ * @param _observers The observers list. The order defines observer priority, with the first
+ * observer having the highest priority.
+ * @param _init_val The message initialization.
+ *
+ * @see struct zbus_channel
+ */
+#define ZBUS_CHAN_DEFINE_SEQLOCK(_name, _type, _validator, _user_data, _observers, _init_val)      \
+	BUILD_ASSERT(IS_ENABLED(CONFIG_ZBUS_CHANNEL_SEQLOCK),                                      \
+		     "Lock-free channels require CONFIG_ZBUS_CHANNEL_SEQLOCK");                    \
+	static _type _ZBUS_MESSAGE_NAME(_name) = _init_val;                                        \
+	_ZBUS_CHAN_DEFINE(_name, ZBUS_CHAN_ID_INVALID, _type, _validator, _user_data, true);       \
 	/* Extern declaration of observers */                                                      \
 	ZBUS_OBS_DECLARE(_observers);                                                              \
 	/* Create all channel observations from observers list */                                  \
@@ -698,7 +754,9 @@ int zbus_chan_pub(const struct zbus_channel *chan, const void *msg, k_timeout_t
 /**
  * @brief Read a channel
  *
- * This routine reads a message from a channel.
+ * This routine reads a message from a channel. Reading a lock-free channel, see
+ * ZBUS_CHAN_DEFINE_SEQLOCK, does not take the channel semaphore. The read is retried until no
+ * publication overlaps the copy, and only waits while the message is being written.
  *
  * @param[in] chan The channel's reference.
  * @param[out] msg Reference to the message where the read function copies the channel's
@@ -798,6 +856,9 @@ static inline const char *zbus_chan_name(const struct zbus_channel *chan)
 /**
  * @brief Retrieve a zbus channel from its numeric identifier
  *
+ * With @kconfig{CONFIG_ZBUS_CHANNEL_ID_INDEX} the lookup is a binary search over the channels
+ * ordered by identifier during the zbus initialization.
+ *
  * @param channel_id Unique channel ID from @ref ZBUS_CHAN_DEFINE_WITH_ID
  *
  * @retval NULL If channel with ID @a channel_id does not exist.
@@ -812,6 +873,8 @@ const struct zbus_channel *zbus_chan_from_id(uint32_t channel_id);
 /**
  * @brief Retrieve a zbus channel from its name string
  *
+ * The lookup is a binary search, the linker places the channels sorted by name.
+ *
  * @param name Name of the channel to retrieve.
  *
  * @retval NULL If channel with name @a name does not exist.
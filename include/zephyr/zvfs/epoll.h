@@ -0,0 +1,112 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZEPHYR_ZVFS_EPOLL_H_
+#define ZEPHYR_INCLUDE_ZEPHYR_ZVFS_EPOLL_H_
+
+#include <stdint.h>
+
+#include <zephyr/sys/fdtable.h>
+#include <zephyr/sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ZVFS_EPOLL_CTL_ADD 1
+#define ZVFS_EPOLL_CTL_DEL 2
+#define ZVFS_EPOLL_CTL_MOD 3
+
+#define ZVFS_EPOLLIN      ZVFS_POLLIN
+#define ZVFS_EPOLLPRI     ZVFS_POLLPRI
+#define ZVFS_EPOLLOUT     ZVFS_POLLOUT
+#define ZVFS_EPOLLERR     ZVFS_POLLERR
+#define ZVFS_EPOLLHUP     ZVFS_POLLHUP
+#define ZVFS_EPOLLONESHOT BIT(30)
+#define ZVFS_EPOLLET      BIT(31)
+
+#define ZVFS_EPOLL_CLOEXEC 0x80000
+
+typedef union zvfs_epoll_data {
+	void *ptr;
+	int fd;
+	uint32_t u32;
+	uint64_t u64;
+} zvfs_epoll_data_t;
+
+struct zvfs_epoll_event {
+	uint32_t events;
+	zvfs_epoll_data_t data;
+};
+
+/**
+ * @brief Create a ZVFS epoll instance
+ *
+ * An epoll instance keeps a set of file descriptors of interest, registered
+ * with @ref zvfs_epoll_ctl. The set survives across calls to
+ * @ref zvfs_epoll_wait, which only returns the file descriptors that are
+ * ready. Any file descriptor supporting poll can be registered.
+ *
+ * The poll events of a registered file descriptor stay registered with the
+ * kernel between waits. When one of them fires, the ZVFS epoll work queue
+ * moves the file descriptor to the ready list of the instance, so that a
+ * wait only goes through the ready file descriptors.
+ *
+ * A file descriptor is dropped from the set when it is closed.
+ *
+ * @param flags 0 or ZVFS_EPOLL_CLOEXEC, which is accepted and ignored
+ *
+ * @return New ZVFS epoll file descriptor on success, -1 on error
+ */
+int zvfs_epoll_create(int flags);
+
+/**
+ * @brief Change the interest set of a ZVFS epoll instance
+ *
+ * @param epfd Epoll file descriptor
+ * @param op ZVFS_EPOLL_CTL_ADD, ZVFS_EPOLL_CTL_MOD or ZVFS_EPOLL_CTL_DEL
+ * @param fd File descriptor the operation applies to
+ * @param event Events of interest and data returned with them, ignored by
+ *        ZVFS_EPOLL_CTL_DEL
+ *
+ * @return 0 on success, -1 on error
+ */
+int zvfs_epoll_ctl(int epfd, int op, int fd, struct zvfs_epoll_event *event);
+
+/**
+ * @brief Wait for events on a ZVFS epoll instance
+ *
+ * Entries registered with ZVFS_EPOLLET are reported once each time they
+ * become ready, the caller is expected to consume the data until the
+ * operation would block. Entries registered with ZVFS_EPOLLONESHOT are
+ * disabled after being reported until they are re-armed with
+ * ZVFS_EPOLL_CTL_MOD.
+ *
+ * @param epfd Epoll file descriptor
+ * @param events Array filled with the ready file descriptors
+ * @param maxevents Size of the @p events array
+ * @param timeout Timeout in milliseconds, -1 to wait forever
+ *
+ * @return Number of ready file descriptors, 0 on timeout, -1 on error
+ */
+int zvfs_epoll_wait(int epfd, struct zvfs_epoll_event *events, int maxevents, int timeout);
+
+/**
+ * @brief Drop a file descriptor from the ZVFS epoll instances
+ *
+ * Called by zvfs_close() before closing the underlying object, so that no
+ * poll event stays registered on it.
+ *
+ * @param fd File descriptor being closed
+ * @param obj Object the file descriptor refers to
+ */
+void zvfs_epoll_release(int fd, void *obj);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZEPHYR_ZVFS_EPOLL_H_ */
@@ -37,6 +37,13 @@
 #define _priq_run_best		z_priq_mq_best
 #endif
 
+/* Highest priority thread of a run queue, ignoring CPU masks */
+#if defined(CONFIG_SCHED_SIMPLE)
+#define _priq_run_head		z_priq_simple_best
+#else
+#define _priq_run_head		_priq_run_best
+#endif
+
 /* Scalable Wait Queue */
 #if defined(CONFIG_WAITQ_SCALABLE)
 #define _priq_wait_add		z_priq_rb_add
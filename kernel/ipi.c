@@ -28,6 +28,26 @@ void flag_ipi(uint32_t ipi_mask)
 /* Create a bitmask of CPUs that need an IPI. Note: sched_spinlock is held. */
 atomic_val_t ipi_mask_create(struct k_thread *thread)
 {
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	/* Only the CPU whose queue received <thread> may need to
+	 * reschedule, other CPUs check the remote queues whenever
+	 * they reschedule on their own.
+	 */
+	uint32_t cpu = thread->base.runq_cpu;
+	struct k_thread *cpu_thread = _kernel.cpus[cpu].current;
+
+	if (!z_is_thread_queued(thread) || (thread == _current) ||
+	    (cpu == _current_cpu->id) || (cpu_thread == NULL)) {
+		return 0;
+	}
+
+	if (((z_sched_prio_cmp(cpu_thread, thread) < 0) && thread_is_preemptible(cpu_thread)) ||
+	    thread_is_metairq(thread)) {
+		return (atomic_val_t)BIT(cpu);
+	}
+
+	return 0;
+#else
 	if (!IS_ENABLED(CONFIG_IPI_OPTIMIZE)) {
 		return (CONFIG_MP_MAX_NUM_CPUS > 1) ? IPI_ALL_CPUS_MASK : 0;
 	}
@@ -67,6 +87,7 @@ atomic_val_t ipi_mask_create(struct k_thread *thread)
 	}
 
 	return (atomic_val_t)ipi_mask;
+#endif /* CONFIG_SCHED_CPU_RUNQ */
 }
 
 void signal_pending_ipi(void)
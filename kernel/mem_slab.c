@@ -23,6 +23,19 @@ static struct k_obj_type obj_type_mem_slab;
 
 #ifdef CONFIG_OBJ_CORE_STATS_MEM_SLAB
 
+#ifdef CONFIG_MEM_SLAB_PERCPU_CACHE
+static uint32_t slab_cache_hits_get(struct k_mem_slab *slab)
+{
+	uint32_t hits = 0U;
+
+	for (unsigned int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		hits += slab->cpu_cache[i].hits;
+	}
+
+	return hits;
+}
+#endif /* CONFIG_MEM_SLAB_PERCPU_CACHE */
+
 static int k_mem_slab_stats_raw(struct k_obj_core *obj_core, void *stats)
 {
 	__ASSERT((obj_core != NULL) && (stats != NULL), "NULL parameter");
@@ -35,6 +48,13 @@ static int k_mem_slab_stats_raw(struct k_obj_core *obj_core, void *stats)
 	memcpy(stats, &slab->info, sizeof(slab->info));
 	k_spin_unlock(&slab->lock, key);
 
+#ifdef CONFIG_MEM_SLAB_PERCPU_CACHE
+	struct k_mem_slab_info *ptr = stats;
+
+	ptr->num_used = k_mem_slab_num_used_get(slab);
+	ptr->cache_hits = slab_cache_hits_get(slab);
+#endif /* CONFIG_MEM_SLAB_PERCPU_CACHE */
+
 	return 0;
 }
 
@@ -45,12 +65,18 @@ static int k_mem_slab_stats_query(struct k_obj_core *obj_core, void *stats)
 	struct k_mem_slab *slab;
 	k_spinlock_key_t   key;
 	struct sys_memory_stats *ptr = stats;
+	uint32_t num_used;
 
 	slab = CONTAINER_OF(obj_core, struct k_mem_slab, obj_core);
+
+	/* With the per-CPU caches, this takes the cache locks, which come
+	 * before the slab lock.
+	 */
+	num_used = k_mem_slab_num_used_get(slab);
+
 	key = k_spin_lock(&slab->lock);
-	ptr->free_bytes = (slab->info.num_blocks - slab->info.num_used) *
-			  slab->info.block_size;
-	ptr->allocated_bytes = slab->info.num_used * slab->info.block_size;
+	ptr->free_bytes = (slab->info.num_blocks - num_used) * slab->info.block_size;
+	ptr->allocated_bytes = num_used * slab->info.block_size;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	ptr->max_allocated_bytes = slab->info.max_used * slab->info.block_size;
 #else
@@ -69,11 +95,24 @@ static int k_mem_slab_stats_reset(struct k_obj_core *obj_core)
 	k_spinlock_key_t   key;
 
 	slab = CONTAINER_OF(obj_core, struct k_mem_slab, obj_core);
+
+#ifdef CONFIG_MEM_SLAB_PERCPU_CACHE
+	/* The cache locks are taken before the slab lock */
+	for (unsigned int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		K_SPINLOCK(&slab->cpu_cache[i].lock) {
+			slab->cpu_cache[i].hits = 0U;
+		}
+	}
+#endif /* CONFIG_MEM_SLAB_PERCPU_CACHE */
+
 	key = k_spin_lock(&slab->lock);
 
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	slab->info.max_used = slab->info.num_used;
 #endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
+#ifdef CONFIG_MEM_SLAB_PERCPU_CACHE
+	slab->info.cache_misses = 0U;
+#endif /* CONFIG_MEM_SLAB_PERCPU_CACHE */
 
 	k_spin_unlock(&slab->lock, key);
 
@@ -183,6 +222,12 @@ int k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	slab->info.max_used = 0U;
 #endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
+#ifdef CONFIG_MEM_SLAB_PERCPU_CACHE
+	slab->info.cache_hits = 0U;
+	slab->info.cache_misses = 0U;
+	atomic_clear(&slab->cache_waiters);
+	memset(slab->cpu_cache, 0, sizeof(slab->cpu_cache));
+#endif /* CONFIG_MEM_SLAB_PERCPU_CACHE */
 
 	rc = create_free_list(slab);
 	if (rc < 0) {
@@ -219,12 +264,177 @@ static bool slab_ptr_is_good(struct k_mem_slab *slab, const void *ptr)
 	       ((offset % slab->info.block_size) == 0);
 }
 
-int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
+#ifdef CONFIG_MEM_SLAB_PERCPU_CACHE
+#define SLAB_CACHE_BATCH (CONFIG_MEM_SLAB_PERCPU_CACHE_SIZE / 2)
+
+/* Move up to @a count blocks of @a cache back to the slab, or to the threads
+ * waiting for a block. Called with the lock of @a cache held.
+ */
+static bool slab_cache_drain(struct k_mem_slab *slab, struct k_mem_slab_cpu_cache *cache,
+			     uint32_t count)
 {
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
-	int result;
+	bool resched = false;
 
-	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
+	while ((count > 0U) && (cache->count > 0U)) {
+		char *mem = cache->free_list;
+
+		cache->free_list = *(char **)mem;
+		cache->count--;
+		count--;
+
+		if (unlikely(slab->free_list == NULL) && IS_ENABLED(CONFIG_MULTITHREADING)) {
+			struct k_thread *pending_thread = z_unpend_first_thread(&slab->wait_q);
+
+			if (unlikely(pending_thread != NULL)) {
+				/* The block stays in use, by the woken thread */
+				z_thread_return_value_set_with_data(pending_thread, 0, mem);
+				z_ready_thread(pending_thread);
+				resched = true;
+				continue;
+			}
+		}
+
+		*(char **)mem = slab->free_list;
+		slab->free_list = mem;
+		slab->info.num_used--;
+	}
+
+	k_spin_unlock(&slab->lock, key);
+
+	return resched;
+}
+
+/* Move all the blocks of the per-CPU caches back to the slab */
+static void slab_cache_flush(struct k_mem_slab *slab)
+{
+	bool resched = false;
+
+	for (unsigned int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		struct k_mem_slab_cpu_cache *cache = &slab->cpu_cache[i];
+
+		K_SPINLOCK(&cache->lock) {
+			resched |= slab_cache_drain(slab, cache, cache->count);
+		}
+	}
+
+	if (resched) {
+		z_reschedule_unlocked();
+	}
+}
+
+uint32_t z_mem_slab_num_used_get(struct k_mem_slab *slab)
+{
+	k_spinlock_key_t cache_keys[CONFIG_MP_MAX_NUM_CPUS];
+	k_spinlock_key_t key;
+	uint32_t num_used;
+
+	/* All the caches are locked, in the order of their CPUs and before
+	 * the slab, so that no block is seen both in a cache and in the slab.
+	 */
+	for (unsigned int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		cache_keys[i] = k_spin_lock(&slab->cpu_cache[i].lock);
+	}
+	key = k_spin_lock(&slab->lock);
+
+	/* Blocks held by the per-CPU caches are not allocated */
+	num_used = slab->info.num_used;
+	for (unsigned int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		num_used -= slab->cpu_cache[i].count;
+	}
+
+	k_spin_unlock(&slab->lock, key);
+	for (unsigned int i = CONFIG_MP_MAX_NUM_CPUS; i > 0; i--) {
+		k_spin_unlock(&slab->cpu_cache[i - 1].lock, cache_keys[i - 1]);
+	}
+
+	return num_used;
+}
+
+static int slab_cache_alloc(struct k_mem_slab *slab, void **mem)
+{
+	/* Interrupts are locked first so the thread stays on this CPU */
+	unsigned int irq_key = arch_irq_lock();
+	struct k_mem_slab_cpu_cache *cache = &slab->cpu_cache[_current_cpu->id];
+	k_spinlock_key_t key = k_spin_lock(&cache->lock);
+	int result = 0;
+
+	if (cache->count > 0U) {
+		cache->hits++;
+	} else {
+		k_spinlock_key_t slab_key = k_spin_lock(&slab->lock);
+
+		slab->info.cache_misses++;
+
+		/* Refill the cache with a batch of blocks */
+		while ((cache->count < SLAB_CACHE_BATCH) && (slab->free_list != NULL)) {
+			char *block = slab->free_list;
+
+			slab->free_list = *(char **)block;
+			*(char **)block = cache->free_list;
+			cache->free_list = block;
+			cache->count++;
+			slab->info.num_used++;
+		}
+
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+		slab->info.max_used = max(slab->info.num_used,
+					  slab->info.max_used);
+#endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
+
+		k_spin_unlock(&slab->lock, slab_key);
+	}
+
+	if (cache->count > 0U) {
+		*mem = cache->free_list;
+		cache->free_list = *(char **)(cache->free_list);
+		cache->count--;
+	} else {
+		result = -ENOMEM;
+	}
+
+	k_spin_unlock(&cache->lock, key);
+	arch_irq_unlock(irq_key);
+
+	return result;
+}
+
+static void slab_cache_free(struct k_mem_slab *slab, void *mem)
+{
+	unsigned int irq_key = arch_irq_lock();
+	struct k_mem_slab_cpu_cache *cache = &slab->cpu_cache[_current_cpu->id];
+	k_spinlock_key_t key = k_spin_lock(&cache->lock);
+	bool resched = false;
+
+	if (cache->count == CONFIG_MEM_SLAB_PERCPU_CACHE_SIZE) {
+		resched = slab_cache_drain(slab, cache, SLAB_CACHE_BATCH);
+	}
+
+	*(char **)mem = cache->free_list;
+	cache->free_list = (char *)mem;
+	cache->count++;
+
+	/* A thread about to wait for a block flushes the caches after
+	 * registering itself, so a block cached after that flush is seen
+	 * here and handed over.
+	 */
+	if (atomic_get(&slab->cache_waiters) != 0) {
+		resched |= slab_cache_drain(slab, cache, cache->count);
+	}
+
+	k_spin_unlock(&cache->lock, key);
+	arch_irq_unlock(irq_key);
+
+	if (resched) {
+		z_reschedule_unlocked();
+	}
+}
+#endif /* CONFIG_MEM_SLAB_PERCPU_CACHE */
+
+static int slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
+{
+	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	int result;
 
 	if (slab->free_list != NULL) {
 		/* take a free block */
@@ -256,18 +466,47 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 			*mem = _current->base.swap_data;
 		}
 
-		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, result);
-
 		return result;
 	}
 
-	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, result);
-
 	k_spin_unlock(&slab->lock, key);
 
 	return result;
 }
 
+int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
+{
+	int result;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
+
+#ifdef CONFIG_MEM_SLAB_PERCPU_CACHE
+	result = slab_cache_alloc(slab, mem);
+	if (result != 0) {
+		bool wait = !K_TIMEOUT_EQ(timeout, K_NO_WAIT) &&
+			    IS_ENABLED(CONFIG_MULTITHREADING);
+
+		/* Take back the blocks held by the caches of the other CPUs */
+		if (wait) {
+			atomic_inc(&slab->cache_waiters);
+		}
+
+		slab_cache_flush(slab);
+		result = slab_alloc(slab, mem, timeout);
+
+		if (wait) {
+			atomic_dec(&slab->cache_waiters);
+		}
+	}
+#else
+	result = slab_alloc(slab, mem, timeout);
+#endif /* CONFIG_MEM_SLAB_PERCPU_CACHE */
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, result);
+
+	return result;
+}
+
 void k_mem_slab_free(struct k_mem_slab *slab, void *mem)
 {
 	if (!slab_ptr_is_good(slab, mem)) {
@@ -276,6 +515,13 @@ void k_mem_slab_free(struct k_mem_slab *slab, void *mem)
 		return;
 	}
 
+#ifdef CONFIG_MEM_SLAB_PERCPU_CACHE
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
+	slab_cache_free(slab, mem);
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+	return;
+#endif /* CONFIG_MEM_SLAB_PERCPU_CACHE */
+
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
@@ -306,11 +552,14 @@ int k_mem_slab_runtime_stats_get(struct k_mem_slab *slab, struct sys_memory_stat
 		return -EINVAL;
 	}
 
+	/* With the per-CPU caches, this takes the cache locks, which come
+	 * before the slab lock.
+	 */
+	uint32_t num_used = k_mem_slab_num_used_get(slab);
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 
-	stats->allocated_bytes = slab->info.num_used * slab->info.block_size;
-	stats->free_bytes = (slab->info.num_blocks - slab->info.num_used) *
-			    slab->info.block_size;
+	stats->allocated_bytes = num_used * slab->info.block_size;
+	stats->free_bytes = (slab->info.num_blocks - num_used) * slab->info.block_size;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	stats->max_allocated_bytes = slab->info.max_used *
 				     slab->info.block_size;
@@ -253,6 +253,130 @@ static inline int z_vrfy_k_msgq_put_front(struct k_msgq *msgq, const void *data)
 #include <zephyr/syscalls/k_msgq_put_front_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+/* Number of messages from @a ptr to the end of the ring buffer */
+static inline uint32_t msgs_to_end(struct k_msgq *msgq, const char *ptr)
+{
+	return (msgq->buffer_end - ptr) / msgq->msg_size;
+}
+
+/*
+ * Put as many messages as possible without waiting, giving the first ones to
+ * threads waiting to get a message. Must be called with the lock held.
+ */
+static uint32_t put_msgs_locked(struct k_msgq *msgq, const char *data,
+				uint32_t num_msgs, bool *resched)
+{
+	struct k_thread *pending_thread;
+	uint32_t count = 0;
+	uint32_t chunk;
+
+	/* readers only wait on an empty queue */
+	while (msgq->used_msgs == 0U && count < num_msgs) {
+		pending_thread = z_unpend_first_thread(&msgq->wait_q);
+		if (pending_thread == NULL) {
+			break;
+		}
+
+		(void)memcpy(pending_thread->base.swap_data, data, msgq->msg_size);
+		arch_thread_return_value_set(pending_thread, 0);
+		z_ready_thread(pending_thread);
+		*resched = true;
+
+		data += msgq->msg_size;
+		count++;
+	}
+
+	/* copy the rest in at most two runs around the end of the buffer */
+	while (msgq->used_msgs < msgq->max_msgs && count < num_msgs) {
+		__ASSERT_NO_MSG(msgq->write_ptr >= msgq->buffer_start &&
+				msgq->write_ptr < msgq->buffer_end);
+		chunk = MIN(num_msgs - count, msgq->max_msgs - msgq->used_msgs);
+		chunk = MIN(chunk, msgs_to_end(msgq, msgq->write_ptr));
+
+		(void)memcpy(msgq->write_ptr, data, chunk * msgq->msg_size);
+		msgq->write_ptr += chunk * msgq->msg_size;
+		if (msgq->write_ptr == msgq->buffer_end) {
+			msgq->write_ptr = msgq->buffer_start;
+		}
+		msgq->used_msgs += chunk;
+
+		data += chunk * msgq->msg_size;
+		count += chunk;
+	}
+
+	if (msgq->used_msgs > 0U && count > 0U) {
+		*resched |= handle_poll_events(msgq);
+	}
+
+	return count;
+}
+
+int z_impl_k_msgq_put_many(struct k_msgq *msgq, const void *data, uint32_t num_msgs,
+			   k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	k_spinlock_key_t key;
+	int result;
+	uint32_t count;
+	bool resched = false;
+
+	if (num_msgs == 0U) {
+		return 0;
+	}
+
+	key = k_spin_lock(&msgq->lock);
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put, msgq, timeout);
+
+	count = put_msgs_locked(msgq, data, num_msgs, &resched);
+	if (count > 0U) {
+		result = count;
+	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		/* don't wait for message space to become available */
+		result = -ENOMSG;
+	} else {
+		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, put, msgq, timeout);
+
+		/* wait for the first message to be put */
+		_current->base.swap_data = (void *) data;
+
+		result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+		if (result != 0) {
+			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put, msgq, timeout, result);
+			return result;
+		}
+
+		/* put the rest of the messages without waiting again */
+		key = k_spin_lock(&msgq->lock);
+		count = 1U + put_msgs_locked(msgq, (const char *)data + msgq->msg_size,
+					     num_msgs - 1U, &resched);
+		result = count;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put, msgq, timeout, result);
+
+	if (resched) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return result;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_put_many(struct k_msgq *msgq, const void *data,
+					 uint32_t num_msgs, k_timeout_t timeout)
+{
+	K_OOPS(K_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_READ(data, num_msgs, msgq->msg_size));
+
+	return z_impl_k_msgq_put_many(msgq, data, num_msgs, timeout);
+}
+#include <zephyr/syscalls/k_msgq_put_many_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
 void z_impl_k_msgq_get_attrs(struct k_msgq *msgq, struct k_msgq_attrs *attrs)
 {
 	attrs->msg_size = msgq->msg_size;
@@ -352,6 +476,124 @@ static inline int z_vrfy_k_msgq_get(struct k_msgq *msgq, void *data,
 #include <zephyr/syscalls/k_msgq_get_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+/*
+ * Get as many messages as possible without waiting, refilling the freed
+ * space from threads waiting to put a message. Must be called with the lock
+ * held.
+ */
+static uint32_t get_msgs_locked(struct k_msgq *msgq, char *data,
+				uint32_t num_msgs, bool *resched)
+{
+	struct k_thread *pending_thread;
+	uint32_t count = 0;
+	uint32_t chunk;
+
+	while (msgq->used_msgs > 0U && count < num_msgs) {
+		chunk = MIN(num_msgs - count, msgq->used_msgs);
+		chunk = MIN(chunk, msgs_to_end(msgq, msgq->read_ptr));
+
+		(void)memcpy(data, msgq->read_ptr, chunk * msgq->msg_size);
+		msgq->read_ptr += chunk * msgq->msg_size;
+		if (msgq->read_ptr == msgq->buffer_end) {
+			msgq->read_ptr = msgq->buffer_start;
+		}
+		msgq->used_msgs -= chunk;
+
+		data += chunk * msgq->msg_size;
+		count += chunk;
+
+		/* writers only wait on a full queue, queue their messages */
+		while (msgq->used_msgs < msgq->max_msgs) {
+			pending_thread = z_unpend_first_thread(&msgq->wait_q);
+			if (pending_thread == NULL) {
+				break;
+			}
+
+			__ASSERT_NO_MSG(msgq->write_ptr >= msgq->buffer_start &&
+					msgq->write_ptr < msgq->buffer_end);
+			(void)memcpy(msgq->write_ptr, (char *)pending_thread->base.swap_data,
+			       msgq->msg_size);
+			msgq->write_ptr += msgq->msg_size;
+			if (msgq->write_ptr == msgq->buffer_end) {
+				msgq->write_ptr = msgq->buffer_start;
+			}
+			msgq->used_msgs++;
+
+			arch_thread_return_value_set(pending_thread, 0);
+			z_ready_thread(pending_thread);
+			*resched = true;
+		}
+	}
+
+	return count;
+}
+
+int z_impl_k_msgq_get_many(struct k_msgq *msgq, void *data, uint32_t num_msgs,
+			   k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	k_spinlock_key_t key;
+	int result;
+	uint32_t count;
+	bool resched = false;
+
+	if (num_msgs == 0U) {
+		return 0;
+	}
+
+	key = k_spin_lock(&msgq->lock);
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, get, msgq, timeout);
+
+	count = get_msgs_locked(msgq, data, num_msgs, &resched);
+	if (count > 0U) {
+		result = count;
+	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		/* don't wait for a message to become available */
+		result = -ENOMSG;
+	} else {
+		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, get, msgq, timeout);
+
+		/* wait for the first message */
+		_current->base.swap_data = data;
+
+		result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+		if (result != 0) {
+			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get, msgq, timeout, result);
+			return result;
+		}
+
+		/* take the messages queued meanwhile without waiting again */
+		key = k_spin_lock(&msgq->lock);
+		count = 1U + get_msgs_locked(msgq, (char *)data + msgq->msg_size,
+					     num_msgs - 1U, &resched);
+		result = count;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get, msgq, timeout, result);
+
+	if (resched) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return result;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_get_many(struct k_msgq *msgq, void *data,
+					 uint32_t num_msgs, k_timeout_t timeout)
+{
+	K_OOPS(K_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_WRITE(data, num_msgs, msgq->msg_size));
+
+	return z_impl_k_msgq_get_many(msgq, data, num_msgs, timeout);
+}
+#include <zephyr/syscalls/k_msgq_get_many_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
 int z_impl_k_msgq_peek(struct k_msgq *msgq, void *data)
 {
 	k_spinlock_key_t key;
@@ -29,9 +29,20 @@ static inline bool pipe_full(struct k_pipe *pipe)
 	return ring_buf_space_get(&pipe->buf) == 0;
 }
 
+static inline bool pipe_write_claimed(struct k_pipe *pipe)
+{
+	return (pipe->flags & PIPE_FLAG_WRITE_CLAIM) != 0;
+}
+
+static inline bool pipe_read_claimed(struct k_pipe *pipe)
+{
+	return (pipe->flags & PIPE_FLAG_READ_CLAIM) != 0;
+}
+
 static inline bool pipe_empty(struct k_pipe *pipe)
 {
-	return ring_buf_is_empty(&pipe->buf);
+	/* Claimed data is still in the pipe until it is released */
+	return !pipe_read_claimed(pipe) && ring_buf_is_empty(&pipe->buf);
 }
 
 static int wait_for(_wait_q_t *waitq, struct k_pipe *pipe, k_spinlock_key_t *key,
@@ -96,6 +107,7 @@ static size_t copy_to_pending_readers(struct k_pipe *pipe, bool *need_resched,
 	struct k_thread *reader = NULL;
 	struct pipe_buf_spec *reader_buf;
 	size_t copy_size, written = 0;
+	bool claim_waiter = false;
 
 	/*
 	 * Attempt a direct data copy to waiting readers if any.
@@ -113,6 +125,18 @@ static size_t copy_to_pending_readers(struct k_pipe *pipe, bool *need_resched,
 			}
 
 			reader_buf = reader->base.swap_data;
+			if (reader_buf->len == 0) {
+				/*
+				 * This reader waits to claim data from the
+				 * ring buffer: wake it up and leave the rest
+				 * of the data to the ring buffer.
+				 */
+				claim_waiter = true;
+				unpend_thread_no_timeout(reader);
+				z_abort_thread_timeout(reader);
+				K_SPINLOCK_BREAK;
+			}
+
 			copy_size = min(len - written,
 					reader_buf->len - reader_buf->used);
 			memcpy(&reader_buf->data[reader_buf->used],
@@ -139,7 +163,7 @@ static size_t copy_to_pending_readers(struct k_pipe *pipe, bool *need_resched,
 			z_ready_thread(reader);
 			*need_resched = true;
 		}
-	} while (reader != NULL && written < len);
+	} while (reader != NULL && written < len && !claim_waiter);
 
 	return written;
 }
@@ -193,10 +217,13 @@ int z_impl_k_pipe_write(struct k_pipe *pipe, const uint8_t *data, size_t len, k_
 							 K_POLL_STATE_PIPE_DATA_AVAILABLE);
 #endif /* CONFIG_POLL */
 
-		written += ring_buf_put(&pipe->buf, &data[written], len - written);
-		if (likely(written == len)) {
-			rc = written;
-			break;
+		/* The ring buffer is not written to behind the back of a claim */
+		if (likely(!pipe_write_claimed(pipe))) {
+			written += ring_buf_put(&pipe->buf, &data[written], len - written);
+			if (likely(written == len)) {
+				rc = written;
+				break;
+			}
 		}
 
 		rc = wait_for(&pipe->space, pipe, &key, end, &need_resched);
@@ -238,10 +265,12 @@ int z_impl_k_pipe_read(struct k_pipe *pipe, uint8_t *data, size_t len, k_timeout
 			need_resched = z_sched_wake_all(&pipe->space, 0, NULL);
 		}
 
-		buf.used += ring_buf_get(&pipe->buf, &data[buf.used], len - buf.used);
-		if (likely(buf.used == len)) {
-			rc = buf.used;
-			break;
+		if (likely(!pipe_read_claimed(pipe))) {
+			buf.used += ring_buf_get(&pipe->buf, &data[buf.used], len - buf.used);
+			if (likely(buf.used == len)) {
+				rc = buf.used;
+				break;
+			}
 		}
 
 		if (unlikely(pipe_closed(pipe))) {
@@ -270,11 +299,185 @@ exit:
 	return rc;
 }
 
+static void pipe_unlock(struct k_pipe *pipe, k_spinlock_key_t key, bool need_resched)
+{
+	if (need_resched) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+}
+
+int k_pipe_write_claim(struct k_pipe *pipe, uint8_t **data, size_t len, k_timeout_t timeout)
+{
+	int rc;
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	k_spinlock_key_t key;
+	bool need_resched = false;
+
+	if (len == 0 || ring_buf_capacity_get(&pipe->buf) == 0) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&pipe->lock);
+
+	if (unlikely(pipe_resetting(pipe))) {
+		rc = -ECANCELED;
+		goto exit;
+	}
+
+	for (;;) {
+		if (unlikely(pipe_closed(pipe))) {
+			rc = -EPIPE;
+			break;
+		}
+
+		/* Only one region can be claimed for writing at a time */
+		if (likely(!pipe_write_claimed(pipe))) {
+			rc = ring_buf_put_claim(&pipe->buf, data,
+						MIN(len, ring_buf_capacity_get(&pipe->buf)));
+			if (likely(rc != 0)) {
+				pipe->flags |= PIPE_FLAG_WRITE_CLAIM;
+				break;
+			}
+		}
+
+		rc = wait_for(&pipe->space, pipe, &key, end, &need_resched);
+		if (rc != 0) {
+			break;
+		}
+	}
+exit:
+	pipe_unlock(pipe, key, need_resched);
+	return rc;
+}
+
+int k_pipe_write_commit(struct k_pipe *pipe, size_t len)
+{
+	int rc;
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+	bool need_resched = false;
+
+	if (unlikely(!pipe_write_claimed(pipe))) {
+		/* Discarded by k_pipe_reset() or k_pipe_close() */
+		rc = pipe_closed(pipe) ? -EPIPE : -EINVAL;
+		goto exit;
+	}
+
+	if (ring_buf_put_finish(&pipe->buf, len) != 0) {
+		rc = -EINVAL;
+		goto exit;
+	}
+
+	pipe->flags &= ~PIPE_FLAG_WRITE_CLAIM;
+	rc = len;
+
+	if (len != 0) {
+		/* Readers waiting for data, including those waiting to claim it */
+		need_resched = z_sched_wake_all(&pipe->data, 0, NULL);
+#ifdef CONFIG_POLL
+		need_resched |= z_handle_obj_poll_events(&pipe->poll_events,
+							 K_POLL_STATE_PIPE_DATA_AVAILABLE);
+#endif /* CONFIG_POLL */
+	}
+
+	if (!pipe_full(pipe)) {
+		/* Writers waiting for the claim to be released */
+		need_resched |= z_sched_wake_all(&pipe->space, 0, NULL);
+	}
+exit:
+	pipe_unlock(pipe, key, need_resched);
+	return rc;
+}
+
+int k_pipe_read_claim(struct k_pipe *pipe, uint8_t **data, size_t len, k_timeout_t timeout)
+{
+	/* An empty spec makes writers leave the data to the ring buffer */
+	struct pipe_buf_spec buf = { NULL, 0, 0 };
+	int rc;
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	k_spinlock_key_t key;
+	bool need_resched = false;
+
+	if (len == 0 || ring_buf_capacity_get(&pipe->buf) == 0) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&pipe->lock);
+
+	if (unlikely(pipe_resetting(pipe))) {
+		rc = -ECANCELED;
+		goto exit;
+	}
+
+	for (;;) {
+		/* Only one region can be claimed for reading at a time */
+		if (likely(!pipe_read_claimed(pipe))) {
+			rc = ring_buf_get_claim(&pipe->buf, data,
+						MIN(len, ring_buf_capacity_get(&pipe->buf)));
+			if (likely(rc != 0)) {
+				pipe->flags |= PIPE_FLAG_READ_CLAIM;
+				break;
+			}
+		}
+
+		if (unlikely(pipe_closed(pipe))) {
+			rc = -EPIPE;
+			break;
+		}
+
+		_current->base.swap_data = &buf;
+
+		rc = wait_for(&pipe->data, pipe, &key, end, &need_resched);
+		if (rc != 0) {
+			break;
+		}
+	}
+exit:
+	pipe_unlock(pipe, key, need_resched);
+	return rc;
+}
+
+int k_pipe_read_release(struct k_pipe *pipe, size_t len)
+{
+	int rc;
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+	bool need_resched = false;
+
+	if (unlikely(!pipe_read_claimed(pipe))) {
+		/* Discarded by k_pipe_reset() */
+		rc = -EINVAL;
+		goto exit;
+	}
+
+	if (ring_buf_get_finish(&pipe->buf, len) != 0) {
+		rc = -EINVAL;
+		goto exit;
+	}
+
+	pipe->flags &= ~PIPE_FLAG_READ_CLAIM;
+	rc = len;
+
+	if (len != 0) {
+		need_resched = z_sched_wake_all(&pipe->space, 0, NULL);
+	}
+
+	if (!pipe_empty(pipe)) {
+		/* Readers waiting for the claim to be released */
+		need_resched |= z_sched_wake_all(&pipe->data, 0, NULL);
+	}
+exit:
+	pipe_unlock(pipe, key, need_resched);
+	return rc;
+}
+
 void z_impl_k_pipe_reset(struct k_pipe *pipe)
 {
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_pipe, reset, pipe);
 	K_SPINLOCK(&pipe->lock) {
 		ring_buf_reset(&pipe->buf);
+		/* Outstanding claims refer to discarded data */
+		pipe->flags &= ~(PIPE_FLAG_WRITE_CLAIM | PIPE_FLAG_READ_CLAIM);
 		if (likely(pipe->waiting != 0)) {
 			pipe->flags |= PIPE_FLAG_RESET;
 			z_sched_wake_all(&pipe->data, 0, NULL);
@@ -288,7 +491,12 @@ void z_impl_k_pipe_close(struct k_pipe *pipe)
 {
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_pipe, close, pipe);
 	K_SPINLOCK(&pipe->lock) {
-		pipe->flags = 0;
+		if (pipe_write_claimed(pipe)) {
+			/* Nothing can be read from the claimed region anymore */
+			(void)ring_buf_put_finish(&pipe->buf, 0);
+		}
+		/* The remaining data can still be read, including a claimed region */
+		pipe->flags &= PIPE_FLAG_READ_CLAIM;
 		z_sched_wake_all(&pipe->data, 0, NULL);
 		z_sched_wake_all(&pipe->space, 0, NULL);
 	}
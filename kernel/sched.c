@@ -15,6 +15,7 @@
 #include <zephyr/internal/syscall_handler.h>
 #include <zephyr/drivers/timer/system_timer.h>
 #include <stdbool.h>
+#include <limits.h>
 #include <kernel_internal.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/sys/atomic.h>
@@ -48,9 +49,91 @@ BUILD_ASSERT(CONFIG_NUM_COOP_PRIORITIES >= CONFIG_NUM_METAIRQ_PRIORITIES,
 #ifdef IAR_SUPPRESS_ALWAYS_INLINE_WARNING_FLAG
 TOOLCHAIN_DISABLE_WARNING(TOOLCHAIN_WARNING_ALWAYS_INLINE)
 #endif
+#ifdef CONFIG_SCHED_CPU_RUNQ
+static ALWAYS_INLINE bool runq_cpu_allowed(struct k_thread *thread, unsigned int cpu)
+{
+#ifdef CONFIG_SCHED_CPU_MASK
+	return (thread->base.cpu_mask & BIT(cpu)) != 0;
+#else
+	ARG_UNUSED(thread);
+	ARG_UNUSED(cpu);
+	return true;
+#endif /* CONFIG_SCHED_CPU_MASK */
+}
+
+/* Picks the CPU whose ready queue a newly runnable thread goes to: an
+ * idle CPU, else the CPU running the lowest priority thread if the new
+ * thread would preempt it, else the CPU the thread last ran on to keep
+ * its caches warm.  The CPU the thread last ran on wins ties.
+ */
+static unsigned int runq_select_cpu(struct k_thread *thread)
+{
+	unsigned int num_cpus = arch_num_cpus();
+	unsigned int last = thread->base.cpu;
+	unsigned int best = num_cpus;
+	struct k_thread *best_current = NULL;
+
+	if ((thread == _current) || !runq_cpu_allowed(thread, last)) {
+		last = _current_cpu->id;
+	}
+
+	for (unsigned int n = 0; n < num_cpus; n++) {
+		/* Start the scan at the preferred CPU so it wins ties */
+		unsigned int i = (last + n) % num_cpus;
+		struct k_thread *cpu_current = _kernel.cpus[i].current;
+
+		if (!runq_cpu_allowed(thread, i) || (cpu_current == NULL)) {
+			continue;
+		}
+
+		if (z_is_idle_thread_object(cpu_current)) {
+			return i;
+		}
+
+		if (thread_is_preemptible(cpu_current) &&
+		    (z_sched_prio_cmp(thread, cpu_current) > 0) &&
+		    ((best_current == NULL) || (z_sched_prio_cmp(best_current, cpu_current) > 0))) {
+			best = i;
+			best_current = cpu_current;
+		}
+	}
+
+	if (best < num_cpus) {
+		return best;
+	}
+
+	if (runq_cpu_allowed(thread, last)) {
+		return last;
+	}
+
+	/* Edge case: it's legal per the API to "make runnable" a
+	 * thread with all CPUs masked off, park it on CPU 0.
+	 */
+#ifdef CONFIG_SCHED_CPU_MASK
+	return (thread->base.cpu_mask == 0) ? 0 : u32_count_trailing_zeros(thread->base.cpu_mask);
+#else
+	return 0;
+#endif /* CONFIG_SCHED_CPU_MASK */
+}
+
+static ALWAYS_INLINE struct _ready_q *thread_ready_q(struct k_thread *thread)
+{
+	return &_kernel.cpus[thread->base.runq_cpu].ready_q;
+}
+
+static ALWAYS_INLINE void runq_update_head(struct _ready_q *ready_q)
+{
+	struct k_thread *head = _priq_run_head(&ready_q->runq);
+
+	ready_q->head_prio = (head != NULL) ? head->base.prio : INT_MAX;
+}
+#endif /* CONFIG_SCHED_CPU_RUNQ */
+
 static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	return &thread_ready_q(thread)->runq;
+#elif defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY)
 	int cpu, m = thread->base.cpu_mask;
 
 	/* Edge case: it's legal per the API to "make runnable" a
@@ -65,16 +148,16 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 #else
 	ARG_UNUSED(thread);
 	return &_kernel.ready_q.runq;
-#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY */
+#endif /* CONFIG_SCHED_CPU_RUNQ */
 }
 
 static ALWAYS_INLINE void *curr_cpu_runq(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || defined(CONFIG_SCHED_CPU_RUNQ)
 	return &arch_curr_cpu()->ready_q.runq;
 #else
 	return &_kernel.ready_q.runq;
-#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY */
+#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY || CONFIG_SCHED_CPU_RUNQ */
 }
 
 static ALWAYS_INLINE void runq_add(struct k_thread *thread)
@@ -82,7 +165,16 @@ static ALWAYS_INLINE void runq_add(struct k_thread *thread)
 	__ASSERT_NO_MSG(!z_is_idle_thread_object(thread));
 	__ASSERT_NO_MSG(!is_thread_dummy(thread));
 
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	thread->base.runq_cpu = runq_select_cpu(thread);
+	thread_ready_q(thread)->count++;
+#endif /* CONFIG_SCHED_CPU_RUNQ */
+
 	_priq_run_add(thread_runq(thread), thread);
+
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	runq_update_head(thread_ready_q(thread));
+#endif /* CONFIG_SCHED_CPU_RUNQ */
 }
 
 static ALWAYS_INLINE void runq_remove(struct k_thread *thread)
@@ -90,7 +182,15 @@ static ALWAYS_INLINE void runq_remove(struct k_thread *thread)
 	__ASSERT_NO_MSG(!z_is_idle_thread_object(thread));
 	__ASSERT_NO_MSG(!is_thread_dummy(thread));
 
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	thread_ready_q(thread)->count--;
+#endif /* CONFIG_SCHED_CPU_RUNQ */
+
 	_priq_run_remove(thread_runq(thread), thread);
+
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	runq_update_head(thread_ready_q(thread));
+#endif /* CONFIG_SCHED_CPU_RUNQ */
 }
 
 static ALWAYS_INLINE void runq_yield(void)
@@ -98,9 +198,70 @@ static ALWAYS_INLINE void runq_yield(void)
 	_priq_run_yield(curr_cpu_runq());
 }
 
+#ifdef CONFIG_SCHED_CPU_RUNQ
+/* Returns the thread that should run here rather than @a local (the
+ * best thread of the local queue, or NULL): the highest priority
+ * thread of another queue if it outranks @a local, when the local
+ * queue is empty the best thread of the busiest queue of the highest
+ * priority.  Another queue is only walked if the cached priority of
+ * its head may beat the best thread found so far, so the common case
+ * reads one word per CPU.  The _priq_run_best() calls honor the CPU
+ * mask of the current CPU.
+ */
+static struct k_thread *runq_pull(struct k_thread *local)
+{
+	unsigned int num_cpus = arch_num_cpus();
+	unsigned int self = _current_cpu->id;
+	struct k_thread *best = local;
+	unsigned int best_count = 0;
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		struct _ready_q *rq = &_kernel.cpus[i].ready_q;
+		int head_prio = rq->head_prio;
+		struct k_thread *thread;
+		int32_t cmp;
+
+		if ((i == self) || (head_prio == INT_MAX)) {
+			continue;
+		}
+
+		if (best != NULL) {
+			if (head_prio > best->base.prio) {
+				continue;
+			}
+
+			/* The local thread wins priority ties, unless
+			 * deadlines may order them
+			 */
+			if (!IS_ENABLED(CONFIG_SCHED_DEADLINE) && (best == local) &&
+			    (head_prio == best->base.prio)) {
+				continue;
+			}
+		}
+
+		thread = _priq_run_best(&rq->runq);
+		if (thread == NULL) {
+			continue;
+		}
+
+		cmp = (best == NULL) ? 1 : z_sched_prio_cmp(thread, best);
+		if ((cmp > 0) || ((cmp == 0) && (best != local) && (rq->count > best_count))) {
+			best = thread;
+			best_count = rq->count;
+		}
+	}
+
+	return best;
+}
+#endif /* CONFIG_SCHED_CPU_RUNQ */
+
 static ALWAYS_INLINE struct k_thread *runq_best(void)
 {
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	return runq_pull(_priq_run_best(curr_cpu_runq()));
+#else
 	return _priq_run_best(curr_cpu_runq());
+#endif /* CONFIG_SCHED_CPU_RUNQ */
 }
 
 /* _current is never in the run queue until context switch on
@@ -146,6 +307,10 @@ void z_requeue_current(struct k_thread *thread)
 {
 	if (z_is_thread_queued(thread)) {
 		runq_add(thread);
+#ifdef CONFIG_SCHED_CPU_RUNQ
+		/* It may have been placed on another CPU's queue */
+		flag_ipi(ipi_mask_create(thread));
+#endif /* CONFIG_SCHED_CPU_RUNQ */
 	}
 	signal_pending_ipi();
 }
@@ -1003,17 +1168,21 @@ int z_unpend_all(_wait_q_t *wait_q)
 void init_ready_q(struct _ready_q *ready_q)
 {
 	_priq_run_init(&ready_q->runq);
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	ready_q->count = 0;
+	ready_q->head_prio = INT_MAX;
+#endif /* CONFIG_SCHED_CPU_RUNQ */
 }
 
 void z_sched_init(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || defined(CONFIG_SCHED_CPU_RUNQ)
 	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
 		init_ready_q(&_kernel.cpus[i].ready_q);
 	}
 #else
 	init_ready_q(&_kernel.ready_q);
-#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY */
+#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY || CONFIG_SCHED_CPU_RUNQ */
 }
 
 void z_impl_k_thread_priority_set(k_tid_t thread, int prio)
@@ -11,12 +11,11 @@
 #include <zephyr/internal/syscall_handler.h>
 #include <zephyr/drivers/timer/system_timer.h>
 #include <zephyr/sys_clock.h>
+#include <zephyr/sys/math_extras.h>
 #include <zephyr/llext/symbol.h>
 
 static uint64_t curr_tick;
 
-static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
-
 /*
  * The timeout code shall take no locks other than its own (timeout_lock), nor
  * shall it call any other subsystem while holding this lock.
@@ -38,6 +37,321 @@ static inline unsigned int z_vrfy_sys_clock_hw_cycles_per_sec_runtime_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
+static int32_t elapsed(void)
+{
+	/* While sys_clock_announce() is executing, new relative timeouts will be
+	 * scheduled relatively to the currently firing timeout's original tick
+	 * value (=curr_tick) rather than relative to the current
+	 * sys_clock_elapsed().
+	 *
+	 * This means that timeouts being scheduled from within timeout callbacks
+	 * will be scheduled at well-defined offsets from the currently firing
+	 * timeout.
+	 *
+	 * As a side effect, the same will happen if an ISR with higher priority
+	 * preempts a timeout callback and schedules a timeout.
+	 *
+	 * The distinction is implemented by looking at announce_remaining which
+	 * will be non-zero while sys_clock_announce() is executing and zero
+	 * otherwise.
+	 */
+	return announce_remaining == 0 ? sys_clock_elapsed() : 0U;
+}
+
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+/*
+ * Hierarchical timing wheel.  While queued, a timeout's dticks field
+ * holds its absolute expiry tick.  A timeout is stored on the level
+ * of the most significant WHEEL_BITS wide bit group in which its
+ * expiry differs from curr_tick, in the slot indexed by that group.
+ * When curr_tick reaches the first tick covered by a slot above
+ * level 0, the slot is "cascaded": its timeouts are reinserted and
+ * land on lower levels.  Everything in a level 0 slot expires on the
+ * same tick.  Timeouts beyond the reach of the top level wait on an
+ * overflow list that is rescanned whenever the top level wraps.
+ *
+ * Slot lists are initialized lazily, a slot whose bit is clear in
+ * wheel_map[] is empty whatever its list head contains.
+ */
+#define WHEEL_BITS   6
+#define WHEEL_SLOTS  BIT(WHEEL_BITS)
+#define WHEEL_MASK   (WHEEL_SLOTS - 1U)
+#define WHEEL_LEVELS CONFIG_TIMEOUT_WHEEL_LEVELS
+
+static sys_dlist_t wheel[WHEEL_LEVELS][WHEEL_SLOTS];
+static uint64_t wheel_map[WHEEL_LEVELS];
+static sys_dlist_t wheel_overflow = SYS_DLIST_STATIC_INIT(&wheel_overflow);
+
+static inline uint64_t expiry(const struct _timeout *t)
+{
+	return (uint64_t)t->dticks;
+}
+
+static unsigned int wheel_level(uint64_t exp)
+{
+	uint64_t diff = exp ^ curr_tick;
+
+	if (diff == 0U) {
+		return 0U;
+	}
+
+	return (63U - u64_count_leading_zeros(diff)) / WHEEL_BITS;
+}
+
+static inline unsigned int wheel_slot(uint64_t tick, unsigned int level)
+{
+	return (tick >> (level * WHEEL_BITS)) & WHEEL_MASK;
+}
+
+/* First tick covered by the slot holding @a exp on @a level */
+static inline uint64_t wheel_slot_start(uint64_t exp, unsigned int level)
+{
+	return exp & ~(BIT64(level * WHEEL_BITS) - 1U);
+}
+
+static sys_dlist_t *wheel_list(uint64_t exp, unsigned int level)
+{
+	if (level >= WHEEL_LEVELS) {
+		return &wheel_overflow;
+	}
+
+	return &wheel[level][wheel_slot(exp, level)];
+}
+
+static void wheel_insert(struct _timeout *t)
+{
+	uint64_t exp = expiry(t);
+	unsigned int level = wheel_level(exp);
+	unsigned int slot = wheel_slot(exp, level);
+
+	if ((level < WHEEL_LEVELS) && ((wheel_map[level] & BIT64(slot)) == 0U)) {
+		sys_dlist_init(&wheel[level][slot]);
+		wheel_map[level] |= BIT64(slot);
+	}
+
+	sys_dlist_append(wheel_list(exp, level), &t->node);
+}
+
+static void remove_timeout(struct _timeout *t)
+{
+	uint64_t exp = expiry(t);
+	unsigned int level = wheel_level(exp);
+
+	sys_dlist_remove(&t->node);
+
+	if ((level < WHEEL_LEVELS) && sys_dlist_is_empty(wheel_list(exp, level))) {
+		wheel_map[level] &= ~BIT64(wheel_slot(exp, level));
+	}
+}
+
+/* Tick at which the overflow list is rescanned, when the top level wraps.
+ * It comes after every event of the levels.
+ */
+static inline uint64_t wheel_overflow_event(void)
+{
+	return wheel_slot_start(curr_tick, WHEEL_LEVELS) + BIT64(WHEEL_LEVELS * WHEEL_BITS);
+}
+
+/* Next tick after curr_tick at which the wheel has work to do, either
+ * expiring timeouts or cascading a slot.  Any event on a level comes
+ * before every event on the levels above it, so the first non-empty
+ * level wins.
+ */
+static bool wheel_next_event(uint64_t *ev)
+{
+	for (unsigned int level = 0; level < WHEEL_LEVELS; level++) {
+		unsigned int shift = level * WHEEL_BITS;
+		unsigned int cur = wheel_slot(curr_tick, level);
+		uint64_t pending;
+
+		if (cur == WHEEL_MASK) {
+			continue;
+		}
+
+		pending = wheel_map[level] & ~(BIT64(cur + 1U) - 1U);
+		if (pending != 0U) {
+			*ev = wheel_slot_start(curr_tick, level + 1U) |
+			      ((uint64_t)u64_count_trailing_zeros(pending) << shift);
+			return true;
+		}
+	}
+
+	if (!sys_dlist_is_empty(&wheel_overflow)) {
+		*ev = wheel_overflow_event();
+		return true;
+	}
+
+	return false;
+}
+
+static void wheel_move(sys_dlist_t *dst, sys_dlist_t *src)
+{
+	sys_dnode_t *node;
+
+	while ((node = sys_dlist_get(src)) != NULL) {
+		sys_dlist_append(dst, node);
+	}
+}
+
+static void wheel_reinsert(sys_dlist_t *list)
+{
+	sys_dnode_t *node;
+
+	while ((node = sys_dlist_get(list)) != NULL) {
+		wheel_insert(CONTAINER_OF(node, struct _timeout, node));
+	}
+}
+
+/* Redistributes every slot starting at curr_tick, top level first */
+static void wheel_cascade(void)
+{
+	if ((wheel_slot_start(curr_tick, WHEEL_LEVELS) == curr_tick) &&
+	    !sys_dlist_is_empty(&wheel_overflow)) {
+		sys_dlist_t pending;
+
+		sys_dlist_init(&pending);
+		wheel_move(&pending, &wheel_overflow);
+		wheel_reinsert(&pending);
+	}
+
+	for (unsigned int level = WHEEL_LEVELS - 1U; level > 0U; level--) {
+		unsigned int slot = wheel_slot(curr_tick, level);
+
+		if ((wheel_slot_start(curr_tick, level) != curr_tick) ||
+		    ((wheel_map[level] & BIT64(slot)) == 0U)) {
+			continue;
+		}
+
+		wheel_map[level] &= ~BIT64(slot);
+		wheel_reinsert(&wheel[level][slot]);
+	}
+}
+
+/* True if @a to alone determines the next timer event */
+static bool is_next_event(const struct _timeout *to)
+{
+	uint64_t exp = expiry(to);
+	unsigned int level = wheel_level(exp);
+	uint64_t ev;
+
+	if (sys_dlist_has_multiple_nodes(wheel_list(exp, level))) {
+		return false;
+	}
+
+	if (level >= WHEEL_LEVELS) {
+		/* The rescan of the overflow list is the next event when
+		 * the levels are empty
+		 */
+		return wheel_next_event(&ev) && (ev == wheel_overflow_event());
+	}
+
+	return wheel_next_event(&ev) && (ev == wheel_slot_start(exp, level));
+}
+
+/* must be locked, to->dticks is relative to curr_tick */
+static bool insert_timeout(struct _timeout *to)
+{
+	to->dticks += curr_tick;
+	wheel_insert(to);
+
+	return is_next_event(to);
+}
+
+/* must be locked
+ *
+ * Returns the next timeout expiring within announce_remaining ticks,
+ * advancing curr_tick to its expiry.  The ticks curr_tick moved are
+ * stored in @a dt, even when no timeout is found but slots were
+ * cascaded on the way.
+ */
+static struct _timeout *next_expired(int32_t *dt)
+{
+	struct _timeout *t;
+	uint64_t ev;
+
+	*dt = 0;
+	for (;;) {
+		if ((wheel_map[0] & BIT64(wheel_slot(curr_tick, 0))) != 0U) {
+			t = CONTAINER_OF(sys_dlist_peek_head(wheel_list(curr_tick, 0)),
+					 struct _timeout, node);
+			remove_timeout(t);
+			t->dticks = 0;
+			return t;
+		}
+
+		if (!wheel_next_event(&ev) ||
+		    ((int64_t)(ev - curr_tick) > (int64_t)(announce_remaining - *dt))) {
+			return NULL;
+		}
+
+		*dt += (int32_t)(ev - curr_tick);
+		curr_tick = ev;
+		wheel_cascade();
+	}
+}
+
+/* must be locked, called as curr_tick moves forward by @a ticks
+ * without any event
+ */
+static void advance_timeouts(int32_t ticks)
+{
+	ARG_UNUSED(ticks);
+}
+
+static int32_t next_timeout(int32_t ticks_elapsed)
+{
+	uint64_t ev;
+	int64_t dt;
+
+	if (!wheel_next_event(&ev)) {
+		return SYS_CLOCK_MAX_WAIT;
+	}
+
+	dt = (int64_t)(ev - curr_tick) - ticks_elapsed;
+
+	return (dt > (int64_t)INT_MAX) ? SYS_CLOCK_MAX_WAIT : (int32_t)MAX(0, dt);
+}
+
+/* must be locked */
+static k_ticks_t timeout_rem(const struct _timeout *timeout)
+{
+	return expiry(timeout) - curr_tick;
+}
+
+#ifdef CONFIG_ZTEST
+/* must be locked, moves curr_tick keeping every timeout's remaining delay */
+static void rebase_timeouts(uint64_t tick)
+{
+	sys_dlist_t pending;
+	sys_dnode_t *node;
+
+	sys_dlist_init(&pending);
+	for (unsigned int level = 0; level < WHEEL_LEVELS; level++) {
+		for (unsigned int slot = 0; slot < WHEEL_SLOTS; slot++) {
+			if ((wheel_map[level] & BIT64(slot)) != 0U) {
+				wheel_move(&pending, &wheel[level][slot]);
+			}
+		}
+		wheel_map[level] = 0U;
+	}
+	wheel_move(&pending, &wheel_overflow);
+
+	SYS_DLIST_FOR_EACH_NODE(&pending, node) {
+		struct _timeout *t = CONTAINER_OF(node, struct _timeout, node);
+
+		t->dticks = (int64_t)(expiry(t) - curr_tick + tick);
+	}
+
+	curr_tick = tick;
+	wheel_reinsert(&pending);
+}
+#endif /* CONFIG_ZTEST */
+
+#else /* CONFIG_TIMEOUT_QUEUE_DLIST */
+
+/* Sorted delta list, dticks of each timeout is relative to its predecessor */
+static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
+
 static struct _timeout *first(void)
 {
 	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
@@ -61,25 +375,60 @@ static void remove_timeout(struct _timeout *t)
 	sys_dlist_remove(&t->node);
 }
 
-static int32_t elapsed(void)
+/* must be locked, to->dticks is relative to curr_tick */
+static bool insert_timeout(struct _timeout *to)
 {
-	/* While sys_clock_announce() is executing, new relative timeouts will be
-	 * scheduled relatively to the currently firing timeout's original tick
-	 * value (=curr_tick) rather than relative to the current
-	 * sys_clock_elapsed().
-	 *
-	 * This means that timeouts being scheduled from within timeout callbacks
-	 * will be scheduled at well-defined offsets from the currently firing
-	 * timeout.
-	 *
-	 * As a side effect, the same will happen if an ISR with higher priority
-	 * preempts a timeout callback and schedules a timeout.
-	 *
-	 * The distinction is implemented by looking at announce_remaining which
-	 * will be non-zero while sys_clock_announce() is executing and zero
-	 * otherwise.
-	 */
-	return announce_remaining == 0 ? sys_clock_elapsed() : 0U;
+	struct _timeout *t;
+
+	for (t = first(); t != NULL; t = next(t)) {
+		if (t->dticks > to->dticks) {
+			t->dticks -= to->dticks;
+			sys_dlist_insert(&t->node, &to->node);
+			break;
+		}
+		to->dticks -= t->dticks;
+	}
+
+	if (t == NULL) {
+		sys_dlist_append(&timeout_list, &to->node);
+	}
+
+	return to == first();
+}
+
+static bool is_next_event(const struct _timeout *to)
+{
+	return to == first();
+}
+
+/* must be locked */
+static struct _timeout *next_expired(int32_t *dt)
+{
+	struct _timeout *t = first();
+
+	if ((t == NULL) || (t->dticks > announce_remaining)) {
+		*dt = 0;
+		return NULL;
+	}
+
+	*dt = t->dticks;
+	curr_tick += *dt;
+	t->dticks = 0;
+	remove_timeout(t);
+
+	return t;
+}
+
+/* must be locked, called as curr_tick moves forward by @a ticks
+ * without any event
+ */
+static void advance_timeouts(int32_t ticks)
+{
+	struct _timeout *t = first();
+
+	if (t != NULL) {
+		t->dticks -= ticks;
+	}
 }
 
 static int32_t next_timeout(int32_t ticks_elapsed)
@@ -97,6 +446,30 @@ static int32_t next_timeout(int32_t ticks_elapsed)
 	return ret;
 }
 
+/* must be locked */
+static k_ticks_t timeout_rem(const struct _timeout *timeout)
+{
+	k_ticks_t ticks = 0;
+
+	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
+		ticks += t->dticks;
+		if (timeout == t) {
+			break;
+		}
+	}
+
+	return ticks;
+}
+
+#ifdef CONFIG_ZTEST
+static void rebase_timeouts(uint64_t tick)
+{
+	curr_tick = tick;
+}
+#endif /* CONFIG_ZTEST */
+
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
+
 k_ticks_t z_add_timeout(struct _timeout *to, _timeout_func_t fn, k_timeout_t timeout)
 {
 	k_ticks_t ticks = 0;
@@ -113,7 +486,6 @@ k_ticks_t z_add_timeout(struct _timeout *to, _timeout_func_t fn, k_timeout_t tim
 	to->fn = fn;
 
 	K_SPINLOCK(&timeout_lock) {
-		struct _timeout *t;
 		int32_t ticks_elapsed;
 		bool has_elapsed = false;
 
@@ -129,20 +501,7 @@ k_ticks_t z_add_timeout(struct _timeout *to, _timeout_func_t fn, k_timeout_t tim
 			ticks = timeout.ticks;
 		}
 
-		for (t = first(); t != NULL; t = next(t)) {
-			if (t->dticks > to->dticks) {
-				t->dticks -= to->dticks;
-				sys_dlist_insert(&t->node, &to->node);
-				break;
-			}
-			to->dticks -= t->dticks;
-		}
-
-		if (t == NULL) {
-			sys_dlist_append(&timeout_list, &to->node);
-		}
-
-		if (to == first() && announce_remaining == 0) {
+		if (insert_timeout(to) && announce_remaining == 0) {
 			if (!has_elapsed) {
 				/* In case of absolute timeout that is first to expire
 				 * elapsed need to be read from the system clock.
@@ -162,7 +521,7 @@ int z_abort_timeout(struct _timeout *to)
 
 	K_SPINLOCK(&timeout_lock) {
 		if (sys_dnode_is_linked(&to->node)) {
-			bool is_first = (to == first());
+			bool is_first = is_next_event(to);
 
 			remove_timeout(to);
 			to->dticks = TIMEOUT_DTICKS_ABORTED;
@@ -176,21 +535,6 @@ int z_abort_timeout(struct _timeout *to)
 	return ret;
 }
 
-/* must be locked */
-static k_ticks_t timeout_rem(const struct _timeout *timeout)
-{
-	k_ticks_t ticks = 0;
-
-	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
-		ticks += t->dticks;
-		if (timeout == t) {
-			break;
-		}
-	}
-
-	return ticks;
-}
-
 k_ticks_t z_timeout_remaining(const struct _timeout *timeout)
 {
 	k_ticks_t ticks = 0;
@@ -249,26 +593,17 @@ void sys_clock_announce(int32_t ticks)
 	announce_remaining = ticks;
 
 	struct _timeout *t;
+	int32_t dt;
 
-	for (t = first();
-	     (t != NULL) && (t->dticks <= announce_remaining);
-	     t = first()) {
-		int dt = t->dticks;
-
-		curr_tick += dt;
-		t->dticks = 0;
-		remove_timeout(t);
-
+	while ((t = next_expired(&dt)) != NULL) {
 		k_spin_unlock(&timeout_lock, key);
 		t->fn(t);
 		key = k_spin_lock(&timeout_lock);
 		announce_remaining -= dt;
 	}
+	announce_remaining -= dt;
 
-	if (t != NULL) {
-		t->dticks -= announce_remaining;
-	}
-
+	advance_timeouts(announce_remaining);
 	curr_tick += announce_remaining;
 	announce_remaining = 0;
 
@@ -353,7 +688,9 @@ k_timeout_t sys_timepoint_timeout(k_timepoint_t timepoint)
 #ifdef CONFIG_ZTEST
 void z_impl_sys_clock_tick_set(uint64_t tick)
 {
-	curr_tick = tick;
+	K_SPINLOCK(&timeout_lock) {
+		rebase_timeouts(tick);
+	}
 }
 
 void z_vrfy_sys_clock_tick_set(uint64_t tick)
@@ -0,0 +1,210 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/sys/sys_heap_mag.h>
+#include <zephyr/sys/math_extras.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/kernel.h>
+#include "heap.h"
+
+#define MIN_CLASS_SHIFT 4
+
+BUILD_ASSERT(BIT(MIN_CLASS_SHIFT) == SYS_HEAP_MAG_MIN_BYTES);
+
+/* Class of the smallest size class that fits @a bytes */
+static int alloc_class(size_t bytes)
+{
+	if (bytes <= SYS_HEAP_MAG_MIN_BYTES) {
+		return 0;
+	}
+	if (bytes > SYS_HEAP_MAG_MAX_BYTES) {
+		return -1;
+	}
+
+	return (32 - u32_count_leading_zeros((uint32_t)bytes - 1U)) - MIN_CLASS_SHIFT;
+}
+
+/* Class of the largest size class that a block of @a usable bytes
+ * can serve, blocks much larger than the biggest class are not cached
+ * so as not to waste memory.
+ */
+static int free_class(size_t usable)
+{
+	if ((usable < SYS_HEAP_MAG_MIN_BYTES) || (usable >= 2 * SYS_HEAP_MAG_MAX_BYTES)) {
+		return -1;
+	}
+
+	return (31 - u32_count_leading_zeros((uint32_t)usable)) - MIN_CLASS_SHIFT;
+}
+
+/* Heap bytes of the chunk holding @a mem, as accounted in runtime stats */
+static size_t block_bytes(struct sys_heap *heap, void *mem)
+{
+	struct z_heap *h = heap->heap;
+	chunkid_t c = ((uint8_t *)mem - chunk_header_bytes(h) - (uint8_t *)chunk_buf(h)) /
+		      CHUNK_UNIT;
+
+	return chunksz_to_bytes(h, chunk_size(h, c));
+}
+
+/* The magazine of the current CPU is locked with interrupts masked
+ * first, so that the thread cannot migrate between reading the CPU id
+ * and taking the lock.  The lock itself is only ever contended by
+ * sys_heap_mag_flush().
+ */
+static struct sys_heap_mag_cpu *cpu_lock(struct sys_heap_mag *mag, unsigned int *irq,
+					 k_spinlock_key_t *key)
+{
+	struct sys_heap_mag_cpu *cpu;
+
+	*irq = arch_irq_lock();
+	cpu = &mag->cpus[arch_curr_cpu()->id];
+	*key = k_spin_lock(&cpu->lock);
+
+	return cpu;
+}
+
+static void cpu_unlock(struct sys_heap_mag_cpu *cpu, unsigned int irq, k_spinlock_key_t key)
+{
+	k_spin_unlock(&cpu->lock, key);
+	arch_irq_unlock(irq);
+}
+
+void sys_heap_mag_init(struct sys_heap_mag *mag, struct sys_heap *heap)
+{
+	*mag = (struct sys_heap_mag) {
+		.heap = heap,
+	};
+}
+
+size_t sys_heap_mag_alloc_size(size_t bytes)
+{
+	int cls = alloc_class(bytes);
+
+	return ((cls < 0) || (bytes == 0)) ? bytes : (SYS_HEAP_MAG_MIN_BYTES << cls);
+}
+
+void *sys_heap_mag_alloc(struct sys_heap_mag *mag, size_t bytes)
+{
+	struct sys_heap_mag_cpu *cpu;
+	struct sys_heap_mag_class *mc;
+	k_spinlock_key_t key;
+	unsigned int irq;
+	void *mem = NULL;
+	int cls = alloc_class(bytes);
+
+	if ((cls < 0) || (bytes == 0) || k_is_user_context()) {
+		return NULL;
+	}
+
+	cpu = cpu_lock(mag, &irq, &key);
+	mc = &cpu->classes[cls];
+	if (mc->count > 0) {
+		mem = mc->blocks[--mc->count];
+		cpu->cached_bytes -= block_bytes(mag->heap, mem);
+		cpu->hits++;
+	} else {
+		cpu->misses++;
+	}
+	cpu_unlock(cpu, irq, key);
+
+	return mem;
+}
+
+bool sys_heap_mag_free(struct sys_heap_mag *mag, void *mem)
+{
+	struct sys_heap_mag_cpu *cpu;
+	struct sys_heap_mag_class *mc;
+	k_spinlock_key_t key;
+	unsigned int irq;
+	bool cached = false;
+	int cls;
+
+	if (mem == NULL) {
+		return true;
+	}
+
+	if (k_is_user_context()) {
+		return false;
+	}
+
+	/* The size of an allocated chunk only changes under its owner's
+	 * control, reading it without the heap lock is fine.
+	 */
+	cls = free_class(sys_heap_usable_size(mag->heap, mem));
+	if (cls < 0) {
+		return false;
+	}
+
+	cpu = cpu_lock(mag, &irq, &key);
+	mc = &cpu->classes[cls];
+	if (mc->count < CONFIG_SYS_HEAP_MAGAZINE_DEPTH) {
+		mc->blocks[mc->count++] = mem;
+		cpu->cached_bytes += block_bytes(mag->heap, mem);
+		cpu->hits++;
+		cached = true;
+	} else {
+		cpu->misses++;
+	}
+	cpu_unlock(cpu, irq, key);
+
+	return cached;
+}
+
+void sys_heap_mag_flush(struct sys_heap_mag *mag)
+{
+	for (unsigned int i = 0; i < ARRAY_SIZE(mag->cpus); i++) {
+		struct sys_heap_mag_cpu *cpu = &mag->cpus[i];
+		k_spinlock_key_t key = k_spin_lock(&cpu->lock);
+
+		for (int cls = 0; cls < CONFIG_SYS_HEAP_MAGAZINE_CLASSES; cls++) {
+			struct sys_heap_mag_class *mc = &cpu->classes[cls];
+
+			while (mc->count > 0) {
+				sys_heap_free(mag->heap, mc->blocks[--mc->count]);
+			}
+		}
+		cpu->cached_bytes = 0;
+
+		k_spin_unlock(&cpu->lock, key);
+	}
+}
+
+void sys_heap_mag_stats_get(struct sys_heap_mag *mag, struct sys_heap_mag_stats *stats)
+{
+	*stats = (struct sys_heap_mag_stats) {0};
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(mag->cpus); i++) {
+		struct sys_heap_mag_cpu *cpu = &mag->cpus[i];
+		k_spinlock_key_t key = k_spin_lock(&cpu->lock);
+
+		stats->hits += cpu->hits;
+		stats->misses += cpu->misses;
+		stats->cached_bytes += cpu->cached_bytes;
+
+		k_spin_unlock(&cpu->lock, key);
+	}
+}
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+int sys_heap_mag_runtime_stats_get(struct sys_heap_mag *mag, struct sys_memory_stats *stats)
+{
+	struct sys_heap_mag_stats mstats;
+	int ret;
+
+	if ((mag == NULL) || (stats == NULL)) {
+		return -EINVAL;
+	}
+
+	ret = sys_heap_runtime_stats_get(mag->heap, stats);
+	if (ret == 0) {
+		sys_heap_mag_stats_get(mag, &mstats);
+		stats->allocated_bytes -= mstats.cached_bytes;
+		stats->free_bytes += mstats.cached_bytes;
+	}
+
+	return ret;
+}
+#endif /* CONFIG_SYS_HEAP_RUNTIME_STATS */
@@ -18,6 +18,7 @@ struct z_heap_stress_rec {
 	size_t blocks_alloced;
 	size_t bytes_alloced;
 	uint32_t target_percent;
+	uint64_t rand_state;
 };
 
 struct z_heap_stress_block {
@@ -25,17 +26,21 @@ struct z_heap_stress_block {
 	size_t sz;
 };
 
+#define RAND_SEED 123456789
+
+/* State of the single threaded rig, carried over between runs */
+static uint64_t rand_state = RAND_SEED;
+
 /* Very simple LCRNG (from https://nuclear.llnl.gov/CNP/rng/rngman/node4.html)
  *
- * Here to guarantee cross-platform test repeatability.
+ * Here to guarantee cross-platform test repeatability.  Each rig
+ * carries its own state so that concurrent runs stay repeatable.
  */
-static uint32_t rand32(void)
+static uint32_t rand32(struct z_heap_stress_rec *sr)
 {
-	static uint64_t state = 123456789; /* seed */
-
-	state = state * 2862933555777941757UL + 3037000493UL;
+	sr->rand_state = sr->rand_state * 2862933555777941757UL + 3037000493UL;
 
-	return (uint32_t)(state >> 32);
+	return (uint32_t)(sr->rand_state >> 32);
 }
 
 static bool rand_alloc_choice(struct z_heap_stress_rec *sr)
@@ -71,7 +76,7 @@ static bool rand_alloc_choice(struct z_heap_stress_rec *sr)
 			free_chance = full_pct * (0x80000000U / target);
 		}
 
-		return rand32() > free_chance;
+		return rand32(sr) > free_chance;
 	}
 }
 
@@ -80,20 +85,49 @@ static bool rand_alloc_choice(struct z_heap_stress_rec *sr)
  */
 static size_t rand_alloc_size(struct z_heap_stress_rec *sr)
 {
-	ARG_UNUSED(sr);
-
 	/* Min scale of 4 means that the half of the requests in the
 	 * smallest size have an average size of 8
 	 */
-	int scale = 4 + __builtin_clz(rand32());
+	int scale = 4 + __builtin_clz(rand32(sr));
 
-	return rand32() & BIT_MASK(scale);
+	return rand32(sr) & BIT_MASK(scale);
 }
 
 /* Returns the index of a randomly chosen block to free */
 static size_t rand_free_choice(struct z_heap_stress_rec *sr)
 {
-	return rand32() % sr->blocks_alloced;
+	return rand32(sr) % sr->blocks_alloced;
+}
+
+static void stress_loop(struct z_heap_stress_rec *sr, uint32_t op_count,
+			struct z_heap_stress_result *result)
+{
+	for (uint32_t i = 0; i < op_count; i++) {
+		if (rand_alloc_choice(sr)) {
+			size_t sz = rand_alloc_size(sr);
+			void *p = sr->alloc_fn(sr->arg, sz);
+
+			result->total_allocs++;
+			if (p != NULL) {
+				result->successful_allocs++;
+				sr->blocks[sr->blocks_alloced].ptr = p;
+				sr->blocks[sr->blocks_alloced].sz = sz;
+				sr->blocks_alloced++;
+				sr->bytes_alloced += sz;
+			}
+		} else {
+			int b = rand_free_choice(sr);
+			void *p = sr->blocks[b].ptr;
+			size_t sz = sr->blocks[b].sz;
+
+			result->total_frees++;
+			sr->blocks[b] = sr->blocks[sr->blocks_alloced - 1];
+			sr->blocks_alloced--;
+			sr->bytes_alloced -= sz;
+			sr->free_fn(sr->arg, p);
+		}
+		result->accumulated_in_use_bytes += sr->bytes_alloced;
+	}
 }
 
 /* General purpose heap stress test.  Takes function pointers to allow
@@ -120,34 +154,102 @@ void sys_heap_stress(void *(*alloc_fn)(void *arg, size_t bytes),
 	       .blocks = scratch_mem,
 	       .nblocks = scratch_bytes / sizeof(struct z_heap_stress_block),
 	       .target_percent = target_percent,
+	       .rand_state = rand_state,
 	};
+	uint32_t start;
 
 	*result = (struct z_heap_stress_result) {0};
 
-	for (uint32_t i = 0; i < op_count; i++) {
-		if (rand_alloc_choice(&sr)) {
-			size_t sz = rand_alloc_size(&sr);
-			void *p = sr.alloc_fn(sr.arg, sz);
+	start = k_cycle_get_32();
+	stress_loop(&sr, op_count, result);
+	result->elapsed_cycles = k_cycle_get_32() - start;
 
-			result->total_allocs++;
-			if (p != NULL) {
-				result->successful_allocs++;
-				sr.blocks[sr.blocks_alloced].ptr = p;
-				sr.blocks[sr.blocks_alloced].sz = sz;
-				sr.blocks_alloced++;
-				sr.bytes_alloced += sz;
-			}
-		} else {
-			int b = rand_free_choice(&sr);
-			void *p = sr.blocks[b].ptr;
-			size_t sz = sr.blocks[b].sz;
+	rand_state = sr.rand_state;
+}
 
-			result->total_frees++;
-			sr.blocks[b] = sr.blocks[sr.blocks_alloced - 1];
-			sr.blocks_alloced--;
-			sr.bytes_alloced -= sz;
-			sr.free_fn(sr.arg, p);
-		}
-		result->accumulated_in_use_bytes += sr.bytes_alloced;
+#ifdef CONFIG_MULTITHREADING
+struct z_heap_stress_mt_worker {
+	struct z_heap_stress_rec sr;
+	struct z_heap_stress_result result;
+	uint32_t op_count;
+};
+
+static void stress_mt_entry(void *p1, void *p2, void *p3)
+{
+	struct z_heap_stress_mt_worker *w = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	stress_loop(&w->sr, w->op_count, &w->result);
+}
+
+/* Multithreaded variant of the rig: each worker thread runs the same
+ * random loop as sys_heap_stress() on its own share of the heap and
+ * of the scratch memory, concurrently with the others, so the elapsed
+ * time reflects contention on the allocator.
+ */
+void sys_heap_stress_mt(void *(*alloc_fn)(void *arg, size_t bytes),
+			void (*free_fn)(void *arg, void *p),
+			void *arg, size_t total_bytes,
+			uint32_t op_count,
+			void *scratch_mem, size_t scratch_bytes,
+			int target_percent,
+			const struct z_heap_stress_mt_config *config,
+			struct z_heap_stress_result *result)
+{
+	int n = config->num_threads;
+	/* The worker bookkeeping lives at the start of the scratch memory,
+	 * the rest is split evenly into per-thread block arrays.
+	 */
+	struct z_heap_stress_mt_worker *workers = scratch_mem;
+	struct z_heap_stress_block *blocks = (void *)&workers[n];
+	size_t nblocks = (scratch_bytes - n * sizeof(*workers)) / n /
+			 sizeof(struct z_heap_stress_block);
+	int prio = k_thread_priority_get(k_current_get());
+	uint32_t start;
+
+	__ASSERT(scratch_bytes > n * sizeof(*workers), "not enough scratch memory");
+
+	*result = (struct z_heap_stress_result) {0};
+
+	for (int i = 0; i < n; i++) {
+		workers[i] = (struct z_heap_stress_mt_worker) {
+			.sr = {
+				.alloc_fn = alloc_fn,
+				.free_fn = free_fn,
+				.arg = arg,
+				.total_bytes = total_bytes / n,
+				.blocks = &blocks[i * nblocks],
+				.nblocks = nblocks,
+				.target_percent = target_percent,
+				.rand_state = RAND_SEED + i,
+			},
+			.op_count = op_count / n,
+		};
+
+		k_thread_create(&config->threads[i],
+				(k_thread_stack_t *)((uint8_t *)config->stacks +
+						     i * config->stack_stride),
+				config->stack_size, stress_mt_entry,
+				&workers[i], NULL, NULL, prio, 0, K_FOREVER);
+	}
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < n; i++) {
+		k_thread_start(&config->threads[i]);
+	}
+	for (int i = 0; i < n; i++) {
+		k_thread_join(&config->threads[i], K_FOREVER);
+	}
+	result->elapsed_cycles = k_cycle_get_32() - start;
+
+	for (int i = 0; i < n; i++) {
+		result->total_allocs += workers[i].result.total_allocs;
+		result->successful_allocs += workers[i].result.successful_allocs;
+		result->total_frees += workers[i].result.total_frees;
+		result->accumulated_in_use_bytes +=
+			workers[i].result.accumulated_in_use_bytes;
 	}
 }
+#endif /* CONFIG_MULTITHREADING */
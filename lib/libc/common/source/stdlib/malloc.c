@@ -15,6 +15,9 @@
 #include <zephyr/sys/mutex.h>
 #endif
 #include <zephyr/sys/sys_heap.h>
+#ifdef CONFIG_COMMON_LIBC_MALLOC_MAGAZINE
+#include <zephyr/sys/sys_heap_mag.h>
+#endif
 #include <zephyr/sys/libc-hooks.h>
 #include <zephyr/types.h>
 #ifdef CONFIG_MMU
@@ -137,13 +140,61 @@ malloc_unlock(void)
 #define malloc_unlock()
 #endif
 
+#ifdef CONFIG_COMMON_LIBC_MALLOC_MAGAZINE
+/* Only ever touched from supervisor mode, so not in the libc partition */
+static struct sys_heap_mag z_malloc_mag;
+
+static inline void *malloc_mag_alloc(size_t *size)
+{
+	void *ret = sys_heap_mag_alloc(&z_malloc_mag, *size);
+
+	if (ret == NULL) {
+		/* Round the heap allocation up so it can be cached on free */
+		*size = sys_heap_mag_alloc_size(*size);
+	}
+
+	return ret;
+}
+
+static inline bool malloc_mag_free(void *ptr)
+{
+	/* Blocks with weaker alignment (from aligned_alloc()) could not
+	 * be handed out again by malloc(), leave them to the heap.
+	 */
+	if ((POINTER_TO_UINT(ptr) & (__alignof__(z_max_align_t) - 1)) != 0) {
+		return false;
+	}
+
+	return sys_heap_mag_free(&z_malloc_mag, ptr);
+}
+#else
+#define malloc_mag_alloc(size) NULL
+#define malloc_mag_free(ptr) false
+#endif /* CONFIG_COMMON_LIBC_MALLOC_MAGAZINE */
+
 void *malloc(size_t size)
 {
+	size_t alloc_size = size;
+	void *ret = malloc_mag_alloc(&alloc_size);
+
+	if (ret != NULL) {
+		return ret;
+	}
+
 	malloc_lock();
 
-	void *ret = sys_heap_aligned_alloc(&z_malloc_heap,
-					   __alignof__(z_max_align_t),
-					   size);
+	ret = sys_heap_aligned_alloc(&z_malloc_heap,
+				     __alignof__(z_max_align_t),
+				     alloc_size);
+#ifdef CONFIG_COMMON_LIBC_MALLOC_MAGAZINE
+	if (ret == NULL && size != 0) {
+		/* Give cached blocks back and retry before failing */
+		sys_heap_mag_flush(&z_malloc_mag);
+		ret = sys_heap_aligned_alloc(&z_malloc_heap,
+					     __alignof__(z_max_align_t),
+					     size);
+	}
+#endif
 	if (ret == NULL && size != 0) {
 		errno = ENOMEM;
 	}
@@ -234,6 +285,9 @@ static int malloc_prepare(void)
 #endif
 
 	sys_heap_init(&z_malloc_heap, heap_base, heap_size);
+#ifdef CONFIG_COMMON_LIBC_MALLOC_MAGAZINE
+	sys_heap_mag_init(&z_malloc_mag, &z_malloc_heap);
+#endif
 
 	return 0;
 }
@@ -257,6 +311,10 @@ void *realloc(void *ptr, size_t requested_size)
 
 void free(void *ptr)
 {
+	if (malloc_mag_free(ptr)) {
+		return;
+	}
+
 	malloc_lock();
 	sys_heap_free(&z_malloc_heap, ptr);
 	malloc_unlock();
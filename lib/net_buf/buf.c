@@ -85,6 +85,147 @@ static inline struct net_buf *pool_get_uninit(struct net_buf_pool *pool,
 	return buf;
 }
 
+#if defined(CONFIG_NET_BUF_POOL_PERCPU_CACHE)
+#define POOL_CACHE_BATCH (CONFIG_NET_BUF_POOL_PERCPU_CACHE_SIZE / 2)
+
+/* The cache of the current CPU is locked with interrupts masked first,
+ * so that the thread cannot migrate between reading the CPU id and
+ * taking the lock.
+ */
+static struct net_buf_pool_cpu_cache *pool_cache_lock(struct net_buf_pool *pool,
+						      unsigned int *irq, k_spinlock_key_t *key)
+{
+	struct net_buf_pool_cpu_cache *cache;
+
+	*irq = arch_irq_lock();
+	cache = &pool->cpu_cache[arch_curr_cpu()->id];
+	*key = k_spin_lock(&cache->lock);
+
+	return cache;
+}
+
+static void pool_cache_unlock(struct net_buf_pool_cpu_cache *cache, unsigned int irq,
+			      k_spinlock_key_t key)
+{
+	k_spin_unlock(&cache->lock, key);
+	arch_irq_unlock(irq);
+}
+
+/* Take up to @a count buffers out of @a cache, called with its lock held */
+static void pool_cache_take(struct net_buf_pool_cpu_cache *cache, uint16_t count,
+			    sys_slist_t *list)
+{
+	while ((count > 0U) && (cache->count > 0U)) {
+		sys_slist_append(list, sys_slist_get_not_empty(&cache->free));
+		cache->count--;
+		count--;
+	}
+}
+
+/* Give the buffers of @a list back to the free LIFO of the pool, which
+ * wakes up the threads waiting for a buffer.
+ */
+static void pool_cache_give(struct net_buf_pool *pool, sys_slist_t *list)
+{
+	sys_snode_t *node;
+
+	while ((node = sys_slist_get(list)) != NULL) {
+		k_lifo_put(&pool->free, CONTAINER_OF(node, struct net_buf, node));
+	}
+}
+
+/* Move all the buffers of the per-CPU caches back to the free LIFO */
+static void pool_cache_flush(struct net_buf_pool *pool)
+{
+	for (unsigned int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		struct net_buf_pool_cpu_cache *cache = &pool->cpu_cache[i];
+		sys_slist_t list;
+
+		sys_slist_init(&list);
+
+		K_SPINLOCK(&cache->lock) {
+			pool_cache_take(cache, cache->count, &list);
+		}
+
+		pool_cache_give(pool, &list);
+	}
+}
+
+static struct net_buf *pool_cache_get(struct net_buf_pool *pool)
+{
+	struct net_buf_pool_cpu_cache *cache;
+	struct net_buf *buf;
+	k_spinlock_key_t key;
+	unsigned int irq;
+
+	if (k_is_user_context()) {
+		return NULL;
+	}
+
+	cache = pool_cache_lock(pool, &irq, &key);
+
+	if (cache->count == 0U) {
+		/* Refill the cache with a batch of buffers */
+		while (cache->count < POOL_CACHE_BATCH) {
+			buf = k_lifo_get(&pool->free, K_NO_WAIT);
+			if (!buf) {
+				break;
+			}
+
+			sys_slist_prepend(&cache->free, &buf->node);
+			cache->count++;
+		}
+	}
+
+	if (cache->count > 0U) {
+		buf = CONTAINER_OF(sys_slist_get_not_empty(&cache->free), struct net_buf, node);
+		cache->count--;
+	} else {
+		buf = NULL;
+	}
+
+	pool_cache_unlock(cache, irq, key);
+
+	return buf;
+}
+
+void net_buf_pool_cache_put(struct net_buf_pool *pool, struct net_buf *buf)
+{
+	struct net_buf_pool_cpu_cache *cache;
+	k_spinlock_key_t key;
+	unsigned int irq;
+	sys_slist_t list;
+
+	if (k_is_user_context()) {
+		k_lifo_put(&pool->free, buf);
+		return;
+	}
+
+	sys_slist_init(&list);
+
+	cache = pool_cache_lock(pool, &irq, &key);
+
+	if (cache->count == CONFIG_NET_BUF_POOL_PERCPU_CACHE_SIZE) {
+		pool_cache_take(cache, POOL_CACHE_BATCH, &list);
+	}
+
+	sys_slist_prepend(&cache->free, &buf->node);
+	cache->count++;
+
+	/* A thread about to wait for a buffer flushes the caches after
+	 * registering itself, so a buffer cached after that flush is seen
+	 * here and handed over.
+	 */
+	if (atomic_get(&pool->cache_waiters) != 0) {
+		pool_cache_take(cache, cache->count, &list);
+	}
+
+	pool_cache_unlock(cache, irq, key);
+
+	pool_cache_give(pool, &list);
+}
+#endif /* CONFIG_NET_BUF_POOL_PERCPU_CACHE */
+
 void net_buf_reset(struct net_buf *buf)
 {
 	__ASSERT_NO_MSG(buf->frags == NULL);
@@ -258,6 +399,13 @@ struct net_buf *net_buf_alloc_len(struct net_buf_pool *pool, size_t size,
 
 	NET_BUF_DBG("%s():%d: pool %p size %zu", func, line, pool, size);
 
+#if defined(CONFIG_NET_BUF_POOL_PERCPU_CACHE)
+	buf = pool_cache_get(pool);
+	if (buf) {
+		goto success;
+	}
+#endif
+
 	/* We need to prevent race conditions
 	 * when accessing pool->uninit_count.
 	 */
@@ -290,6 +438,17 @@ struct net_buf *net_buf_alloc_len(struct net_buf_pool *pool, size_t size,
 
 	k_spin_unlock(&pool->lock, key);
 
+#if defined(CONFIG_NET_BUF_POOL_PERCPU_CACHE)
+	bool wait = !K_TIMEOUT_EQ(timeout, K_NO_WAIT);
+
+	/* Take back the buffers held by the caches of the other CPUs */
+	if (wait) {
+		atomic_inc(&pool->cache_waiters);
+	}
+
+	pool_cache_flush(pool);
+#endif
+
 #if defined(CONFIG_NET_BUF_LOG) && (CONFIG_NET_BUF_LOG_LEVEL >= LOG_LEVEL_WRN)
 	if (K_TIMEOUT_EQ(timeout, K_FOREVER)) {
 		uint32_t ref = k_uptime_get_32();
@@ -319,6 +478,13 @@ struct net_buf *net_buf_alloc_len(struct net_buf_pool *pool, size_t size,
 #else
 	buf = k_lifo_get(&pool->free, timeout);
 #endif
+
+#if defined(CONFIG_NET_BUF_POOL_PERCPU_CACHE)
+	if (wait) {
+		atomic_dec(&pool->cache_waiters);
+	}
+#endif
+
 	if (!buf) {
 		NET_BUF_ERR("%s():%d: Failed to get free buffer", func, line);
 		return NULL;
@@ -348,6 +514,9 @@ success:
 	buf->flags = 0U;
 	buf->frags = NULL;
 	buf->size  = size;
+#if defined(CONFIG_NET_BUF_EXTERNAL_REF)
+	buf->ext   = NULL;
+#endif
 	memset(buf->user_data, 0, buf->user_data_size);
 	net_buf_reset(buf);
 
@@ -404,6 +573,31 @@ struct net_buf *net_buf_alloc_with_data(struct net_buf_pool *pool,
 	return buf;
 }
 
+#if defined(CONFIG_NET_BUF_EXTERNAL_REF)
+struct net_buf *net_buf_alloc_with_ext(struct net_buf_pool *pool,
+				       struct net_buf_ext *ext,
+				       const void *data, size_t len,
+				       k_timeout_t timeout)
+{
+	struct net_buf *buf;
+
+	__ASSERT_NO_MSG(ext);
+
+	if (len > UINT16_MAX) {
+		return NULL;
+	}
+
+	buf = net_buf_alloc_with_data(pool, (void *)data, len, timeout);
+	if (!buf) {
+		return NULL;
+	}
+
+	buf->ext = net_buf_ext_ref(ext);
+
+	return buf;
+}
+#endif /* CONFIG_NET_BUF_EXTERNAL_REF */
+
 static struct k_spinlock net_buf_slist_lock;
 
 void net_buf_slist_put(sys_slist_t *list, struct net_buf *buf)
@@ -514,6 +708,16 @@ struct net_buf *net_buf_clone(struct net_buf *buf, k_timeout_t timeout)
 		clone->data = buf->data;
 		clone->len = buf->len;
 		clone->size = buf->size;
+#if defined(CONFIG_NET_BUF_EXTERNAL_REF)
+	} else if (buf->ext) {
+		/* External memory is shared by taking a reference to it */
+		clone->__buf = buf->__buf;
+		clone->data = buf->data;
+		clone->len = buf->len;
+		clone->size = buf->size;
+		clone->flags = NET_BUF_EXTERNAL_DATA;
+		clone->ext = net_buf_ext_ref(buf->ext);
+#endif
 	} else {
 		size_t size = buf->size;
 
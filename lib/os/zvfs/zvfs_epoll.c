@@ -0,0 +1,774 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/bitarray.h>
+#include <zephyr/sys/fdtable.h>
+#include <zephyr/sys/slist.h>
+#include <zephyr/zvfs/epoll.h>
+
+/* Poll events a file descriptor may prepare, see ZFD_IOCTL_POLL_PREPARE */
+#define ZVFS_EPOLL_FD_EVENTS 2
+
+#define ZVFS_EPOLL_POLL_EVENTS (ZVFS_EPOLLIN | ZVFS_EPOLLPRI | ZVFS_EPOLLOUT)
+#define ZVFS_EPOLL_EVENTS_SET                                                                      \
+	(ZVFS_EPOLL_POLL_EVENTS | ZVFS_EPOLLERR | ZVFS_EPOLLHUP | ZVFS_EPOLLONESHOT | ZVFS_EPOLLET)
+
+/* The entry belongs to the interest set */
+#define ZVFS_EPOLL_ENTRY_USED     BIT(0)
+/* The entry reported its readiness when it was prepared */
+#define ZVFS_EPOLL_ENTRY_READY    BIT(1)
+/* Edge-triggered or one-shot entry reported and not re-armed yet */
+#define ZVFS_EPOLL_ENTRY_DISARMED BIT(2)
+
+struct zvfs_epoll;
+
+/*
+ * An armed entry keeps its poll events registered across waits, through its
+ * k_work_poll. When one of them fires, the epoll work queue moves the entry to
+ * the ready list of the instance, so a wait only goes through the ready
+ * entries. An entry is either armed, in the ready list, in the edge list of
+ * the reported edge-triggered entries, or disarmed one-shot.
+ */
+struct zvfs_epoll_entry {
+	sys_snode_t node;
+	struct zvfs_epoll *ep;
+	struct k_work_poll work;
+	struct k_poll_event poll_events[ZVFS_EPOLL_FD_EVENTS];
+	int fd;
+	/* Object the fd referred to when registered, to notice it was closed */
+	void *obj;
+	uint32_t events;
+	zvfs_epoll_data_t data;
+	uint8_t flags;
+};
+
+struct zvfs_epoll {
+	struct k_mutex lock;
+	struct k_condvar cond;
+	/* Entries whose events fired, filled by the epoll work queue */
+	sys_slist_t ready;
+	struct k_spinlock ready_lock;
+	/* Edge-triggered entries reported and still ready, checked by each wait */
+	sys_slist_t edge;
+	/* Raised when an entry is added to the ready list */
+	struct k_poll_signal wake;
+	struct k_poll_event wake_event;
+	/* Submitted after the pending work of the epoll work queue to wait for it */
+	struct k_work flush;
+	struct zvfs_epoll_entry entries[CONFIG_ZVFS_EPOLL_MAX_FDS];
+	/* Threads inside zvfs_epoll_wait(), the instance is freed after them */
+	int users;
+	bool waiting;
+	bool in_use;
+};
+
+SYS_BITARRAY_DEFINE_STATIC(epolls_bitarray, CONFIG_ZVFS_EPOLL_MAX);
+static struct zvfs_epoll epolls[CONFIG_ZVFS_EPOLL_MAX];
+static const struct fd_op_vtable zvfs_epoll_fd_vtable;
+
+static K_KERNEL_STACK_DEFINE(zvfs_epoll_workq_stack, CONFIG_ZVFS_EPOLL_WORKQUEUE_STACK_SIZE);
+static struct k_work_q zvfs_epoll_workq;
+
+static void zvfs_epoll_queue(struct zvfs_epoll *ep, struct zvfs_epoll_entry *entry)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&ep->ready_lock);
+	sys_slist_append(&ep->ready, &entry->node);
+	k_spin_unlock(&ep->ready_lock, key);
+
+	k_poll_signal_raise(&ep->wake, 0);
+}
+
+/* Called by the epoll work queue, the events of the entry are not registered anymore */
+static void zvfs_epoll_fired(struct k_work *work)
+{
+	struct k_work_poll *pwork = CONTAINER_OF(work, struct k_work_poll, work);
+	struct zvfs_epoll_entry *entry = CONTAINER_OF(pwork, struct zvfs_epoll_entry, work);
+
+	zvfs_epoll_queue(entry->ep, entry);
+}
+
+static void zvfs_epoll_flushed(struct k_work *work)
+{
+	ARG_UNUSED(work);
+}
+
+/* Let the epoll work queue queue the entries whose events already fired */
+static void zvfs_epoll_flush(struct zvfs_epoll *ep)
+{
+	struct k_work_sync sync;
+
+	(void)k_work_submit_to_queue(&zvfs_epoll_workq, &ep->flush);
+	(void)k_work_flush(&ep->flush, &sync);
+}
+
+static struct zvfs_epoll_entry *zvfs_epoll_find(struct zvfs_epoll *ep, int fd)
+{
+	for (int i = 0; i < ARRAY_SIZE(ep->entries); i++) {
+		struct zvfs_epoll_entry *entry = &ep->entries[i];
+
+		if ((entry->flags & ZVFS_EPOLL_ENTRY_USED) != 0 && entry->fd == fd) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+static struct zvfs_epoll_entry *zvfs_epoll_alloc(struct zvfs_epoll *ep)
+{
+	for (int i = 0; i < ARRAY_SIZE(ep->entries); i++) {
+		if ((ep->entries[i].flags & ZVFS_EPOLL_ENTRY_USED) == 0) {
+			return &ep->entries[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Must be called with the instance locked and the entry neither armed nor listed */
+static int zvfs_epoll_prepare(struct zvfs_epoll_entry *entry)
+{
+	struct k_poll_event *pev = entry->poll_events;
+	struct zvfs_pollfd pfd = {
+		.fd = entry->fd,
+		.events = entry->events & ZVFS_EPOLL_POLL_EVENTS,
+	};
+	const struct fd_op_vtable *vtable;
+	struct k_mutex *lock;
+	void *obj;
+	int ret;
+
+	entry->flags &= ~ZVFS_EPOLL_ENTRY_READY;
+
+	for (int i = 0; i < ZVFS_EPOLL_FD_EVENTS; i++) {
+		entry->poll_events[i].state = K_POLL_STATE_NOT_READY;
+	}
+
+	obj = zvfs_get_fd_obj_and_vtable(entry->fd, &vtable, &lock);
+	if (obj == NULL || obj != entry->obj) {
+		return -EBADF;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+	ret = zvfs_fdtable_call_ioctl(vtable, obj, ZFD_IOCTL_POLL_PREPARE, &pfd, &pev,
+				      entry->poll_events + ZVFS_EPOLL_FD_EVENTS);
+	k_mutex_unlock(lock);
+
+	if (ret == -EALREADY) {
+		/* Readiness must be checked without waiting for an event */
+		entry->flags |= ZVFS_EPOLL_ENTRY_READY;
+	} else if (ret == -EXDEV) {
+		/* Offloaded sockets are polled by their own implementation */
+		return -EPERM;
+	} else if (ret < 0) {
+		return ret;
+	}
+
+	/* Number of prepared poll events */
+	return pev - entry->poll_events;
+}
+
+static int zvfs_epoll_update(struct zvfs_epoll_entry *entry, uint32_t *revents)
+{
+	struct k_poll_event *pev = entry->poll_events;
+	struct zvfs_pollfd pfd = {
+		.fd = entry->fd,
+		.events = entry->events & ZVFS_EPOLL_POLL_EVENTS,
+	};
+	const struct fd_op_vtable *vtable;
+	struct k_mutex *lock;
+	void *obj;
+	int ret;
+
+	obj = zvfs_get_fd_obj_and_vtable(entry->fd, &vtable, &lock);
+	if (obj == NULL || obj != entry->obj) {
+		return -EBADF;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+	ret = zvfs_fdtable_call_ioctl(vtable, obj, ZFD_IOCTL_POLL_UPDATE, &pfd, &pev);
+	k_mutex_unlock(lock);
+
+	*revents = (uint16_t)pfd.revents;
+
+	return ret;
+}
+
+/* Register the poll events of the entry, or queue it right away if it is ready */
+static int zvfs_epoll_arm(struct zvfs_epoll *ep, struct zvfs_epoll_entry *entry)
+{
+	int count;
+
+	count = zvfs_epoll_prepare(entry);
+	if (count < 0) {
+		return count;
+	}
+
+	if ((entry->flags & ZVFS_EPOLL_ENTRY_READY) != 0) {
+		if (count > 0) {
+			(void)k_poll(entry->poll_events, count, K_NO_WAIT);
+		}
+
+		zvfs_epoll_queue(ep, entry);
+		return 0;
+	}
+
+	return k_work_poll_submit_to_queue(&zvfs_epoll_workq, &entry->work, entry->poll_events,
+					   count, K_FOREVER);
+}
+
+/* Cancel the registration of the entry and take it off the lists */
+static void zvfs_epoll_disarm(struct zvfs_epoll *ep, struct zvfs_epoll_entry *entry)
+{
+	struct k_work_sync sync;
+	k_spinlock_key_t key;
+
+	/* Once an event fired, cancel the pending work or wait for it to queue the entry */
+	if (k_work_poll_cancel(&entry->work) != 0) {
+		(void)k_work_cancel_sync(&entry->work.work, &sync);
+	}
+
+	k_work_poll_init(&entry->work, zvfs_epoll_fired);
+
+	if ((entry->flags & ZVFS_EPOLL_ENTRY_DISARMED) != 0) {
+		(void)sys_slist_find_and_remove(&ep->edge, &entry->node);
+	} else {
+		key = k_spin_lock(&ep->ready_lock);
+		(void)sys_slist_find_and_remove(&ep->ready, &entry->node);
+		k_spin_unlock(&ep->ready_lock, key);
+	}
+
+	entry->flags &= ~(ZVFS_EPOLL_ENTRY_READY | ZVFS_EPOLL_ENTRY_DISARMED);
+}
+
+static void zvfs_epoll_remove(struct zvfs_epoll *ep, struct zvfs_epoll_entry *entry)
+{
+	zvfs_epoll_disarm(ep, entry);
+	entry->flags = 0;
+}
+
+/* Re-arm an entry taken off the lists, a closed file descriptor leaves the set */
+static int zvfs_epoll_rearm(struct zvfs_epoll *ep, struct zvfs_epoll_entry *entry)
+{
+	int ret;
+
+	ret = zvfs_epoll_arm(ep, entry);
+	if (ret == -EBADF) {
+		entry->flags = 0;
+		return 0;
+	} else if (ret < 0) {
+		/* Reported again by the next wait */
+		zvfs_epoll_queue(ep, entry);
+	}
+
+	return ret;
+}
+
+/* Check if a reported edge-triggered entry is still ready, without waiting.
+ * Returns 1 once the data was consumed, the next readiness being a new edge.
+ */
+static int zvfs_epoll_drained(struct zvfs_epoll_entry *entry)
+{
+	uint32_t revents = 0;
+	int count;
+	int ret;
+
+	count = zvfs_epoll_prepare(entry);
+	if (count < 0) {
+		return count;
+	}
+
+	if (count > 0) {
+		(void)k_poll(entry->poll_events, count, K_NO_WAIT);
+	}
+
+	ret = zvfs_epoll_update(entry, &revents);
+	if (ret == -EAGAIN) {
+		return 0;
+	} else if (ret < 0) {
+		return ret;
+	}
+
+	return (revents == 0) ? 1 : 0;
+}
+
+static int zvfs_epoll_check_edges(struct zvfs_epoll *ep)
+{
+	struct zvfs_epoll_entry *entry;
+	struct zvfs_epoll_entry *next;
+	sys_snode_t *prev = NULL;
+	int ret;
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&ep->edge, entry, next, node) {
+		ret = zvfs_epoll_drained(entry);
+		if (ret == 0) {
+			prev = &entry->node;
+			continue;
+		} else if (ret < 0 && ret != -EBADF) {
+			return ret;
+		}
+
+		sys_slist_remove(&ep->edge, prev, &entry->node);
+		entry->flags &= ~ZVFS_EPOLL_ENTRY_DISARMED;
+
+		if (ret == -EBADF) {
+			entry->flags = 0;
+			continue;
+		}
+
+		ret = zvfs_epoll_rearm(ep, entry);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+static int zvfs_epoll_collect(struct zvfs_epoll *ep, struct zvfs_epoll_event *events,
+			      int maxevents, bool *ready)
+{
+	struct zvfs_epoll_entry *entry;
+	k_spinlock_key_t key;
+	sys_slist_t queued;
+	sys_snode_t *node;
+	uint32_t revents;
+	int count = 0;
+	int ret = 0;
+
+	/* Entries queued again while collecting are reported by the next wait */
+	key = k_spin_lock(&ep->ready_lock);
+	queued = ep->ready;
+	sys_slist_init(&ep->ready);
+	k_spin_unlock(&ep->ready_lock, key);
+
+	while (count < maxevents) {
+		node = sys_slist_get(&queued);
+		if (node == NULL) {
+			break;
+		}
+
+		entry = CONTAINER_OF(node, struct zvfs_epoll_entry, node);
+		if ((entry->flags & ZVFS_EPOLL_ENTRY_READY) != 0) {
+			*ready = true;
+		}
+
+		revents = 0;
+		ret = zvfs_epoll_update(entry, &revents);
+		if (ret == -EBADF) {
+			/* A closed file descriptor leaves the interest set */
+			entry->flags = 0;
+			continue;
+		} else if (ret < 0 && ret != -EAGAIN) {
+			sys_slist_prepend(&queued, node);
+			break;
+		}
+
+		if (revents != 0) {
+			events[count].events = revents;
+			events[count].data = entry->data;
+			count++;
+
+			if ((entry->events & ZVFS_EPOLLONESHOT) != 0) {
+				entry->flags |= ZVFS_EPOLL_ENTRY_DISARMED;
+				continue;
+			} else if ((entry->events & ZVFS_EPOLLET) != 0) {
+				entry->flags |= ZVFS_EPOLL_ENTRY_DISARMED;
+				sys_slist_append(&ep->edge, node);
+				continue;
+			}
+		}
+
+		/* A level-triggered entry still ready is queued again right away */
+		ret = zvfs_epoll_rearm(ep, entry);
+		if (ret < 0) {
+			break;
+		}
+	}
+
+	/* Entries left over when the array is full are found again by the next wait */
+	key = k_spin_lock(&ep->ready_lock);
+	sys_slist_merge_slist(&queued, &ep->ready);
+	ep->ready = queued;
+	k_spin_unlock(&ep->ready_lock, key);
+
+	if (ret < 0 && ret != -EAGAIN && count == 0) {
+		return ret;
+	}
+
+	return count;
+}
+
+static int zvfs_epoll_wait_locked(struct zvfs_epoll *ep, struct zvfs_epoll_event *events,
+				  int maxevents, k_timepoint_t end)
+{
+	bool flushed = false;
+	bool ready;
+	int ret;
+
+	while (true) {
+		/* A single thread waits for the wake signal at a time */
+		while (ep->waiting) {
+			(void)k_condvar_wait(&ep->cond, &ep->lock, K_FOREVER);
+		}
+
+		if (!ep->in_use) {
+			return -EBADF;
+		}
+
+		ret = zvfs_epoll_check_edges(ep);
+		if (ret < 0) {
+			return ret;
+		}
+
+		/* Like zvfs_poll(), do not spin on entries which did not wait */
+		ready = false;
+		ret = zvfs_epoll_collect(ep, events, maxevents, &ready);
+		if (ret != 0 || ready) {
+			return ret;
+		}
+
+		if (sys_timepoint_expired(end)) {
+			if (flushed) {
+				return 0;
+			}
+
+			/* Events which fired before the timeout are still reported */
+			zvfs_epoll_flush(ep);
+			flushed = true;
+			continue;
+		}
+
+		ep->waiting = true;
+		k_mutex_unlock(&ep->lock);
+
+		ret = k_poll(&ep->wake_event, 1, sys_timepoint_timeout(end));
+
+		(void)k_mutex_lock(&ep->lock, K_FOREVER);
+		ep->waiting = false;
+		k_condvar_broadcast(&ep->cond);
+
+		/* EAGAIN when timeout expired, EINTR when cancelled (i.e. EOF) */
+		if (ret != 0 && ret != -EAGAIN && ret != -EINTR) {
+			return ret;
+		}
+
+		/* Entries queued from now on raise the signal again */
+		k_poll_signal_reset(&ep->wake);
+		ep->wake_event.state = K_POLL_STATE_NOT_READY;
+	}
+}
+
+/* Called with the lock held, the instance is freed once it is closed and
+ * no thread uses it anymore.
+ */
+static bool zvfs_epoll_unused(struct zvfs_epoll *ep)
+{
+	return !ep->in_use && ep->users == 0;
+}
+
+/* Called without the lock held, as the slot may be reused right away */
+static void zvfs_epoll_free(struct zvfs_epoll *ep)
+{
+	int err;
+
+	err = sys_bitarray_free(&epolls_bitarray, 1, ep - epolls);
+	__ASSERT(err == 0, "sys_bitarray_free() failed: %d", err);
+}
+
+static int zvfs_epoll_close_op(void *obj)
+{
+	struct zvfs_epoll *ep = obj;
+	bool unused;
+
+	(void)k_mutex_lock(&ep->lock, K_FOREVER);
+
+	ep->in_use = false;
+
+	for (int i = 0; i < ARRAY_SIZE(ep->entries); i++) {
+		if ((ep->entries[i].flags & ZVFS_EPOLL_ENTRY_USED) != 0) {
+			zvfs_epoll_remove(ep, &ep->entries[i]);
+		}
+	}
+
+	unused = zvfs_epoll_unused(ep);
+
+	/* Wake up the waiter, which returns an error */
+	k_poll_signal_raise(&ep->wake, 0);
+	k_condvar_broadcast(&ep->cond);
+	k_mutex_unlock(&ep->lock);
+
+	if (unused) {
+		zvfs_epoll_free(ep);
+	}
+
+	return 0;
+}
+
+static int zvfs_epoll_ioctl_op(void *obj, unsigned int request, va_list args)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(request);
+	ARG_UNUSED(args);
+
+	/* An epoll instance cannot be polled, nor nested */
+	errno = EOPNOTSUPP;
+	return -1;
+}
+
+static const struct fd_op_vtable zvfs_epoll_fd_vtable = {
+	.close = zvfs_epoll_close_op,
+	.ioctl = zvfs_epoll_ioctl_op,
+};
+
+static int zvfs_epoll_init(void)
+{
+	const struct k_work_queue_config cfg = {.name = "zvfs_epoll"};
+
+	for (int i = 0; i < ARRAY_SIZE(epolls); i++) {
+		k_mutex_init(&epolls[i].lock);
+		k_condvar_init(&epolls[i].cond);
+	}
+
+	k_work_queue_init(&zvfs_epoll_workq);
+	k_work_queue_start(&zvfs_epoll_workq, zvfs_epoll_workq_stack,
+			   K_KERNEL_STACK_SIZEOF(zvfs_epoll_workq_stack),
+			   CONFIG_ZVFS_EPOLL_WORKQUEUE_PRIORITY, &cfg);
+
+	return 0;
+}
+
+SYS_INIT(zvfs_epoll_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+/*
+ * Public-facing API
+ */
+
+int zvfs_epoll_create(int flags)
+{
+	struct zvfs_epoll *ep;
+	size_t offset;
+	int fd;
+
+	if ((flags & ~ZVFS_EPOLL_CLOEXEC) != 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (sys_bitarray_alloc(&epolls_bitarray, 1, &offset) < 0) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	ep = &epolls[offset];
+
+	fd = zvfs_reserve_fd();
+	if (fd < 0) {
+		sys_bitarray_free(&epolls_bitarray, 1, offset);
+		return -1;
+	}
+
+	(void)k_mutex_lock(&ep->lock, K_FOREVER);
+
+	sys_slist_init(&ep->ready);
+	sys_slist_init(&ep->edge);
+	k_poll_signal_init(&ep->wake);
+	k_poll_event_init(&ep->wake_event, K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY,
+			  &ep->wake);
+	k_work_init(&ep->flush, zvfs_epoll_flushed);
+
+	for (int i = 0; i < ARRAY_SIZE(ep->entries); i++) {
+		ep->entries[i].flags = 0;
+	}
+
+	ep->users = 0;
+	ep->waiting = false;
+	ep->in_use = true;
+
+	k_mutex_unlock(&ep->lock);
+
+	zvfs_finalize_fd(fd, ep, &zvfs_epoll_fd_vtable);
+
+	return fd;
+}
+
+int zvfs_epoll_ctl(int epfd, int op, int fd, struct zvfs_epoll_event *event)
+{
+	struct zvfs_epoll_entry *entry;
+	struct zvfs_epoll *ep;
+	const struct fd_op_vtable *vtable;
+	void *obj;
+	int ret = 0;
+
+	ep = zvfs_get_fd_obj(epfd, &zvfs_epoll_fd_vtable, EINVAL);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	obj = zvfs_get_fd_obj_and_vtable(fd, &vtable, NULL);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (fd == epfd || vtable == &zvfs_epoll_fd_vtable) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (op != ZVFS_EPOLL_CTL_DEL) {
+		if (event == NULL) {
+			errno = EFAULT;
+			return -1;
+		}
+
+		if ((event->events & ~ZVFS_EPOLL_EVENTS_SET) != 0) {
+			errno = EINVAL;
+			return -1;
+		}
+	}
+
+	(void)k_mutex_lock(&ep->lock, K_FOREVER);
+
+	entry = zvfs_epoll_find(ep, fd);
+	if (entry != NULL && entry->obj != obj) {
+		/* Left behind by a file descriptor closed without zvfs_close() */
+		zvfs_epoll_remove(ep, entry);
+		entry = NULL;
+	}
+
+	switch (op) {
+	case ZVFS_EPOLL_CTL_ADD:
+		if (entry != NULL) {
+			ret = -EEXIST;
+			break;
+		}
+
+		entry = zvfs_epoll_alloc(ep);
+		if (entry == NULL) {
+			ret = -ENOMEM;
+			break;
+		}
+
+		entry->ep = ep;
+		entry->fd = fd;
+		entry->obj = obj;
+		entry->events = event->events;
+		entry->data = event->data;
+		entry->flags = ZVFS_EPOLL_ENTRY_USED;
+		k_work_poll_init(&entry->work, zvfs_epoll_fired);
+
+		/* Fail early for file descriptors which cannot be polled */
+		ret = zvfs_epoll_arm(ep, entry);
+		if (ret < 0) {
+			entry->flags = 0;
+		}
+		break;
+
+	case ZVFS_EPOLL_CTL_MOD:
+		if (entry == NULL) {
+			ret = -ENOENT;
+			break;
+		}
+
+		zvfs_epoll_disarm(ep, entry);
+		entry->events = event->events;
+		entry->data = event->data;
+
+		ret = zvfs_epoll_arm(ep, entry);
+		if (ret < 0) {
+			entry->flags = 0;
+		}
+		break;
+
+	case ZVFS_EPOLL_CTL_DEL:
+		if (entry == NULL) {
+			ret = -ENOENT;
+			break;
+		}
+
+		zvfs_epoll_remove(ep, entry);
+		break;
+
+	default:
+		ret = -EINVAL;
+		break;
+	}
+
+	k_mutex_unlock(&ep->lock);
+
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	return 0;
+}
+
+int zvfs_epoll_wait(int epfd, struct zvfs_epoll_event *events, int maxevents, int timeout)
+{
+	struct zvfs_epoll *ep;
+	k_timepoint_t end;
+	bool unused;
+	int ret;
+
+	if (k_is_in_isr()) {
+		errno = EWOULDBLOCK;
+		return -1;
+	}
+
+	ep = zvfs_get_fd_obj(epfd, &zvfs_epoll_fd_vtable, EINVAL);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	if (events == NULL || maxevents <= 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	end = sys_timepoint_calc(timeout < 0 ? K_FOREVER : K_MSEC(timeout));
+
+	(void)k_mutex_lock(&ep->lock, K_FOREVER);
+	ep->users++;
+	ret = zvfs_epoll_wait_locked(ep, events, maxevents, end);
+	ep->users--;
+	unused = zvfs_epoll_unused(ep);
+	k_mutex_unlock(&ep->lock);
+
+	if (unused) {
+		zvfs_epoll_free(ep);
+	}
+
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	return ret;
+}
+
+void zvfs_epoll_release(int fd, void *obj)
+{
+	struct zvfs_epoll_entry *entry;
+
+	for (int i = 0; i < ARRAY_SIZE(epolls); i++) {
+		struct zvfs_epoll *ep = &epolls[i];
+
+		(void)k_mutex_lock(&ep->lock, K_FOREVER);
+
+		entry = ep->in_use ? zvfs_epoll_find(ep, fd) : NULL;
+		if (entry != NULL && entry->obj == obj) {
+			zvfs_epoll_remove(ep, entry);
+		}
+
+		k_mutex_unlock(&ep->lock);
+	}
+}
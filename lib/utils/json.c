@@ -90,12 +90,49 @@ static int peek(struct json_lexer *lex)
 	return chr;
 }
 
+/* Strings are scanned a word at a time: a byte of a word is equal to c when
+ * the same byte of word ^ (c * ones) is zero.
+ */
+typedef unsigned long json_word_t;
+
+#define JSON_WORD_ONES ((json_word_t)-1 / 0xff)
+#define JSON_WORD_HAS_ZERO(word) \
+	(((word) - JSON_WORD_ONES) & ~(word) & (JSON_WORD_ONES * 0x80))
+#define JSON_WORD_HAS_BYTE(word, c) JSON_WORD_HAS_ZERO((word) ^ (JSON_WORD_ONES * (c)))
+
+/* Find the next quote, backslash or null character of a string */
+static const char *string_scan(const char *pos, const char *end)
+{
+	while ((size_t)(end - pos) >= sizeof(json_word_t)) {
+		json_word_t word;
+
+		memcpy(&word, pos, sizeof(word));
+		if (JSON_WORD_HAS_BYTE(word, '"') || JSON_WORD_HAS_BYTE(word, '\\') ||
+		    JSON_WORD_HAS_ZERO(word)) {
+			break;
+		}
+
+		pos += sizeof(word);
+	}
+
+	while (pos < end && *pos != '"' && *pos != '\\' && *pos != '\0') {
+		pos++;
+	}
+
+	return pos;
+}
+
 static void *lexer_string(struct json_lexer *lex)
 {
 	ignore(lex);
 
 	while (true) {
-		int chr = next(lex);
+		int chr;
+
+		/* Skip the characters with no special meaning */
+		lex->pos = (char *)string_scan(lex->pos, lex->end);
+
+		chr = next(lex);
 
 		if (chr == '\0') {
 			emit(lex, JSON_TOK_ERROR);
@@ -1268,6 +1305,610 @@ int json_arr_separate_parse_object(struct json_obj *json, const struct json_obj_
 	return obj_parse(json, descr, descr_len, val);
 }
 
+#ifdef CONFIG_JSON_PUSH_PARSER
+
+/* Syntax element expected next by the incremental parser */
+enum {
+	PUSH_EXPECT_OBJECT,
+	PUSH_EXPECT_KEY_OR_END,
+	PUSH_EXPECT_KEY,
+	PUSH_EXPECT_COLON,
+	PUSH_EXPECT_VALUE,
+	PUSH_EXPECT_VALUE_OR_END,
+	PUSH_EXPECT_COMMA_OR_END,
+	PUSH_EXPECT_NOTHING,
+};
+
+/* Token being lexed by the incremental parser */
+enum {
+	PUSH_LEX_NONE,
+	PUSH_LEX_STRING,
+	PUSH_LEX_BARE,
+};
+
+/* Literals a bare token may be, matched as they are lexed if not stored */
+static const char *const push_literals[] = {
+	"true", "false", "null", "NaN", "Infinity", "-Infinity",
+};
+
+enum {
+	PUSH_LIT_TRUE,
+	PUSH_LIT_FALSE,
+	PUSH_LIT_NULL,
+	PUSH_LIT_NAN,
+	PUSH_LIT_INFINITY,
+	PUSH_LIT_NEG_INFINITY,
+};
+
+static struct json_push_frame *push_top(struct json_push_parser *parser)
+{
+	return &parser->frames[parser->depth];
+}
+
+/* Find where the value starting now is decoded to, descr is NULL if it is skipped */
+static int push_value_target(struct json_push_parser *parser,
+			     const struct json_obj_descr **descr, void **field, void **val)
+{
+	struct json_push_frame *frame = push_top(parser);
+
+	*descr = NULL;
+	*field = NULL;
+	*val = NULL;
+
+	if (frame->descr == NULL) {
+		return 0;
+	}
+
+	if (frame->array) {
+		if (*frame->count == frame->descr_len) {
+			return -ENOSPC;
+		}
+
+		*descr = frame->descr;
+		*field = (char *)frame->val + frame->elem_size * *frame->count;
+		*val = *field;
+	} else if (frame->field >= 0) {
+		*descr = &frame->descr[frame->field];
+		*field = (char *)frame->val + (*descr)->offset;
+		*val = frame->val;
+	}
+
+	return 0;
+}
+
+static void push_value_done(struct json_push_parser *parser)
+{
+	struct json_push_frame *frame = push_top(parser);
+
+	parser->state = PUSH_EXPECT_COMMA_OR_END;
+
+	if (frame->descr == NULL) {
+		return;
+	}
+
+	if (frame->array) {
+		(*frame->count)++;
+	} else if (frame->field >= 0) {
+		frame->decoded |= (int64_t)1 << frame->field;
+	}
+}
+
+static int push_open(struct json_push_parser *parser, bool array)
+{
+	enum json_tokens type = array ? JSON_TOK_ARRAY_START : JSON_TOK_OBJECT_START;
+	const struct json_obj_descr *descr;
+	const struct json_obj_descr *elem_descr;
+	struct json_push_frame *frame;
+	void *field;
+	void *val;
+	int ret;
+
+	ret = push_value_target(parser, &descr, &field, &val);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (descr != NULL && descr->type != type) {
+		/* The types referring to the raw JSON data are not supported */
+		return equivalent_types(type, descr->type) ? -ENOTSUP : -EINVAL;
+	}
+
+	if ((size_t)parser->depth + 1 >= ARRAY_SIZE(parser->frames)) {
+		return -ENOSPC;
+	}
+
+	frame = &parser->frames[++parser->depth];
+	frame->descr = NULL;
+	frame->decoded = 0;
+	frame->field = -1;
+	frame->array = array;
+
+	parser->state = array ? PUSH_EXPECT_VALUE_OR_END : PUSH_EXPECT_KEY_OR_END;
+
+	if (descr == NULL) {
+		return 0;
+	}
+
+	if (!array) {
+		frame->descr = descr->object.sub_descr;
+		frame->descr_len = descr->object.sub_descr_len;
+		frame->val = field;
+
+		return 0;
+	}
+
+	/* Same layout as for arr_parse() */
+	elem_descr = descr->array.element_descr;
+	frame->count = (size_t *)((char *)val + elem_descr->offset);
+	if (elem_descr->type == JSON_TOK_ARRAY_START) {
+		elem_descr = elem_descr->array.element_descr;
+	}
+
+	frame->descr = elem_descr;
+	frame->descr_len = descr->array.n_elements;
+	frame->val = field;
+	frame->elem_size = get_elem_size(elem_descr);
+	*frame->count = 0;
+
+	__ASSERT_NO_MSG(frame->elem_size > 0);
+
+	return 0;
+}
+
+static int push_close(struct json_push_parser *parser, bool array)
+{
+	if (push_top(parser)->array != array) {
+		return -EINVAL;
+	}
+
+	if (parser->depth == 0) {
+		parser->decoded = parser->frames[0].decoded;
+		parser->state = PUSH_EXPECT_NOTHING;
+
+		return 0;
+	}
+
+	parser->depth--;
+	push_value_done(parser);
+
+	return 0;
+}
+
+static int push_key(struct json_push_parser *parser)
+{
+	struct json_push_frame *frame = push_top(parser);
+	const char *key = parser->buf + parser->buf_used;
+	size_t room = parser->buf_size - MIN(parser->buf_used, parser->buf_size);
+
+	frame->field = -1;
+
+	if (frame->descr == NULL) {
+		return 0;
+	}
+
+	for (size_t i = 0; i < frame->descr_len; i++) {
+		/* Field has been decoded already, skip */
+		if (frame->decoded & ((int64_t)1 << i)) {
+			continue;
+		}
+
+		if (parser->tok_truncated) {
+			/* A truncated key only rules out the names it is longer than */
+			if (frame->descr[i].field_name_len >= room) {
+				return -ENOSPC;
+			}
+
+			continue;
+		}
+
+		if (parser->tok_len == frame->descr[i].field_name_len &&
+		    memcmp(key, frame->descr[i].field_name, parser->tok_len) == 0) {
+			frame->field = i;
+			return 0;
+		}
+	}
+
+	return 0;
+}
+
+static int push_scalar(struct json_push_parser *parser, enum json_tokens type)
+{
+	const struct json_obj_descr *descr;
+	struct json_token token;
+	void *field;
+	void *val;
+	int64_t ret;
+
+	ret = push_value_target(parser, &descr, &field, &val);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (descr != NULL) {
+		if (parser->tok_truncated) {
+			return -ENOSPC;
+		}
+
+		token.type = type;
+		token.start = parser->buf + parser->buf_used;
+		token.end = token.start + parser->tok_len;
+
+		ret = decode_value(NULL, descr, &token, field, val);
+		if (ret < 0) {
+			return ret;
+		}
+
+		/* The decoded value points to the token, keep it */
+		if (descr->type == JSON_TOK_STRING || descr->type == JSON_TOK_OPAQUE ||
+		    descr->type == JSON_TOK_FLOAT) {
+			parser->buf_used += parser->tok_len + 1;
+		}
+	}
+
+	push_value_done(parser);
+
+	return 0;
+}
+
+static void push_tok_start(struct json_push_parser *parser, uint8_t lex, bool store)
+{
+	parser->lex = lex;
+	parser->tok_len = 0;
+	parser->tok_store = store;
+	parser->lit_match = BIT_MASK(ARRAY_SIZE(push_literals));
+	/* No room left by the decoded strings */
+	parser->tok_truncated = store && parser->buf_used >= parser->buf_size;
+}
+
+static void push_tok_append(struct json_push_parser *parser, const char *data, size_t len)
+{
+	if (!parser->tok_store || parser->tok_truncated) {
+		return;
+	}
+
+	/* Leave room for the null character written by the decoding */
+	if (parser->buf_used + parser->tok_len + len >= parser->buf_size) {
+		parser->tok_truncated = true;
+		return;
+	}
+
+	memcpy(parser->buf + parser->buf_used + parser->tok_len, data, len);
+	parser->tok_len += len;
+}
+
+static int push_string_done(struct json_push_parser *parser)
+{
+	parser->lex = PUSH_LEX_NONE;
+
+	if (parser->tok_key) {
+		parser->state = PUSH_EXPECT_COLON;
+
+		return push_key(parser);
+	}
+
+	return push_scalar(parser, JSON_TOK_STRING);
+}
+
+static int push_lex_string(struct json_push_parser *parser, const char **pos, const char *end)
+{
+	while (*pos < end) {
+		const char *run_end;
+		char chr;
+
+		if (parser->escape || parser->hex_left > 0) {
+			chr = **pos;
+
+			if (parser->hex_left > 0) {
+				if (isxdigit((unsigned char)chr) == 0) {
+					return -EINVAL;
+				}
+
+				parser->hex_left--;
+			} else {
+				if (chr == '\0' || strchr("\"\\/bfnrtu", chr) == NULL) {
+					return -EINVAL;
+				}
+
+				parser->escape = false;
+				parser->hex_left = (chr == 'u') ? 4 : 0;
+			}
+
+			push_tok_append(parser, (*pos)++, 1);
+			continue;
+		}
+
+		run_end = string_scan(*pos, end);
+		push_tok_append(parser, *pos, run_end - *pos);
+		*pos = run_end;
+
+		if (*pos == end) {
+			break;
+		}
+
+		switch (*(*pos)++) {
+		case '"':
+			return push_string_done(parser);
+		case '\\':
+			parser->escape = true;
+			push_tok_append(parser, run_end, 1);
+			break;
+		default:
+			return -EINVAL;
+		}
+	}
+
+	return 0;
+}
+
+static bool push_bare_char(char chr)
+{
+	return isalnum((unsigned char)chr) != 0 || chr == '.' || chr == '+' || chr == '-';
+}
+
+static bool push_number_char(char chr)
+{
+	return isdigit((unsigned char)chr) != 0 || chr == '.' || chr == 'e' || chr == 'E' ||
+	       chr == '+' || chr == '-';
+}
+
+/* Bare tokens of skipped values are only matched against the literals */
+static void push_bare_append(struct json_push_parser *parser, const char *data, size_t len)
+{
+	if (parser->tok_store) {
+		push_tok_append(parser, data, len);
+		return;
+	}
+
+	ARRAY_FOR_EACH(push_literals, i) {
+		const char *lit = push_literals[i];
+
+		if (parser->tok_len + len > strlen(lit) ||
+		    memcmp(lit + parser->tok_len, data, len) != 0) {
+			parser->lit_match &= ~BIT(i);
+		}
+	}
+
+	parser->tok_len += len;
+}
+
+static bool push_tok_equal(struct json_push_parser *parser, int lit)
+{
+	if (parser->tok_len != strlen(push_literals[lit])) {
+		return false;
+	}
+
+	if (!parser->tok_store) {
+		return (parser->lit_match & BIT(lit)) != 0;
+	}
+
+	return !parser->tok_truncated &&
+	       memcmp(parser->buf + parser->buf_used, push_literals[lit], parser->tok_len) == 0;
+}
+
+/* Numbers and literals */
+static int push_bare_done(struct json_push_parser *parser)
+{
+	enum json_tokens type;
+
+	parser->lex = PUSH_LEX_NONE;
+
+	if (parser->tok_number) {
+		type = JSON_TOK_NUMBER;
+	} else if (push_tok_equal(parser, PUSH_LIT_TRUE)) {
+		type = JSON_TOK_TRUE;
+	} else if (push_tok_equal(parser, PUSH_LIT_FALSE)) {
+		type = JSON_TOK_FALSE;
+	} else if (push_tok_equal(parser, PUSH_LIT_NULL)) {
+		type = JSON_TOK_NULL;
+	} else if (IS_ENABLED(CONFIG_JSON_LIBRARY_FP_SUPPORT) &&
+		   (push_tok_equal(parser, PUSH_LIT_NAN) ||
+		    push_tok_equal(parser, PUSH_LIT_INFINITY) ||
+		    push_tok_equal(parser, PUSH_LIT_NEG_INFINITY))) {
+		type = JSON_TOK_NUMBER;
+	} else if (parser->tok_truncated) {
+		return -ENOSPC;
+	} else {
+		return -EINVAL;
+	}
+
+	return push_scalar(parser, type);
+}
+
+static int push_lex_bare(struct json_push_parser *parser, const char **pos, const char *end)
+{
+	const char *run_end = *pos;
+
+	while (run_end < end && push_bare_char(*run_end)) {
+		if (!push_number_char(*run_end)) {
+			parser->tok_number = false;
+		}
+
+		run_end++;
+	}
+
+	push_bare_append(parser, *pos, run_end - *pos);
+	*pos = run_end;
+
+	if (*pos == end) {
+		return 0;
+	}
+
+	/* The delimiter is parsed next */
+	return push_bare_done(parser);
+}
+
+static int push_value_start(struct json_push_parser *parser, char chr)
+{
+	const struct json_obj_descr *descr;
+	void *field;
+	void *val;
+	int ret;
+
+	switch (chr) {
+	case '{':
+		return push_open(parser, false);
+	case '[':
+		return push_open(parser, true);
+	case '"':
+		ret = push_value_target(parser, &descr, &field, &val);
+		if (ret < 0) {
+			return ret;
+		}
+
+		/* The strings of skipped values are not copied */
+		parser->tok_key = false;
+		parser->escape = false;
+		parser->hex_left = 0;
+		push_tok_start(parser, PUSH_LEX_STRING, descr != NULL);
+
+		return 0;
+	default:
+		if (!push_bare_char(chr)) {
+			return -EINVAL;
+		}
+
+		ret = push_value_target(parser, &descr, &field, &val);
+		if (ret < 0) {
+			return ret;
+		}
+
+		parser->tok_number = isdigit((unsigned char)chr) != 0 || chr == '-';
+		push_tok_start(parser, PUSH_LEX_BARE, descr != NULL);
+		push_bare_append(parser, &chr, 1);
+
+		return 0;
+	}
+}
+
+static int push_structural(struct json_push_parser *parser, char chr)
+{
+	if (isspace((unsigned char)chr) != 0) {
+		return 0;
+	}
+
+	switch (parser->state) {
+	case PUSH_EXPECT_OBJECT:
+		if (chr != '{') {
+			return -EINVAL;
+		}
+
+		parser->state = PUSH_EXPECT_KEY_OR_END;
+
+		return 0;
+	case PUSH_EXPECT_KEY_OR_END:
+		if (chr == '}') {
+			return push_close(parser, false);
+		}
+
+		__fallthrough;
+	case PUSH_EXPECT_KEY:
+		if (chr != '"') {
+			return -EINVAL;
+		}
+
+		parser->tok_key = true;
+		parser->escape = false;
+		parser->hex_left = 0;
+		push_tok_start(parser, PUSH_LEX_STRING, true);
+
+		return 0;
+	case PUSH_EXPECT_COLON:
+		if (chr != ':') {
+			return -EINVAL;
+		}
+
+		parser->state = PUSH_EXPECT_VALUE;
+
+		return 0;
+	case PUSH_EXPECT_VALUE_OR_END:
+		if (chr == ']') {
+			return push_close(parser, true);
+		}
+
+		__fallthrough;
+	case PUSH_EXPECT_VALUE:
+		return push_value_start(parser, chr);
+	case PUSH_EXPECT_COMMA_OR_END:
+		if (chr == ',') {
+			parser->state = push_top(parser)->array ? PUSH_EXPECT_VALUE :
+								  PUSH_EXPECT_KEY;
+			return 0;
+		}
+
+		if (chr == '}' || chr == ']') {
+			return push_close(parser, chr == ']');
+		}
+
+		return -EINVAL;
+	default:
+		/* Data after the object is ignored, as by json_obj_parse() */
+		return 0;
+	}
+}
+
+int json_push_parser_init(struct json_push_parser *parser, const struct json_obj_descr *descr,
+			  size_t descr_len, void *val, char *buf, size_t buf_size)
+{
+	__ASSERT_NO_MSG(descr_len < (sizeof(int64_t) * CHAR_BIT - 1));
+
+	if (buf == NULL || buf_size < 2) {
+		return -EINVAL;
+	}
+
+	memset(parser, 0, sizeof(*parser));
+
+	parser->frames[0].descr = descr;
+	parser->frames[0].descr_len = descr_len;
+	parser->frames[0].val = val;
+	parser->frames[0].field = -1;
+	parser->buf = buf;
+	parser->buf_size = buf_size;
+	parser->state = PUSH_EXPECT_OBJECT;
+	parser->lex = PUSH_LEX_NONE;
+
+	return 0;
+}
+
+int json_push_parser_feed(struct json_push_parser *parser, const char *data, size_t len)
+{
+	const char *pos = data;
+	const char *end = data + len;
+	int ret = parser->error;
+
+	while (pos < end && ret == 0) {
+		switch (parser->lex) {
+		case PUSH_LEX_STRING:
+			ret = push_lex_string(parser, &pos, end);
+			break;
+		case PUSH_LEX_BARE:
+			ret = push_lex_bare(parser, &pos, end);
+			break;
+		default:
+			ret = push_structural(parser, *pos++);
+			break;
+		}
+	}
+
+	parser->error = ret;
+
+	return ret;
+}
+
+int64_t json_push_parser_finish(struct json_push_parser *parser)
+{
+	if (parser->error < 0) {
+		return parser->error;
+	}
+
+	if (parser->state != PUSH_EXPECT_NOTHING) {
+		return -EINVAL;
+	}
+
+	return parser->decoded;
+}
+
+#endif /* CONFIG_JSON_PUSH_PARSER */
+
 static char escape_as(char chr)
 {
 	switch (chr) {
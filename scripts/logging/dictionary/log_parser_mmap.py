@@ -0,0 +1,124 @@
+#!/usr/bin/env python3
+#
+# Copyright The Zephyr Project Contributors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Log Parser for Dictionary-based Logging
+
+This uses the JSON database file to decode the ring file written
+by the memory-mapped log backend of the native simulator
+(CONFIG_LOG_BACKEND_NATIVE_MMAP) and print the log messages.
+"""
+
+import argparse
+import logging
+import struct
+import sys
+
+import parserlib
+
+LOGGER_FORMAT = "%(message)s"
+logger = logging.getLogger("parser")
+
+LOG_MMAP_MAGIC = b"ZLOGMMAP"
+LOG_MMAP_VERSION = 1
+
+# Keep in sync with struct log_mmap_hdr in log_backend_native_mmap.c,
+# native simulator hosts are little endian.
+LOG_MMAP_HDR_FMT = "<8sIIQQII"
+LOG_MMAP_FRAME_HDR_FMT = "<H"
+
+
+def parse_args():
+    """Parse command line arguments"""
+    argparser = argparse.ArgumentParser(allow_abbrev=False)
+
+    argparser.add_argument("dbfile", help="Dictionary Logging Database file")
+    argparser.add_argument("mmapfile", help="Ring file written by the native simulator")
+    argparser.add_argument("--debug", action="store_true", help="Print extra debugging information")
+
+    return argparser.parse_args()
+
+
+def read_ring(mmapfile):
+    """
+    Read the ring file and return the dictionary-based log data of the
+    frames it holds, oldest first
+    """
+    with open(mmapfile, "rb") as f:
+        filedata = f.read()
+
+    hdr_size = struct.calcsize(LOG_MMAP_HDR_FMT)
+    if len(filedata) < hdr_size:
+        logger.error("ERROR: %s is too short to be a log ring file, exiting...", mmapfile)
+        sys.exit(1)
+
+    magic, version, size, head, tail, overwritten, discarded = struct.unpack_from(
+        LOG_MMAP_HDR_FMT, filedata
+    )
+
+    if magic != LOG_MMAP_MAGIC or version != LOG_MMAP_VERSION:
+        logger.error("ERROR: %s is not a log ring file (version %d), exiting...",
+                     mmapfile, LOG_MMAP_VERSION)
+        sys.exit(1)
+
+    ring = filedata[hdr_size:hdr_size + size]
+    if len(ring) != size or head < tail or head - tail > size:
+        logger.error("ERROR: %s is corrupted, exiting...", mmapfile)
+        sys.exit(1)
+
+    logger.debug("Ring of %d bytes, %d frames overwritten, %d frames discarded",
+                 size, overwritten, discarded)
+    if overwritten > 0:
+        logger.info("--- %d oldest messages were overwritten ---", overwritten)
+
+    # Unroll the ring, from the oldest frame to the newest one
+    start = tail % size
+    used = head - tail
+    data = ring[start:start + used]
+    data += ring[:used - len(data)]
+
+    frame_hdr_size = struct.calcsize(LOG_MMAP_FRAME_HDR_FMT)
+    logdata = bytearray()
+    offset = 0
+
+    while offset < used:
+        (frame_len,) = struct.unpack_from(LOG_MMAP_FRAME_HDR_FMT, data, offset)
+        offset += frame_hdr_size
+        logdata += data[offset:offset + frame_len]
+        offset += frame_len
+
+    if offset != used:
+        logger.error("ERROR: last frame of %s is truncated", mmapfile)
+
+    return bytes(logdata)
+
+
+def main():
+    """Main function of log parser"""
+    args = parse_args()
+
+    # Setup logging for parser
+    logging.basicConfig(format=LOGGER_FORMAT)
+    if args.debug:
+        logger.setLevel(logging.DEBUG)
+    else:
+        logger.setLevel(logging.INFO)
+
+    log_parser = parserlib.get_log_parser(args.dbfile, logger)
+
+    logdata = read_ring(args.mmapfile)
+
+    parsed_data_offset = parserlib.parser(logdata, log_parser, logger)
+    if parsed_data_offset != len(logdata):
+        logger.error(
+            'ERROR: Not all data was parsed, %d bytes left unparsed',
+            len(logdata) - parsed_data_offset,
+        )
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
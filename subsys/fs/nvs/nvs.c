@@ -19,9 +19,9 @@ LOG_MODULE_REGISTER(fs_nvs, CONFIG_NVS_LOG_LEVEL);
 static int nvs_prev_ate(struct nvs_fs *fs, uint32_t *addr, struct nvs_ate *ate);
 static int nvs_ate_valid(struct nvs_fs *fs, const struct nvs_ate *entry);
 
-#ifdef CONFIG_NVS_LOOKUP_CACHE
+#if defined(CONFIG_NVS_LOOKUP_CACHE) || defined(CONFIG_NVS_ATE_INDEX)
 
-static inline size_t nvs_lookup_cache_pos(uint16_t id)
+static inline uint16_t nvs_id_hash(uint16_t id)
 {
 	uint16_t hash;
 
@@ -33,7 +33,16 @@ static inline size_t nvs_lookup_cache_pos(uint16_t id)
 	hash *= 0xdb2dU;
 	hash ^= hash >> 9;
 
-	return hash % CONFIG_NVS_LOOKUP_CACHE_SIZE;
+	return hash;
+}
+
+#endif
+
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+
+static inline size_t nvs_lookup_cache_pos(uint16_t id)
+{
+	return nvs_id_hash(id) % CONFIG_NVS_LOOKUP_CACHE_SIZE;
 }
 
 static int nvs_lookup_cache_rebuild(struct nvs_fs *fs)
@@ -84,6 +93,180 @@ static void nvs_lookup_cache_invalidate(struct nvs_fs *fs, uint32_t sector)
 
 #endif /* CONFIG_NVS_LOOKUP_CACHE */
 
+#ifdef CONFIG_NVS_ATE_INDEX
+
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_NVS_ATE_INDEX_SIZE),
+	     "CONFIG_NVS_ATE_INDEX_SIZE is not power of 2");
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_NVS_ATE_INDEX_BLOOM_BITS),
+	     "CONFIG_NVS_ATE_INDEX_BLOOM_BITS is not power of 2");
+
+#define NVS_ATE_INDEX_MASK (CONFIG_NVS_ATE_INDEX_SIZE - 1U)
+/* Keep free entries so that looking up a missing ID stops early */
+#define NVS_ATE_INDEX_MAX_COUNT (CONFIG_NVS_ATE_INDEX_SIZE / 4U * 3U)
+
+static inline uint32_t nvs_ate_index_bloom_bit(uint16_t id, bool second)
+{
+	/* The second bit comes from a multiplicative hash, independent of nvs_id_hash() */
+	uint32_t hash = second ? (((uint32_t)id * 0x9e3779b1U) >> 16) : nvs_id_hash(id);
+
+	return hash & (CONFIG_NVS_ATE_INDEX_BLOOM_BITS - 1U);
+}
+
+static inline void nvs_ate_index_bloom_add(struct nvs_fs *fs, uint16_t id)
+{
+	for (int i = 0; i < 2; i++) {
+		uint32_t bit = nvs_ate_index_bloom_bit(id, i);
+
+		fs->ate_index_bloom[bit / 32U] |= BIT(bit % 32U);
+	}
+}
+
+static inline bool nvs_ate_index_bloom_test(struct nvs_fs *fs, uint16_t id)
+{
+	for (int i = 0; i < 2; i++) {
+		uint32_t bit = nvs_ate_index_bloom_bit(id, i);
+
+		if ((fs->ate_index_bloom[bit / 32U] & BIT(bit % 32U)) == 0U) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/* Return the entry holding id, or the free entry where it goes */
+static size_t nvs_ate_index_pos(struct nvs_fs *fs, uint16_t id)
+{
+	size_t pos = nvs_id_hash(id) & NVS_ATE_INDEX_MASK;
+
+	while (fs->ate_index_addr[pos] != NVS_LOOKUP_CACHE_NO_ADDR &&
+	       fs->ate_index_id[pos] != id) {
+		pos = (pos + 1U) & NVS_ATE_INDEX_MASK;
+	}
+
+	return pos;
+}
+
+static void nvs_ate_index_clear(struct nvs_fs *fs)
+{
+	memset(fs->ate_index_addr, 0xff, sizeof(fs->ate_index_addr));
+	memset(fs->ate_index_bloom, 0, sizeof(fs->ate_index_bloom));
+	fs->ate_index_count = 0U;
+	fs->ate_index_full = false;
+}
+
+static void nvs_ate_index_set(struct nvs_fs *fs, uint16_t id, uint32_t addr)
+{
+	size_t pos = nvs_ate_index_pos(fs, id);
+
+	nvs_ate_index_bloom_add(fs, id);
+
+	if (fs->ate_index_addr[pos] == NVS_LOOKUP_CACHE_NO_ADDR) {
+		if (fs->ate_index_count == NVS_ATE_INDEX_MAX_COUNT) {
+			fs->ate_index_full = true;
+			return;
+		}
+
+		fs->ate_index_id[pos] = id;
+		fs->ate_index_count++;
+	}
+
+	fs->ate_index_addr[pos] = addr;
+}
+
+/* Return the address to start searching id from, NVS_LOOKUP_CACHE_NO_ADDR if not stored */
+static uint32_t nvs_ate_index_get(struct nvs_fs *fs, uint16_t id)
+{
+	size_t pos;
+
+	if (!nvs_ate_index_bloom_test(fs, id)) {
+		return NVS_LOOKUP_CACHE_NO_ADDR;
+	}
+
+	pos = nvs_ate_index_pos(fs, id);
+	if (fs->ate_index_addr[pos] != NVS_LOOKUP_CACHE_NO_ADDR) {
+		return fs->ate_index_addr[pos];
+	}
+
+	/* IDs left out of a full index are searched through all the ATEs */
+	return fs->ate_index_full ? fs->ate_wra : NVS_LOOKUP_CACHE_NO_ADDR;
+}
+
+/* Free the entry at pos, moving back the entries that were displaced past it */
+static void nvs_ate_index_remove(struct nvs_fs *fs, size_t pos)
+{
+	size_t next = pos;
+	size_t home;
+
+	while (true) {
+		next = (next + 1U) & NVS_ATE_INDEX_MASK;
+		if (fs->ate_index_addr[next] == NVS_LOOKUP_CACHE_NO_ADDR) {
+			break;
+		}
+
+		home = nvs_id_hash(fs->ate_index_id[next]) & NVS_ATE_INDEX_MASK;
+		if (((next - home) & NVS_ATE_INDEX_MASK) >= ((next - pos) & NVS_ATE_INDEX_MASK)) {
+			fs->ate_index_id[pos] = fs->ate_index_id[next];
+			fs->ate_index_addr[pos] = fs->ate_index_addr[next];
+			pos = next;
+		}
+	}
+
+	fs->ate_index_addr[pos] = NVS_LOOKUP_CACHE_NO_ADDR;
+	fs->ate_index_count--;
+}
+
+static int nvs_ate_index_rebuild(struct nvs_fs *fs)
+{
+	int rc;
+	uint32_t addr, ate_addr;
+	struct nvs_ate ate;
+
+	nvs_ate_index_clear(fs);
+	addr = fs->ate_wra;
+
+	while (true) {
+		/* Make a copy of 'addr' as it will be advanced by nvs_prev_ate() */
+		ate_addr = addr;
+		rc = nvs_prev_ate(fs, &addr, &ate);
+
+		if (rc) {
+			return rc;
+		}
+
+		/* The first ATE found for an ID is the most recent one */
+		if (ate.id != 0xFFFF &&
+		    fs->ate_index_addr[nvs_ate_index_pos(fs, ate.id)] == NVS_LOOKUP_CACHE_NO_ADDR &&
+		    nvs_ate_valid(fs, &ate)) {
+			nvs_ate_index_set(fs, ate.id, ate_addr);
+		}
+
+		if (addr == fs->ate_wra) {
+			break;
+		}
+	}
+
+	return 0;
+}
+
+static void nvs_ate_index_invalidate(struct nvs_fs *fs, uint32_t sector)
+{
+	size_t pos = 0U;
+
+	while (pos < CONFIG_NVS_ATE_INDEX_SIZE) {
+		if (fs->ate_index_addr[pos] != NVS_LOOKUP_CACHE_NO_ADDR &&
+		    (fs->ate_index_addr[pos] >> ADDR_SECT_SHIFT) == sector) {
+			/* Another entry may be moved to pos, check it again */
+			nvs_ate_index_remove(fs, pos);
+			continue;
+		}
+
+		pos++;
+	}
+}
+
+#endif /* CONFIG_NVS_ATE_INDEX */
+
 /* basic routines */
 /* nvs_al_size returns size aligned to fs->write_block_size */
 static inline size_t nvs_al_size(struct nvs_fs *fs, size_t len)
@@ -168,6 +351,10 @@ static int nvs_flash_ate_wrt(struct nvs_fs *fs, const struct nvs_ate *entry)
 	if (entry->id != 0xFFFF) {
 		fs->lookup_cache[nvs_lookup_cache_pos(entry->id)] = fs->ate_wra;
 	}
+#elif defined(CONFIG_NVS_ATE_INDEX)
+	if (entry->id != 0xFFFF) {
+		nvs_ate_index_set(fs, entry->id, fs->ate_wra);
+	}
 #endif
 	fs->ate_wra -= nvs_al_size(fs, sizeof(struct nvs_ate));
 
@@ -343,6 +530,8 @@ static int nvs_flash_erase_sector(struct nvs_fs *fs, uint32_t addr)
 
 #ifdef CONFIG_NVS_LOOKUP_CACHE
 	nvs_lookup_cache_invalidate(fs, addr >> ADDR_SECT_SHIFT);
+#elif defined(CONFIG_NVS_ATE_INDEX)
+	nvs_ate_index_invalidate(fs, addr >> ADDR_SECT_SHIFT);
 #endif
 	rc = flash_flatten(fs->flash_device, offset, fs->sector_size);
 
@@ -676,6 +865,12 @@ static int nvs_gc(struct nvs_fs *fs)
 #ifdef CONFIG_NVS_LOOKUP_CACHE
 		wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(gc_ate.id)];
 
+		if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
+			wlk_addr = fs->ate_wra;
+		}
+#elif defined(CONFIG_NVS_ATE_INDEX)
+		wlk_addr = nvs_ate_index_get(fs, gc_ate.id);
+
 		if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
 			wlk_addr = fs->ate_wra;
 		}
@@ -926,6 +1121,9 @@ static int nvs_startup(struct nvs_fs *fs)
 		for (i = 0; i < CONFIG_NVS_LOOKUP_CACHE_SIZE; i++) {
 			fs->lookup_cache[i] = fs->ate_wra;
 		}
+#elif defined(CONFIG_NVS_ATE_INDEX)
+		/* Same for the index, the gc searches the IDs it does not hold from the end */
+		nvs_ate_index_clear(fs);
 #endif
 		rc = nvs_gc(fs);
 		goto end;
@@ -966,6 +1164,10 @@ end:
 	if (!rc) {
 		rc = nvs_lookup_cache_rebuild(fs);
 	}
+#elif defined(CONFIG_NVS_ATE_INDEX)
+	if (!rc) {
+		rc = nvs_ate_index_rebuild(fs);
+	}
 #endif
 	/* If the sector is empty add a gc done ate to avoid having insufficient
 	 * space when doing gc.
@@ -1100,6 +1302,12 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 #ifdef CONFIG_NVS_LOOKUP_CACHE
 	wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(id)];
 
+	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
+		goto no_cached_entry;
+	}
+#elif defined(CONFIG_NVS_ATE_INDEX)
+	wlk_addr = nvs_ate_index_get(fs, id);
+
 	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
 		goto no_cached_entry;
 	}
@@ -1123,7 +1331,7 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 		}
 	}
 
-#ifdef CONFIG_NVS_LOOKUP_CACHE
+#if defined(CONFIG_NVS_LOOKUP_CACHE) || defined(CONFIG_NVS_ATE_INDEX)
 no_cached_entry:
 #endif
 
@@ -1236,6 +1444,13 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
 #ifdef CONFIG_NVS_LOOKUP_CACHE
 	wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(id)];
 
+	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
+		rc = -ENOENT;
+		goto err;
+	}
+#elif defined(CONFIG_NVS_ATE_INDEX)
+	wlk_addr = nvs_ate_index_get(fs, id);
+
 	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
 		rc = -ENOENT;
 		goto err;
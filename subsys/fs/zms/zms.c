@@ -10,6 +10,7 @@
 #include <errno.h>
 #include <inttypes.h>
 #include <zephyr/fs/zms.h>
+#include <zephyr/init.h>
 #include <zephyr/sys/crc.h>
 #include "zms_priv.h"
 #ifdef CONFIG_ZMS_LOOKUP_CACHE_FOR_SETTINGS
@@ -27,6 +28,35 @@ static int zms_get_sector_header(struct zms_fs *fs, uint64_t addr, struct zms_at
 static int zms_ate_valid_different_sector(struct zms_fs *fs, const struct zms_ate *entry,
 					  uint8_t cycle_cnt);
 
+#if defined(CONFIG_ZMS_LOOKUP_CACHE) || defined(CONFIG_ZMS_ATE_INDEX)
+
+static inline zms_id_t zms_id_hash(zms_id_t id)
+{
+#ifdef CONFIG_ZMS_ID_64BIT
+	/* 64-bit integer hash function found by https://github.com/skeeto/hash-prospector. */
+	uint64_t hash = id;
+
+	hash ^= hash >> 32;
+	hash *= 0x42ab4abe4c475039ULL;
+	hash ^= hash >> 31;
+	hash *= 0xfa90c4424c537791ULL;
+	hash ^= hash >> 32;
+#else
+	/* 32-bit integer hash function found by https://github.com/skeeto/hash-prospector. */
+	uint32_t hash = id;
+
+	hash ^= hash >> 16;
+	hash *= 0x7feb352dU;
+	hash ^= hash >> 15;
+	hash *= 0x846ca68bU;
+	hash ^= hash >> 16;
+#endif /* CONFIG_ZMS_ID_64BIT */
+
+	return hash;
+}
+
+#endif
+
 #ifdef CONFIG_ZMS_LOOKUP_CACHE
 
 static inline size_t zms_lookup_cache_pos(zms_id_t id)
@@ -58,24 +88,8 @@ static inline size_t zms_lookup_cache_pos(zms_id_t id)
 
 	hash = (key_value_hash << 2) | (key_value_bit << 1) | key_value_ll;
 
-#elif defined(CONFIG_ZMS_ID_64BIT)
-	/* 64-bit integer hash function found by https://github.com/skeeto/hash-prospector. */
-	uint64_t hash = id;
-
-	hash ^= hash >> 32;
-	hash *= 0x42ab4abe4c475039ULL;
-	hash ^= hash >> 31;
-	hash *= 0xfa90c4424c537791ULL;
-	hash ^= hash >> 32;
 #else
-	/* 32-bit integer hash function found by https://github.com/skeeto/hash-prospector. */
-	uint32_t hash = id;
-
-	hash ^= hash >> 16;
-	hash *= 0x7feb352dU;
-	hash ^= hash >> 15;
-	hash *= 0x846ca68bU;
-	hash ^= hash >> 16;
+	zms_id_t hash = zms_id_hash(id);
 #endif /* CONFIG_ZMS_LOOKUP_CACHE_FOR_SETTINGS */
 
 	return hash % CONFIG_ZMS_LOOKUP_CACHE_SIZE;
@@ -147,6 +161,198 @@ static void zms_lookup_cache_invalidate(struct zms_fs *fs, uint32_t sector)
 
 #endif /* CONFIG_ZMS_LOOKUP_CACHE */
 
+#ifdef CONFIG_ZMS_ATE_INDEX
+
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_ZMS_ATE_INDEX_SIZE),
+	     "CONFIG_ZMS_ATE_INDEX_SIZE is not power of 2");
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_ZMS_ATE_INDEX_BLOOM_BITS),
+	     "CONFIG_ZMS_ATE_INDEX_BLOOM_BITS is not power of 2");
+
+#define ZMS_ATE_INDEX_MASK (CONFIG_ZMS_ATE_INDEX_SIZE - 1U)
+/* Keep free entries so that looking up a missing ID stops early */
+#define ZMS_ATE_INDEX_MAX_COUNT (CONFIG_ZMS_ATE_INDEX_SIZE / 4U * 3U)
+
+static inline uint32_t zms_ate_index_bloom_bit(zms_id_t id, bool second)
+{
+	/* The second bit comes from a multiplicative hash, independent of zms_id_hash() */
+	uint64_t hash = second ? (((uint64_t)id * 0x9e3779b97f4a7c15ULL) >> 32) : zms_id_hash(id);
+
+	return (uint32_t)hash & (CONFIG_ZMS_ATE_INDEX_BLOOM_BITS - 1U);
+}
+
+static inline void zms_ate_index_bloom_add(struct zms_fs *fs, zms_id_t id)
+{
+	for (int i = 0; i < 2; i++) {
+		uint32_t bit = zms_ate_index_bloom_bit(id, i);
+
+		fs->ate_index_bloom[bit / 32U] |= BIT(bit % 32U);
+	}
+}
+
+static inline bool zms_ate_index_bloom_test(struct zms_fs *fs, zms_id_t id)
+{
+	for (int i = 0; i < 2; i++) {
+		uint32_t bit = zms_ate_index_bloom_bit(id, i);
+
+		if ((fs->ate_index_bloom[bit / 32U] & BIT(bit % 32U)) == 0U) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/* Return the entry holding id, or the free entry where it goes */
+static size_t zms_ate_index_pos(struct zms_fs *fs, zms_id_t id)
+{
+	size_t pos = zms_id_hash(id) & ZMS_ATE_INDEX_MASK;
+
+	while (fs->ate_index_addr[pos] != ZMS_LOOKUP_CACHE_NO_ADDR &&
+	       fs->ate_index_id[pos] != id) {
+		pos = (pos + 1U) & ZMS_ATE_INDEX_MASK;
+	}
+
+	return pos;
+}
+
+static void zms_ate_index_clear(struct zms_fs *fs)
+{
+	memset(fs->ate_index_addr, 0xff, sizeof(fs->ate_index_addr));
+	memset(fs->ate_index_bloom, 0, sizeof(fs->ate_index_bloom));
+	fs->ate_index_count = 0U;
+	fs->ate_index_full = false;
+}
+
+static void zms_ate_index_set(struct zms_fs *fs, zms_id_t id, uint64_t addr)
+{
+	size_t pos = zms_ate_index_pos(fs, id);
+
+	zms_ate_index_bloom_add(fs, id);
+
+	if (fs->ate_index_addr[pos] == ZMS_LOOKUP_CACHE_NO_ADDR) {
+		if (fs->ate_index_count == ZMS_ATE_INDEX_MAX_COUNT) {
+			fs->ate_index_full = true;
+			return;
+		}
+
+		fs->ate_index_id[pos] = id;
+		fs->ate_index_count++;
+	}
+
+	fs->ate_index_addr[pos] = addr;
+}
+
+/* Return the address to start searching id from, ZMS_LOOKUP_CACHE_NO_ADDR if not stored */
+static uint64_t zms_ate_index_get(struct zms_fs *fs, zms_id_t id)
+{
+	size_t pos;
+
+	if (!zms_ate_index_bloom_test(fs, id)) {
+		return ZMS_LOOKUP_CACHE_NO_ADDR;
+	}
+
+	pos = zms_ate_index_pos(fs, id);
+	if (fs->ate_index_addr[pos] != ZMS_LOOKUP_CACHE_NO_ADDR) {
+		return fs->ate_index_addr[pos];
+	}
+
+	/* IDs left out of a full index are searched through all the ATEs */
+	return fs->ate_index_full ? fs->ate_wra : ZMS_LOOKUP_CACHE_NO_ADDR;
+}
+
+/* Free the entry at pos, moving back the entries that were displaced past it */
+static void zms_ate_index_remove(struct zms_fs *fs, size_t pos)
+{
+	size_t next = pos;
+	size_t home;
+
+	while (true) {
+		next = (next + 1U) & ZMS_ATE_INDEX_MASK;
+		if (fs->ate_index_addr[next] == ZMS_LOOKUP_CACHE_NO_ADDR) {
+			break;
+		}
+
+		home = zms_id_hash(fs->ate_index_id[next]) & ZMS_ATE_INDEX_MASK;
+		if (((next - home) & ZMS_ATE_INDEX_MASK) >= ((next - pos) & ZMS_ATE_INDEX_MASK)) {
+			fs->ate_index_id[pos] = fs->ate_index_id[next];
+			fs->ate_index_addr[pos] = fs->ate_index_addr[next];
+			pos = next;
+		}
+	}
+
+	fs->ate_index_addr[pos] = ZMS_LOOKUP_CACHE_NO_ADDR;
+	fs->ate_index_count--;
+}
+
+static int zms_ate_index_rebuild(struct zms_fs *fs)
+{
+	int rc;
+	int previous_sector_num = ZMS_INVALID_SECTOR_NUM;
+	uint64_t addr;
+	uint64_t ate_addr;
+	uint8_t current_cycle;
+	struct zms_ate ate;
+
+	zms_ate_index_clear(fs);
+	addr = fs->ate_wra;
+
+	while (true) {
+		/* Make a copy of 'addr' as it will be advanced by zms_prev_ate() */
+		ate_addr = addr;
+		rc = zms_prev_ate(fs, &addr, &ate);
+
+		if (rc) {
+			return rc;
+		}
+
+		/* The first ATE found for an ID is the most recent one */
+		if (ate.id != ZMS_HEAD_ID &&
+		    fs->ate_index_addr[zms_ate_index_pos(fs, ate.id)] == ZMS_LOOKUP_CACHE_NO_ADDR) {
+			/* read the ate cycle only when we change the sector
+			 * or if it is the first read
+			 */
+			if (SECTOR_NUM(ate_addr) != previous_sector_num) {
+				rc = zms_get_sector_cycle(fs, ate_addr, &current_cycle);
+				if (rc == -ENOENT) {
+					/* sector never used */
+					current_cycle = 0;
+				} else if (rc) {
+					/* bad flash read */
+					return rc;
+				}
+			}
+			if (zms_ate_valid_different_sector(fs, &ate, current_cycle)) {
+				zms_ate_index_set(fs, ate.id, ate_addr);
+			}
+			previous_sector_num = SECTOR_NUM(ate_addr);
+		}
+
+		if (addr == fs->ate_wra) {
+			break;
+		}
+	}
+
+	return 0;
+}
+
+static void zms_ate_index_invalidate(struct zms_fs *fs, uint32_t sector)
+{
+	size_t pos = 0U;
+
+	while (pos < CONFIG_ZMS_ATE_INDEX_SIZE) {
+		if (fs->ate_index_addr[pos] != ZMS_LOOKUP_CACHE_NO_ADDR &&
+		    SECTOR_NUM(fs->ate_index_addr[pos]) == sector) {
+			/* Another entry may be moved to pos, check it again */
+			zms_ate_index_remove(fs, pos);
+			continue;
+		}
+
+		pos++;
+	}
+}
+
+#endif /* CONFIG_ZMS_ATE_INDEX */
+
 /* Helper to compute offset given the address */
 static inline off_t zms_addr_to_offset(struct zms_fs *fs, uint64_t addr)
 {
@@ -254,6 +460,10 @@ static int zms_flash_ate_wrt(struct zms_fs *fs, const struct zms_ate *entry)
 	if (entry->id != ZMS_HEAD_ID) {
 		fs->lookup_cache[zms_lookup_cache_pos(entry->id)] = fs->ate_wra;
 	}
+#elif defined(CONFIG_ZMS_ATE_INDEX)
+	if (entry->id != ZMS_HEAD_ID) {
+		zms_ate_index_set(fs, entry->id, fs->ate_wra);
+	}
 #endif
 	fs->ate_wra -= zms_al_size(fs, sizeof(struct zms_ate));
 end:
@@ -388,6 +598,8 @@ static int zms_flash_erase_sector(struct zms_fs *fs, uint64_t addr)
 
 #ifdef CONFIG_ZMS_LOOKUP_CACHE
 	zms_lookup_cache_invalidate(fs, SECTOR_NUM(addr));
+#elif defined(CONFIG_ZMS_ATE_INDEX)
+	zms_ate_index_invalidate(fs, SECTOR_NUM(addr));
 #endif
 	rc = flash_erase(fs->flash_device, offset, fs->sector_size);
 
@@ -964,26 +1176,22 @@ static int zms_find_ate_with_id(struct zms_fs *fs, zms_id_t id, uint64_t start_a
 	return prev_found;
 }
 
-/* garbage collection: the address ate_wra has been updated to the new sector
- * that has just been started. The data to gc is in the sector after this new
- * sector.
+/* Prepare the garbage collection: the address ate_wra has been updated to the
+ * new sector that has just been started. The data to gc is in the sector after
+ * this new sector.
+ * retval: 0 if the sector after the new one is not closed, there is nothing to gc
+ * retval: 1 if it is closed, gc_addr and stop_addr are set to the first and last
+ * ATEs to gc, and gc_cycle to the cycle counter of the sector
+ * retval: < 0 on error
  */
-static int zms_gc(struct zms_fs *fs)
+static int zms_gc_prepare(struct zms_fs *fs, uint64_t *gc_addr, uint64_t *stop_addr,
+			  uint8_t *gc_cycle)
 {
 	int rc;
 	int sec_closed;
 	struct zms_ate close_ate;
-	struct zms_ate gc_ate;
-	struct zms_ate wlk_ate;
 	struct zms_ate empty_ate;
 	uint64_t sec_addr;
-	uint64_t gc_addr;
-	uint64_t gc_prev_addr;
-	uint64_t wlk_addr;
-	uint64_t wlk_prev_addr;
-	uint64_t data_addr;
-	uint64_t stop_addr;
-	uint8_t previous_cycle = 0;
 
 	rc = zms_get_sector_cycle(fs, fs->ate_wra, &fs->sector_cycle);
 	if (rc == -ENOENT) {
@@ -1008,90 +1216,369 @@ static int zms_gc(struct zms_fs *fs)
 		/* bad flash read */
 		return rc;
 	}
-	previous_cycle = fs->sector_cycle;
 
 	sec_addr = (fs->ate_wra & ADDR_SECT_MASK);
 	zms_sector_advance(fs, &sec_addr);
-	gc_addr = sec_addr + fs->sector_size - fs->ate_size;
+	*gc_addr = sec_addr + fs->sector_size - fs->ate_size;
 
 	/* verify if the sector is closed */
-	sec_closed = zms_validate_closed_sector(fs, gc_addr, &empty_ate, &close_ate);
-	if (sec_closed < 0) {
+	sec_closed = zms_validate_closed_sector(fs, *gc_addr, &empty_ate, &close_ate);
+	if (sec_closed <= 0) {
 		return sec_closed;
 	}
 
-	/* if the sector is not closed don't do gc */
-	if (!sec_closed) {
-		goto gc_done;
-	}
-
-	/* update sector_cycle */
-	fs->sector_cycle = empty_ate.cycle_cnt;
+	*gc_cycle = empty_ate.cycle_cnt;
 
 	/* stop_addr points to the first ATE before the header ATEs */
-	stop_addr = gc_addr - 2 * fs->ate_size;
+	*stop_addr = *gc_addr - 2 * fs->ate_size;
 	/* At this step empty & close ATEs are valid.
 	 * let's start the GC
 	 */
-	gc_addr &= ADDR_SECT_MASK;
-	gc_addr += close_ate.offset;
+	*gc_addr &= ADDR_SECT_MASK;
+	*gc_addr += close_ate.offset;
 
-	do {
-		gc_prev_addr = gc_addr;
-		rc = zms_prev_ate(fs, &gc_addr, &gc_ate);
+	return 1;
+}
+
+/* Check if the ATE read at gc_prev_addr is the most recent one of its ID.
+ * return 1 if it must be moved to the active sector, 0 if not, < 0 on error
+ */
+static int zms_gc_ate_live(struct zms_fs *fs, uint64_t gc_prev_addr, const struct zms_ate *gc_ate)
+{
+	int rc;
+	struct zms_ate wlk_ate;
+	uint64_t wlk_addr;
+	uint64_t wlk_prev_addr;
+
+#ifdef CONFIG_ZMS_LOOKUP_CACHE
+	wlk_addr = fs->lookup_cache[zms_lookup_cache_pos(gc_ate->id)];
+
+	if (wlk_addr == ZMS_LOOKUP_CACHE_NO_ADDR) {
+		wlk_addr = fs->ate_wra;
+	}
+#elif defined(CONFIG_ZMS_ATE_INDEX)
+	wlk_addr = zms_ate_index_get(fs, gc_ate->id);
+
+	if (wlk_addr == ZMS_LOOKUP_CACHE_NO_ADDR) {
+		wlk_addr = fs->ate_wra;
+	}
+#else
+	wlk_addr = fs->ate_wra;
+#endif
+
+	/* Initialize the wlk_prev_addr as if no previous ID will be found */
+	wlk_prev_addr = gc_prev_addr;
+	/* Search for a previous valid ATE with the same ID. If it doesn't exist
+	 * then wlk_prev_addr will be equal to gc_prev_addr.
+	 */
+	rc = zms_find_ate_with_id(fs, gc_ate->id, wlk_addr, fs->ate_wra, &wlk_ate, &wlk_prev_addr);
+	if (rc < 0) {
+		return rc;
+	}
+
+	/* if walk_addr has reached the same address as gc_addr, a copy is
+	 * needed unless it is a deleted item.
+	 */
+	return (wlk_prev_addr == gc_prev_addr) ? 1 : 0;
+}
+
+/* Copy the ATE read at gc_prev_addr, and its data, to the active sector */
+static int zms_gc_move_ate(struct zms_fs *fs, uint64_t gc_prev_addr, struct zms_ate *gc_ate)
+{
+	int rc;
+	uint64_t data_addr;
+
+	LOG_DBG("Moving %lld, len %d", (long long)gc_ate->id, gc_ate->len);
+
+	if (gc_ate->len > ZMS_DATA_IN_ATE_SIZE) {
+		/* Copy Data only when len > ZMS_DATA_IN_ATE_SIZE
+		 * Otherwise, Data is already inside ATE
+		 */
+		data_addr = (gc_prev_addr & ADDR_SECT_MASK);
+		data_addr += gc_ate->offset;
+		gc_ate->offset = (uint32_t)SECTOR_OFFSET(fs->data_wra);
+
+		rc = zms_flash_block_move(fs, data_addr, gc_ate->len);
 		if (rc) {
 			return rc;
 		}
+	}
 
-		if (!zms_ate_valid(fs, &gc_ate) || !gc_ate.len) {
-			continue;
-		}
+	gc_ate->cycle_cnt = fs->sector_cycle;
+	zms_ate_crc8_update(gc_ate);
+
+	return zms_flash_ate_wrt(fs, gc_ate);
+}
+
+/* Erase the sector after the active one, once its garbage collection is done */
+static int zms_gc_erase(struct zms_fs *fs)
+{
+	int rc;
+	uint64_t sec_addr;
+
+	sec_addr = (fs->ate_wra & ADDR_SECT_MASK);
+	zms_sector_advance(fs, &sec_addr);
+
+	/* Erase the GC'ed sector when needed */
+	rc = zms_flash_erase_sector(fs, sec_addr);
+	if (rc) {
+		return rc;
+	}
 
 #ifdef CONFIG_ZMS_LOOKUP_CACHE
-		wlk_addr = fs->lookup_cache[zms_lookup_cache_pos(gc_ate.id)];
+	zms_lookup_cache_invalidate(fs, sec_addr >> ADDR_SECT_SHIFT);
+#elif defined(CONFIG_ZMS_ATE_INDEX)
+	zms_ate_index_invalidate(fs, sec_addr >> ADDR_SECT_SHIFT);
+#endif
+	return zms_add_empty_ate(fs, sec_addr);
+}
 
-		if (wlk_addr == ZMS_LOOKUP_CACHE_NO_ADDR) {
-			wlk_addr = fs->ate_wra;
+#ifdef CONFIG_ZMS_GC_INCREMENTAL
+
+/* Space needed in the active sector to move an ATE of the gc'ed sector */
+static inline uint32_t zms_gc_ate_space(struct zms_fs *fs, const struct zms_ate *gc_ate)
+{
+	if (gc_ate->len > ZMS_DATA_IN_ATE_SIZE) {
+		return fs->ate_size + zms_al_size(fs, gc_ate->len);
+	}
+
+	return fs->ate_size;
+}
+
+/* Start a garbage collection which is run later on by zms_gc_run(). The space
+ * needed to move the live entries is reserved in the active sector, writes only
+ * use what is left. An entry which is not live cannot become live again, so the
+ * reservation can only be too large until the gc is done.
+ */
+static int zms_gc_begin(struct zms_fs *fs)
+{
+	int rc;
+	uint32_t reserved;
+	uint64_t addr;
+	uint64_t prev_addr;
+	struct zms_ate gc_ate;
+
+	rc = zms_gc_prepare(fs, &fs->gc_addr, &fs->gc_stop_addr, &fs->gc_cycle);
+	if (rc < 0) {
+		return rc;
+	}
+
+	/* Reserve the gc done ATE, and keep the ATE at offset 0 of the sector free */
+	reserved = 2 * fs->ate_size;
+
+	if (!rc) {
+		/* if the sector is not closed don't do gc */
+		fs->gc_state = ZMS_GC_STATE_DONE;
+		fs->gc_reserved = reserved;
+		return 0;
+	}
+
+	/* Until the space to reserve is known, nothing else fits in the active sector */
+	fs->gc_state = ZMS_GC_STATE_MOVE;
+	fs->gc_reserved = fs->sector_size;
+
+	addr = fs->gc_addr;
+	do {
+		prev_addr = addr;
+		rc = zms_prev_ate(fs, &addr, &gc_ate);
+		if (rc) {
+			return rc;
 		}
-#else
-		wlk_addr = fs->ate_wra;
-#endif
 
-		/* Initialize the wlk_prev_addr as if no previous ID will be found */
-		wlk_prev_addr = gc_prev_addr;
-		/* Search for a previous valid ATE with the same ID. If it doesn't exist
-		 * then wlk_prev_addr will be equal to gc_prev_addr.
-		 */
-		rc = zms_find_ate_with_id(fs, gc_ate.id, wlk_addr, fs->ate_wra, &wlk_ate,
-					  &wlk_prev_addr);
+		if (!zms_ate_valid_different_sector(fs, &gc_ate, fs->gc_cycle) || !gc_ate.len) {
+			continue;
+		}
+
+		rc = zms_gc_ate_live(fs, prev_addr, &gc_ate);
 		if (rc < 0) {
 			return rc;
 		}
 
-		/* if walk_addr has reached the same address as gc_addr, a copy is
-		 * needed unless it is a deleted item.
-		 */
-		if (wlk_prev_addr == gc_prev_addr) {
-			/* copy needed */
-			LOG_DBG("Moving %lld, len %d", (long long)gc_ate.id, gc_ate.len);
+		if (rc) {
+			reserved += zms_gc_ate_space(fs, &gc_ate);
+		}
+	} while (prev_addr != fs->gc_stop_addr);
 
-			if (gc_ate.len > ZMS_DATA_IN_ATE_SIZE) {
-				/* Copy Data only when len > ZMS_DATA_IN_ATE_SIZE
-				 * Otherwise, Data is already inside ATE
-				 */
-				data_addr = (gc_prev_addr & ADDR_SECT_MASK);
-				data_addr += gc_ate.offset;
-				gc_ate.offset = (uint32_t)SECTOR_OFFSET(fs->data_wra);
+	fs->gc_reserved = reserved;
+
+	return 0;
+}
+
+/* Run the pending garbage collection, until it is done or until budget_us
+ * microseconds are elapsed (0 for no limit). At least one ATE is handled.
+ * return 0 when no garbage collection is pending anymore, 1 otherwise
+ */
+static int zms_gc_run(struct zms_fs *fs, uint32_t budget_us)
+{
+	int rc;
+	uint32_t start = k_cycle_get_32();
+	uint32_t space;
+	uint64_t gc_prev_addr;
+	struct zms_ate gc_ate;
+
+	while (fs->gc_state != ZMS_GC_STATE_IDLE) {
+		switch (fs->gc_state) {
+		case ZMS_GC_STATE_MOVE:
+			gc_prev_addr = fs->gc_addr;
+			rc = zms_prev_ate(fs, &fs->gc_addr, &gc_ate);
+			if (rc) {
+				return rc;
+			}
+
+			if (gc_prev_addr == fs->gc_stop_addr) {
+				fs->gc_state = ZMS_GC_STATE_DONE;
+			}
+
+			if (!zms_ate_valid_different_sector(fs, &gc_ate, fs->gc_cycle) ||
+			    !gc_ate.len) {
+				break;
+			}
+
+			rc = zms_gc_ate_live(fs, gc_prev_addr, &gc_ate);
+			if (rc < 0) {
+				return rc;
+			}
 
-				rc = zms_flash_block_move(fs, data_addr, gc_ate.len);
+			if (rc) {
+				/* A live entry was already live when its space was reserved */
+				space = zms_gc_ate_space(fs, &gc_ate);
+				rc = zms_gc_move_ate(fs, gc_prev_addr, &gc_ate);
 				if (rc) {
 					return rc;
 				}
+				fs->gc_reserved -= space;
+			}
+			break;
+		case ZMS_GC_STATE_DONE:
+			/* Write a GC_done ATE to mark the end of this operation, the
+			 * sector can be erased at any time after this one.
+			 */
+			rc = zms_add_gc_done_ate(fs);
+			if (rc) {
+				return rc;
 			}
 
-			gc_ate.cycle_cnt = previous_cycle;
-			zms_ate_crc8_update(&gc_ate);
-			rc = zms_flash_ate_wrt(fs, &gc_ate);
+			fs->gc_reserved = 0U;
+			fs->gc_state = ZMS_GC_STATE_ERASE;
+			break;
+		default:
+			rc = zms_gc_erase(fs);
+			if (rc) {
+				return rc;
+			}
+
+			fs->gc_state = ZMS_GC_STATE_IDLE;
+			break;
+		}
+
+		if ((budget_us != 0U) &&
+		    (k_cyc_to_us_floor32(k_cycle_get_32() - start) >= budget_us)) {
+			break;
+		}
+	}
+
+	return (fs->gc_state != ZMS_GC_STATE_IDLE) ? 1 : 0;
+}
+
+/* garbage collection of the sector after the new sector, done at once */
+static int zms_gc(struct zms_fs *fs)
+{
+	int rc;
+
+	rc = zms_gc_begin(fs);
+	if (rc) {
+		return rc;
+	}
+
+	return zms_gc_run(fs, 0U);
+}
+
+#ifdef CONFIG_ZMS_GC_WORKQUEUE
+
+static K_THREAD_STACK_DEFINE(zms_gc_stack, CONFIG_ZMS_GC_WORKQUEUE_STACK_SIZE);
+static struct k_work_q zms_gc_work_q;
+
+static void zms_gc_work_handler(struct k_work *work)
+{
+	struct zms_fs *fs = CONTAINER_OF(work, struct zms_fs, gc_work);
+	int rc;
+
+	rc = zms_gc_step(fs, CONFIG_ZMS_GC_STEP_BUDGET_US);
+	if (rc > 0) {
+		/* Let the writes through the lock before the next step */
+		(void)k_work_submit_to_queue(&zms_gc_work_q, work);
+	} else if (rc < 0) {
+		LOG_ERR("Garbage collection step failed, returned = %d", rc);
+	}
+}
+
+/* Run the pending garbage collection, if any, from the work queue */
+static void zms_gc_schedule(struct zms_fs *fs)
+{
+	if (fs->gc_state != ZMS_GC_STATE_IDLE) {
+		(void)k_work_submit_to_queue(&zms_gc_work_q, &fs->gc_work);
+	}
+}
+
+static int zms_gc_work_q_init(void)
+{
+	const struct k_work_queue_config cfg = {.name = "zms_gc"};
+
+	k_work_queue_init(&zms_gc_work_q);
+	k_work_queue_start(&zms_gc_work_q, zms_gc_stack, K_THREAD_STACK_SIZEOF(zms_gc_stack),
+			   K_LOWEST_APPLICATION_THREAD_PRIO, &cfg);
+
+	return 0;
+}
+
+SYS_INIT(zms_gc_work_q_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+#endif /* CONFIG_ZMS_GC_WORKQUEUE */
+
+#else
+
+/* garbage collection: the address ate_wra has been updated to the new sector
+ * that has just been started. The data to gc is in the sector after this new
+ * sector.
+ */
+static int zms_gc(struct zms_fs *fs)
+{
+	int rc;
+	struct zms_ate gc_ate;
+	uint64_t gc_addr;
+	uint64_t gc_prev_addr;
+	uint64_t stop_addr;
+	uint8_t gc_cycle;
+
+	rc = zms_gc_prepare(fs, &gc_addr, &stop_addr, &gc_cycle);
+	if (rc < 0) {
+		return rc;
+	}
+
+	/* if the sector is not closed don't do gc */
+	if (!rc) {
+		goto gc_done;
+	}
+
+	do {
+		gc_prev_addr = gc_addr;
+		rc = zms_prev_ate(fs, &gc_addr, &gc_ate);
+		if (rc) {
+			return rc;
+		}
+
+		if (!zms_ate_valid_different_sector(fs, &gc_ate, gc_cycle) || !gc_ate.len) {
+			continue;
+		}
+
+		rc = zms_gc_ate_live(fs, gc_prev_addr, &gc_ate);
+		if (rc < 0) {
+			return rc;
+		}
+
+		if (rc) {
+			/* copy needed */
+			rc = zms_gc_move_ate(fs, gc_prev_addr, &gc_ate);
 			if (rc) {
 				return rc;
 			}
@@ -1100,9 +1587,6 @@ static int zms_gc(struct zms_fs *fs)
 
 gc_done:
 
-	/* restore the previous sector_cycle */
-	fs->sector_cycle = previous_cycle;
-
 	/* Write a GC_done ATE to mark the end of this operation
 	 */
 
@@ -1111,24 +1595,29 @@ gc_done:
 		return rc;
 	}
 
-	/* Erase the GC'ed sector when needed */
-	rc = zms_flash_erase_sector(fs, sec_addr);
-	if (rc) {
-		return rc;
-	}
+	return zms_gc_erase(fs);
+}
 
-#ifdef CONFIG_ZMS_LOOKUP_CACHE
-	zms_lookup_cache_invalidate(fs, sec_addr >> ADDR_SECT_SHIFT);
-#endif
-	rc = zms_add_empty_ate(fs, sec_addr);
+#endif /* CONFIG_ZMS_GC_INCREMENTAL */
 
-	return rc;
+/* Space of the active sector which is not available to writes */
+static inline uint32_t zms_gc_reserved_space(struct zms_fs *fs)
+{
+#ifdef CONFIG_ZMS_GC_INCREMENTAL
+	return fs->gc_reserved;
+#else
+	ARG_UNUSED(fs);
+	return 0U;
+#endif
 }
 
 int zms_clear(struct zms_fs *fs)
 {
 	int rc;
 	uint64_t addr;
+#ifdef CONFIG_ZMS_GC_WORKQUEUE
+	struct k_work_sync sync;
+#endif
 
 	if (!fs) {
 		LOG_ERR("Invalid fs");
@@ -1140,6 +1629,11 @@ int zms_clear(struct zms_fs *fs)
 		return -EACCES;
 	}
 
+#ifdef CONFIG_ZMS_GC_WORKQUEUE
+	/* The pending garbage collection is dropped along with the data */
+	(void)k_work_cancel_sync(&fs->gc_work, &sync);
+#endif
+
 	k_mutex_lock(&fs->zms_lock, K_FOREVER);
 	for (uint32_t i = 0; i < fs->sector_count; i++) {
 		addr = (uint64_t)i << ADDR_SECT_SHIFT;
@@ -1180,6 +1674,11 @@ static int zms_init(struct zms_fs *fs)
 
 	k_mutex_lock(&fs->zms_lock, K_FOREVER);
 
+#ifdef CONFIG_ZMS_GC_INCREMENTAL
+	fs->gc_state = ZMS_GC_STATE_IDLE;
+	fs->gc_reserved = 0U;
+#endif
+
 	/* step through the sectors to find a open sector following
 	 * a closed sector, this is where zms can write.
 	 */
@@ -1414,6 +1913,13 @@ static int zms_init(struct zms_fs *fs)
 			rc = zms_add_empty_ate(fs, addr);
 			goto end;
 		}
+#ifdef CONFIG_ZMS_GC_INCREMENTAL
+		/* The write sector may hold entries written while the gc was pending,
+		 * resume the gc instead of restarting it: the entries that were already
+		 * moved have a more recent ATE and are skipped.
+		 */
+		LOG_INF("No GC Done marker found: resuming gc");
+#else
 		LOG_INF("No GC Done marker found: restarting gc");
 		rc = zms_flash_erase_sector(fs, fs->ate_wra);
 		if (rc) {
@@ -1428,6 +1934,7 @@ static int zms_init(struct zms_fs *fs)
 		fs->ate_wra &= ADDR_SECT_MASK;
 		fs->ate_wra += (fs->sector_size - 3 * fs->ate_size);
 		fs->data_wra = (fs->ate_wra & ADDR_SECT_MASK);
+#endif
 #ifdef CONFIG_ZMS_LOOKUP_CACHE
 		/**
 		 * At this point, the lookup cache wasn't built but the gc function need to use it.
@@ -1437,6 +1944,9 @@ static int zms_init(struct zms_fs *fs)
 		for (i = 0; i < CONFIG_ZMS_LOOKUP_CACHE_SIZE; i++) {
 			fs->lookup_cache[i] = fs->ate_wra;
 		}
+#elif defined(CONFIG_ZMS_ATE_INDEX)
+		/* Same for the index, the gc searches the IDs it does not hold from the end */
+		zms_ate_index_clear(fs);
 #endif
 		rc = zms_gc(fs);
 		goto end;
@@ -1447,6 +1957,10 @@ end:
 	if (!rc) {
 		rc = zms_lookup_cache_rebuild(fs);
 	}
+#elif defined(CONFIG_ZMS_ATE_INDEX)
+	if (!rc) {
+		rc = zms_ate_index_rebuild(fs);
+	}
 #endif
 	/* If the sector is empty add a gc done ate to avoid having insufficient
 	 * space when doing gc.
@@ -1464,12 +1978,20 @@ int zms_mount(struct zms_fs *fs)
 	int rc;
 	struct flash_pages_info info;
 	size_t write_block_size;
+#ifdef CONFIG_ZMS_GC_WORKQUEUE
+	struct k_work_sync sync;
+#endif
 
 	if (!fs) {
 		LOG_ERR("Invalid fs");
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_ZMS_GC_WORKQUEUE
+	/* A new mount drops the garbage collection pending in the background */
+	(void)k_work_cancel_sync(&fs->gc_work, &sync);
+	k_work_init(&fs->gc_work, zms_gc_work_handler);
+#endif
 	k_mutex_init(&fs->zms_lock);
 
 	fs->flash_parameters = flash_get_parameters(fs->flash_device);
@@ -1569,6 +2091,17 @@ ssize_t zms_write(struct zms_fs *fs, zms_id_t id, const void *data, size_t len)
 #ifdef CONFIG_ZMS_LOOKUP_CACHE
 	wlk_addr = fs->lookup_cache[zms_lookup_cache_pos(id)];
 
+	if (wlk_addr == ZMS_LOOKUP_CACHE_NO_ADDR) {
+		if (len > 0) {
+			goto no_cached_entry;
+		} else {
+			/* skip delete entry for non-existing entry */
+			return 0;
+		}
+	}
+#elif defined(CONFIG_ZMS_ATE_INDEX)
+	wlk_addr = zms_ate_index_get(fs, id);
+
 	if (wlk_addr == ZMS_LOOKUP_CACHE_NO_ADDR) {
 		if (len > 0) {
 			goto no_cached_entry;
@@ -1625,9 +2158,9 @@ ssize_t zms_write(struct zms_fs *fs, zms_id_t id, const void *data, size_t len)
 			return 0;
 		}
 	}
-#ifdef CONFIG_ZMS_LOOKUP_CACHE
+#if defined(CONFIG_ZMS_LOOKUP_CACHE) || defined(CONFIG_ZMS_ATE_INDEX)
 no_cached_entry:
-#endif /* CONFIG_ZMS_LOOKUP_CACHE */
+#endif /* CONFIG_ZMS_LOOKUP_CACHE || CONFIG_ZMS_ATE_INDEX */
 #endif /* CONFIG_ZMS_NO_DOUBLE_WRITE */
 
 	/* calculate required space if the entry contains data */
@@ -1659,7 +2192,7 @@ no_cached_entry:
 		 * and the second position could be written only be a delete ATE.
 		 */
 		if ((SECTOR_OFFSET(fs->ate_wra)) &&
-		    (fs->ate_wra >= (fs->data_wra + required_space)) &&
+		    (fs->ate_wra >= (fs->data_wra + required_space + zms_gc_reserved_space(fs))) &&
 		    (SECTOR_OFFSET(fs->ate_wra - fs->ate_size) || !len)) {
 			rc = zms_flash_write_entry(fs, id, data, len);
 			if (rc) {
@@ -1667,12 +2200,29 @@ no_cached_entry:
 			}
 			break;
 		}
+#ifdef CONFIG_ZMS_GC_INCREMENTAL
+		if (fs->gc_state != ZMS_GC_STATE_IDLE) {
+			/* Complete the pending gc, it releases the space reserved for it
+			 * and the active sector cannot be closed before.
+			 */
+			rc = zms_gc_run(fs, 0U);
+			if (rc) {
+				LOG_ERR("Garbage collection failed, returned = %d", rc);
+				goto end;
+			}
+			continue;
+		}
+#endif
 		rc = zms_sector_close(fs);
 		if (rc) {
 			LOG_ERR("Failed to close the sector, returned = %d", rc);
 			goto end;
 		}
+#ifdef CONFIG_ZMS_GC_INCREMENTAL
+		rc = zms_gc_begin(fs);
+#else
 		rc = zms_gc(fs);
+#endif
 		if (rc) {
 			LOG_ERR("Garbage collection failed, returned = %d", rc);
 			goto end;
@@ -1681,6 +2231,9 @@ no_cached_entry:
 	}
 	rc = len;
 end:
+#ifdef CONFIG_ZMS_GC_WORKQUEUE
+	zms_gc_schedule(fs);
+#endif
 	k_mutex_unlock(&fs->zms_lock);
 	return rc;
 }
@@ -1717,6 +2270,13 @@ ssize_t zms_read_hist(struct zms_fs *fs, zms_id_t id, void *data, size_t len, ui
 #ifdef CONFIG_ZMS_LOOKUP_CACHE
 	wlk_addr = fs->lookup_cache[zms_lookup_cache_pos(id)];
 
+	if (wlk_addr == ZMS_LOOKUP_CACHE_NO_ADDR) {
+		rc = -ENOENT;
+		goto err;
+	}
+#elif defined(CONFIG_ZMS_ATE_INDEX)
+	wlk_addr = zms_ate_index_get(fs, id);
+
 	if (wlk_addr == ZMS_LOOKUP_CACHE_NO_ADDR) {
 		rc = -ENOENT;
 		goto err;
@@ -1877,6 +2437,16 @@ ssize_t zms_calc_free_space(struct zms_fs *fs)
 		return -EACCES;
 	}
 
+#ifdef CONFIG_ZMS_GC_INCREMENTAL
+	/* The entries not moved yet by a pending gc would not be accounted */
+	k_mutex_lock(&fs->zms_lock, K_FOREVER);
+	rc = zms_gc_run(fs, 0U);
+	k_mutex_unlock(&fs->zms_lock);
+	if (rc) {
+		return rc;
+	}
+#endif
+
 	step_addr = fs->ate_wra;
 	current_cycle = fs->sector_cycle;
 	/* there is always one reserved sector for garbage collection */
@@ -1967,7 +2537,8 @@ ssize_t zms_active_sector_free_space(struct zms_fs *fs)
 		return -EACCES;
 	}
 
-	return zms_free_space(fs, SECTOR_OFFSET(fs->data_wra), SECTOR_OFFSET(fs->ate_wra));
+	return zms_free_space(fs, SECTOR_OFFSET(fs->data_wra) + zms_gc_reserved_space(fs),
+			      SECTOR_OFFSET(fs->ate_wra));
 }
 
 int zms_sector_use_next(struct zms_fs *fs)
@@ -1986,6 +2557,14 @@ int zms_sector_use_next(struct zms_fs *fs)
 
 	k_mutex_lock(&fs->zms_lock, K_FOREVER);
 
+#ifdef CONFIG_ZMS_GC_INCREMENTAL
+	/* The active sector cannot be closed while its gc is pending */
+	ret = zms_gc_run(fs, 0U);
+	if (ret != 0) {
+		goto end;
+	}
+#endif
+
 	ret = zms_sector_close(fs);
 	if (ret != 0) {
 		goto end;
@@ -1997,3 +2576,26 @@ end:
 	k_mutex_unlock(&fs->zms_lock);
 	return ret;
 }
+
+#ifdef CONFIG_ZMS_GC_INCREMENTAL
+int zms_gc_step(struct zms_fs *fs, uint32_t budget_us)
+{
+	int rc;
+
+	if (!fs) {
+		LOG_ERR("Invalid fs");
+		return -EINVAL;
+	}
+
+	if (!fs->ready) {
+		LOG_ERR("ZMS not initialized");
+		return -EACCES;
+	}
+
+	k_mutex_lock(&fs->zms_lock, K_FOREVER);
+	rc = zms_gc_run(fs, budget_us);
+	k_mutex_unlock(&fs->zms_lock);
+
+	return rc;
+}
+#endif /* CONFIG_ZMS_GC_INCREMENTAL */
@@ -41,6 +41,12 @@
 
 #define ZMS_INVALID_SECTOR_NUM -1
 
+/* States of an incremental garbage collection */
+#define ZMS_GC_STATE_IDLE  0
+#define ZMS_GC_STATE_MOVE  1
+#define ZMS_GC_STATE_DONE  2
+#define ZMS_GC_STATE_ERASE 3
+
 #define ZMS_ATE_FORMAT_ID_32BIT 0
 #define ZMS_ATE_FORMAT_ID_64BIT 1
 
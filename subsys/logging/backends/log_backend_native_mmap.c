@@ -0,0 +1,244 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Dictionary-based log backend for the native simulator, storing the messages
+ * in a ring buffer inside a memory-mapped file on the host.
+ *
+ * The file starts with struct log_mmap_hdr, followed by the ring. Each message
+ * is stored in the ring as a frame: its length on 16 bits, followed by the
+ * dictionary-based message, possibly wrapping around the end of the ring.
+ * Frames between tail and head are complete, head is only moved once a frame
+ * is written, and the oldest frames are dropped to make room for a new one.
+ * All the fields are in the host byte order.
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_core.h>
+#include <zephyr/logging/log_output.h>
+#include <zephyr/logging/log_output_dict.h>
+#include <zephyr/sys/barrier.h>
+#include <zephyr/sys/util.h>
+
+#include "log_backend_native_mmap_native.h"
+#include "cmdline.h"
+#include "soc.h"
+
+#define LOG_MMAP_MAGIC   "ZLOGMMAP"
+#define LOG_MMAP_VERSION 1
+
+#define LOG_MMAP_RING_SIZE CONFIG_LOG_BACKEND_NATIVE_MMAP_SIZE
+#define LOG_MMAP_FRAME_HDR sizeof(uint16_t)
+
+struct log_mmap_hdr {
+	char magic[8];
+	uint32_t version;
+	uint32_t size;
+	/* Positions in the ring since the start, modulo size gives the offset */
+	uint64_t head;
+	uint64_t tail;
+	/* Frames overwritten by newer ones */
+	uint32_t overwritten;
+	/* Frames which did not fit in the ring */
+	uint32_t discarded;
+};
+
+static const char *log_mmap_path;
+static int log_mmap_fd = -1;
+#ifdef CONFIG_ZTEST
+/* Inspected by the tests */
+struct log_mmap_hdr *log_mmap;
+#else
+static struct log_mmap_hdr *log_mmap;
+#endif
+static uint8_t *ring;
+static struct k_spinlock lock;
+
+/* Frame being written, it is published by moving the head past it */
+static uint64_t frame_start;
+static uint64_t frame_end;
+static bool frame_lost;
+
+static uint8_t buf[32];
+
+static void ring_copy_in(uint64_t pos, const uint8_t *data, size_t len)
+{
+	size_t off = pos % LOG_MMAP_RING_SIZE;
+	size_t part = MIN(len, LOG_MMAP_RING_SIZE - off);
+
+	memcpy(&ring[off], data, part);
+	memcpy(ring, &data[part], len - part);
+}
+
+static uint16_t ring_frame_len(uint64_t pos)
+{
+	uint8_t len[LOG_MMAP_FRAME_HDR];
+
+	for (size_t i = 0; i < sizeof(len); i++) {
+		len[i] = ring[(pos + i) % LOG_MMAP_RING_SIZE];
+	}
+
+	return UNALIGNED_GET((uint16_t *)len);
+}
+
+/* Drop the oldest frames until len more bytes fit in the frame being written */
+static bool ring_reserve(size_t len)
+{
+	while (frame_end + len - log_mmap->tail > LOG_MMAP_RING_SIZE) {
+		if (log_mmap->tail == frame_start) {
+			return false;
+		}
+
+		log_mmap->tail += LOG_MMAP_FRAME_HDR + ring_frame_len(log_mmap->tail);
+		log_mmap->overwritten++;
+	}
+
+	return true;
+}
+
+static int char_out(uint8_t *data, size_t length, void *ctx)
+{
+	ARG_UNUSED(ctx);
+
+	if (frame_lost || !ring_reserve(length)) {
+		frame_lost = true;
+		return length;
+	}
+
+	ring_copy_in(frame_end, data, length);
+	frame_end += length;
+
+	return length;
+}
+
+LOG_OUTPUT_DEFINE(log_output_mmap, char_out, buf, sizeof(buf));
+
+static void frame_begin(void)
+{
+	frame_start = log_mmap->head;
+	frame_end = frame_start;
+	frame_lost = !ring_reserve(LOG_MMAP_FRAME_HDR);
+	frame_end += LOG_MMAP_FRAME_HDR;
+}
+
+static void frame_commit(void)
+{
+	uint64_t len = frame_end - frame_start - LOG_MMAP_FRAME_HDR;
+	uint16_t len16 = (uint16_t)len;
+
+	if (frame_lost || len > UINT16_MAX) {
+		log_mmap->discarded++;
+		return;
+	}
+
+	ring_copy_in(frame_start, (uint8_t *)&len16, sizeof(len16));
+
+	/* A reader of the file must not see the head before the frame */
+	barrier_dmem_fence_full();
+	log_mmap->head = frame_end;
+}
+
+static void process(const struct log_backend *const backend, union log_msg_generic *msg)
+{
+	k_spinlock_key_t key;
+
+	if (log_mmap == NULL) {
+		return;
+	}
+
+	key = k_spin_lock(&lock);
+	frame_begin();
+	log_dict_output_msg_process(&log_output_mmap, &msg->log, 0);
+	frame_commit();
+	k_spin_unlock(&lock, key);
+}
+
+static void dropped(const struct log_backend *const backend, uint32_t cnt)
+{
+	k_spinlock_key_t key;
+
+	if (log_mmap == NULL) {
+		return;
+	}
+
+	key = k_spin_lock(&lock);
+	frame_begin();
+	log_dict_output_dropped_process(&log_output_mmap, cnt);
+	frame_commit();
+	k_spin_unlock(&lock, key);
+}
+
+static void panic(struct log_backend const *const backend)
+{
+	/* Frames are in the shared mapping as soon as they are written */
+	ARG_UNUSED(backend);
+}
+
+static void log_backend_native_mmap_init(struct log_backend const *const backend)
+{
+	void *mem;
+
+	ARG_UNUSED(backend);
+
+	if (log_mmap_path == NULL) {
+		log_mmap_path = CONFIG_LOG_BACKEND_NATIVE_MMAP_FILE;
+	}
+
+	log_mmap_fd = log_mmap_init_native(log_mmap_path,
+					   sizeof(struct log_mmap_hdr) + LOG_MMAP_RING_SIZE, &mem);
+	if (log_mmap_fd < 0) {
+		return;
+	}
+
+	log_mmap = mem;
+	ring = (uint8_t *)mem + sizeof(struct log_mmap_hdr);
+
+	log_mmap->version = LOG_MMAP_VERSION;
+	log_mmap->size = LOG_MMAP_RING_SIZE;
+	log_mmap->head = 0;
+	log_mmap->tail = 0;
+	log_mmap->overwritten = 0;
+	log_mmap->discarded = 0;
+
+	/* The magic is written last, the file is valid from then on */
+	barrier_dmem_fence_full();
+	memcpy(log_mmap->magic, LOG_MMAP_MAGIC, sizeof(log_mmap->magic));
+}
+
+const struct log_backend_api log_backend_native_mmap_api = {
+	.process = process,
+	.panic = panic,
+	.init = log_backend_native_mmap_init,
+	.dropped = IS_ENABLED(CONFIG_LOG_MODE_IMMEDIATE) ? NULL : dropped,
+};
+
+LOG_BACKEND_DEFINE(log_backend_native_mmap, log_backend_native_mmap_api, true);
+
+static void log_mmap_native_cleanup(void)
+{
+	log_mmap_cleanup_native(log_mmap_fd, log_mmap,
+				sizeof(struct log_mmap_hdr) + LOG_MMAP_RING_SIZE);
+}
+
+static void log_mmap_native_options(void)
+{
+	static struct args_struct_t log_mmap_options[] = {
+		{ .option = "log_mmap",
+		  .name = "path",
+		  .type = 's',
+		  .dest = (void *)&log_mmap_path,
+		  .descript = "Path of the file the dictionary-based log messages are stored in, "
+			      "by default \"" CONFIG_LOG_BACKEND_NATIVE_MMAP_FILE "\"" },
+		ARG_TABLE_ENDMARKER
+	};
+
+	native_add_command_line_opts(log_mmap_options);
+}
+
+NATIVE_TASK(log_mmap_native_options, PRE_BOOT_1, 1);
+NATIVE_TASK(log_mmap_native_cleanup, ON_EXIT, 1);
@@ -0,0 +1,74 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Part of the memory-mapped log backend which interacts with the host OS
+ *
+ * When building for the native simulator, this file is built in the
+ * native simulator runner/host context, and not in Zephyr/embedded context.
+ */
+
+#undef _POSIX_C_SOURCE
+/* Note: This is used only for interaction with the host C library, and is therefore exempt of
+ * coding guidelines rule A.4&5 which applies to the embedded code using embedded libraries
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <string.h>
+#include <nsi_tracing.h>
+
+/*
+ * Create the ring file, or truncate the existing one, and map it.
+ *
+ * Returns -1 on failure
+ *	    the file descriptor on success
+ */
+int log_mmap_init_native(const char *path, unsigned int size, void **mem)
+{
+	int fd;
+
+	fd = open(path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, (mode_t)0600);
+	if (fd == -1) {
+		nsi_print_warning("Failed to open log file %s: %s\n", path, strerror(errno));
+		return -1;
+	}
+
+	if (ftruncate(fd, size) == -1) {
+		nsi_print_warning("Failed to resize log file %s: %s\n", path, strerror(errno));
+		close(fd);
+		return -1;
+	}
+
+	*mem = mmap(NULL, size, PROT_WRITE | PROT_READ, MAP_SHARED, fd, 0);
+	if (*mem == MAP_FAILED) {
+		nsi_print_warning("Failed to mmap log file %s: %s\n", path, strerror(errno));
+		*mem = NULL;
+		close(fd);
+		return -1;
+	}
+
+	return fd;
+}
+
+/*
+ * Unmap the ring file and close it. The content written so far is kept by the
+ * host even if the process is killed, as the mapping is shared.
+ */
+void log_mmap_cleanup_native(int fd, void *mem, unsigned int size)
+{
+	if (mem != NULL) {
+		(void)msync(mem, size, MS_SYNC);
+		munmap(mem, size);
+	}
+
+	if (fd != -1) {
+		close(fd);
+	}
+}
@@ -0,0 +1,22 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef SUBSYS_LOGGING_BACKENDS_LOG_BACKEND_NATIVE_MMAP_NATIVE_H
+#define SUBSYS_LOGGING_BACKENDS_LOG_BACKEND_NATIVE_MMAP_NATIVE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int log_mmap_init_native(const char *path, unsigned int size, void **mem);
+
+void log_mmap_cleanup_native(int fd, void *mem, unsigned int size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SUBSYS_LOGGING_BACKENDS_LOG_BACKEND_NATIVE_MMAP_NATIVE_H */
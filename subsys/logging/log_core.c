@@ -140,6 +140,17 @@ static const struct mpsc_pbuf_buffer_config mpsc_config = {
 		 (IS_ENABLED(CONFIG_LOG_MEM_UTILIZATION) ?
 		  MPSC_PBUF_MAX_UTILIZATION : 0)
 };
+
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+/* The first CPU uses log_buffer, the other ones have their own buffer. */
+#define LOG_CPU_BUFFERS (CONFIG_MP_MAX_NUM_CPUS - 1)
+
+static uint32_t __aligned(Z_LOG_MSG_ALIGNMENT)
+	cpu_buf32[LOG_CPU_BUFFERS][CONFIG_LOG_BUFFER_SIZE / sizeof(int)];
+static struct mpsc_pbuf_buffer cpu_log_buffer[LOG_CPU_BUFFERS];
+/* Message claimed from each CPU buffer and waiting to be the oldest one. */
+static struct log_msg_ptr cpu_log_msg_ptr[LOG_CPU_BUFFERS];
+#endif /* CONFIG_LOG_PER_CPU_BUFFERS */
 #endif
 
 /* Check that default tag can fit in tag buffer. */
@@ -652,6 +663,45 @@ void z_log_msg_init(void)
 	mpsc_pbuf_init(&log_buffer, &mpsc_config);
 	curr_log_buffer = &log_buffer;
 #endif
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	for (int i = 0; i < LOG_CPU_BUFFERS; i++) {
+		struct mpsc_pbuf_buffer_config config = mpsc_config;
+
+		config.buf = cpu_buf32[i];
+		mpsc_pbuf_init(&cpu_log_buffer[i], &config);
+	}
+#endif
+}
+
+/* Buffer of the CPU the caller runs on, so that CPUs do not share a lock. */
+static struct mpsc_pbuf_buffer *local_log_buffer(void)
+{
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	/* The caller may migrate afterwards, which only costs contention. */
+	uint32_t cpu = arch_curr_cpu()->id;
+
+	if (cpu > 0) {
+		return &cpu_log_buffer[cpu - 1];
+	}
+#endif
+	return &log_buffer;
+}
+
+/* Buffer a message was allocated from. */
+static struct mpsc_pbuf_buffer *msg_log_buffer(const struct log_msg *msg)
+{
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	const uint32_t *addr = (const uint32_t *)msg;
+
+	for (int i = 0; i < LOG_CPU_BUFFERS; i++) {
+		if (addr >= cpu_buf32[i] && addr < &cpu_buf32[i][ARRAY_SIZE(cpu_buf32[i])]) {
+			return &cpu_log_buffer[i];
+		}
+	}
+#else
+	ARG_UNUSED(msg);
+#endif
+	return &log_buffer;
 }
 
 static struct log_msg *msg_alloc(struct mpsc_pbuf_buffer *buffer, uint32_t wlen)
@@ -669,7 +719,7 @@ static struct log_msg *msg_alloc(struct mpsc_pbuf_buffer *buffer, uint32_t wlen)
 
 struct log_msg *z_log_msg_alloc(uint32_t wlen)
 {
-	return msg_alloc(&log_buffer, wlen);
+	return msg_alloc(local_log_buffer(), wlen);
 }
 
 static void msg_commit(struct mpsc_pbuf_buffer *buffer, struct log_msg *msg)
@@ -701,7 +751,7 @@ static void msg_commit(struct mpsc_pbuf_buffer *buffer, struct log_msg *msg)
 void z_log_msg_commit(struct log_msg *msg)
 {
 	msg->hdr.timestamp = timestamp_func();
-	msg_commit(&log_buffer, msg);
+	msg_commit(msg_log_buffer(msg), msg);
 }
 
 union log_msg_generic *z_log_msg_local_claim(void)
@@ -714,7 +764,30 @@ union log_msg_generic *z_log_msg_local_claim(void)
 
 }
 
-/* If there are buffers dedicated for each link, claim the oldest message (lowest timestamp). */
+/* Claim the head of the buffer if needed and check if it is the oldest message so far. */
+static void msg_claim_candidate(struct mpsc_pbuf_buffer *buffer, struct log_msg_ptr *msg_ptr,
+				log_timestamp_t *t_min, struct log_msg_ptr **chosen)
+{
+#ifdef CONFIG_MPSC_PBUF
+	if (msg_ptr->msg == NULL) {
+		msg_ptr->msg = (union log_msg_generic *)mpsc_pbuf_claim(buffer);
+	}
+#endif
+
+	if (msg_ptr->msg) {
+		log_timestamp_t t = log_msg_get_timestamp(&msg_ptr->msg->log);
+
+		if (t < *t_min) {
+			*t_min = t;
+			*chosen = msg_ptr;
+			curr_log_buffer = buffer;
+		}
+	}
+}
+
+/* If there are buffers dedicated for each link or CPU, claim the oldest message
+ * (lowest timestamp).
+ */
 union log_msg_generic *z_log_msg_claim_oldest(k_timeout_t *backoff)
 {
 	union log_msg_generic *msg = NULL;
@@ -728,24 +801,18 @@ union log_msg_generic *z_log_msg_claim_oldest(k_timeout_t *backoff)
 		struct log_mpsc_pbuf *buf;
 
 		STRUCT_SECTION_GET(log_mpsc_pbuf, i, &buf);
+		msg_claim_candidate(&buf->buf, msg_ptr, &t_min, &chosen);
+		i++;
+	}
 
-#ifdef CONFIG_MPSC_PBUF
-		if (msg_ptr->msg == NULL) {
-			msg_ptr->msg = (union log_msg_generic *)mpsc_pbuf_claim(&buf->buf);
-		}
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	for (i = 0; i < LOG_CPU_BUFFERS; i++) {
+		msg_claim_candidate(&cpu_log_buffer[i], &cpu_log_msg_ptr[i], &t_min, &chosen);
+	}
 #endif
 
-		if (msg_ptr->msg) {
-			log_timestamp_t t = log_msg_get_timestamp(&msg_ptr->msg->log);
-
-			if (t < t_min) {
-				t_min = t;
-				msg = msg_ptr->msg;
-				chosen = msg_ptr;
-				curr_log_buffer = &buf->buf;
-			}
-		}
-		i++;
+	if (chosen) {
+		msg = chosen->msg;
 	}
 
 	if (msg) {
@@ -788,7 +855,8 @@ union log_msg_generic *z_log_msg_claim(k_timeout_t *backoff)
 	STRUCT_SECTION_COUNT(log_mpsc_pbuf, &len);
 
 	/* Use only one buffer if others are not registered. */
-	if (IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) && len > 1) {
+	if (IS_ENABLED(CONFIG_LOG_PER_CPU_BUFFERS) ||
+	    (IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) && len > 1)) {
 		return z_log_msg_claim_oldest(backoff);
 	}
 
@@ -823,7 +891,8 @@ bool z_log_msg_pending(void)
 
 	STRUCT_SECTION_COUNT(log_mpsc_pbuf, &len);
 
-	if (!IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) || (len == 1)) {
+	if (!IS_ENABLED(CONFIG_LOG_PER_CPU_BUFFERS) &&
+	    (!IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) || (len == 1))) {
 		return msg_pending(&log_buffer);
 	}
 
@@ -843,6 +912,14 @@ bool z_log_msg_pending(void)
 		i++;
 	}
 
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	for (i = 0; i < LOG_CPU_BUFFERS; i++) {
+		if (cpu_log_msg_ptr[i].msg || msg_pending(&cpu_log_buffer[i])) {
+			return true;
+		}
+	}
+#endif
+
 	return false;
 }
 
@@ -850,7 +927,8 @@ void z_log_msg_enqueue(const struct log_link *link, const void *data, size_t len
 {
 	struct log_msg *log_msg = (struct log_msg *)data;
 	size_t wlen = DIV_ROUND_UP(ROUND_UP(len, Z_LOG_MSG_ALIGNMENT), sizeof(int));
-	struct mpsc_pbuf_buffer *mpsc_pbuffer = link->mpsc_pbuf ? link->mpsc_pbuf : &log_buffer;
+	struct mpsc_pbuf_buffer *mpsc_pbuffer = link->mpsc_pbuf ? link->mpsc_pbuf :
+						local_log_buffer();
 	struct log_msg *local_msg = msg_alloc(mpsc_pbuffer, wlen);
 
 	if (!local_msg) {
@@ -905,6 +983,17 @@ int log_mem_get_usage(uint32_t *buf_size, uint32_t *usage)
 
 	mpsc_pbuf_get_utilization(&log_buffer, buf_size, usage);
 
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	for (int i = 0; i < LOG_CPU_BUFFERS; i++) {
+		uint32_t cpu_size;
+		uint32_t cpu_usage;
+
+		mpsc_pbuf_get_utilization(&cpu_log_buffer[i], &cpu_size, &cpu_usage);
+		*buf_size += cpu_size;
+		*usage += cpu_usage;
+	}
+#endif
+
 	return 0;
 }
 
@@ -916,7 +1005,20 @@ int log_mem_get_max_usage(uint32_t *max)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	/* Sum of the peaks of each CPU buffer, which may not have happened together. */
+	uint32_t cpu_max;
+	int err = mpsc_pbuf_get_max_utilization(&log_buffer, max);
+
+	for (int i = 0; (err == 0) && (i < LOG_CPU_BUFFERS); i++) {
+		err = mpsc_pbuf_get_max_utilization(&cpu_log_buffer[i], &cpu_max);
+		*max += cpu_max;
+	}
+
+	return err;
+#else
 	return mpsc_pbuf_get_max_utilization(&log_buffer, max);
+#endif
 }
 
 static void log_backend_notify_all(enum log_backend_evt event,
@@ -61,6 +61,125 @@ static struct net_conn conns[CONFIG_NET_MAX_CONN];
 static sys_slist_t conn_unused;
 static sys_slist_t conn_used;
 
+#if defined(CONFIG_NET_CONN_HASH)
+/** Both addresses and both ports specified, i.e. the highest rank */
+#define NET_CONN_FULLY_SPECIFIED (NET_CONN_REMOTE_PORT_SPEC | \
+				  NET_CONN_LOCAL_PORT_SPEC |  \
+				  NET_CONN_REMOTE_ADDR_SPEC | \
+				  NET_CONN_LOCAL_ADDR_SPEC)
+
+/* Used connections are indexed by their local port, the ones without a
+ * local port are kept in a wildcard list instead.  Fully specified
+ * TCP/UDP connections are also indexed by their 5-tuple so that unicast
+ * input can find them without a scan.
+ */
+static sys_slist_t conn_port_hash[CONFIG_NET_CONN_HASH_BUCKETS];
+static sys_slist_t conn_tuple_hash[CONFIG_NET_CONN_HASH_BUCKETS];
+static sys_slist_t conn_wildcard;
+
+#define CONN_LOOKUP_NODE hash_node
+
+/* FNV-1a */
+static uint32_t conn_hash_bytes(uint32_t hash, const uint8_t *buf, size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		hash = (hash ^ buf[i]) * 16777619U;
+	}
+
+	return hash;
+}
+
+/* Port is in network byte order */
+static sys_slist_t *conn_port_bucket(uint16_t port)
+{
+	return &conn_port_hash[((uint32_t)port * 2654435761U >> 16) %
+			       CONFIG_NET_CONN_HASH_BUCKETS];
+}
+
+/* Ports are in network byte order */
+static sys_slist_t *conn_tuple_bucket(uint8_t family, uint16_t proto,
+				      const uint8_t *local_addr,
+				      const uint8_t *remote_addr, size_t addr_len,
+				      uint16_t local_port, uint16_t remote_port)
+{
+	uint32_t hash = 2166136261U;
+	uint8_t key[] = {
+		family, proto,
+		local_port >> 8, local_port & 0xff,
+		remote_port >> 8, remote_port & 0xff,
+	};
+
+	hash = conn_hash_bytes(hash, key, sizeof(key));
+	hash = conn_hash_bytes(hash, local_addr, addr_len);
+	hash = conn_hash_bytes(hash, remote_addr, addr_len);
+
+	return &conn_tuple_hash[hash % CONFIG_NET_CONN_HASH_BUCKETS];
+}
+
+static bool conn_is_fully_specified(struct net_conn *conn)
+{
+	return (conn->flags & NET_CONN_FULLY_SPECIFIED) == NET_CONN_FULLY_SPECIFIED &&
+	       ((IS_ENABLED(CONFIG_NET_IPV6) && conn->family == NET_AF_INET6) ||
+		(IS_ENABLED(CONFIG_NET_IPV4) && conn->family == NET_AF_INET));
+}
+
+static sys_slist_t *conn_tuple_bucket_of(struct net_conn *conn)
+{
+	if (IS_ENABLED(CONFIG_NET_IPV6) && conn->family == NET_AF_INET6) {
+		return conn_tuple_bucket(conn->family, conn->proto,
+					 net_sin6(&conn->local_addr)->sin6_addr.s6_addr,
+					 net_sin6(&conn->remote_addr)->sin6_addr.s6_addr,
+					 sizeof(struct net_in6_addr),
+					 net_sin6(&conn->local_addr)->sin6_port,
+					 net_sin6(&conn->remote_addr)->sin6_port);
+	}
+
+	return conn_tuple_bucket(conn->family, conn->proto,
+				 net_sin(&conn->local_addr)->sin_addr.s4_addr,
+				 net_sin(&conn->remote_addr)->sin_addr.s4_addr,
+				 sizeof(struct net_in_addr),
+				 net_sin(&conn->local_addr)->sin_port,
+				 net_sin(&conn->remote_addr)->sin_port);
+}
+
+/* Must be called with conn_lock held */
+static void conn_hash_add(struct net_conn *conn)
+{
+	if ((conn->flags & NET_CONN_LOCAL_PORT_SPEC) != 0U) {
+		sys_slist_prepend(conn_port_bucket(net_sin(&conn->local_addr)->sin_port),
+				  &conn->hash_node);
+	} else {
+		sys_slist_prepend(&conn_wildcard, &conn->hash_node);
+	}
+
+	conn->tuple_hashed = conn_is_fully_specified(conn);
+	if (conn->tuple_hashed) {
+		sys_slist_prepend(conn_tuple_bucket_of(conn), &conn->tuple_node);
+	}
+}
+
+/* Must be called with conn_lock held, before the addresses change */
+static void conn_hash_remove(struct net_conn *conn)
+{
+	if ((conn->flags & NET_CONN_LOCAL_PORT_SPEC) != 0U) {
+		sys_slist_find_and_remove(
+			conn_port_bucket(net_sin(&conn->local_addr)->sin_port),
+			&conn->hash_node);
+	} else {
+		sys_slist_find_and_remove(&conn_wildcard, &conn->hash_node);
+	}
+
+	if (conn->tuple_hashed) {
+		sys_slist_find_and_remove(conn_tuple_bucket_of(conn), &conn->tuple_node);
+		conn->tuple_hashed = 0U;
+	}
+}
+#else
+#define CONN_LOOKUP_NODE node
+#define conn_hash_add(conn)
+#define conn_hash_remove(conn)
+#endif /* CONFIG_NET_CONN_HASH */
+
 #if (CONFIG_NET_CONN_LOG_LEVEL >= LOG_LEVEL_DBG)
 static inline
 void conn_register_debug(struct net_conn *conn,
@@ -138,6 +257,7 @@ static void conn_set_used(struct net_conn *conn)
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_prepend(&conn_used, &conn->node);
+	conn_hash_add(conn);
 	k_mutex_unlock(&conn_lock);
 }
 
@@ -150,119 +270,154 @@ static void conn_set_unused(struct net_conn *conn)
 	k_mutex_unlock(&conn_lock);
 }
 
-/* Check if we already have identical connection handler installed. */
-static struct net_conn *conn_find_handler(struct net_if *iface,
-					  uint16_t proto, uint8_t family,
-					  const struct net_sockaddr *remote_addr,
-					  const struct net_sockaddr *local_addr,
-					  uint16_t remote_port,
-					  uint16_t local_port,
-					  bool reuseport_set)
+/* Is the connection handler identical to the one being registered? */
+static bool conn_handler_match(struct net_conn *conn, struct net_if *iface,
+			       uint16_t proto, uint8_t family,
+			       const struct net_sockaddr *remote_addr,
+			       const struct net_sockaddr *local_addr,
+			       uint16_t remote_port,
+			       uint16_t local_port,
+			       bool reuseport_set)
 {
-	struct net_conn *conn;
-	struct net_conn *tmp;
-
-	k_mutex_lock(&conn_lock, K_FOREVER);
+	if (conn->proto != proto) {
+		return false;
+	}
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&conn_used, conn, tmp, node) {
-		if (conn->proto != proto) {
-			continue;
-		}
+	if (conn->family != family) {
+		return false;
+	}
 
-		if (conn->family != family) {
-			continue;
+	if (local_addr) {
+		if (!(conn->flags & NET_CONN_LOCAL_ADDR_SET)) {
+			return false;
 		}
 
-		if (local_addr) {
-			if (!(conn->flags & NET_CONN_LOCAL_ADDR_SET)) {
-				continue;
+		if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		    local_addr->sa_family == NET_AF_INET6 &&
+		    local_addr->sa_family ==
+		    conn->local_addr.sa_family) {
+			if (!net_ipv6_addr_cmp(
+				    &net_sin6(local_addr)->sin6_addr,
+				    &net_sin6(&conn->local_addr)->
+							sin6_addr)) {
+				return false;
 			}
-
-			if (IS_ENABLED(CONFIG_NET_IPV6) &&
-			    local_addr->sa_family == NET_AF_INET6 &&
-			    local_addr->sa_family ==
-			    conn->local_addr.sa_family) {
-				if (!net_ipv6_addr_cmp(
-					    &net_sin6(local_addr)->sin6_addr,
-					    &net_sin6(&conn->local_addr)->
-								sin6_addr)) {
-					continue;
-				}
-			} else if (IS_ENABLED(CONFIG_NET_IPV4) &&
-				   local_addr->sa_family == NET_AF_INET &&
-				   local_addr->sa_family ==
-				   conn->local_addr.sa_family) {
-				if (!net_ipv4_addr_cmp(
-					    &net_sin(local_addr)->sin_addr,
-					    &net_sin(&conn->local_addr)->
-								sin_addr)) {
-					continue;
-				}
-			} else {
-				continue;
+		} else if (IS_ENABLED(CONFIG_NET_IPV4) &&
+			   local_addr->sa_family == NET_AF_INET &&
+			   local_addr->sa_family ==
+			   conn->local_addr.sa_family) {
+			if (!net_ipv4_addr_cmp(
+				    &net_sin(local_addr)->sin_addr,
+				    &net_sin(&conn->local_addr)->
+							sin_addr)) {
+				return false;
 			}
-		} else if (conn->flags & NET_CONN_LOCAL_ADDR_SET) {
-			continue;
+		} else {
+			return false;
 		}
+	} else if (conn->flags & NET_CONN_LOCAL_ADDR_SET) {
+		return false;
+	}
 
-		if (net_sin(&conn->local_addr)->sin_port !=
-		    net_htons(local_port)) {
-			continue;
+	if (net_sin(&conn->local_addr)->sin_port !=
+	    net_htons(local_port)) {
+		return false;
+	}
+
+	if (remote_addr) {
+		if (!(conn->flags & NET_CONN_REMOTE_ADDR_SET)) {
+			return false;
 		}
 
-		if (remote_addr) {
-			if (!(conn->flags & NET_CONN_REMOTE_ADDR_SET)) {
-				continue;
+		if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		    remote_addr->sa_family == NET_AF_INET6 &&
+		    remote_addr->sa_family ==
+		    conn->remote_addr.sa_family) {
+			if (!net_ipv6_addr_cmp(
+				    &net_sin6(remote_addr)->sin6_addr,
+				    &net_sin6(&conn->remote_addr)->
+							sin6_addr)) {
+				return false;
 			}
-
-			if (IS_ENABLED(CONFIG_NET_IPV6) &&
-			    remote_addr->sa_family == NET_AF_INET6 &&
-			    remote_addr->sa_family ==
-			    conn->remote_addr.sa_family) {
-				if (!net_ipv6_addr_cmp(
-					    &net_sin6(remote_addr)->sin6_addr,
-					    &net_sin6(&conn->remote_addr)->
-								sin6_addr)) {
-					continue;
-				}
-			} else if (IS_ENABLED(CONFIG_NET_IPV4) &&
-				   remote_addr->sa_family == NET_AF_INET &&
-				   remote_addr->sa_family ==
-				   conn->remote_addr.sa_family) {
-				if (!net_ipv4_addr_cmp(
-					    &net_sin(remote_addr)->sin_addr,
-					    &net_sin(&conn->remote_addr)->
-								sin_addr)) {
-					continue;
-				}
-			} else {
-				continue;
+		} else if (IS_ENABLED(CONFIG_NET_IPV4) &&
+			   remote_addr->sa_family == NET_AF_INET &&
+			   remote_addr->sa_family ==
+			   conn->remote_addr.sa_family) {
+			if (!net_ipv4_addr_cmp(
+				    &net_sin(remote_addr)->sin_addr,
+				    &net_sin(&conn->remote_addr)->
+							sin_addr)) {
+				return false;
 			}
-		} else if (conn->flags & NET_CONN_REMOTE_ADDR_SET) {
-			continue;
-		} else if (reuseport_set && conn->context != NULL &&
-			   net_context_is_reuseport_set(conn->context)) {
-			continue;
+		} else {
+			return false;
 		}
+	} else if (conn->flags & NET_CONN_REMOTE_ADDR_SET) {
+		return false;
+	} else if (reuseport_set && conn->context != NULL &&
+		   net_context_is_reuseport_set(conn->context)) {
+		return false;
+	}
 
-		if (net_sin(&conn->remote_addr)->sin_port !=
-		    net_htons(remote_port)) {
+	if (net_sin(&conn->remote_addr)->sin_port !=
+	    net_htons(remote_port)) {
+		return false;
+	}
+
+	if (conn->context != NULL && iface != NULL &&
+	    net_context_is_bound_to_iface(conn->context)) {
+		if (iface != net_context_get_iface(conn->context)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/* Check if we already have identical connection handler installed. */
+static struct net_conn *conn_find_handler(struct net_if *iface,
+					  uint16_t proto, uint8_t family,
+					  const struct net_sockaddr *remote_addr,
+					  const struct net_sockaddr *local_addr,
+					  uint16_t remote_port,
+					  uint16_t local_port,
+					  bool reuseport_set)
+{
+	struct net_conn *conn;
+
+	k_mutex_lock(&conn_lock, K_FOREVER);
+
+#if defined(CONFIG_NET_CONN_HASH)
+	/* A handler with the same local port is either hashed by that
+	 * port or, if its port was not specified, in the wildcard list.
+	 */
+	sys_slist_t *lists[] = {
+		local_port != 0U ? conn_port_bucket(net_htons(local_port)) : NULL,
+		&conn_wildcard,
+	};
+#else
+	sys_slist_t *lists[] = { &conn_used };
+#endif /* CONFIG_NET_CONN_HASH */
+
+	ARRAY_FOR_EACH(lists, i) {
+		if (lists[i] == NULL) {
 			continue;
 		}
 
-		if (conn->context != NULL && iface != NULL &&
-		    net_context_is_bound_to_iface(conn->context)) {
-			if (iface != net_context_get_iface(conn->context)) {
-				continue;
+		SYS_SLIST_FOR_EACH_CONTAINER(lists[i], conn, CONN_LOOKUP_NODE) {
+			if (conn_handler_match(conn, iface, proto, family,
+					       remote_addr, local_addr,
+					       remote_port, local_port,
+					       reuseport_set)) {
+				goto out;
 			}
 		}
-
-		k_mutex_unlock(&conn_lock);
-		return conn;
 	}
 
+	conn = NULL;
+out:
 	k_mutex_unlock(&conn_lock);
-	return NULL;
+	return conn;
 }
 
 static void net_conn_change_callback(struct net_conn *conn,
@@ -463,6 +618,7 @@ int net_conn_unregister(struct net_conn_handle *handle)
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_find_and_remove(&conn_used, &conn->node);
+	conn_hash_remove(conn);
 	k_mutex_unlock(&conn_lock);
 
 	conn_set_unused(conn);
@@ -491,12 +647,17 @@ int net_conn_update(struct net_conn_handle *handle,
 
 	net_conn_change_callback(conn, cb, user_data);
 
+	/* The addresses and ports decide where the connection is hashed */
+	k_mutex_lock(&conn_lock, K_FOREVER);
+	conn_hash_remove(conn);
+
 	ret = net_conn_change_local(conn, local_addr, local_port);
-	if (ret < 0) {
-		return ret;
+	if (ret == 0) {
+		ret = net_conn_change_remote(conn, remote_addr, remote_port);
 	}
 
-	ret = net_conn_change_remote(conn, remote_addr, remote_port);
+	conn_hash_add(conn);
+	k_mutex_unlock(&conn_lock);
 
 	return ret;
 }
@@ -844,6 +1005,125 @@ enum net_verdict net_conn_can_input(struct net_pkt *pkt, uint8_t proto)
 }
 #endif /* defined(CONFIG_NET_SOCKETS_CAN) */
 
+/* Is the candidate TCP/UDP connection matching the received packet? */
+static bool conn_input_match(struct net_conn *conn, struct net_pkt *pkt,
+			     union net_ip_header *ip_hdr, uint8_t proto,
+			     uint16_t src_port, uint16_t dst_port)
+{
+	uint8_t pkt_family = net_pkt_family(pkt);
+
+	/* Is the candidate connection matching the packet's interface? */
+	if (!is_iface_matching(conn, pkt)) {
+		return false; /* wrong interface */
+	}
+
+	/* Is the candidate connection matching the packet's protocol family? */
+	if (conn->family != NET_AF_UNSPEC && conn->family != pkt_family) {
+		if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
+			if (!(conn->family == NET_AF_INET6 && pkt_family == NET_AF_INET &&
+			      !conn->v6only && conn->type != NET_SOCK_RAW)) {
+				return false;
+			}
+		} else {
+			return false; /* wrong protocol family */
+		}
+
+		/* We might have a match for v4-to-v6 mapping, check more */
+	}
+
+	/* Is the candidate connection matching the packet's protocol within the family? */
+	if (conn->proto != proto) {
+		return false; /* wrong protocol */
+	}
+
+	/* Apply protocol-specific matching criteria... */
+	uint8_t conn_family = conn->family;
+
+	if (!((IS_ENABLED(CONFIG_NET_UDP) || IS_ENABLED(CONFIG_NET_TCP)) &&
+	      (conn_family == NET_AF_INET || conn_family == NET_AF_INET6 ||
+	       conn_family == NET_AF_UNSPEC))) {
+		return false;
+	}
+
+	/* Is the candidate connection matching the packet's TCP/UDP
+	 * address and port?
+	 */
+	if ((conn->flags & NET_CONN_REMOTE_PORT_SPEC) != 0 &&
+	    net_sin(&conn->remote_addr)->sin_port != src_port) {
+		return false; /* wrong remote port */
+	}
+
+	if ((conn->flags & NET_CONN_LOCAL_PORT_SPEC) != 0 &&
+	    net_sin(&conn->local_addr)->sin_port != dst_port) {
+		return false; /* wrong local port */
+	}
+
+	if ((conn->flags & NET_CONN_REMOTE_ADDR_SET) != 0 &&
+	    !conn_addr_cmp(pkt, ip_hdr, &conn->remote_addr, true)) {
+		return false; /* wrong remote address */
+	}
+
+	if ((conn->flags & NET_CONN_LOCAL_ADDR_SET) != 0 &&
+	    !conn_addr_cmp(pkt, ip_hdr, &conn->local_addr, false)) {
+
+		/* Check if we could do a v4-mapping-to-v6 and the IPv6 socket
+		 * has no IPV6_V6ONLY option set and if the local IPV6 address
+		 * is unspecified, then we could accept a connection from IPv4
+		 * address by mapping it to IPv6 address.
+		 */
+		if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
+			if (!(conn->family == NET_AF_INET6 &&
+			      pkt_family == NET_AF_INET &&
+			      !conn->v6only &&
+			      net_ipv6_is_addr_unspecified(
+				      &net_sin6(&conn->local_addr)->sin6_addr))) {
+				return false; /* wrong local address */
+			}
+		} else {
+			return false; /* wrong local address */
+		}
+
+		/* We might have a match for v4-to-v6 mapping,
+		 * continue with rank checking.
+		 */
+	}
+
+	return true;
+}
+
+#if defined(CONFIG_NET_CONN_HASH)
+static struct net_conn *conn_tuple_lookup(struct net_pkt *pkt,
+					  union net_ip_header *ip_hdr,
+					  uint8_t proto,
+					  uint16_t src_port, uint16_t dst_port)
+{
+	uint8_t pkt_family = net_pkt_family(pkt);
+	sys_slist_t *bucket;
+	struct net_conn *conn;
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && pkt_family == NET_AF_INET6) {
+		bucket = conn_tuple_bucket(pkt_family, proto, ip_hdr->ipv6->dst,
+					   ip_hdr->ipv6->src, sizeof(struct net_in6_addr),
+					   dst_port, src_port);
+	} else if (IS_ENABLED(CONFIG_NET_IPV4) && pkt_family == NET_AF_INET) {
+		bucket = conn_tuple_bucket(pkt_family, proto, ip_hdr->ipv4->dst,
+					   ip_hdr->ipv4->src, sizeof(struct net_in_addr),
+					   dst_port, src_port);
+	} else {
+		return NULL;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(bucket, conn, tuple_node) {
+		if (conn->family == pkt_family &&
+		    conn_input_match(conn, pkt, ip_hdr, proto, src_port, dst_port)) {
+			return conn;
+		}
+	}
+
+	return NULL;
+}
+#endif /* CONFIG_NET_CONN_HASH */
+
 enum net_verdict net_conn_input(struct net_pkt *pkt,
 				union net_ip_header *ip_hdr,
 				uint8_t proto,
@@ -909,119 +1189,75 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
-		/* Is the candidate connection matching the packet's interface? */
-		if (!is_iface_matching(conn, pkt)) {
-			continue; /* wrong interface */
-		}
-
-		/* Is the candidate connection matching the packet's protocol family? */
-		if (conn->family != NET_AF_UNSPEC && conn->family != pkt_family) {
-			if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
-				if (!(conn->family == NET_AF_INET6 && pkt_family == NET_AF_INET &&
-				      !conn->v6only && conn->type != NET_SOCK_RAW)) {
-					continue;
-				}
-			} else {
-				continue; /* wrong protocol family */
-			}
+#if defined(CONFIG_NET_CONN_HASH)
+	/* A fully specified connection has the highest possible rank and
+	 * is unique, so for unicast it is the best match if there is one.
+	 * Otherwise fall back to the handlers listening on the destination
+	 * port and to the ones listening on any port.
+	 */
+	if (!is_mcast_pkt && !is_bcast_pkt) {
+		best_match = conn_tuple_lookup(pkt, ip_hdr, proto, src_port, dst_port);
+	}
 
-			/* We might have a match for v4-to-v6 mapping, check more */
-		}
+	sys_slist_t *lists[] = {
+		best_match == NULL ? conn_port_bucket(dst_port) : NULL,
+		best_match == NULL ? &conn_wildcard : NULL,
+	};
+#else
+	sys_slist_t *lists[] = { &conn_used };
+#endif /* CONFIG_NET_CONN_HASH */
 
-		/* Is the candidate connection matching the packet's protocol within the family? */
-		if (conn->proto != proto) {
-			continue; /* wrong protocol */
+	ARRAY_FOR_EACH(lists, i) {
+		if (lists[i] == NULL) {
+			continue;
 		}
 
-		/* Apply protocol-specific matching criteria... */
-		uint8_t conn_family = conn->family;
+		SYS_SLIST_FOR_EACH_CONTAINER(lists[i], conn, CONN_LOOKUP_NODE) {
+			struct net_pkt *mcast_pkt;
 
-		if ((IS_ENABLED(CONFIG_NET_UDP) || IS_ENABLED(CONFIG_NET_TCP)) &&
-		    (conn_family == NET_AF_INET || conn_family == NET_AF_INET6 ||
-		     conn_family == NET_AF_UNSPEC)) {
-			/* Is the candidate connection matching the packet's TCP/UDP
-			 * address and port?
-			 */
-			if ((conn->flags & NET_CONN_REMOTE_PORT_SPEC) != 0 &&
-			    net_sin(&conn->remote_addr)->sin_port != src_port) {
-				continue; /* wrong remote port */
+			if (!conn_input_match(conn, pkt, ip_hdr, proto, src_port, dst_port)) {
+				continue;
 			}
 
-			if ((conn->flags & NET_CONN_LOCAL_PORT_SPEC) != 0 &&
-			    net_sin(&conn->local_addr)->sin_port != dst_port) {
-				continue; /* wrong local port */
+			if (best_rank >= NET_CONN_RANK(conn->flags)) {
+				continue;
 			}
 
-			if ((conn->flags & NET_CONN_REMOTE_ADDR_SET) != 0 &&
-			    !conn_addr_cmp(pkt, ip_hdr, &conn->remote_addr, true)) {
-				continue; /* wrong remote address */
+			if (!is_mcast_pkt) {
+				best_rank = NET_CONN_RANK(conn->flags);
+				best_match = conn;
+
+				continue; /* found a match - but maybe not yet the best */
 			}
 
-			if ((conn->flags & NET_CONN_LOCAL_ADDR_SET) != 0 &&
-			    !conn_addr_cmp(pkt, ip_hdr, &conn->local_addr, false)) {
-
-				/* Check if we could do a v4-mapping-to-v6 and the IPv6 socket
-				 * has no IPV6_V6ONLY option set and if the local IPV6 address
-				 * is unspecified, then we could accept a connection from IPv4
-				 * address by mapping it to IPv6 address.
-				 */
-				if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
-					if (!(conn->family == NET_AF_INET6 &&
-					      pkt_family == NET_AF_INET &&
-					      !conn->v6only &&
-					      net_ipv6_is_addr_unspecified(
-						      &net_sin6(&conn->local_addr)->sin6_addr))) {
-						continue; /* wrong local address */
-					}
-				} else {
-					continue; /* wrong local address */
-				}
-
-				/* We might have a match for v4-to-v6 mapping,
-				 * continue with rank checking.
-				 */
+			/* If we have a multicast packet, and we found
+			 * a match, then deliver the packet immediately
+			 * to the handler. As there might be several
+			 * sockets interested about these, we need to
+			 * clone the received pkt.
+			 */
+
+			NET_DBG("[%p] mcast match found cb %p ud %p", conn, conn->cb,
+				conn->user_data);
+
+			mcast_pkt = net_pkt_clone(
+				pkt, K_MSEC(CONFIG_NET_CONN_PACKET_CLONE_TIMEOUT));
+			if (!mcast_pkt) {
+				k_mutex_unlock(&conn_lock);
+				goto drop;
 			}
 
-			if (best_rank < NET_CONN_RANK(conn->flags)) {
-				struct net_pkt *mcast_pkt;
-
-				if (!is_mcast_pkt) {
-					best_rank = NET_CONN_RANK(conn->flags);
-					best_match = conn;
-
-					continue; /* found a match - but maybe not yet the best */
-				}
-
-				/* If we have a multicast packet, and we found
-				 * a match, then deliver the packet immediately
-				 * to the handler. As there might be several
-				 * sockets interested about these, we need to
-				 * clone the received pkt.
-				 */
-
-				NET_DBG("[%p] mcast match found cb %p ud %p", conn, conn->cb,
-					conn->user_data);
-
-				mcast_pkt = net_pkt_clone(
-					pkt, K_MSEC(CONFIG_NET_CONN_PACKET_CLONE_TIMEOUT));
-				if (!mcast_pkt) {
-					k_mutex_unlock(&conn_lock);
-					goto drop;
-				}
-
-				if (conn->cb(conn, mcast_pkt, ip_hdr, proto_hdr, conn->user_data) ==
-				    NET_DROP) {
-					net_stats_update_per_proto_drop(pkt_iface, proto);
-					net_pkt_unref(mcast_pkt);
-				} else {
-					net_stats_update_per_proto_recv(pkt_iface, proto);
-				}
-
-				mcast_pkt_delivered = true;
+			if (conn->cb(conn, mcast_pkt, ip_hdr, proto_hdr, conn->user_data) ==
+			    NET_DROP) {
+				net_stats_update_per_proto_drop(pkt_iface, proto);
+				net_pkt_unref(mcast_pkt);
+			} else {
+				net_stats_update_per_proto_recv(pkt_iface, proto);
 			}
+
+			mcast_pkt_delivered = true;
 		}
-	} /* loop end */
+	}
 
 	if (best_match != NULL) {
 		cb = best_match->cb;
@@ -1092,6 +1328,15 @@ void net_conn_init(void)
 	sys_slist_init(&conn_unused);
 	sys_slist_init(&conn_used);
 
+#if defined(CONFIG_NET_CONN_HASH)
+	sys_slist_init(&conn_wildcard);
+
+	ARRAY_FOR_EACH(conn_port_hash, j) {
+		sys_slist_init(&conn_port_hash[j]);
+		sys_slist_init(&conn_tuple_hash[j]);
+	}
+#endif /* CONFIG_NET_CONN_HASH */
+
 	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
 		sys_slist_prepend(&conn_unused, &conns[i].node);
 	}
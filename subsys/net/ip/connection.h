@@ -85,6 +85,17 @@ struct net_conn {
 
 	/** Is v4-mapping-to-v6 enabled for this connection */
 	uint8_t v6only : 1;
+
+#if defined(CONFIG_NET_CONN_HASH)
+	/** Is the connection in the 5-tuple hash */
+	uint8_t tuple_hashed : 1;
+
+	/** Local port hash (or wildcard list) node */
+	sys_snode_t hash_node;
+
+	/** 5-tuple hash node */
+	sys_snode_t tuple_node;
+#endif
 };
 
 /**
@@ -2157,12 +2157,138 @@ static int context_write_data(struct net_pkt *pkt, const void *buf,
 	return ret;
 }
 
+#if defined(CONFIG_NET_CONTEXT_SENDMSG_ZEROCOPY)
+struct context_zerocopy {
+	struct net_buf_ext ext;
+	struct k_sem done;
+	bool attached;
+};
+
+static void context_zerocopy_release(struct net_buf_ext *ext)
+{
+	struct context_zerocopy *zc = CONTAINER_OF(ext, struct context_zerocopy, ext);
+
+	k_sem_give(&zc->done);
+}
+
+/* Datagrams sent to one of our own addresses are given to the receiving
+ * context as they are, the iovecs would then stay referenced until the
+ * data is read. TCP segments are copied out of the send queue, they do not
+ * reference the iovecs.
+ */
+static bool context_zerocopy_dst_is_local(net_sa_family_t family,
+					  const struct net_sockaddr *dst_addr)
+{
+	if (IS_ENABLED(CONFIG_NET_IPV6) && family == NET_AF_INET6) {
+		const uint8_t *addr = net_sin6(dst_addr)->sin6_addr.s6_addr;
+
+		return net_ipv6_is_addr_loopback_raw(addr) ||
+		       net_ipv6_is_my_addr_raw(addr) ||
+		       net_ipv6_is_addr_mcast_iface_raw(addr);
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && family == NET_AF_INET) {
+		const uint8_t *addr = net_sin(dst_addr)->sin_addr.s4_addr;
+
+		return net_ipv4_is_addr_loopback_raw(addr) || net_ipv4_is_my_addr_raw(addr);
+	}
+
+	return true;
+}
+
+/* Only sends without a timeout attach the iovecs, as the caller waits for
+ * their release and cannot be given them back earlier. UDP releases them
+ * once the driver sent the packet, TCP once the data is acknowledged.
+ */
+static struct net_buf_ext *context_zerocopy_init(struct context_zerocopy *zc,
+						 struct net_context *context,
+						 const struct net_msghdr *msghdr,
+						 size_t len, k_timeout_t timeout,
+						 net_sa_family_t family,
+						 const struct net_sockaddr *dst_addr)
+{
+	enum net_ip_protocol proto = net_context_get_proto(context);
+
+	if (zc == NULL || msghdr == NULL || dst_addr == NULL ||
+	    len < CONFIG_NET_CONTEXT_SENDMSG_ZEROCOPY_THRESHOLD ||
+	    !K_TIMEOUT_EQ(timeout, K_FOREVER) || k_is_in_isr() ||
+	    !((IS_ENABLED(CONFIG_NET_UDP) && proto == NET_IPPROTO_UDP &&
+	       net_context_get_type(context) == NET_SOCK_DGRAM) ||
+	      (IS_ENABLED(CONFIG_NET_NATIVE_TCP) && proto == NET_IPPROTO_TCP)) ||
+	    net_if_is_ip_offloaded(net_context_get_iface(context))) {
+		return NULL;
+	}
+
+	if (proto == NET_IPPROTO_UDP && context_zerocopy_dst_is_local(family, dst_addr)) {
+		return NULL;
+	}
+
+	net_buf_ext_init(&zc->ext, context_zerocopy_release);
+	k_sem_init(&zc->done, 0, 1);
+	zc->attached = true;
+
+	return &zc->ext;
+}
+
+/* Wait until the network stack does not reference the iovecs anymore. This
+ * is called without the context lock, as the packet may wait for address
+ * resolution, in a driver queue or for its acknowledgment while the context
+ * receives data. The socket lock is released as well, as when waiting for
+ * send buffers.
+ */
+static void context_zerocopy_wait(struct net_context *context, struct context_zerocopy *zc)
+{
+	bool unlocked;
+
+	if (!zc->attached) {
+		return;
+	}
+
+	unlocked = context->cond.lock != NULL && k_mutex_unlock(context->cond.lock) == 0;
+
+	net_buf_ext_unref(&zc->ext);
+	k_sem_take(&zc->done, K_FOREVER);
+
+	if (unlocked) {
+		(void)k_mutex_lock(context->cond.lock, K_FOREVER);
+	}
+}
+
+/* Same as context_write_data() but the iovecs of msghdr are attached to
+ * net_pkt instead of being copied.
+ */
+static int context_append_ext(struct net_pkt *pkt, struct net_buf_ext *ext,
+			      int buf_len, const struct net_msghdr *msghdr)
+{
+	int ret = 0;
+
+	for (int i = 0; i < msghdr->msg_iovlen && buf_len > 0; i++) {
+		int len = MIN(msghdr->msg_iov[i].iov_len, buf_len);
+
+		ret = net_pkt_append_ext(pkt, ext, msghdr->msg_iov[i].iov_base,
+					 len, PKT_WAIT_TIME);
+		if (ret < 0) {
+			break;
+		}
+
+		buf_len -= len;
+	}
+
+	return ret;
+}
+#else
+struct context_zerocopy;
+
+#define context_append_ext(...) -ENOTSUP
+#endif /* CONFIG_NET_CONTEXT_SENDMSG_ZEROCOPY */
+
 static int context_setup_udp_packet(struct net_context *context,
 				    net_sa_family_t family,
 				    struct net_pkt *pkt,
 				    const void *buf,
 				    size_t len,
 				    const struct net_msghdr *msg,
+				    struct net_buf_ext *ext,
 				    const struct net_sockaddr *dst_addr,
 				    net_socklen_t addrlen)
 {
@@ -2202,7 +2328,12 @@ static int context_setup_udp_packet(struct net_context *context,
 		return ret;
 	}
 
-	ret = context_write_data(pkt, buf, len, msg);
+	if (ext != NULL) {
+		ret = context_append_ext(pkt, ext, len, msg);
+	} else {
+		ret = context_write_data(pkt, buf, len, msg);
+	}
+
 	if (ret) {
 		return ret;
 	}
@@ -2390,9 +2521,11 @@ static int context_sendto(struct net_context *context,
 			  net_context_send_cb_t cb,
 			  k_timeout_t timeout,
 			  void *user_data,
-			  bool sendto)
+			  bool sendto,
+			  struct context_zerocopy *zc)
 {
 	const struct net_msghdr *msghdr = NULL;
+	struct net_buf_ext *ext = NULL;
 	struct net_if *iface = NULL;
 	struct net_pkt *pkt = NULL;
 	net_sa_family_t family;
@@ -2682,13 +2815,20 @@ static int context_sendto(struct net_context *context,
 	context->send_cb = cb;
 	context->user_data = user_data;
 
+#if defined(CONFIG_NET_CONTEXT_SENDMSG_ZEROCOPY)
+	ext = context_zerocopy_init(zc, context, msghdr, len, timeout, family, dst_addr);
+#else
+	ARG_UNUSED(zc);
+#endif
+
 	if (IS_ENABLED(CONFIG_NET_TCP) &&
 	    net_context_get_proto(context) == NET_IPPROTO_TCP &&
 	    !net_if_is_ip_offloaded(net_context_get_iface(context))) {
 		goto skip_alloc;
 	}
 
-	pkt = context_alloc_pkt(context, family, len, PKT_WAIT_TIME);
+	/* Attached iovecs only need buffer space for the headers */
+	pkt = context_alloc_pkt(context, family, ext != NULL ? 0 : len, PKT_WAIT_TIME);
 	if (!pkt) {
 		NET_ERR("Failed to allocate net_pkt");
 		return -ENOBUFS;
@@ -2696,7 +2836,7 @@ static int context_sendto(struct net_context *context,
 
 	tmp_len = net_pkt_available_payload_buffer(
 				pkt, net_context_get_proto(context));
-	if (tmp_len < len) {
+	if (ext == NULL && tmp_len < len) {
 		if (net_context_get_type(context) == NET_SOCK_DGRAM ||
 		    net_context_get_type(context) == NET_SOCK_RAW) {
 			NET_ERR("Available payload buffer (%zu) is not enough for requested DGRAM (%zu)",
@@ -2762,7 +2902,7 @@ skip_alloc:
 	} else if (IS_ENABLED(CONFIG_NET_UDP) &&
 	    net_context_get_proto(context) == NET_IPPROTO_UDP) {
 		ret = context_setup_udp_packet(context, family, pkt, buf, len, msghdr,
-					       dst_addr, addrlen);
+					       ext, dst_addr, addrlen);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -2773,7 +2913,7 @@ skip_alloc:
 	} else if (IS_ENABLED(CONFIG_NET_TCP) &&
 		   net_context_get_proto(context) == NET_IPPROTO_TCP) {
 
-		ret = net_tcp_queue(context, buf, len, msghdr);
+		ret = net_tcp_queue(context, buf, len, msghdr, ext);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -2955,7 +3095,7 @@ int net_context_send(struct net_context *context,
 	}
 
 	ret = context_sendto(context, buf, len, &context->remote,
-			     addrlen, cb, timeout, user_data, false);
+			     addrlen, cb, timeout, user_data, false, NULL);
 unlock:
 	k_mutex_unlock(&context->lock);
 
@@ -2970,14 +3110,22 @@ int net_context_sendmsg(struct net_context *context,
 			void *user_data)
 {
 	int ret;
+#if defined(CONFIG_NET_CONTEXT_SENDMSG_ZEROCOPY)
+	struct context_zerocopy zc = { 0 };
+#endif
 
 	k_mutex_lock(&context->lock, K_FOREVER);
 
 	ret = context_sendto(context, msghdr, 0, NULL, 0,
-			     cb, timeout, user_data, true);
+			     cb, timeout, user_data, true,
+			     COND_CODE_1(CONFIG_NET_CONTEXT_SENDMSG_ZEROCOPY, (&zc), (NULL)));
 
 	k_mutex_unlock(&context->lock);
 
+#if defined(CONFIG_NET_CONTEXT_SENDMSG_ZEROCOPY)
+	context_zerocopy_wait(context, &zc);
+#endif
+
 	return ret;
 }
 
@@ -2995,7 +3143,7 @@ int net_context_sendto(struct net_context *context,
 	k_mutex_lock(&context->lock, K_FOREVER);
 
 	ret = context_sendto(context, buf, len, dst_addr, addrlen,
-			     cb, timeout, user_data, true);
+			     cb, timeout, user_data, true, NULL);
 
 	k_mutex_unlock(&context->lock);
 
@@ -1763,6 +1763,48 @@ void net_pkt_append_buffer(struct net_pkt *pkt, struct net_buf *buffer)
 	}
 }
 
+#if defined(CONFIG_NET_BUF_EXTERNAL_REF)
+int net_pkt_append_ext(struct net_pkt *pkt, struct net_buf_ext *ext,
+		       const void *data, size_t len, k_timeout_t timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	struct net_buf_pool *pool = NULL;
+	const uint8_t *pos = data;
+
+	if (k_is_in_isr()) {
+		end = sys_timepoint_calc(K_NO_WAIT);
+	}
+
+	if (pkt->context) {
+		pool = get_data_pool(pkt->context);
+	}
+
+	if (!pool) {
+		pool = pkt->slab == &tx_pkts ? &tx_bufs : &rx_bufs;
+	}
+
+	while (len > 0) {
+		/* The length of a buffer is 16 bits wide */
+		size_t frag_len = MIN(len, UINT16_MAX);
+		struct net_buf *buf;
+
+		buf = net_buf_alloc_with_ext(pool, ext, pos, frag_len,
+					     sys_timepoint_timeout(end));
+		if (!buf) {
+			NET_ERR("External buffer (%zu) allocation failed.", frag_len);
+			return -ENOMEM;
+		}
+
+		net_pkt_append_buffer(pkt, buf);
+
+		pos += frag_len;
+		len -= frag_len;
+	}
+
+	return 0;
+}
+#endif /* CONFIG_NET_BUF_EXTERNAL_REF */
+
 void net_pkt_cursor_init(struct net_pkt *pkt)
 {
 	pkt->cursor.buf = pkt->buffer;
@@ -2198,6 +2240,41 @@ size_t net_pkt_remaining_data(struct net_pkt *pkt)
 	return data_length;
 }
 
+size_t net_pkt_remaining_iov(struct net_pkt *pkt, struct net_iovec *iov,
+			     size_t iovcnt, size_t *len)
+{
+	struct net_buf *buf;
+	uint8_t *pos;
+	size_t count = 0;
+
+	*len = 0;
+
+	if (!pkt || !pkt->cursor.buf || !pkt->cursor.pos) {
+		return 0;
+	}
+
+	buf = pkt->cursor.buf;
+	pos = pkt->cursor.pos;
+
+	while (buf && count < iovcnt) {
+		size_t frag_len = buf->len - (pos - buf->data);
+
+		if (frag_len > 0) {
+			iov[count].iov_base = pos;
+			iov[count].iov_len = frag_len;
+			*len += frag_len;
+			count++;
+		}
+
+		buf = buf->frags;
+		if (buf) {
+			pos = buf->data;
+		}
+	}
+
+	return count;
+}
+
 int net_pkt_update_length(struct net_pkt *pkt, size_t length)
 {
 	struct net_buf *buf;
@@ -2239,7 +2316,12 @@ int net_pkt_pull(struct net_pkt *pkt, size_t length)
 
 		c_op->buf->len -= rem;
 		left -= rem;
-		if (left) {
+		if (left && c_op->pos == c_op->buf->data &&
+		    (c_op->buf->flags & NET_BUF_EXTERNAL_DATA)) {
+			/* External data may be read-only, move its start instead */
+			c_op->buf->data += rem;
+			c_op->pos = c_op->buf->data;
+		} else if (left) {
 			memmove(c_op->pos, c_op->pos+rem, left);
 		} else {
 			struct net_buf *buf = pkt->buffer;
@@ -10,6 +10,7 @@ LOG_MODULE_REGISTER(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
 #include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <limits.h>
 #include <zephyr/kernel.h>
 #include <zephyr/random/random.h>
 
@@ -65,10 +66,6 @@ static int tcp_tx_window =
 #define TCP_RTO_MS (tcp_rto)
 #endif
 
-/* Define the number of MSS sections the congestion window is initialized at */
-#define TCP_CONGESTION_INITIAL_WIN 1
-#define TCP_CONGESTION_INITIAL_SSTHRESH 3
-
 static sys_slist_t tcp_conns = SYS_SLIST_STATIC_INIT(&tcp_conns);
 
 static K_MUTEX_DEFINE(tcp_lock);
@@ -499,7 +496,7 @@ static void tcp_derive_rto(struct tcp *conn)
 
 static void tcp_new_reno_log(struct tcp *conn, char *step)
 {
-	NET_DBG("[%p] ca %s, cwnd=%d, ssthres=%d, fast_pend=%i",
+	NET_DBG("[%p] ca %s, cwnd=%u, ssthres=%u, fast_pend=%i",
 		conn, step, conn->ca.cwnd, conn->ca.ssthresh,
 		conn->ca.pending_fast_retransmit_bytes);
 }
@@ -533,17 +530,17 @@ static void tcp_new_reno_timeout(struct tcp *conn)
 /* For every duplicate ack increment the cwnd by mss */
 static void tcp_new_reno_dup_ack(struct tcp *conn)
 {
-	int32_t new_win = conn->ca.cwnd;
+	uint32_t new_win = conn->ca.cwnd;
 
 	new_win += conn_mss(conn);
-	conn->ca.cwnd = MIN(new_win, UINT16_MAX);
+	conn->ca.cwnd = MIN(new_win, TCP_CONGESTION_MAX_WIN);
 	tcp_new_reno_log(conn, "dup_ack");
 }
 
 static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len)
 {
-	int32_t new_win = conn->ca.cwnd;
-	int32_t win_inc = MIN(acked_len, conn_mss(conn));
+	uint32_t new_win = conn->ca.cwnd;
+	uint32_t win_inc = MIN(acked_len, conn_mss(conn));
 
 	if (conn->ca.pending_fast_retransmit_bytes == 0) {
 		if (conn->ca.cwnd < conn->ca.ssthresh) {
@@ -552,7 +549,7 @@ static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len)
 			/* Implement a div_ceil	to avoid rounding to 0 */
 			new_win += ((win_inc * win_inc) + conn->ca.cwnd - 1) / conn->ca.cwnd;
 		}
-		conn->ca.cwnd = MIN(new_win, UINT16_MAX);
+		conn->ca.cwnd = MIN(new_win, TCP_CONGESTION_MAX_WIN);
 	} else {
 		/* Check if it is still in fast recovery mode */
 		if (conn->ca.pending_fast_retransmit_bytes <= acked_len) {
@@ -566,30 +563,173 @@ static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len)
 	tcp_new_reno_log(conn, "pkts_acked");
 }
 
+TCP_CA_DEFINE(reno,
+	      .init = tcp_new_reno_init,
+	      .fast_retransmit = tcp_new_reno_fast_retransmit,
+	      .timeout = tcp_new_reno_timeout,
+	      .dup_ack = tcp_new_reno_dup_ack,
+	      .pkts_acked = tcp_new_reno_pkts_acked);
+
+static const struct tcp_ca_ops *tcp_ca_find(const char *name)
+{
+	STRUCT_SECTION_FOREACH(tcp_ca_ops, ops) {
+		if (strcmp(ops->name, name) == 0) {
+			return ops;
+		}
+	}
+
+	return NULL;
+}
+
+static const struct tcp_ca_ops *tcp_ca_default(void)
+{
+	const struct tcp_ca_ops *ops = tcp_ca_find(CONFIG_NET_TCP_CA_DEFAULT);
+
+	return ops != NULL ? ops : &tcp_ca_reno;
+}
+
 static void tcp_ca_init(struct tcp *conn)
 {
-	tcp_new_reno_init(conn);
+	conn->ca.rtt_pending = false;
+	conn->ca.rtt_us = 0;
+	conn->ca.snd_max = conn->seq + conn->unacked_len;
+	conn->ca.ops->init(conn);
 }
 
 static void tcp_ca_fast_retransmit(struct tcp *conn)
 {
-	tcp_new_reno_fast_retransmit(conn);
+	conn->ca.ops->fast_retransmit(conn);
 }
 
 static void tcp_ca_timeout(struct tcp *conn)
 {
-	tcp_new_reno_timeout(conn);
+	/* Karn's algorithm, never time a retransmitted segment */
+	conn->ca.rtt_pending = false;
+	conn->ca.ops->timeout(conn);
 }
 
 static void tcp_ca_dup_ack(struct tcp *conn)
 {
-	tcp_new_reno_dup_ack(conn);
+	conn->ca.ops->dup_ack(conn);
 }
 
 static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len)
 {
-	tcp_new_reno_pkts_acked(conn, acked_len);
+	uint32_t ack = conn->seq + acked_len;
+
+	if (conn->ca.rtt_pending && net_tcp_seq_cmp(ack, conn->ca.rtt_seq) >= 0) {
+		uint32_t elapsed = k_cycle_get_32() - conn->ca.rtt_start;
+
+		conn->ca.rtt_us = MAX(k_cyc_to_us_floor32(elapsed), 1U);
+		conn->ca.rtt_pending = false;
+	}
+
+	conn->ca.ops->pkts_acked(conn, acked_len);
 }
+
+/* Time one segment per round trip for the modules that need it */
+static void tcp_ca_data_sent(struct tcp *conn, uint32_t seq, uint32_t len)
+{
+	if (net_tcp_seq_cmp(seq, conn->ca.snd_max) < 0) {
+		/* Retransmission, drop the sample if it covers the timed byte */
+		if (conn->ca.rtt_pending &&
+		    net_tcp_seq_cmp(seq, conn->ca.rtt_seq) < 0) {
+			conn->ca.rtt_pending = false;
+		}
+
+		return;
+	}
+
+	conn->ca.snd_max = seq + len;
+
+	if (!conn->ca.rtt_pending) {
+		conn->ca.rtt_pending = true;
+		conn->ca.rtt_seq = seq + len;
+		conn->ca.rtt_start = k_cycle_get_32();
+	}
+}
+
+/* An accepted connection uses the algorithm selected on the listener */
+static void tcp_ca_param_copy(struct tcp *to, struct tcp *from)
+{
+	to->ca.ops = from->ca.ops;
+}
+
+static int set_tcp_congestion(struct tcp *conn, const void *value, uint32_t len)
+{
+	char name[TCP_CA_NAME_MAX];
+	const struct tcp_ca_ops *ops;
+
+	if (value == NULL || len == 0) {
+		return -EINVAL;
+	}
+
+	len = strnlen(value, MIN(len, sizeof(name)));
+	if (len == sizeof(name)) {
+		return -EINVAL;
+	}
+
+	memcpy(name, value, len);
+	name[len] = '\0';
+
+	ops = tcp_ca_find(name);
+	if (ops == NULL) {
+		return -ENOENT;
+	}
+
+	if (ops != conn->ca.ops) {
+		conn->ca.ops = ops;
+
+		if (conn->state == TCP_ESTABLISHED ||
+		    conn->state == TCP_CLOSE_WAIT) {
+			tcp_ca_init(conn);
+		}
+	}
+
+	return 0;
+}
+
+static int get_tcp_congestion(struct tcp *conn, void *value, uint32_t *len)
+{
+	uint32_t name_len;
+
+	if (value == NULL || len == NULL || *len == 0) {
+		return -EINVAL;
+	}
+
+	name_len = MIN(strlen(conn->ca.ops->name) + 1, *len);
+	memcpy(value, conn->ca.ops->name, name_len);
+	*len = name_len;
+
+	return 0;
+}
+
+#if defined(CONFIG_NET_TCP_CA_PACING)
+static void tcp_pacing_timeout(struct k_work *work);
+
+/* Returns true if the module wants the next segment to be delayed */
+static bool tcp_ca_pacing_wait(struct tcp *conn, uint32_t len)
+{
+	uint32_t delay_us;
+
+	if (conn->ca.ops->pacing_delay == NULL) {
+		return false;
+	}
+
+	delay_us = conn->ca.ops->pacing_delay(conn, len);
+	if (delay_us == 0) {
+		return false;
+	}
+
+	k_work_schedule_for_queue(&tcp_work_q, &conn->pacing_timer,
+				  K_USEC(delay_us));
+
+	return true;
+}
+#else
+#define tcp_ca_pacing_wait(...) false
+#endif /* CONFIG_NET_TCP_CA_PACING */
+
 #else
 
 static void tcp_ca_init(struct tcp *conn) { }
@@ -602,8 +742,271 @@ static void tcp_ca_dup_ack(struct tcp *conn) { }
 
 static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len) { }
 
+static void tcp_ca_data_sent(struct tcp *conn, uint32_t seq, uint32_t len) { }
+
+#define tcp_ca_param_copy(...)
+#define tcp_ca_pacing_wait(...) false
+#define set_tcp_congestion(...) (-ENOPROTOOPT)
+#define get_tcp_congestion(...) (-ENOPROTOOPT)
+
 #endif
 
+#if defined(CONFIG_NET_TCP_SACK)
+
+static bool tcp_sack_block_has(const struct tcp_sack_block *block, uint32_t seq)
+{
+	return net_tcp_seq_cmp(seq, block->left) >= 0 &&
+	       net_tcp_seq_cmp(seq, block->right) < 0;
+}
+
+/* Describe the out-of-order receive queue as SACK blocks. As required by
+ * RFC 2018, the first block holds the most recently received segment.
+ */
+static size_t tcp_sack_blocks_get(struct tcp *conn, struct tcp_sack_block *blocks)
+{
+	struct net_buf *buf = conn->queue_recv_data;
+	struct tcp_sack_block latest;
+	bool latest_found = false;
+	size_t count = 0;
+
+	while (buf != NULL) {
+		struct tcp_sack_block block;
+
+		block.left = tcp_get_seq(buf);
+		block.right = block.left + buf->len;
+
+		for (buf = buf->frags; buf != NULL && tcp_get_seq(buf) == block.right;
+		     buf = buf->frags) {
+			block.right += buf->len;
+		}
+
+		if (!latest_found && tcp_sack_block_has(&block, conn->sack_last_seq)) {
+			latest = block;
+			latest_found = true;
+		} else if (count < NET_TCP_SACK_MAX_BLOCKS) {
+			blocks[count++] = block;
+		}
+	}
+
+	if (latest_found) {
+		/* The latest segment goes first, pushing out the last block */
+		count = MIN(count + 1, NET_TCP_SACK_MAX_BLOCKS);
+		memmove(&blocks[1], &blocks[0], (count - 1) * sizeof(blocks[0]));
+		blocks[0] = latest;
+	}
+
+	return count;
+}
+
+static size_t tcp_sack_opt_size(size_t count)
+{
+	return (count == 0) ? 0 : 2 * NET_TCP_NOP_SIZE + 2 + count * NET_TCP_SACK_BLOCK_SIZE;
+}
+
+/* Length of the SACK option of the next data segment */
+static size_t tcp_sack_opt_len(struct tcp *conn)
+{
+	struct tcp_sack_block blocks[NET_TCP_SACK_MAX_BLOCKS];
+
+	if (!conn->sack_ok) {
+		return 0;
+	}
+
+	return tcp_sack_opt_size(tcp_sack_blocks_get(conn, blocks));
+}
+
+/* Build the SACK related options of an outgoing segment */
+static size_t tcp_sack_opt_build(struct tcp *conn, uint8_t flags, uint8_t *opt)
+{
+	struct tcp_sack_block blocks[NET_TCP_SACK_MAX_BLOCKS];
+	size_t count;
+	size_t len = 0;
+
+	if (flags & SYN) {
+		/* Offer SACK in SYN, agree to it in SYN-ACK if it was offered */
+		if ((flags & ACK) && !conn->sack_ok) {
+			return 0;
+		}
+
+		opt[len++] = NET_TCP_NOP_OPT;
+		opt[len++] = NET_TCP_NOP_OPT;
+		opt[len++] = NET_TCP_SACK_PERM_OPT;
+		opt[len++] = NET_TCP_SACK_PERM_SIZE;
+
+		return len;
+	}
+
+	if (!(flags & ACK) || !conn->sack_ok) {
+		return 0;
+	}
+
+	count = tcp_sack_blocks_get(conn, blocks);
+	if (count == 0) {
+		return 0;
+	}
+
+	opt[len++] = NET_TCP_NOP_OPT;
+	opt[len++] = NET_TCP_NOP_OPT;
+	opt[len++] = NET_TCP_SACK_OPT;
+	opt[len++] = 2 + count * NET_TCP_SACK_BLOCK_SIZE;
+
+	for (size_t i = 0; i < count; i++) {
+		UNALIGNED_PUT(net_htonl(blocks[i].left), (uint32_t *)&opt[len]);
+		UNALIGNED_PUT(net_htonl(blocks[i].right), (uint32_t *)&opt[len + 4]);
+		len += NET_TCP_SACK_BLOCK_SIZE;
+	}
+
+	return len;
+}
+
+static void tcp_sack_negotiate(struct tcp *conn)
+{
+	conn->sack_ok = conn->recv_options.sack_perm_found;
+}
+
+/* Insert a SACKed range into the sorted scoreboard, merging it with the
+ * ranges it overlaps or touches.
+ */
+static void tcp_sack_board_add(struct tcp *conn, uint32_t left, uint32_t right)
+{
+	struct tcp_sack_block *board = conn->sack_board;
+	int cnt = conn->sack_board_cnt;
+	int i = 0;
+	int j;
+
+	while (i < cnt && net_tcp_seq_cmp(board[i].right, left) < 0) {
+		i++;
+	}
+
+	for (j = i; j < cnt && net_tcp_seq_cmp(board[j].left, right) <= 0; j++) {
+		if (net_tcp_seq_cmp(board[j].left, left) < 0) {
+			left = board[j].left;
+		}
+
+		if (net_tcp_seq_cmp(board[j].right, right) > 0) {
+			right = board[j].right;
+		}
+	}
+
+	if (i == j) {
+		if (cnt == ARRAY_SIZE(conn->sack_board)) {
+			if (i == cnt) {
+				return;
+			}
+
+			/* Scoreboard full, forget the highest range */
+			cnt--;
+		}
+
+		memmove(&board[i + 1], &board[i], (cnt - i) * sizeof(board[0]));
+		cnt++;
+	} else {
+		memmove(&board[i + 1], &board[j], (cnt - j) * sizeof(board[0]));
+		cnt -= j - i - 1;
+	}
+
+	board[i].left = left;
+	board[i].right = right;
+	conn->sack_board_cnt = cnt;
+}
+
+/* Forget the ranges covered by the cumulative ACK and add the SACK blocks
+ * of the received segment to the scoreboard.
+ */
+static void tcp_sack_board_update(struct tcp *conn, uint32_t ack)
+{
+	struct tcp_options *opts = &conn->recv_options;
+	struct tcp_sack_block *board = conn->sack_board;
+	uint32_t snd_max = conn->seq + conn->send_data_total;
+	int i;
+
+	if (!conn->sack_ok) {
+		return;
+	}
+
+	if (net_tcp_seq_greater(conn->seq, ack)) {
+		ack = conn->seq;
+	}
+
+	for (i = 0; i < conn->sack_board_cnt; i++) {
+		if (net_tcp_seq_greater(board[i].right, ack)) {
+			break;
+		}
+	}
+
+	conn->sack_board_cnt -= i;
+	memmove(&board[0], &board[i], conn->sack_board_cnt * sizeof(board[0]));
+
+	if (conn->sack_board_cnt > 0 && net_tcp_seq_greater(ack, board[0].left)) {
+		board[0].left = ack;
+	}
+
+	for (i = 0; i < opts->sack_cnt; i++) {
+		uint32_t left = opts->sack[i].left;
+		uint32_t right = opts->sack[i].right;
+
+		/* Ignore blocks outside of the data in flight (e.g. D-SACK) */
+		if (!net_tcp_seq_greater(left, ack) || !net_tcp_seq_greater(right, left) ||
+		    net_tcp_seq_greater(right, snd_max)) {
+			continue;
+		}
+
+		tcp_sack_board_add(conn, left, right);
+	}
+}
+
+/* Move the send position past data the peer already has and return how
+ * much can be sent before the next SACKed range.
+ */
+static int tcp_sack_hole_len(struct tcp *conn)
+{
+	for (int i = 0; i < conn->sack_board_cnt; i++) {
+		struct tcp_sack_block *block = &conn->sack_board[i];
+		uint32_t nxt = conn->seq + conn->unacked_len;
+
+		if (!net_tcp_seq_greater(block->right, nxt)) {
+			continue;
+		}
+
+		if (!net_tcp_seq_greater(block->left, nxt)) {
+			conn->unacked_len = block->right - conn->seq;
+			continue;
+		}
+
+		return block->left - nxt;
+	}
+
+	return INT_MAX;
+}
+
+static void tcp_sack_timeout(struct tcp *conn)
+{
+	conn->sack_recovery = false;
+
+	/* The peer is allowed to discard data it has SACKed, so only trust
+	 * the scoreboard for the first retransmission.
+	 */
+	if (conn->send_data_retries > 0) {
+		conn->sack_board_cnt = 0;
+	}
+}
+
+#else
+
+static size_t tcp_sack_opt_build(struct tcp *conn, uint8_t flags, uint8_t *opt) { return 0; }
+
+static size_t tcp_sack_opt_len(struct tcp *conn) { return 0; }
+
+static void tcp_sack_negotiate(struct tcp *conn) { }
+
+static void tcp_sack_board_update(struct tcp *conn, uint32_t ack) { }
+
+static int tcp_sack_hole_len(struct tcp *conn) { return INT_MAX; }
+
+static void tcp_sack_timeout(struct tcp *conn) { }
+
+#endif /* CONFIG_NET_TCP_SACK */
+
 #if defined(CONFIG_NET_TCP_KEEPALIVE)
 
 static void tcp_send_keepalive_probe(struct k_work *work);
@@ -901,6 +1304,9 @@ static void tcp_conn_release(struct k_work *work)
 	(void)k_work_cancel_delayable(&conn->ack_timer);
 	(void)k_work_cancel_delayable(&conn->send_timer);
 	(void)k_work_cancel_delayable(&conn->recv_queue_timer);
+#if defined(CONFIG_NET_TCP_CA_PACING)
+	(void)k_work_cancel_delayable(&conn->pacing_timer);
+#endif
 	keep_alive_timer_stop(conn);
 
 	k_mutex_unlock(&conn->lock);
@@ -1107,9 +1513,6 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 
 	NET_DBG("len=%zd", len);
 
-	recv_options->mss_found = false;
-	recv_options->wnd_found = false;
-
 	for ( ; options && len >= 1; options += opt_len, len -= opt_len) {
 		opt = options[0];
 
@@ -1157,6 +1560,36 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 			recv_options->window = opt;
 			recv_options->wnd_found = true;
 			break;
+#if defined(CONFIG_NET_TCP_SACK)
+		case NET_TCP_SACK_PERM_OPT:
+			if (opt_len != NET_TCP_SACK_PERM_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->sack_perm_found = true;
+			break;
+		case NET_TCP_SACK_OPT:
+			if ((opt_len - 2) % NET_TCP_SACK_BLOCK_SIZE != 0 ||
+			    opt_len == 2) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->sack_cnt = MIN((opt_len - 2) / NET_TCP_SACK_BLOCK_SIZE,
+						     NET_TCP_SACK_MAX_BLOCKS);
+
+			for (int i = 0; i < recv_options->sack_cnt; i++) {
+				uint8_t *block = options + 2 + i * NET_TCP_SACK_BLOCK_SIZE;
+
+				recv_options->sack[i].left =
+					net_ntohl(UNALIGNED_GET((uint32_t *)block));
+				recv_options->sack[i].right =
+					net_ntohl(UNALIGNED_GET((uint32_t *)(block + 4)));
+			}
+
+			break;
+#endif
 		default:
 			continue;
 		}
@@ -1169,6 +1602,24 @@ end:
 	return result;
 }
 
+/* The MSS, window scale and SACK-permitted options are only meaningful
+ * in SYN segments, the other segments only bring SACK blocks.
+ */
+static void tcp_options_update(struct tcp *conn, const struct tcp_options *options,
+			       bool syn)
+{
+	if (syn) {
+		conn->recv_options = *options;
+		return;
+	}
+
+#if defined(CONFIG_NET_TCP_SACK)
+	conn->recv_options.sack_cnt = options->sack_cnt;
+	memcpy(conn->recv_options.sack, options->sack,
+	       options->sack_cnt * sizeof(options->sack[0]));
+#endif
+}
+
 static bool tcp_short_window(struct tcp *conn)
 {
 	int32_t threshold = MIN(conn_mss(conn), conn->recv_win_max / 2);
@@ -1235,55 +1686,44 @@ static size_t tcp_check_pending_data(struct tcp *conn, struct net_pkt *pkt,
 	size_t pending_len = 0;
 
 	if (CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT && conn->queue_recv_data != NULL) {
-		/* Some potentential cases:
-		 * Note: MI = MAX_INT
-		 * Packet | Queued| End off   | Gap size | Required handling
-		 * Seq|Len|Seq|Len|           |          |
-		 *  3 | 3 | 6 | 4 | 3+3-6=  0 | 6-3-3=0  | Append
-		 *  3 | 4 | 6 | 4 | 3+4-6 = 1 | 6-3-4=-1 | Append, pull from queue
-		 *  3 | 7 | 6 | 4 | 3+7-6 = 4 | 6-3-7=-4 | Drop queued data
-		 *  3 | 8 | 6 | 4 | 3+8-6 = 5 | 6-3-8=-5 | Drop queued data
-		 *  6 | 5 | 6 | 4 | 6+5-6 = 5 | 6-6-5=-5 | Drop queued data
-		 *  6 | 4 | 6 | 4 | 6+4-6 = 4 | 6-6-4=-4 | Drop queued data / packet
-		 * 10 | 2 | 6 | 4 | 10+2-6= 6 | 6-10-2=-6| Should not happen, dropping queue
-		 *  7 | 4 | 6 | 4 | 7+4-6 = 5 | 6-7-4=-5 | Should not happen, dropping queue
-		 * 11 | 2 | 6 | 4 | 11+2-6= 7 | 6-11-2=-7| Should not happen, dropping queue
-		 *  2 | 3 | 6 | 4 | 2+3-6= MI | 6-2-3=1  | Keep queued data
-		 */
 		struct tcphdr *th = th_get(pkt);
 		uint32_t expected_seq = th_seq(th) + len;
-		uint32_t pending_seq;
-		int32_t gap_size;
-		uint32_t end_offset;
-
-		pending_seq = tcp_get_seq(conn->queue_recv_data);
-		end_offset = expected_seq - pending_seq;
-		gap_size = (int32_t)(pending_seq - th_seq(th) - ((uint32_t)len));
-		pending_len = net_buf_frags_len(conn->queue_recv_data);
-		if (end_offset < pending_len) {
-			if (end_offset) {
-				net_pkt_remove_tail(pkt, end_offset);
-				pending_len -= end_offset;
-			}
+		struct net_buf *last = NULL;
+		struct net_buf *buf;
+
+		/* Drop the queued data the incoming segment already covers */
+		buf = conn->queue_recv_data;
+		while (buf != NULL &&
+		       !net_tcp_seq_greater(tcp_get_seq(buf) + buf->len, expected_seq)) {
+			buf = net_buf_frag_del(NULL, buf);
+		}
 
-			NET_DBG("[%p] Found pending data seq %u len %zd", conn,
-				expected_seq, pending_len);
+		if (buf != NULL && net_tcp_seq_greater(expected_seq, tcp_get_seq(buf))) {
+			net_buf_pull(buf, expected_seq - tcp_get_seq(buf));
+			tcp_set_seq(buf, expected_seq);
+		}
 
-			net_buf_frag_add(pkt->buffer,
-					 conn->queue_recv_data);
-			conn->queue_recv_data = NULL;
+		conn->queue_recv_data = buf;
 
-			k_work_cancel_delayable(&conn->recv_queue_timer);
-		} else {
-			/* Check if the queued data is just a section of the incoming data */
-			if (gap_size <= 0) {
-				net_buf_unref(conn->queue_recv_data);
-				conn->queue_recv_data = NULL;
+		/* Pass the queued data up to the first hole along */
+		while (buf != NULL && tcp_get_seq(buf) == expected_seq) {
+			expected_seq += buf->len;
+			pending_len += buf->len;
+			last = buf;
+			buf = buf->frags;
+		}
 
-				k_work_cancel_delayable(&conn->recv_queue_timer);
-			}
+		if (last != NULL) {
+			NET_DBG("[%p] Found pending data seq %u len %zd", conn,
+				tcp_get_seq(conn->queue_recv_data), pending_len);
+
+			last->frags = NULL;
+			net_buf_frag_add(pkt->buffer, conn->queue_recv_data);
+			conn->queue_recv_data = buf;
+		}
 
-			pending_len = 0;
+		if (conn->queue_recv_data == NULL) {
+			k_work_cancel_delayable(&conn->recv_queue_timer);
 		}
 	}
 
@@ -1347,7 +1787,7 @@ static int tcp_finalize_pkt(struct net_pkt *pkt)
 }
 
 static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
-			  uint32_t seq)
+			  uint32_t seq, size_t opts_len)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct tcphdr *th;
@@ -1361,11 +1801,7 @@ static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 
 	UNALIGNED_PUT(conn->src.sin.sin_port, UNALIGNED_MEMBER_ADDR(th, th_sport));
 	UNALIGNED_PUT(conn->dst.sin.sin_port, UNALIGNED_MEMBER_ADDR(th, th_dport));
-	th->th_off = 5;
-
-	if (conn->send_options.mss_found) {
-		th->th_off++;
-	}
+	th->th_off = 5 + opts_len / 4;
 
 	UNALIGNED_PUT(flags, &th->th_flags);
 	UNALIGNED_PUT(net_htons(conn->recv_win), UNALIGNED_MEMBER_ADDR(th, th_win));
@@ -1557,14 +1993,22 @@ err:
 static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		       uint32_t seq)
 {
+	uint8_t sack_opt[2 * NET_TCP_NOP_SIZE + 2 +
+			 NET_TCP_SACK_MAX_BLOCKS * NET_TCP_SACK_BLOCK_SIZE];
 	size_t alloc_len = sizeof(struct tcphdr);
+	size_t opts_len = 0;
+	size_t sack_opt_len;
 	struct net_pkt *pkt;
 	int ret = 0;
 
 	if (conn->send_options.mss_found) {
-		alloc_len += sizeof(uint32_t);
+		opts_len += NET_TCP_MSS_SIZE;
 	}
 
+	sack_opt_len = tcp_sack_opt_build(conn, flags, sack_opt);
+	opts_len += sack_opt_len;
+	alloc_len += opts_len;
+
 	pkt = tcp_pkt_alloc(conn, alloc_len);
 	if (!pkt) {
 		ret = -ENOBUFS;
@@ -1583,7 +2027,7 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		goto out;
 	}
 
-	ret = tcp_header_add(conn, pkt, flags, seq);
+	ret = tcp_header_add(conn, pkt, flags, seq, opts_len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
 		goto out;
@@ -1597,6 +2041,14 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		}
 	}
 
+	if (sack_opt_len > 0) {
+		ret = net_pkt_write(pkt, sack_opt, sack_opt_len);
+		if (ret < 0) {
+			tcp_pkt_unref(pkt);
+			goto out;
+		}
+	}
+
 	ret = tcp_finalize_pkt(pkt);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
@@ -1817,10 +2269,15 @@ static void tcp_setup_retransmission(struct tcp *conn)
 static int tcp_send_data(struct tcp *conn)
 {
 	int ret = 0;
+	int hole_len;
 	int len;
 	struct net_pkt *pkt;
 
-	len = MIN(tcp_unsent_len(conn), conn_mss(conn));
+	hole_len = tcp_sack_hole_len(conn);
+
+	/* The MSS does not account for the options of the segment (RFC 6691) */
+	len = MIN(tcp_unsent_len(conn), conn_mss(conn) - (int)tcp_sack_opt_len(conn));
+	len = MIN(len, hole_len);
 	if (len < 0) {
 		ret = len;
 		goto out;
@@ -1847,6 +2304,7 @@ static int tcp_send_data(struct tcp *conn)
 
 	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + conn->unacked_len);
 	if (ret == 0) {
+		tcp_ca_data_sent(conn, conn->seq + conn->unacked_len, len);
 		conn->unacked_len += len;
 
 		if (conn->data_mode == TCP_DATA_MODE_RESEND) {
@@ -1870,6 +2328,81 @@ static int tcp_send_data(struct tcp *conn)
 	return ret;
 }
 
+#if defined(CONFIG_NET_TCP_SACK)
+
+/* Retransmit the next hole below the highest SACKed range, if any */
+static void tcp_sack_retransmit(struct tcp *conn)
+{
+	int unacked_len = conn->unacked_len;
+	uint32_t highest;
+
+	if (conn->sack_board_cnt == 0) {
+		return;
+	}
+
+	highest = conn->sack_board[conn->sack_board_cnt - 1].left;
+
+	if (net_tcp_seq_greater(conn->seq, conn->sack_rexmit_nxt)) {
+		conn->sack_rexmit_nxt = conn->seq;
+	}
+
+	if (!net_tcp_seq_greater(highest, conn->sack_rexmit_nxt)) {
+		/* All known holes have been resent */
+		return;
+	}
+
+	conn->unacked_len = conn->sack_rexmit_nxt - conn->seq;
+
+	if (tcp_send_data(conn) == 0) {
+		conn->sack_rexmit_nxt = conn->seq + conn->unacked_len;
+	}
+
+	conn->unacked_len = unacked_len;
+}
+
+/* Start SACK based loss recovery, returns false if the peer has not
+ * reported anything the recovery could be based on.
+ */
+static bool tcp_sack_recovery_enter(struct tcp *conn)
+{
+	if (!conn->sack_ok || conn->sack_board_cnt == 0) {
+		return false;
+	}
+
+	if (!conn->sack_recovery) {
+		conn->sack_recovery = true;
+		conn->sack_recover = conn->seq + conn->unacked_len;
+		conn->sack_rexmit_nxt = conn->seq;
+	}
+
+	tcp_sack_retransmit(conn);
+
+	return true;
+}
+
+/* Every ACK received during the recovery may reveal another hole */
+static void tcp_sack_recovery_ack(struct tcp *conn)
+{
+	if (!conn->sack_recovery) {
+		return;
+	}
+
+	if (!net_tcp_seq_greater(conn->sack_recover, conn->seq)) {
+		conn->sack_recovery = false;
+		return;
+	}
+
+	tcp_sack_retransmit(conn);
+}
+
+#else
+
+static bool tcp_sack_recovery_enter(struct tcp *conn) { return false; }
+
+static void tcp_sack_recovery_ack(struct tcp *conn) { }
+
+#endif /* CONFIG_NET_TCP_SACK */
+
 /* Send all queued but unsent data from the send_data packet by packet
  * until the receiver's window is full. */
 static int tcp_send_queued_data(struct tcp *conn)
@@ -1895,6 +2428,10 @@ static int tcp_send_queued_data(struct tcp *conn)
 			}
 		}
 
+		if (tcp_ca_pacing_wait(conn, MIN(tcp_unsent_len(conn), conn_mss(conn)))) {
+			break;
+		}
+
 		ret = tcp_send_data(conn);
 		if (ret < 0) {
 			break;
@@ -1916,6 +2453,22 @@ static int tcp_send_queued_data(struct tcp *conn)
 	return ret;
 }
 
+#if defined(CONFIG_NET_TCP_CA_PACING)
+static void tcp_pacing_timeout(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct tcp *conn = CONTAINER_OF(dwork, struct tcp, pacing_timer);
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+
+	if (conn->state == TCP_ESTABLISHED || conn->state == TCP_CLOSE_WAIT) {
+		(void)tcp_send_queued_data(conn);
+	}
+
+	k_mutex_unlock(&conn->lock);
+}
+#endif /* CONFIG_NET_TCP_CA_PACING */
+
 static void tcp_cleanup_recv_queue(struct k_work *work)
 {
 	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
@@ -1969,6 +2522,8 @@ static void tcp_resend_data(struct k_work *work)
 			}
 		}
 
+		tcp_sack_timeout(conn);
+
 		conn->data_mode = TCP_DATA_MODE_RESEND;
 		conn->unacked_len = 0;
 
@@ -2204,6 +2759,7 @@ static struct tcp *tcp_conn_alloc(void)
 	 * is available as soon as the connection is established
 	 */
 	conn->ca.cwnd = UINT16_MAX;
+	conn->ca.ops = tcp_ca_default();
 #endif
 
 	/* The ISN value will be set when we get the connection attempt or
@@ -2220,6 +2776,9 @@ static struct tcp *tcp_conn_alloc(void)
 	k_work_init_delayable(&conn->recv_queue_timer, tcp_cleanup_recv_queue);
 	k_work_init_delayable(&conn->persist_timer, tcp_send_zwp);
 	k_work_init_delayable(&conn->ack_timer, tcp_send_ack);
+#if defined(CONFIG_NET_TCP_CA_PACING)
+	k_work_init_delayable(&conn->pacing_timer, tcp_pacing_timeout);
+#endif
 	k_work_init(&conn->conn_release, tcp_conn_release);
 	keep_alive_timer_init(conn);
 
@@ -2641,30 +3200,60 @@ static enum tcp_state tcp_enter_time_wait(struct tcp *conn)
 	return TCP_TIME_WAIT;
 }
 
-static bool check_seq_list(struct net_buf *buf)
+/* Insert one fragment of out-of-order data into the receive queue, which is
+ * a chain of fragments sorted by sequence number that may contain holes.
+ * The new data replaces any queued data it overlaps, unless it is already
+ * fully queued in which case false is returned.
+ */
+static bool tcp_queue_recv_frag(struct tcp *conn, struct net_buf *frag)
 {
-	struct net_buf *last = NULL;
-	struct net_buf *tmp = buf;
-	uint32_t seq;
-	uint32_t next_seq = 0;
-	bool result = true;
+	uint32_t start = tcp_get_seq(frag);
+	uint32_t end = start + frag->len;
+	struct net_buf *prev = NULL;
+	struct net_buf *cur = conn->queue_recv_data;
+
+	/* Skip the queued data ending before the new fragment */
+	while (cur != NULL && !net_tcp_seq_greater(tcp_get_seq(cur) + cur->len, start)) {
+		prev = cur;
+		cur = cur->frags;
+	}
 
-	while (tmp) {
-		seq = tcp_get_seq(tmp);
+	if (cur != NULL && !net_tcp_seq_greater(tcp_get_seq(cur), start)) {
+		if (!net_tcp_seq_greater(end, tcp_get_seq(cur) + cur->len)) {
+			return false;
+		}
 
-		NET_DBG("buf %p seq %u len %d", tmp, seq, tmp->len);
+		/* Queued data overlaps the start of the new fragment */
+		net_buf_remove_mem(cur, tcp_get_seq(cur) + cur->len - start);
+		prev = cur;
+		cur = cur->frags;
+	}
 
-		if (last != NULL) {
-			if (next_seq != seq) {
-				result = false;
-			}
+	/* Drop the queued data the new fragment covers */
+	while (cur != NULL && !net_tcp_seq_greater(tcp_get_seq(cur) + cur->len, end)) {
+		cur = net_buf_frag_del(prev, cur);
+		if (prev == NULL) {
+			conn->queue_recv_data = cur;
+		}
+	}
+
+	/* Queued data overlaps the end of the new fragment */
+	if (cur != NULL && net_tcp_seq_greater(end, tcp_get_seq(cur))) {
+		net_buf_pull(cur, end - tcp_get_seq(cur));
+		tcp_set_seq(cur, end);
+	}
+
+	if (prev == NULL) {
+		if (conn->queue_recv_data != NULL) {
+			net_buf_frag_insert(frag, conn->queue_recv_data);
 		}
 
-		next_seq = seq + tmp->len;
-		last = tmp;
-		tmp = tmp->frags;
+		conn->queue_recv_data = frag;
+	} else {
+		net_buf_frag_insert(prev, frag);
 	}
-	return result;
+
+	return true;
 }
 
 static void tcp_queue_recv_data(struct tcp *conn, struct net_pkt *pkt,
@@ -2672,136 +3261,54 @@ static void tcp_queue_recv_data(struct tcp *conn, struct net_pkt *pkt,
 {
 	uint32_t seq_start = seq;
 	bool inserted = false;
+	struct net_buf *next;
 	struct net_buf *tmp;
 
 	NET_DBG("[%p] len %zd seq %u ack %u", conn, len, seq, conn->ack);
 
-	tmp = pkt->buffer;
-
-	tcp_set_seq(tmp, seq);
-	seq += tmp->len;
-	tmp = tmp->frags;
-
-	while (tmp) {
-		tcp_set_seq(tmp, seq);
-		seq += tmp->len;
-		tmp = tmp->frags;
-	}
-
 	if (IS_ENABLED(CONFIG_NET_TCP_LOG_LEVEL_DBG)) {
 		NET_DBG("[%p] Queuing data", conn);
 	}
 
-	if (conn->queue_recv_data != NULL) {
-		/* Place the data to correct place in the list. If the data
-		 * would not be sequential, then drop this packet.
-		 *
-		 * Only work with subtractions between sequence numbers in uint32_t format
-		 * to proper handle cases that are around the wrapping point.
-		 */
-
-		/* Some potentential cases:
-		 * Note: MI = MAX_INT
-		 * Packet | Queued| End off1  | Start off| End off2    | Required handling
-		 * Seq|Len|Seq|Len|           |          |             |
-		 *  3 | 3 | 6 | 4 | 3+3-6=  0 | NA       | NA          | Prepend
-		 *  3 | 4 | 6 | 4 | 3+4-6 = 1 | NA       | NA          | Prepend, pull from buffer
-		 *  3 | 7 | 6 | 4 | 3+7-6 = 4 | 6-3=3    | 6+4-3=7     | Drop queued data
-		 *  3 | 8 | 6 | 4 | 3+8-6 = 5 | 6-3=3    | 6+4-3=7     | Drop queued data
-		 *  6 | 5 | 6 | 4 | 6+5-6 = 5 | 6-6=0    | 6+4-6=4     | Drop queued data
-		 *  6 | 4 | 6 | 4 | 6+4-6 = 4 | 6-6=0    | 6+4-6=4     | Drop queued data / packet
-		 *  7 | 2 | 6 | 4 | 7+2-6 = 3 | 6-7=MI   | 6+4-7=3     | Drop packet
-		 * 10 | 2 | 6 | 4 | 10+2-6= 6 | 6-10=MI-3| 6+4-10=0    | Append
-		 *  7 | 4 | 6 | 4 | 7+4-6 = 5 | 6-7 =MI  | 6+4-7 =3    | Append, pull from packet
-		 * 11 | 2 | 6 | 4 | 11+2-6= 7 | 6-11=MI-6| 6+4-11=MI-1 | Drop incoming packet
-		 *  2 | 3 | 6 | 4 | 2+3-6= MI | 6-2=4    | 6+4-2=8     | Drop incoming packet
-		 */
-
-		uint32_t pending_seq;
-		uint32_t start_offset;
-		uint32_t end_offset;
-		size_t pending_len;
-
-		pending_seq = tcp_get_seq(conn->queue_recv_data);
-		end_offset = seq - pending_seq;
-		pending_len = net_buf_frags_len(conn->queue_recv_data);
-		if (end_offset < pending_len) {
-			if (end_offset < len) {
-				if (end_offset) {
-					net_pkt_remove_tail(pkt, end_offset);
-				}
-
-				/* Put new data before the pending data */
-				net_buf_frag_add(pkt->buffer,
-						 conn->queue_recv_data);
-				NET_DBG("[%p] Adding at before queue, "
-					"end_offset %i, pending_len %zu",
-					conn, end_offset, pending_len);
-				conn->queue_recv_data = pkt->buffer;
-				inserted = true;
-			}
-		} else {
-			struct net_buf *last;
-
-			last = net_buf_frag_last(conn->queue_recv_data);
-			pending_seq = tcp_get_seq(last);
-
-			start_offset = pending_seq - seq_start;
-			/* Compute the offset w.r.t. the start point of the new packet */
-			end_offset = (pending_seq + last->len) - seq_start;
+	/* Queue the data fragment by fragment, so that each of them can be
+	 * placed in its own slot of the sequence space.
+	 */
+	for (tmp = pkt->buffer; tmp != NULL; tmp = next) {
+		next = tmp->frags;
+		tmp->frags = NULL;
 
-			/* Check if queue start with within the within the new packet */
-			if ((start_offset < len) && (end_offset <= len)) {
-				/* The queued data is irrelevant since the new packet overlaps the
-				 * new packet, take the new packet as contents
-				 */
-				net_buf_unref(conn->queue_recv_data);
-				conn->queue_recv_data = pkt->buffer;
-				inserted = true;
-			} else {
-				if (end_offset < len) {
-					if (end_offset) {
-						net_buf_remove_mem(conn->queue_recv_data,
-								   end_offset);
-					}
-
-					/* Put new data after pending data */
-					NET_DBG("[%p] Adding at end of queue, "
-						"start %i, end %i, len %zu",
-						conn, start_offset, end_offset, len);
-					net_buf_frag_add(conn->queue_recv_data,
-							 pkt->buffer);
-					inserted = true;
-				}
-			}
+		if (tmp->len > len) {
+			net_buf_remove_mem(tmp, tmp->len - len);
 		}
 
-		if (inserted) {
-			NET_DBG("[%p] All pending data", conn);
-			if (check_seq_list(conn->queue_recv_data) == false) {
-				NET_ERR("Incorrect order in out of order sequence for conn %p",
-					conn);
-				/* error in sequence list, drop it */
-				net_buf_unref(conn->queue_recv_data);
-				conn->queue_recv_data = NULL;
-			}
+		tcp_set_seq(tmp, seq);
+		seq += tmp->len;
+		len -= tmp->len;
+
+		if (tmp->len > 0 && tcp_queue_recv_frag(conn, tmp)) {
+			inserted = true;
 		} else {
-			NET_DBG("[%p] Cannot add new data to queue", conn);
+			net_buf_unref(tmp);
 		}
-	} else {
-		conn->queue_recv_data = pkt->buffer;
-		inserted = true;
 	}
 
+	/* The fragments are now owned by the queue or freed */
+	pkt->buffer = NULL;
+
 	if (inserted) {
-		/* We need to keep the received data but free the pkt */
-		pkt->buffer = NULL;
+		NET_DBG("[%p] Queued data seq %u", conn, seq_start);
+
+#if defined(CONFIG_NET_TCP_SACK)
+		conn->sack_last_seq = seq_start;
+#endif
 
 		if (!k_work_delayable_is_pending(&conn->recv_queue_timer)) {
 			k_work_reschedule_for_queue(
 				&tcp_work_q, &conn->recv_queue_timer,
 				K_MSEC(CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT));
 		}
+	} else {
+		NET_DBG("[%p] Cannot add new data to queue", conn);
 	}
 }
 
@@ -2999,13 +3506,23 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		goto out;
 	}
 
-	if (tcp_options_len && !tcp_options_check(&conn->recv_options, pkt,
-						  tcp_options_len)) {
-		NET_DBG("[%p] DROP: Invalid TCP option list", conn);
-		net_tcp_reply_rst(pkt);
-		do_close = true;
-		close_status = -ECONNRESET;
-		goto out;
+#if defined(CONFIG_NET_TCP_SACK)
+	/* SACK information is only valid for the segment carrying it */
+	conn->recv_options.sack_cnt = 0;
+#endif
+
+	if (tcp_options_len) {
+		struct tcp_options options = { 0 };
+
+		if (!tcp_options_check(&options, pkt, tcp_options_len)) {
+			NET_DBG("[%p] DROP: Invalid TCP option list", conn);
+			net_tcp_reply_rst(pkt);
+			do_close = true;
+			close_status = -ECONNRESET;
+			goto out;
+		}
+
+		tcp_options_update(conn, &options, FL(&fl, &, SYN));
 	}
 
 	if ((conn->state != TCP_LISTEN) && (conn->state != TCP_SYN_SENT) && FL(&fl, &, SYN)) {
@@ -3094,6 +3611,7 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 
 			/* Make sure our MSS is also sent in the ACK */
 			conn->send_options.mss_found = true;
+			tcp_sack_negotiate(conn);
 			conn->isn_peer = th_seq(th);
 			conn_ack(conn, th_seq(th) + 1); /* capture peer's isn */
 			tcp_out(conn, SYN | ACK);
@@ -3123,6 +3641,7 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 				accept_cb = conn->accepted_conn->accept_cb;
 				context = conn->accepted_conn->context;
 				keep_alive_param_copy(conn, conn->accepted_conn);
+				tcp_ca_param_copy(conn, conn->accepted_conn);
 			}
 
 			k_work_cancel_delayable(&conn->establish_timer);
@@ -3207,6 +3726,7 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		 */
 		if (FL(&fl, &, SYN | ACK, th && th_ack(th) == conn->seq)) {
 			k_work_cancel_delayable(&conn->send_data_timer);
+			tcp_sack_negotiate(conn);
 			conn->isn_peer = th_seq(th);
 			conn_ack(conn, th_seq(th) + 1);
 			if (len) {
@@ -3252,6 +3772,8 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		 */
 		keep_alive_timer_restart(conn);
 
+		tcp_sack_board_update(conn, th_ack(th));
+
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 		if (net_tcp_seq_cmp(th_ack(th), conn->seq) == 0) {
 			/* Only if there is pending data, increment the duplicate ack count */
@@ -3272,20 +3794,26 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 			/* Only do fast retransmit when not already in a resend state */
 			if ((conn->data_mode == TCP_DATA_MODE_SEND) &&
 			    (conn->dup_ack_cnt == DUPLICATE_ACK_RETRANSMIT_TRHESHOLD)) {
-				/* Apply a fast retransmit */
-				int temp_unacked_len = conn->unacked_len;
+				/* Apply a fast retransmit, only resending the holes
+				 * if the peer has reported what it has received.
+				 */
+				if (!tcp_sack_recovery_enter(conn)) {
+					int temp_unacked_len = conn->unacked_len;
 
-				conn->unacked_len = 0;
+					conn->unacked_len = 0;
 
-				(void)tcp_send_data(conn);
+					(void)tcp_send_data(conn);
 
-				/* Restore the current transmission */
-				conn->unacked_len = temp_unacked_len;
+					/* Restore the current transmission */
+					conn->unacked_len = temp_unacked_len;
+				}
 
 				tcp_ca_fast_retransmit(conn);
 				if (tcp_window_full(conn)) {
 					(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
 				}
+			} else if (conn->dup_ack_cnt > DUPLICATE_ACK_RETRANSMIT_TRHESHOLD) {
+				tcp_sack_recovery_ack(conn);
 			}
 		}
 #endif
@@ -3349,6 +3877,8 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 				tcp_setup_retransmission(conn);
 			}
 
+			tcp_sack_recovery_ack(conn);
+
 			/* We are closing the connection, send a FIN to peer */
 			if (conn->in_close && conn->send_data_total == 0) {
 				if (fin) {
@@ -3803,8 +4333,34 @@ int net_tcp_update_recv_wnd(struct net_context *context, int32_t delta)
 	return ret;
 }
 
+/* Queue the data without copying it, the buffers reference it through ext */
+static int tcp_pkt_append_ext(struct net_pkt *pkt, struct net_buf_ext *ext,
+			      const uint8_t *data, size_t len)
+{
+#if defined(CONFIG_NET_BUF_EXTERNAL_REF)
+	size_t queued = net_pkt_get_len(pkt);
+
+	if (ext == NULL) {
+		return tcp_pkt_append(pkt, data, len);
+	}
+
+	if (net_pkt_append_ext(pkt, ext, data, len, TCP_PKT_ALLOC_TIMEOUT) < 0) {
+		/* Drop the part appended before running out of buffers */
+		(void)net_pkt_remove_tail(pkt, net_pkt_get_len(pkt) - queued);
+		net_pkt_trim_buffer(pkt);
+		return -ENOBUFS;
+	}
+
+	return 0;
+#else
+	ARG_UNUSED(ext);
+
+	return tcp_pkt_append(pkt, data, len);
+#endif
+}
+
 int net_tcp_queue(struct net_context *context, const void *data, size_t len,
-		  const struct net_msghdr *msg)
+		  const struct net_msghdr *msg, struct net_buf_ext *ext)
 {
 	struct tcp *conn = context->tcp;
 	size_t queued_len = 0;
@@ -3844,9 +4400,9 @@ int net_tcp_queue(struct net_context *context, const void *data, size_t len,
 		for (int i = 0; i < msg->msg_iovlen; i++) {
 			int iovlen = MIN(msg->msg_iov[i].iov_len, len);
 
-			ret = tcp_pkt_append(&conn->send_data,
-					     msg->msg_iov[i].iov_base,
-					     iovlen);
+			ret = tcp_pkt_append_ext(&conn->send_data, ext,
+						 msg->msg_iov[i].iov_base,
+						 iovlen);
 			if (ret < 0) {
 				if (queued_len == 0) {
 					goto out;
@@ -4683,6 +5239,9 @@ int net_tcp_set_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = set_tcp_keep_cnt(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+		ret = set_tcp_congestion(conn, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -4720,6 +5279,9 @@ int net_tcp_get_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = get_tcp_keep_cnt(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+		ret = get_tcp_congestion(conn, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
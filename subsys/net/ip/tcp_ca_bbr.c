@@ -0,0 +1,264 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Lightweight model based congestion control in the spirit of BBR.
+ *
+ * The bottleneck bandwidth is estimated once per round trip from the
+ * amount of acknowledged data, and kept as a windowed maximum over
+ * BBR_BW_ROUNDS rounds. Together with the minimum round-trip time this
+ * gives the bandwidth-delay product, which sizes the congestion window.
+ * Segments are paced at the estimated bandwidth scaled by a gain that
+ * depends on the phase the connection is in.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include "tcp_internal.h"
+
+enum bbr_mode {
+	BBR_STARTUP,   /* Grow exponentially until the bandwidth plateaus */
+	BBR_DRAIN,     /* Drain the queue created during startup */
+	BBR_PROBE_BW,  /* Cycle the pacing gain around the estimated bandwidth */
+	BBR_PROBE_RTT, /* Shrink the window to refresh the minimum RTT */
+};
+
+/* Gains are scaled by BBR_UNIT */
+#define BBR_UNIT 256U
+#define BBR_HIGH_GAIN 739U  /* 2 / ln(2) */
+#define BBR_DRAIN_GAIN 89U  /* 1 / BBR_HIGH_GAIN */
+#define BBR_CWND_GAIN 512U
+
+#define BBR_BW_ROUNDS 10
+#define BBR_FULL_BW_ROUNDS 3
+#define BBR_MIN_RTT_WIN_MS (10 * MSEC_PER_SEC)
+#define BBR_PROBE_RTT_MS 200
+#define BBR_MIN_CWND_SEGS 4
+
+static const uint16_t bbr_probe_bw_gain[] = {
+	BBR_UNIT * 5 / 4, BBR_UNIT * 3 / 4,
+	BBR_UNIT, BBR_UNIT, BBR_UNIT, BBR_UNIT, BBR_UNIT, BBR_UNIT,
+};
+
+static void bbr_log(struct tcp *conn, char *step)
+{
+	NET_DBG("[%p] ca %s, cwnd=%u, mode=%d, bw=%u, min_rtt=%u",
+		conn, step, conn->ca.cwnd, conn->ca.bbr.mode,
+		conn->ca.bbr.btl_bw, conn->ca.bbr.min_rtt_us);
+}
+
+static uint32_t bbr_pacing_gain(struct tcp_ca_bbr *bbr)
+{
+	switch (bbr->mode) {
+	case BBR_STARTUP:
+		return BBR_HIGH_GAIN;
+	case BBR_DRAIN:
+		return BBR_DRAIN_GAIN;
+	case BBR_PROBE_BW:
+		return bbr_probe_bw_gain[bbr->cycle_idx];
+	default:
+		return BBR_UNIT;
+	}
+}
+
+/* Bandwidth-delay product in bytes scaled by gain */
+static uint32_t bbr_bdp(struct tcp_ca_bbr *bbr, uint32_t gain)
+{
+	uint64_t bdp = (uint64_t)bbr->btl_bw * bbr->min_rtt_us / USEC_PER_SEC;
+
+	return MIN(bdp * gain / BBR_UNIT, UINT32_MAX);
+}
+
+static bool bbr_full_pipe(struct tcp_ca_bbr *bbr)
+{
+	return bbr->full_bw_cnt >= BBR_FULL_BW_ROUNDS;
+}
+
+static void bbr_set_cwnd(struct tcp *conn, uint32_t acked_len)
+{
+	struct tcp_ca_bbr *bbr = &conn->ca.bbr;
+	uint32_t min_cwnd = conn_mss(conn) * BBR_MIN_CWND_SEGS;
+	uint32_t gain = bbr->mode == BBR_STARTUP ? BBR_HIGH_GAIN : BBR_CWND_GAIN;
+	uint32_t target = bbr_bdp(bbr, gain);
+	uint32_t cwnd = conn->ca.cwnd;
+
+	if (bbr->mode == BBR_PROBE_RTT) {
+		cwnd = MIN(cwnd, min_cwnd);
+	} else if (bbr_full_pipe(bbr)) {
+		cwnd = MIN(cwnd + acked_len, target);
+	} else if (cwnd < target || bbr->btl_bw == 0) {
+		/* Grow like slow start until the model catches up */
+		cwnd += acked_len;
+	}
+
+	conn->ca.cwnd = CLAMP(cwnd, min_cwnd, TCP_CONGESTION_MAX_WIN);
+}
+
+static void bbr_init(struct tcp *conn)
+{
+	struct tcp_ca_bbr *bbr = &conn->ca.bbr;
+
+	memset(bbr, 0, sizeof(*bbr));
+	bbr->mode = BBR_STARTUP;
+	bbr->round_start = k_cycle_get_32();
+	bbr->min_rtt_stamp = k_uptime_get_32();
+
+	conn->ca.cwnd = tcp_ca_initial_win(conn);
+	conn->ca.ssthresh = TCP_CONGESTION_MAX_WIN;
+	conn->ca.pending_fast_retransmit_bytes = 0;
+	bbr_log(conn, "init");
+}
+
+/* The model does not treat losses as a congestion signal, the
+ * retransmissions are covered by the unchanged window.
+ */
+static void bbr_fast_retransmit(struct tcp *conn)
+{
+	bbr_log(conn, "fast_retransmit");
+}
+
+static void bbr_timeout(struct tcp *conn)
+{
+	/* Restart from one segment, the next round restores the model */
+	conn->ca.cwnd = conn_mss(conn);
+	conn->ca.bbr.next_send = k_cycle_get_32();
+	bbr_log(conn, "timeout");
+}
+
+static void bbr_dup_ack(struct tcp *conn)
+{
+	ARG_UNUSED(conn);
+}
+
+static void bbr_update_min_rtt(struct tcp *conn)
+{
+	struct tcp_ca_bbr *bbr = &conn->ca.bbr;
+	uint32_t now = k_uptime_get_32();
+	bool expired = (now - bbr->min_rtt_stamp) > BBR_MIN_RTT_WIN_MS;
+	uint32_t rtt_us = conn->ca.rtt_us;
+
+	if (rtt_us != 0 && (bbr->min_rtt_us == 0 || rtt_us <= bbr->min_rtt_us)) {
+		bbr->min_rtt_us = rtt_us;
+		bbr->min_rtt_stamp = now;
+	} else if (expired && bbr->mode != BBR_PROBE_RTT) {
+		/* Drain the queue so that the samples show the path delay */
+		bbr->mode = BBR_PROBE_RTT;
+		bbr->probe_rtt_done = now + BBR_PROBE_RTT_MS;
+		bbr_log(conn, "probe_rtt");
+	}
+
+	if (bbr->mode == BBR_PROBE_RTT && (int32_t)(now - bbr->probe_rtt_done) >= 0) {
+		/* The latest sample was taken with a drained queue */
+		if (rtt_us != 0) {
+			bbr->min_rtt_us = rtt_us;
+		}
+
+		bbr->min_rtt_stamp = now;
+		bbr->mode = bbr_full_pipe(bbr) ? BBR_PROBE_BW : BBR_STARTUP;
+	}
+}
+
+/* Advance the state machine once per round trip */
+static void bbr_round_end(struct tcp *conn, uint32_t bw)
+{
+	struct tcp_ca_bbr *bbr = &conn->ca.bbr;
+
+	if (bw >= bbr->btl_bw || ++bbr->bw_age >= BBR_BW_ROUNDS) {
+		bbr->btl_bw = bw;
+		bbr->bw_age = 0;
+	}
+
+	switch (bbr->mode) {
+	case BBR_STARTUP:
+		/* Startup is done when the bandwidth stops growing by 25% */
+		if (bbr->btl_bw >= bbr->full_bw + bbr->full_bw / 4) {
+			bbr->full_bw = bbr->btl_bw;
+			bbr->full_bw_cnt = 0;
+		} else if (++bbr->full_bw_cnt >= BBR_FULL_BW_ROUNDS) {
+			bbr_log(conn, "drain");
+			bbr->mode = BBR_DRAIN;
+		}
+		break;
+	case BBR_DRAIN:
+		if ((uint32_t)conn->unacked_len <= bbr_bdp(bbr, BBR_UNIT)) {
+			bbr->mode = BBR_PROBE_BW;
+			/* Do not probe right away after draining */
+			bbr->cycle_idx = 2;
+		}
+		break;
+	case BBR_PROBE_BW:
+		bbr->cycle_idx = (bbr->cycle_idx + 1) % ARRAY_SIZE(bbr_probe_bw_gain);
+		break;
+	default:
+		break;
+	}
+}
+
+static void bbr_pkts_acked(struct tcp *conn, uint32_t acked_len)
+{
+	struct tcp_ca_bbr *bbr = &conn->ca.bbr;
+	uint32_t round_us = bbr->min_rtt_us != 0 ? bbr->min_rtt_us : conn->ca.rtt_us;
+	uint32_t elapsed_us;
+
+	bbr_update_min_rtt(conn);
+
+	bbr->delivered += acked_len;
+	elapsed_us = k_cyc_to_us_floor32(k_cycle_get_32() - bbr->round_start);
+
+	if (round_us != 0 && elapsed_us >= round_us) {
+		uint64_t bw = (uint64_t)bbr->delivered * USEC_PER_SEC / elapsed_us;
+
+		bbr_round_end(conn, MIN(bw, UINT32_MAX));
+		bbr->delivered = 0;
+		bbr->round_start = k_cycle_get_32();
+	}
+
+	bbr_set_cwnd(conn, acked_len);
+
+	bbr_log(conn, "pkts_acked");
+}
+
+static uint32_t bbr_pacing_delay(struct tcp *conn, uint32_t len)
+{
+	struct tcp_ca_bbr *bbr = &conn->ca.bbr;
+	uint32_t now = k_cycle_get_32();
+	int32_t wait = (int32_t)(bbr->next_send - now);
+	uint64_t rate;
+	uint32_t interval;
+
+	if (bbr->btl_bw == 0) {
+		/* Nothing to pace at before the first estimate */
+		return 0;
+	}
+
+	/* A wait shorter than a system tick cannot be timed, send the
+	 * segment now and let the debt delay a later one instead.
+	 */
+	if (wait > 0 && k_cyc_to_us_ceil32(wait) >= USEC_PER_SEC / CONFIG_SYS_CLOCK_TICKS_PER_SEC) {
+		return k_cyc_to_us_ceil32(wait);
+	}
+
+	rate = (uint64_t)bbr->btl_bw * bbr_pacing_gain(bbr) / BBR_UNIT;
+	interval = k_us_to_cyc_ceil32((uint64_t)len * USEC_PER_SEC / MAX(rate, 1U));
+
+	/* Do not build up credit while the connection is idle */
+	if (wait < -(int32_t)interval) {
+		bbr->next_send = now;
+	}
+
+	bbr->next_send += interval;
+
+	return 0;
+}
+
+TCP_CA_DEFINE(bbr,
+	      .init = bbr_init,
+	      .fast_retransmit = bbr_fast_retransmit,
+	      .timeout = bbr_timeout,
+	      .dup_ack = bbr_dup_ack,
+	      .pkts_acked = bbr_pkts_acked,
+	      .pacing_delay = bbr_pacing_delay);
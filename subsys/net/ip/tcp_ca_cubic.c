@@ -0,0 +1,213 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* CUBIC congestion control, implementation according to RFC 9438 */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include "tcp_internal.h"
+
+/* beta_cubic = 0.7 and C = 0.4, scaled by CUBIC_SCALE */
+#define CUBIC_SCALE 1024U
+#define CUBIC_BETA 717U
+/* Fast convergence factor (1 + beta_cubic) / 2 */
+#define CUBIC_BETA_FAST 870U
+/* alpha_cubic = 3 * (1 - beta_cubic) / (1 + beta_cubic) */
+#define CUBIC_ALPHA 542U
+#define CUBIC_C 410U
+
+/* Limit the time distance from K so the cube cannot overflow */
+#define CUBIC_MAX_DELTA_MS (60 * MSEC_PER_SEC)
+
+static uint32_t cubic_cbrt(uint64_t x)
+{
+	uint64_t y = 0;
+
+	for (int shift = 63; shift >= 0; shift -= 3) {
+		uint64_t b;
+
+		y <<= 1;
+		b = 3 * y * (y + 1) + 1;
+
+		if ((x >> shift) >= b) {
+			x -= b << shift;
+			y++;
+		}
+	}
+
+	return (uint32_t)y;
+}
+
+static uint32_t cubic_now(void)
+{
+	uint32_t now = k_uptime_get_32();
+
+	/* 0 marks that no epoch is running */
+	return now != 0U ? now : 1U;
+}
+
+static void cubic_log(struct tcp *conn, char *step)
+{
+	NET_DBG("[%p] ca %s, cwnd=%u, ssthres=%u, w_max=%u, k=%u",
+		conn, step, conn->ca.cwnd, conn->ca.ssthresh,
+		conn->ca.cubic.w_max, conn->ca.cubic.k);
+}
+
+static void cubic_init(struct tcp *conn)
+{
+	conn->ca.cwnd = tcp_ca_initial_win(conn);
+	conn->ca.ssthresh = conn_mss(conn) * TCP_CONGESTION_INITIAL_SSTHRESH;
+	conn->ca.pending_fast_retransmit_bytes = 0;
+	conn->ca.cubic.epoch_start = 0;
+	conn->ca.cubic.w_max = 0;
+	conn->ca.cubic.k = 0;
+	cubic_log(conn, "init");
+}
+
+/* Multiplicative decrease on a congestion event */
+static void cubic_reduce(struct tcp *conn)
+{
+	struct tcp_ca_cubic *cubic = &conn->ca.cubic;
+	uint32_t flight = MAX(conn->unacked_len, 0);
+
+	if (conn->ca.cwnd < cubic->w_max) {
+		/* Release bandwidth for a new flow, see RFC 9438 4.7 */
+		cubic->w_max = (uint64_t)conn->ca.cwnd * CUBIC_BETA_FAST / CUBIC_SCALE;
+	} else {
+		cubic->w_max = conn->ca.cwnd;
+	}
+
+	conn->ca.ssthresh = MAX(conn_mss(conn) * 2,
+				flight * CUBIC_BETA / CUBIC_SCALE);
+	cubic->epoch_start = 0;
+}
+
+static void cubic_fast_retransmit(struct tcp *conn)
+{
+	if (conn->ca.pending_fast_retransmit_bytes == 0) {
+		cubic_reduce(conn);
+		/* Account for the lost segments */
+		conn->ca.cwnd = conn_mss(conn) * 3 + conn->ca.ssthresh;
+		conn->ca.pending_fast_retransmit_bytes = conn->unacked_len;
+		cubic_log(conn, "fast_retransmit");
+	}
+}
+
+static void cubic_timeout(struct tcp *conn)
+{
+	cubic_reduce(conn);
+	conn->ca.cwnd = conn_mss(conn);
+	conn->ca.pending_fast_retransmit_bytes = 0;
+	cubic_log(conn, "timeout");
+}
+
+static void cubic_dup_ack(struct tcp *conn)
+{
+	conn->ca.cwnd = MIN(conn->ca.cwnd + conn_mss(conn), TCP_CONGESTION_MAX_WIN);
+}
+
+static void cubic_epoch_start(struct tcp *conn)
+{
+	struct tcp_ca_cubic *cubic = &conn->ca.cubic;
+	uint32_t cwnd = conn->ca.cwnd;
+
+	cubic->epoch_start = cubic_now();
+	cubic->w_est = cwnd;
+
+	if (cwnd < cubic->w_max) {
+		/* K = cbrt((W_max - cwnd) / C), in ms with windows in segments */
+		uint64_t diff = (uint64_t)(cubic->w_max - cwnd) * CUBIC_SCALE *
+				MSEC_PER_SEC * MSEC_PER_SEC;
+
+		diff /= (uint64_t)CUBIC_C * conn_mss(conn);
+		cubic->k = cubic_cbrt(diff * MSEC_PER_SEC);
+	} else {
+		cubic->k = 0;
+		cubic->w_max = cwnd;
+	}
+}
+
+/* W_cubic(t) = C * (t - K)^3 + W_max, t in ms */
+static uint32_t cubic_window(struct tcp *conn, uint32_t t)
+{
+	struct tcp_ca_cubic *cubic = &conn->ca.cubic;
+	int64_t delta = (int64_t)t - cubic->k;
+	int64_t win;
+
+	delta = CLAMP(delta, -CUBIC_MAX_DELTA_MS, CUBIC_MAX_DELTA_MS);
+
+	win = delta * delta * delta * CUBIC_C / CUBIC_SCALE * conn_mss(conn);
+	win /= (int64_t)MSEC_PER_SEC * MSEC_PER_SEC * MSEC_PER_SEC;
+	win += cubic->w_max;
+
+	return CLAMP(win, 0, TCP_CONGESTION_MAX_WIN);
+}
+
+static void cubic_congestion_avoidance(struct tcp *conn, uint32_t acked_len)
+{
+	struct tcp_ca_cubic *cubic = &conn->ca.cubic;
+	uint32_t cwnd = conn->ca.cwnd;
+	uint32_t mss = conn_mss(conn);
+	uint32_t target;
+	uint32_t t;
+
+	if (cubic->epoch_start == 0) {
+		cubic_epoch_start(conn);
+	}
+
+	/* Aim for the window one round-trip time ahead */
+	t = cubic_now() - cubic->epoch_start + conn->ca.rtt_us / USEC_PER_MSEC;
+	target = cubic_window(conn, t);
+	target = CLAMP(target, cwnd, cwnd + cwnd / 2);
+
+	/* Do not grow slower than Reno would, see RFC 9438 4.3 */
+	cubic->w_est += DIV_ROUND_UP(CUBIC_ALPHA * mss / CUBIC_SCALE * acked_len, cwnd);
+	if (cubic->w_est > target) {
+		target = cubic->w_est;
+	}
+
+	if (target > cwnd) {
+		uint32_t win_inc = MIN(acked_len, mss);
+
+		cwnd += DIV_ROUND_UP((uint64_t)(target - cwnd) * win_inc, cwnd);
+		conn->ca.cwnd = MIN(cwnd, TCP_CONGESTION_MAX_WIN);
+	}
+}
+
+static void cubic_pkts_acked(struct tcp *conn, uint32_t acked_len)
+{
+	uint32_t mss = conn_mss(conn);
+
+	if (conn->ca.pending_fast_retransmit_bytes != 0) {
+		/* Check if it is still in fast recovery mode */
+		if (conn->ca.pending_fast_retransmit_bytes <= acked_len) {
+			conn->ca.pending_fast_retransmit_bytes = 0;
+			conn->ca.cwnd = conn->ca.ssthresh;
+		} else {
+			conn->ca.pending_fast_retransmit_bytes -= acked_len;
+
+			/* Deflate the window, but not below one segment */
+			if (conn->ca.cwnd > mss) {
+				conn->ca.cwnd -= MIN(acked_len, conn->ca.cwnd - mss);
+			}
+		}
+	} else if (conn->ca.cwnd < conn->ca.ssthresh) {
+		conn->ca.cwnd = MIN(conn->ca.cwnd + MIN(acked_len, mss), TCP_CONGESTION_MAX_WIN);
+	} else {
+		cubic_congestion_avoidance(conn, acked_len);
+	}
+
+	cubic_log(conn, "pkts_acked");
+}
+
+TCP_CA_DEFINE(cubic,
+	      .init = cubic_init,
+	      .fast_retransmit = cubic_fast_retransmit,
+	      .timeout = cubic_timeout,
+	      .dup_ack = cubic_dup_ack,
+	      .pkts_acked = cubic_pkts_acked);
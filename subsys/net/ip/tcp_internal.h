@@ -50,6 +50,7 @@ enum tcp_conn_option {
 	TCP_OPT_KEEPIDLE = 3,
 	TCP_OPT_KEEPINTVL = 4,
 	TCP_OPT_KEEPCNT = 5,
+	TCP_OPT_CONGESTION = 6,
 };
 
 /**
@@ -308,20 +309,24 @@ struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt,
  * @param data		Pointer to the data
  * @param len		Number of bytes
  * @param msg		Data for a vector array operation
+ * @param ext		If not NULL, the iovecs of msg are referenced through it
+ *			until acknowledged instead of being copied
  *
  * @return 0 if ok, < 0 if error
  */
 #if defined(CONFIG_NET_NATIVE_TCP)
 int net_tcp_queue(struct net_context *context, const void *data, size_t len,
-		  const struct net_msghdr *msg);
+		  const struct net_msghdr *msg, struct net_buf_ext *ext);
 #else
 static inline int net_tcp_queue(struct net_context *context, const void *data,
-				size_t len, const struct net_msghdr *msg)
+				size_t len, const struct net_msghdr *msg,
+				struct net_buf_ext *ext)
 {
 	ARG_UNUSED(context);
 	ARG_UNUSED(data);
 	ARG_UNUSED(len);
 	ARG_UNUSED(msg);
+	ARG_UNUSED(ext);
 
 	return -EPROTONOSUPPORT;
 }
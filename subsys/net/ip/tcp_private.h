@@ -7,6 +7,7 @@
 
 #include "tp.h"
 #include <zephyr/toolchain/gcc.h>
+#include <zephyr/sys/iterable_sections.h>
 
 #define is(_a, _b) (strcmp((_a), (_b)) == 0)
 
@@ -229,30 +230,140 @@ union tcp_endpoint {
 #define NET_TCP_NOP_OPT          1
 #define NET_TCP_MSS_OPT          2
 #define NET_TCP_WINDOW_SCALE_OPT 3
+#define NET_TCP_SACK_PERM_OPT    4
+#define NET_TCP_SACK_OPT         5
 
 /* TCP Option sizes */
 #define NET_TCP_END_SIZE          1
 #define NET_TCP_NOP_SIZE          1
 #define NET_TCP_MSS_SIZE          4
 #define NET_TCP_WINDOW_SCALE_SIZE 3
+#define NET_TCP_SACK_PERM_SIZE    2
+#define NET_TCP_SACK_BLOCK_SIZE   8
+
+/* At most 4 SACK blocks fit in the 40 bytes of TCP options */
+#define NET_TCP_SACK_MAX_BLOCKS   4
+
+struct tcp_sack_block {
+	uint32_t left;  /* First sequence number of the block */
+	uint32_t right; /* Sequence number following the block */
+};
 
 struct tcp_options {
 	uint16_t mss;
 	uint16_t window;
+#if defined(CONFIG_NET_TCP_SACK)
+	struct tcp_sack_block sack[NET_TCP_SACK_MAX_BLOCKS];
+	uint8_t sack_cnt;
+	bool sack_perm_found : 1;
+#endif
 	bool mss_found : 1;
 	bool wnd_found : 1;
 };
 
+struct tcp;
+
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
 
-struct tcp_collision_avoidance_reno {
-	uint16_t cwnd;
-	uint16_t ssthresh;
+/* Congestion control module, selectable per connection by name */
+struct tcp_ca_ops {
+	const char *name;
+	/* Called when the connection is established */
+	void (*init)(struct tcp *conn);
+	/* Three duplicate acks have been received */
+	void (*fast_retransmit)(struct tcp *conn);
+	/* The retransmission timer expired */
+	void (*timeout)(struct tcp *conn);
+	/* A duplicate ack has been received */
+	void (*dup_ack)(struct tcp *conn);
+	/* New data has been acknowledged */
+	void (*pkts_acked)(struct tcp *conn, uint32_t acked_len);
+#if defined(CONFIG_NET_TCP_CA_PACING)
+	/* Optional, microseconds to wait before len more bytes may be sent.
+	 * Returning 0 allows the transmission, which the module accounts for.
+	 */
+	uint32_t (*pacing_delay)(struct tcp *conn, uint32_t len);
+#endif
+};
+
+#define TCP_CA_NAME_MAX 16
+
+/* Define the number of MSS sections the congestion window is initialized at */
+#define TCP_CONGESTION_INITIAL_WIN 1
+#define TCP_CONGESTION_INITIAL_SSTHRESH 3
+
+/* The CUBIC and BBR modules start at 10 segments instead, limited to
+ * TCP_CA_INITIAL_WIN_BYTES for large segments (RFC 6928)
+ */
+#define TCP_CA_INITIAL_WIN 10
+#define TCP_CA_INITIAL_WIN_BYTES 14600
+
+/* Largest window that can be advertised with window scaling (RFC 7323) */
+#define TCP_CONGESTION_MAX_WIN ((uint32_t)UINT16_MAX << 14)
+
+#define tcp_ca_initial_win(_conn)					\
+	MIN(conn_mss(_conn) * TCP_CA_INITIAL_WIN,			\
+	    MAX(conn_mss(_conn) * 2, TCP_CA_INITIAL_WIN_BYTES))
+
+/* Register a congestion control module, _name is the name selectable
+ * with the TCP_CONGESTION socket option.
+ */
+#define TCP_CA_DEFINE(_name, ...)					\
+	static const STRUCT_SECTION_ITERABLE(tcp_ca_ops,		\
+					     tcp_ca_##_name) = {	\
+		.name = STRINGIFY(_name),				\
+		__VA_ARGS__						\
+	}
+
+#if defined(CONFIG_NET_TCP_CA_CUBIC)
+struct tcp_ca_cubic {
+	uint32_t epoch_start; /* Start of the growth epoch in ms, 0 if none */
+	uint32_t k;           /* Time in ms to grow back to w_max */
+	uint32_t w_max;       /* Window before the last reduction */
+	uint32_t w_est;       /* Reno friendly window estimate */
+};
+#endif
+
+#if defined(CONFIG_NET_TCP_CA_BBR)
+struct tcp_ca_bbr {
+	uint32_t btl_bw;        /* Bottleneck bandwidth, bytes per second */
+	uint32_t full_bw;       /* Bandwidth when startup last grew */
+	uint32_t min_rtt_us;    /* Minimum round-trip time seen */
+	uint32_t min_rtt_stamp; /* Uptime in ms when min_rtt_us was taken */
+	uint32_t round_start;   /* Cycle count when the delivery round began */
+	uint32_t delivered;     /* Bytes acked in the current round */
+	uint32_t next_send;     /* Cycle count when pacing allows sending */
+	uint32_t probe_rtt_done; /* Uptime in ms when the RTT probe ends */
+	uint8_t mode;
+	uint8_t cycle_idx;      /* Position in the probe bandwidth gain cycle */
+	uint8_t full_bw_cnt;    /* Rounds without significant growth */
+	uint8_t bw_age;         /* Rounds since btl_bw was measured */
+};
+#endif
+
+struct tcp_ca_state {
+	const struct tcp_ca_ops *ops;
+	uint32_t snd_max;   /* Highest sequence number sent so far */
+	uint32_t rtt_start; /* Cycle count when rtt_seq was sent */
+	uint32_t rtt_seq;   /* Sequence number being timed */
+	uint32_t rtt_us;    /* Latest round-trip time sample, 0 if none */
+	uint32_t cwnd;
+	uint32_t ssthresh;
 	uint16_t pending_fast_retransmit_bytes;
+	bool rtt_pending;
+#if defined(CONFIG_NET_TCP_CA_CUBIC) || defined(CONFIG_NET_TCP_CA_BBR)
+	union {
+#if defined(CONFIG_NET_TCP_CA_CUBIC)
+		struct tcp_ca_cubic cubic;
+#endif
+#if defined(CONFIG_NET_TCP_CA_BBR)
+		struct tcp_ca_bbr bbr;
+#endif
+	};
+#endif
 };
 #endif
 
-struct tcp;
 typedef void (*net_tcp_closed_cb_t)(struct tcp *conn, void *user_data);
 
 struct tcp { /* TCP connection */
@@ -292,6 +403,9 @@ struct tcp { /* TCP connection */
 	struct k_work_delayable timewait_timer;
 	struct k_work_delayable persist_timer;
 	struct k_work_delayable ack_timer;
+#if defined(CONFIG_NET_TCP_CA_PACING)
+	struct k_work_delayable pacing_timer;
+#endif
 #if defined(CONFIG_NET_TCP_KEEPALIVE)
 	struct k_work_delayable keepalive_timer;
 #endif /* CONFIG_NET_TCP_KEEPALIVE */
@@ -335,7 +449,15 @@ struct tcp { /* TCP connection */
 	uint16_t rto;
 #endif
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
-	struct tcp_collision_avoidance_reno ca;
+	struct tcp_ca_state ca;
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+	/* Ranges of sent data the peer reported as received, sorted */
+	struct tcp_sack_block sack_board[CONFIG_NET_TCP_SACK_SCOREBOARD_SIZE];
+	uint32_t sack_last_seq;  /* Start of the latest out-of-order segment */
+	uint32_t sack_recover;   /* Loss recovery ends when this is acked */
+	uint32_t sack_rexmit_nxt; /* Next hole byte to retransmit */
+	uint8_t sack_board_cnt;
 #endif
 	uint8_t send_data_retries;
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
@@ -350,6 +472,10 @@ struct tcp { /* TCP connection */
 	bool tcp_nodelay : 1;
 	bool addr_ref_done : 1;
 	bool rst_received : 1;
+#if defined(CONFIG_NET_TCP_SACK)
+	bool sack_ok : 1;       /* SACK negotiated with the peer */
+	bool sack_recovery : 1; /* SACK based loss recovery in progress */
+#endif
 };
 
 #define _flags(_fl, _op, _mask, _cond)					\
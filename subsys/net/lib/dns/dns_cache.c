@@ -6,18 +6,163 @@
 
 #include <zephyr/net/dns_resolve.h>
 #include <zephyr/net/net_ip.h>
+#include <zephyr/sys/crc.h>
 #include "dns_cache.h"
 
 LOG_MODULE_REGISTER(net_dns_cache, CONFIG_DNS_RESOLVER_LOG_LEVEL);
 
-static void dns_cache_clean(struct dns_cache const *cache);
+static void dns_cache_clean(struct dns_cache *cache);
+
+int dns_cache_expiry_cmp(const void *a, const void *b)
+{
+	const struct dns_cache_expiry *expiry_a = a;
+	const struct dns_cache_expiry *expiry_b = b;
+
+	return sys_timepoint_cmp(expiry_a->expiry, expiry_b->expiry);
+}
+
+static uint16_t dns_cache_hash(char const *query)
+{
+	return crc16_ansi(query, strlen(query));
+}
+
+static sys_slist_t *dns_cache_bucket(struct dns_cache *cache, uint16_t hash)
+{
+	return &cache->buckets[hash % cache->size];
+}
+
+static bool dns_cache_expiry_is_stale(struct dns_cache *cache,
+				      struct dns_cache_expiry const *expiry)
+{
+	struct dns_cache_entry const *entry = &cache->entries[expiry->index];
+
+	return !entry->in_use || entry->generation != expiry->generation;
+}
+
+/* Needs to be called when lock is already acquired */
+static void dns_cache_release(struct dns_cache *cache, struct dns_cache_entry *entry)
+{
+	/* The expiry node of the entry is left in the heap, and skipped once
+	 * the generation does not match anymore.
+	 */
+	sys_slist_find_and_remove(dns_cache_bucket(cache, entry->hash), &entry->node);
+	sys_dlist_remove(&entry->lru_node);
+	entry->in_use = false;
+	entry->generation++;
+	sys_slist_prepend(&cache->free_list, &entry->node);
+}
+
+/* Drop the stale nodes of the expiry heap, needs to be called when lock is
+ * already acquired.
+ */
+static void dns_cache_expiry_compact(struct dns_cache *cache)
+{
+	struct min_heap *heap = &cache->expiry_heap;
+	struct dns_cache_expiry expiry;
+	size_t count = 0;
+
+	for (size_t i = 0; i < heap->size; i++) {
+		struct dns_cache_expiry *node = min_heap_get_element(heap, i);
+
+		if (!dns_cache_expiry_is_stale(cache, node)) {
+			*(struct dns_cache_expiry *)min_heap_get_element(heap, count++) = *node;
+		}
+	}
+
+	heap->size = 0;
+	for (size_t i = 0; i < count; i++) {
+		expiry = *(struct dns_cache_expiry *)min_heap_get_element(heap, i);
+		(void)min_heap_push(heap, &expiry);
+	}
+}
+
+/* Needs to be called when lock is already acquired */
+static struct dns_cache_entry *dns_cache_entry_get(struct dns_cache *cache)
+{
+	sys_snode_t *node;
+
+	if (sys_slist_is_empty(&cache->free_list)) {
+		if (cache->next_unused < cache->size) {
+			return &cache->entries[cache->next_unused++];
+		}
+
+		/* All the entries are in use, replace the least recently used one */
+		struct dns_cache_entry *entry =
+			SYS_DLIST_PEEK_HEAD_CONTAINER(&cache->lru, entry, lru_node);
+
+		NET_DBG("Overwrite \"%s\"", entry->query);
+		dns_cache_release(cache, entry);
+	}
+
+	node = sys_slist_get(&cache->free_list);
+
+	return CONTAINER_OF(node, struct dns_cache_entry, node);
+}
+
+/* Needs to be called when lock is already acquired */
+static void dns_cache_insert(struct dns_cache *cache, char const *query, uint16_t hash,
+			     struct dns_addrinfo const *addrinfo, uint32_t ttl)
+{
+	struct dns_cache_entry *entry = dns_cache_entry_get(cache);
+	struct dns_cache_expiry expiry;
+
+	strncpy(entry->query, query, CONFIG_DNS_RESOLVER_MAX_QUERY_LEN - 1);
+	if (addrinfo != NULL) {
+		entry->data = *addrinfo;
+	} else {
+		memset(&entry->data, 0, sizeof(entry->data));
+	}
+	entry->expiry = sys_timepoint_calc(K_SECONDS(ttl));
+	entry->hash = hash;
+	entry->nxdomain = (addrinfo == NULL);
+	entry->in_use = true;
+
+	sys_slist_append(dns_cache_bucket(cache, hash), &entry->node);
+	sys_dlist_append(&cache->lru, &entry->lru_node);
+
+	expiry.expiry = entry->expiry;
+	expiry.index = entry - cache->entries;
+	expiry.generation = entry->generation;
+
+	/* At most half of the heap holds nodes of entries in use */
+	if (cache->expiry_heap.size == cache->expiry_heap.capacity) {
+		dns_cache_expiry_compact(cache);
+	}
+
+	(void)min_heap_push(&cache->expiry_heap, &expiry);
+}
+
+/* Needs to be called when lock is already acquired */
+static void dns_cache_drop(struct dns_cache *cache, char const *query, uint16_t hash,
+			   bool nxdomain_only)
+{
+	struct dns_cache_entry *entry;
+	struct dns_cache_entry *next;
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(dns_cache_bucket(cache, hash), entry, next, node) {
+		if (entry->hash != hash || strcmp(entry->query, query) != 0) {
+			continue;
+		}
+
+		if (!nxdomain_only || entry->nxdomain) {
+			dns_cache_release(cache, entry);
+		}
+	}
+}
 
 int dns_cache_flush(struct dns_cache *cache)
 {
 	k_mutex_lock(cache->lock, K_FOREVER);
 	for (size_t i = 0; i < cache->size; i++) {
 		cache->entries[i].in_use = false;
+		sys_slist_init(&cache->buckets[i]);
 	}
+	sys_slist_init(&cache->free_list);
+	sys_dlist_init(&cache->lru);
+	cache->next_unused = 0;
+	min_heap_init(&cache->expiry_heap, cache->expiry_heap.storage,
+		      cache->expiry_heap.capacity, cache->expiry_heap.elem_size,
+		      cache->expiry_heap.cmp);
 	k_mutex_unlock(cache->lock);
 
 	return 0;
@@ -26,9 +171,7 @@ int dns_cache_flush(struct dns_cache *cache)
 int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinfo const *addrinfo,
 		  uint32_t ttl)
 {
-	k_timepoint_t closest_to_expiry = sys_timepoint_calc(K_FOREVER);
-	size_t index_to_replace = 0;
-	bool found_empty = false;
+	uint16_t hash;
 
 	if (cache == NULL || query == NULL || addrinfo == NULL || ttl == 0) {
 		return -EINVAL;
@@ -41,32 +184,48 @@ int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinf
 		return -EINVAL;
 	}
 
+	hash = dns_cache_hash(query);
+
 	k_mutex_lock(cache->lock, K_FOREVER);
 
 	NET_DBG("Add \"%s\" with TTL %" PRIu32, query, ttl);
 
 	dns_cache_clean(cache);
 
-	for (size_t i = 0; i < cache->size; i++) {
-		if (!cache->entries[i].in_use) {
-			index_to_replace = i;
-			found_empty = true;
-			break;
-		} else if (sys_timepoint_cmp(closest_to_expiry, cache->entries[i].expiry) > 0) {
-			index_to_replace = i;
-			closest_to_expiry = cache->entries[i].expiry;
-		}
+	/* The name exists after all */
+	dns_cache_drop(cache, query, hash, true);
+	dns_cache_insert(cache, query, hash, addrinfo, ttl);
+
+	k_mutex_unlock(cache->lock);
+
+	return 0;
+}
+
+int dns_cache_add_nxdomain(struct dns_cache *cache, char const *query, uint32_t ttl)
+{
+	uint16_t hash;
+
+	if (cache == NULL || query == NULL || ttl == 0) {
+		return -EINVAL;
 	}
 
-	if (!found_empty) {
-		NET_DBG("Overwrite \"%s\"", cache->entries[index_to_replace].query);
+	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
+		NET_WARN("Query string to big to be processed %u >= "
+			 "CONFIG_DNS_RESOLVER_MAX_QUERY_LEN",
+			 strlen(query));
+		return -EINVAL;
 	}
 
-	strncpy(cache->entries[index_to_replace].query, query,
-		CONFIG_DNS_RESOLVER_MAX_QUERY_LEN - 1);
-	cache->entries[index_to_replace].data = *addrinfo;
-	cache->entries[index_to_replace].expiry = sys_timepoint_calc(K_SECONDS(ttl));
-	cache->entries[index_to_replace].in_use = true;
+	hash = dns_cache_hash(query);
+
+	k_mutex_lock(cache->lock, K_FOREVER);
+
+	NET_DBG("Add non-existent \"%s\" with TTL %" PRIu32, query, ttl);
+
+	dns_cache_clean(cache);
+
+	dns_cache_drop(cache, query, hash, false);
+	dns_cache_insert(cache, query, hash, NULL, ttl);
 
 	k_mutex_unlock(cache->lock);
 
@@ -90,23 +249,21 @@ int dns_cache_remove(struct dns_cache *cache, char const *query)
 	k_mutex_lock(cache->lock, K_FOREVER);
 
 	dns_cache_clean(cache);
-
-	for (size_t i = 0; i < cache->size; i++) {
-		if (cache->entries[i].in_use && strcmp(cache->entries[i].query, query) == 0) {
-			cache->entries[i].in_use = false;
-		}
-	}
+	dns_cache_drop(cache, query, dns_cache_hash(query), false);
 
 	k_mutex_unlock(cache->lock);
 
 	return 0;
 }
 
-int dns_cache_find(struct dns_cache const *cache, const char *query, enum dns_query_type type,
+int dns_cache_find(struct dns_cache *cache, const char *query, enum dns_query_type type,
 		   struct dns_addrinfo *addrinfo, size_t addrinfo_array_len)
 {
+	struct dns_cache_entry *entry;
+	bool nxdomain = false;
 	size_t found = 0;
 	net_sa_family_t family;
+	uint16_t hash;
 
 	NET_DBG("Find \"%s\"", query);
 	if (cache == NULL || query == NULL || addrinfo == NULL || addrinfo_array_len <= 0) {
@@ -126,25 +283,33 @@ int dns_cache_find(struct dns_cache const *cache, const char *query, enum dns_qu
 		return -EINVAL;
 	}
 
+	hash = dns_cache_hash(query);
+
 	k_mutex_lock(cache->lock, K_FOREVER);
 
 	dns_cache_clean(cache);
 
-	for (size_t i = 0; i < cache->size; i++) {
-		if (!cache->entries[i].in_use) {
+	SYS_SLIST_FOR_EACH_CONTAINER(dns_cache_bucket(cache, hash), entry, node) {
+		if (entry->hash != hash || strcmp(entry->query, query) != 0) {
 			continue;
 		}
-		if (strcmp(cache->entries[i].query, query) != 0) {
+
+		/* Keep the entries of the query the longest when the cache is full */
+		sys_dlist_remove(&entry->lru_node);
+		sys_dlist_append(&cache->lru, &entry->lru_node);
+
+		if (entry->nxdomain) {
+			nxdomain = true;
 			continue;
 		}
-		if (cache->entries[i].data.ai_family != family) {
+		if (entry->data.ai_family != family) {
 			continue;
 		}
 		if (found >= addrinfo_array_len) {
 			NET_WARN("Found \"%s\" but not enough space in provided buffer.", query);
 			found++;
 		} else {
-			addrinfo[found] = cache->entries[i].data;
+			addrinfo[found] = entry->data;
 			found++;
 			NET_DBG("Found \"%s\"", query);
 		}
@@ -157,22 +322,35 @@ int dns_cache_find(struct dns_cache const *cache, const char *query, enum dns_qu
 	}
 
 	if (found == 0) {
+		if (nxdomain) {
+			NET_DBG("\"%s\" does not exist", query);
+			return -ENOENT;
+		}
+
 		NET_DBG("Could not find \"%s\"", query);
 	}
 	return found;
 }
 
 /* Needs to be called when lock is already acquired */
-static void dns_cache_clean(struct dns_cache const *cache)
+static void dns_cache_clean(struct dns_cache *cache)
 {
-	for (size_t i = 0; i < cache->size; i++) {
-		if (!cache->entries[i].in_use) {
-			continue;
-		}
+	struct dns_cache_expiry *expiry;
+	struct dns_cache_expiry removed;
 
-		if (sys_timepoint_expired(cache->entries[i].expiry)) {
-			NET_DBG("Remove \"%s\"", cache->entries[i].query);
-			cache->entries[i].in_use = false;
+	/* Only the entries closest to expiry are looked at */
+	while ((expiry = min_heap_peek(&cache->expiry_heap)) != NULL) {
+		if (!dns_cache_expiry_is_stale(cache, expiry)) {
+			struct dns_cache_entry *entry = &cache->entries[expiry->index];
+
+			if (!sys_timepoint_expired(expiry->expiry)) {
+				break;
+			}
+
+			NET_DBG("Remove \"%s\"", entry->query);
+			dns_cache_release(cache, entry);
 		}
+
+		(void)min_heap_pop(&cache->expiry_heap, &removed);
 	}
 }
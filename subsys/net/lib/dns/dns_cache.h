@@ -17,20 +17,46 @@
 #include <zephyr/net/dns_resolve.h>
 #include <zephyr/kernel.h>
 #include <zephyr/sys_clock.h>
+#include <zephyr/sys/dlist.h>
+#include <zephyr/sys/min_heap.h>
+#include <zephyr/sys/slist.h>
 
 struct dns_cache_entry {
 	char query[CONFIG_DNS_RESOLVER_MAX_QUERY_LEN];
 	struct dns_addrinfo data;
 	k_timepoint_t expiry;
+	/* Node in the hash bucket of the query, or in the free list */
+	sys_snode_t node;
+	/* Node in the list of the entries, least recently used first */
+	sys_dnode_t lru_node;
+	/* Incremented when the entry is released, to spot its stale expiry nodes */
+	uint16_t generation;
+	uint16_t hash;
 	bool in_use;
+	/* The query name does not exist, data is not used */
+	bool nxdomain;
+};
+
+/* Node of the heap ordering the cache entries by expiry time */
+struct dns_cache_expiry {
+	k_timepoint_t expiry;
+	uint16_t index;
+	uint16_t generation;
 };
 
 struct dns_cache {
 	size_t size;
 	struct dns_cache_entry *entries;
 	struct k_mutex *lock;
+	sys_slist_t *buckets;
+	sys_slist_t free_list;
+	sys_dlist_t lru;
+	size_t next_unused;
+	struct min_heap expiry_heap;
 };
 
+int dns_cache_expiry_cmp(const void *a, const void *b);
+
 /**
  * @brief Statically define and initialize a DNS queue.
  *
@@ -41,10 +67,21 @@ struct dns_cache {
  * @param name Name of the cache.
  */
 #define DNS_CACHE_DEFINE(name, cache_size)                                                         \
+	BUILD_ASSERT((cache_size) > 0 && (cache_size) <= UINT16_MAX);                              \
 	static K_MUTEX_DEFINE(name##_mutex);                                                       \
 	static struct dns_cache_entry name##_entries[cache_size];                                  \
+	static sys_slist_t name##_buckets[cache_size];                                             \
+	static struct dns_cache_expiry name##_expiry[2 * (cache_size)];                            \
 	static struct dns_cache name = {                                                           \
-		.entries = name##_entries, .size = cache_size, .lock = &name##_mutex};
+		.entries = name##_entries,                                                         \
+		.size = cache_size,                                                                \
+		.lock = &name##_mutex,                                                             \
+		.buckets = name##_buckets,                                                         \
+		.lru = SYS_DLIST_STATIC_INIT(&name.lru),                                           \
+		.expiry_heap = {.storage = name##_expiry,                                          \
+				.capacity = 2 * (cache_size),                                      \
+				.elem_size = sizeof(struct dns_cache_expiry),                      \
+				.cmp = dns_cache_expiry_cmp}};
 
 /**
  * @brief Flushes the dns cache removing all its entries.
@@ -56,9 +93,11 @@ struct dns_cache {
 int dns_cache_flush(struct dns_cache *cache);
 
 /**
- * @brief Adds a new entry to the dns cache removing the one closest to expiry
+ * @brief Adds a new entry to the dns cache removing the least recently used one
  * if no free space is available.
  *
+ * A previous entry stating that the query name does not exist is removed.
+ *
  * @param cache Cache where the entry should be added.
  * @param query Query which should be persisted in the cache.
  * @param addrinfo Addrinfo resulting from the query which will be returned
@@ -71,6 +110,18 @@ int dns_cache_flush(struct dns_cache *cache);
 int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinfo const *addrinfo,
 		  uint32_t ttl);
 
+/**
+ * @brief Adds an entry stating that the query name does not exist (NXDOMAIN)
+ * to the dns cache, replacing the entries of the query.
+ *
+ * @param cache Cache where the entry should be added.
+ * @param query Query whose name does not exist.
+ * @param ttl Time to live for the entry in seconds.
+ * @retval 0 on success
+ * @retval On error, a negative value is returned.
+ */
+int dns_cache_add_nxdomain(struct dns_cache *cache, char const *query, uint32_t ttl);
+
 /**
  * @brief Removes all entries with the given query
  *
@@ -94,8 +145,9 @@ int dns_cache_remove(struct dns_cache *cache, char const *query);
  * @retval On error a negative value is returned.
  * -ENOSR means there was not enough space in the addrinfo array to accommodate all cache hits the
  * array will however be filled with valid data.
+ * -ENOENT means the query name is cached as not existing.
  */
-int dns_cache_find(struct dns_cache const *cache, const char *query, enum dns_query_type type,
+int dns_cache_find(struct dns_cache *cache, const char *query, enum dns_query_type type,
 		   struct dns_addrinfo *addrinfo, size_t addrinfo_array_len);
 
 #endif /* ZEPHYR_INCLUDE_NET_DNS_CACHE_H_ */
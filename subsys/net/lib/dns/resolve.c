@@ -1089,6 +1089,41 @@ quit:
 	return ret;
 }
 
+#ifdef CONFIG_DNS_RESOLVER_CACHE_NEGATIVE
+/* Remember that the queried name does not exist. Such a response has no
+ * answer and possibly no authority section, so only the question is parsed.
+ */
+static int dns_cache_nxdomain(struct dns_resolve_context *ctx,
+			      struct dns_msg_t *dns_msg,
+			      uint16_t *dns_id,
+			      int *query_idx,
+			      uint16_t *query_hash)
+{
+	uint8_t *query_name = dns_msg->msg + DNS_MSG_HEADER_SIZE;
+	size_t size = dns_msg->msg_size - DNS_MSG_HEADER_SIZE;
+	uint8_t *end;
+	int ret;
+
+	/* The query hash covers the name and the query type */
+	end = memchr(query_name, 0, size);
+	if (end == NULL || end + 1 + DNS_QTYPE_LEN > query_name + size) {
+		return -EMSGSIZE;
+	}
+
+	dns_msg->query_offset = DNS_MSG_HEADER_SIZE;
+
+	if (*query_idx < 0) {
+		ret = update_query_idx(ctx, dns_msg, dns_id, query_idx, query_hash);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return dns_cache_add_nxdomain(&dns_cache, ctx->queries[*query_idx].query,
+				      CONFIG_DNS_RESOLVER_CACHE_NEGATIVE_TTL);
+}
+#endif /* CONFIG_DNS_RESOLVER_CACHE_NEGATIVE */
+
 static int dns_validate_record(struct dns_resolve_context *ctx, struct dns_msg_t *dns_msg,
 			       struct dns_addrinfo *info, enum dns_rr_type *answer_type,
 			       uint32_t *ttl)
@@ -1314,6 +1349,19 @@ int dns_validate_msg(struct dns_resolve_context *ctx,
 		}
 	}
 
+#ifdef CONFIG_DNS_RESOLVER_CACHE_NEGATIVE
+	/* mDNS responders do not answer for names they do not know */
+	if (ret == DNS_HEADER_NAMEERROR && *dns_id > 0) {
+		if (dns_cache_nxdomain(ctx, dns_msg, dns_id, query_idx, query_hash) < 0) {
+			ret = DNS_EAI_FAIL;
+		} else {
+			ret = DNS_EAI_NONAME;
+		}
+
+		goto quit;
+	}
+#endif /* CONFIG_DNS_RESOLVER_CACHE_NEGATIVE */
+
 	if (dns_header_ancount(dns_msg->msg) < 1) {
 		/* there are no useful records in this message */
 		if (*dns_id > 0) {
@@ -1914,6 +1962,13 @@ try_resolve:
 
 			return 0;
 		}
+
+		if (ret == -ENOENT) {
+			/* The name is known not to exist */
+			cb(DNS_EAI_NONAME, NULL, user_data);
+
+			return 0;
+		}
 	}
 #else
 	ARG_UNUSED(use_cache);
@@ -20,6 +20,7 @@
 #include <zephyr/net/net_ip.h>
 #include <zephyr/net/socket.h>
 #include <zephyr/net/tls_credentials.h>
+#include <zephyr/zvfs/epoll.h>
 #include <zephyr/zvfs/eventfd.h>
 #include <zephyr/posix/fnmatch.h>
 #include <zephyr/sys/util_macro.h>
@@ -52,8 +53,20 @@ struct http_server_ctx {
 	 */
 	struct zsock_pollfd fds[HTTP_SERVER_SOCK_COUNT];
 	struct http_client_ctx clients[HTTP_SERVER_MAX_CLIENTS];
+#if defined(CONFIG_HTTP_SERVER_EPOLL)
+	/* The sockets of fds stay registered in the epoll instance between
+	 * waits, with the events they are polled for.
+	 */
+	int epfd;
+	struct zvfs_epoll_event events[HTTP_SERVER_SOCK_COUNT];
+#endif
 };
 
+#if defined(CONFIG_HTTP_SERVER_EPOLL)
+BUILD_ASSERT(HTTP_SERVER_SOCK_COUNT <= CONFIG_ZVFS_EPOLL_MAX_FDS,
+	     "Increase CONFIG_ZVFS_EPOLL_MAX_FDS to the number of HTTP server sockets");
+#endif
+
 static struct http_server_ctx server_ctx;
 static K_SEM_DEFINE(server_start, 0, 1);
 static bool server_running;
@@ -64,6 +77,28 @@ static const char *const alpn_list[] = {"h2", "http/1.1"};
 
 static void close_client_connection(struct http_client_ctx *client);
 
+/* Register, update or unregister the socket of fds[i] in the epoll instance */
+static void watch_socket(struct http_server_ctx *ctx, int op, int i)
+{
+#if defined(CONFIG_HTTP_SERVER_EPOLL)
+	/* The socket is stored along with its slot, so that the events of a
+	 * socket released from its slot are ignored.
+	 */
+	struct zvfs_epoll_event ev = {
+		.events = (uint16_t)ctx->fds[i].events,
+		.data.u64 = ((uint64_t)(uint32_t)ctx->fds[i].fd << 32) | (uint32_t)i,
+	};
+
+	if (zvfs_epoll_ctl(ctx->epfd, op, ctx->fds[i].fd, &ev) < 0) {
+		LOG_DBG("[%d] epoll_ctl %d failed (%d)", ctx->fds[i].fd, op, -errno);
+	}
+#else
+	ARG_UNUSED(ctx);
+	ARG_UNUSED(op);
+	ARG_UNUSED(i);
+#endif
+}
+
 HTTP_SERVER_CONTENT_TYPE(html, "text/html")
 HTTP_SERVER_CONTENT_TYPE(css, "text/css")
 HTTP_SERVER_CONTENT_TYPE(js, "text/javascript")
@@ -107,6 +142,19 @@ int http_server_init(struct http_server_ctx *ctx)
 
 	ctx->fds[count].fd = fd;
 	ctx->fds[count].events = ZSOCK_POLLIN;
+
+#if defined(CONFIG_HTTP_SERVER_EPOLL)
+	ctx->epfd = zvfs_epoll_create(0);
+	if (ctx->epfd < 0) {
+		int ret = -errno;
+
+		LOG_ERR("epoll_create failed (%d)", ret);
+		zsock_close(fd);
+		return ret;
+	}
+#endif
+
+	watch_socket(ctx, ZVFS_EPOLL_CTL_ADD, count);
 	count++;
 
 	HTTP_SERVICE_FOREACH(svc) {
@@ -245,6 +293,7 @@ int http_server_init(struct http_server_ctx *ctx)
 		*svc->fd = fd;
 		ctx->fds[count].fd = fd;
 		ctx->fds[count].events = ZSOCK_POLLIN;
+		watch_socket(ctx, ZVFS_EPOLL_CTL_ADD, count);
 		count++;
 	}
 
@@ -252,6 +301,9 @@ int http_server_init(struct http_server_ctx *ctx)
 		LOG_ERR("All services failed (%d)", failed);
 		/* Close eventfd socket */
 		zsock_close(ctx->fds[0].fd);
+#if defined(CONFIG_HTTP_SERVER_EPOLL)
+		zsock_close(ctx->epfd);
+#endif
 		return -ESRCH;
 	}
 
@@ -309,6 +361,11 @@ static void close_all_sockets(struct http_server_ctx *ctx)
 	HTTP_SERVICE_FOREACH(svc) {
 		*svc->fd = -1;
 	}
+
+#if defined(CONFIG_HTTP_SERVER_EPOLL)
+	zsock_close(ctx->epfd);
+	ctx->epfd = -1;
+#endif
 }
 
 static void client_release_resources(struct http_client_ctx *client)
@@ -365,11 +422,14 @@ void http_server_release_client(struct http_client_ctx *client)
 	for (i = 0; i < server_ctx.listen_fds; i++) {
 		if (server_ctx.fds[i].fd == *client->service->fd) {
 			server_ctx.fds[i].events = ZSOCK_POLLIN;
+			watch_socket(&server_ctx, ZVFS_EPOLL_CTL_MOD, i);
 			break;
 		}
 	}
 	for (i = server_ctx.listen_fds; i < ARRAY_SIZE(server_ctx.fds); i++) {
 		if (server_ctx.fds[i].fd == client->fd) {
+			/* The socket may be kept open, e.g. for a websocket */
+			watch_socket(&server_ctx, ZVFS_EPOLL_CTL_DEL, i);
 			server_ctx.fds[i].fd = INVALID_SOCK;
 			break;
 		}
@@ -551,168 +611,228 @@ static int handle_http_request(struct http_client_ctx *client)
 	return 0;
 }
 
-static int http_server_run(struct http_server_ctx *ctx)
+/* Handle the events of the socket of fds[i], returns a negative errno code
+ * when the server must be stopped.
+ */
+static int handle_socket_events(struct http_server_ctx *ctx, int i)
 {
 	struct http_client_ctx *client;
 	const struct http_service_desc *service;
-	zvfs_eventfd_t value;
 	bool found_slot;
 	int new_socket;
-	int ret, i, j;
-	int sock_error;
+	int ret, j;
+	int sock_error = 0;
 	net_socklen_t optlen = sizeof(int);
 
-	value = 0;
+	if (ctx->fds[i].revents & ZSOCK_POLLHUP) {
+		if (i >= ctx->listen_fds) {
+			LOG_DBG("Client #%d has disconnected",
+				i - ctx->listen_fds);
 
-	while (1) {
-		ret = zsock_poll(ctx->fds, HTTP_SERVER_SOCK_COUNT, -1);
-		if (ret < 0) {
-			ret = -errno;
-			LOG_DBG("poll failed (%d)", ret);
-			goto closing;
+			client = &ctx->clients[i - ctx->listen_fds];
+			close_client_connection(client);
 		}
 
-		if (ret == 0) {
-			/* should not happen because timeout is -1 */
-			break;
+		return 0;
+	}
+
+	if (ctx->fds[i].revents & ZSOCK_POLLERR) {
+		(void)zsock_getsockopt(ctx->fds[i].fd, ZSOCK_SOL_SOCKET,
+				       ZSOCK_SO_ERROR, &sock_error, &optlen);
+		LOG_DBG("Error on fd %d %d", ctx->fds[i].fd, sock_error);
+
+		if (i >= ctx->listen_fds) {
+			client = &ctx->clients[i - ctx->listen_fds];
+			close_client_connection(client);
+			return 0;
 		}
 
-		if (ret == 1 && ctx->fds[0].revents) {
-			zvfs_eventfd_read(ctx->fds[0].fd, &value);
-			LOG_DBG("Received stop event. exiting ..");
-			ret = 0;
-			goto closing;
+		ret = sock_error != 0 ? -sock_error : -EIO;
+
+		if (ret == -ENETDOWN) {
+			LOG_INF("Network is down");
+		} else {
+			LOG_ERR("Listening socket error, aborting. (%d)", ret);
 		}
 
-		for (i = 1; i < ARRAY_SIZE(ctx->fds); i++) {
-			if (ctx->fds[i].fd < 0) {
-				continue;
-			}
+		return ret;
+	}
+
+	if (!(ctx->fds[i].revents & ZSOCK_POLLIN)) {
+		return 0;
+	}
+
+	/* First check if we have something to accept */
+	if (i < ctx->listen_fds) {
+		service = lookup_service(ctx->fds[i].fd);
+		__ASSERT(NULL != service, "fd not associated with a service");
 
-			if (ctx->fds[i].revents & ZSOCK_POLLHUP) {
-				if (i >= ctx->listen_fds) {
-					LOG_DBG("Client #%d has disconnected",
-						i - ctx->listen_fds);
+		if (service->data->num_clients >= service->concurrent) {
+			ctx->fds[i].events = 0;
+			watch_socket(ctx, ZVFS_EPOLL_CTL_MOD, i);
+			return 0;
+		}
+
+		new_socket = accept_new_client(ctx->fds[i].fd);
+		if (new_socket < 0) {
+			ret = -errno;
+			LOG_DBG("accept: %d", ret);
+			return 0;
+		}
 
-					client = &ctx->clients[i - ctx->listen_fds];
-					close_client_connection(client);
-				}
+		found_slot = false;
 
+		for (j = ctx->listen_fds; j < ARRAY_SIZE(ctx->fds); j++) {
+			if (ctx->fds[j].fd != INVALID_SOCK) {
 				continue;
 			}
 
-			if (ctx->fds[i].revents & ZSOCK_POLLERR) {
-				(void)zsock_getsockopt(ctx->fds[i].fd, ZSOCK_SOL_SOCKET,
-						       ZSOCK_SO_ERROR, &sock_error, &optlen);
-				LOG_DBG("Error on fd %d %d", ctx->fds[i].fd, sock_error);
+			ctx->fds[j].fd = new_socket;
+			ctx->fds[j].events = ZSOCK_POLLIN;
+			ctx->fds[j].revents = 0;
+			watch_socket(ctx, ZVFS_EPOLL_CTL_ADD, j);
 
-				if (i >= ctx->listen_fds) {
-					client = &ctx->clients[i - ctx->listen_fds];
-					close_client_connection(client);
-					continue;
-				}
+			service->data->num_clients++;
 
-				ret = -sock_error;
+			LOG_DBG("Init client #%d", j - ctx->listen_fds);
 
-				if (ret == -ENETDOWN) {
-					LOG_INF("Network is down");
-				} else {
-					LOG_ERR("Listening socket error, aborting. (%d)", ret);
-				}
+			init_client_ctx(&ctx->clients[j - ctx->listen_fds], service,
+					new_socket);
+			found_slot = true;
+			break;
+		}
 
-				goto closing;
+		if (!found_slot) {
+			LOG_DBG("No free slot found.");
+			zsock_close(new_socket);
+		}
 
-			}
+		return 0;
+	}
 
-			if (!(ctx->fds[i].revents & ZSOCK_POLLIN)) {
-				continue;
-			}
+	/* Client sock */
+	client = &ctx->clients[i - ctx->listen_fds];
 
-			/* First check if we have something to accept */
-			if (i < ctx->listen_fds) {
-				service = lookup_service(ctx->fds[i].fd);
-				__ASSERT(NULL != service, "fd not associated with a service");
+	ret = zsock_recv(client->fd, client->buffer + client->data_len,
+			 sizeof(client->buffer) - client->data_len, 0);
+	if (ret <= 0) {
+		if (ret == 0) {
+			LOG_DBG("Connection closed by peer for client #%d",
+				i - ctx->listen_fds);
+		} else {
+			ret = -errno;
+			LOG_DBG("ERROR reading from socket (%d)", ret);
+		}
 
-				if (service->data->num_clients >= service->concurrent) {
-					ctx->fds[i].events = 0;
-					continue;
-				}
+		close_client_connection(client);
+		return 0;
+	}
 
-				new_socket = accept_new_client(ctx->fds[i].fd);
-				if (new_socket < 0) {
-					ret = -errno;
-					LOG_DBG("accept: %d", ret);
-					continue;
-				}
+	client->data_len += ret;
 
-				found_slot = false;
+	http_client_timer_restart(client);
 
-				for (j = ctx->listen_fds; j < ARRAY_SIZE(ctx->fds); j++) {
-					if (ctx->fds[j].fd != INVALID_SOCK) {
-						continue;
-					}
+	ret = handle_http_request(client);
+	if (ret < 0 && ret != -EAGAIN) {
+		if (ret == -ENOTCONN) {
+			LOG_DBG("Client closed connection while handling request");
+		} else {
+			LOG_ERR("HTTP request handling error (%d)", ret);
+		}
+		close_client_connection(client);
+	} else if (client->data_len == sizeof(client->buffer)) {
+		/* If the RX buffer is still full after parsing,
+		 * it means we won't be able to handle this request
+		 * with the current buffer size.
+		 */
+		LOG_ERR("RX buffer too small to handle request");
+		close_client_connection(client);
+	}
 
-					ctx->fds[j].fd = new_socket;
-					ctx->fds[j].events = ZSOCK_POLLIN;
-					ctx->fds[j].revents = 0;
+	return 0;
+}
 
-					service->data->num_clients++;
+static int http_server_run(struct http_server_ctx *ctx)
+{
+	zvfs_eventfd_t value;
+	int ret, i;
+#if defined(CONFIG_HTTP_SERVER_EPOLL)
+	bool stop;
+	int n;
+#endif
+
+	value = 0;
+
+	while (1) {
+#if defined(CONFIG_HTTP_SERVER_EPOLL)
+		n = zvfs_epoll_wait(ctx->epfd, ctx->events, ARRAY_SIZE(ctx->events), -1);
+		if (n < 0) {
+			ret = -errno;
+			LOG_DBG("epoll_wait failed (%d)", ret);
+			goto closing;
+		}
 
-					LOG_DBG("Init client #%d", j - ctx->listen_fds);
+		stop = false;
 
-					init_client_ctx(&ctx->clients[j - ctx->listen_fds], service,
-							new_socket);
-					found_slot = true;
-					break;
-				}
+		/* Only the ready sockets are reported */
+		for (int k = 0; k < n; k++) {
+			i = (int)(uint32_t)ctx->events[k].data.u64;
 
-				if (!found_slot) {
-					LOG_DBG("No free slot found.");
-					zsock_close(new_socket);
-				}
+			/* Released from its slot by a previous event */
+			if (ctx->fds[i].fd != (int)(ctx->events[k].data.u64 >> 32)) {
+				continue;
+			}
 
+			if (i == 0) {
+				stop = true;
 				continue;
 			}
 
-			/* Client sock */
-			client = &ctx->clients[i - ctx->listen_fds];
+			ctx->fds[i].revents = (short)ctx->events[k].events;
 
-			ret = zsock_recv(client->fd, client->buffer + client->data_len,
-					 sizeof(client->buffer) - client->data_len, 0);
-			if (ret <= 0) {
-				if (ret == 0) {
-					LOG_DBG("Connection closed by peer for client #%d",
-						i - ctx->listen_fds);
-				} else {
-					ret = -errno;
-					LOG_DBG("ERROR reading from socket (%d)", ret);
-				}
-
-				close_client_connection(client);
+			ret = handle_socket_events(ctx, i);
+			if (ret < 0) {
+				goto closing;
+			}
+		}
+
+		if (stop) {
+			zvfs_eventfd_read(ctx->fds[0].fd, &value);
+			LOG_DBG("Received stop event. exiting ..");
+			ret = 0;
+			goto closing;
+		}
+#else
+		ret = zsock_poll(ctx->fds, HTTP_SERVER_SOCK_COUNT, -1);
+		if (ret < 0) {
+			ret = -errno;
+			LOG_DBG("poll failed (%d)", ret);
+			goto closing;
+		}
+
+		if (ret == 0) {
+			/* should not happen because timeout is -1 */
+			break;
+		}
+
+		if (ret == 1 && ctx->fds[0].revents) {
+			zvfs_eventfd_read(ctx->fds[0].fd, &value);
+			LOG_DBG("Received stop event. exiting ..");
+			ret = 0;
+			goto closing;
+		}
+
+		for (i = 1; i < ARRAY_SIZE(ctx->fds); i++) {
+			if (ctx->fds[i].fd < 0) {
 				continue;
 			}
 
-			client->data_len += ret;
-
-			http_client_timer_restart(client);
-
-			ret = handle_http_request(client);
-			if (ret < 0 && ret != -EAGAIN) {
-				if (ret == -ENOTCONN) {
-					LOG_DBG("Client closed connection while handling request");
-				} else {
-					LOG_ERR("HTTP request handling error (%d)", ret);
-				}
-				close_client_connection(client);
-			} else if (client->data_len == sizeof(client->buffer)) {
-				/* If the RX buffer is still full after parsing,
-				 * it means we won't be able to handle this request
-				 * with the current buffer size.
-				 */
-				LOG_ERR("RX buffer too small to handle request");
-				close_client_connection(client);
+			ret = handle_socket_events(ctx, i);
+			if (ret < 0) {
+				goto closing;
 			}
 		}
+#endif /* CONFIG_HTTP_SERVER_EPOLL */
 	}
 
 	return 0;
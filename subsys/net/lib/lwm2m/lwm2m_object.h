@@ -210,6 +210,11 @@ struct lwm2m_engine_obj {
 
 	/* Object is a core object (defined in the official LwM2M spec.) */
 	bool is_core : 1;
+
+#if defined(CONFIG_LWM2M_ENGINE_OBJ_INST_INDEX)
+	/* instances of the object, sorted by ID */
+	sys_slist_t inst_list;
+#endif
 };
 
 /* Resource instances with this value are considered "not created" yet */
@@ -415,6 +420,13 @@ struct lwm2m_engine_obj_inst {
 	/* object instance member data */
 	uint16_t obj_inst_id;
 	uint16_t resource_count;
+
+#if defined(CONFIG_LWM2M_ENGINE_OBJ_INST_INDEX)
+	/* index bucket list */
+	sys_snode_t index_node;
+	/* instance list of the object */
+	sys_snode_t obj_node;
+#endif
 };
 
 /* Initialize resource instances prior to use */
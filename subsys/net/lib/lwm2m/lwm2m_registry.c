@@ -89,6 +89,10 @@ static const struct default_obj_version default_obj_versions[] = {
 static sys_slist_t engine_obj_list;
 static sys_slist_t engine_obj_inst_list;
 
+#if defined(CONFIG_LWM2M_ENGINE_OBJ_INST_INDEX)
+static sys_slist_t engine_obj_inst_index[CONFIG_LWM2M_ENGINE_OBJ_INST_INDEX_SIZE];
+#endif
+
 /* Resource wrappers */
 sys_slist_t *lwm2m_engine_obj_list(void) { return &engine_obj_list; }
 
@@ -165,6 +169,53 @@ struct lwm2m_engine_obj *lwm2m_engine_get_obj(const struct lwm2m_obj_path *path)
 }
 /* Engine object instance */
 
+#if defined(CONFIG_LWM2M_ENGINE_OBJ_INST_INDEX)
+static sys_slist_t *obj_inst_index_bucket(int obj_id, int obj_inst_id)
+{
+	uint32_t key = ((uint32_t)obj_id << 16) | (uint16_t)obj_inst_id;
+	uint32_t hash = key * 2654435761U;
+
+	/* Multiplicative hashing spreads consecutive instance IDs over the
+	 * high bits of the hash only, so these select the bucket.
+	 */
+	return &engine_obj_inst_index[((uint64_t)hash * ARRAY_SIZE(engine_obj_inst_index)) >> 32];
+}
+
+static void obj_inst_index_add(struct lwm2m_engine_obj_inst *obj_inst)
+{
+	struct lwm2m_engine_obj *obj = obj_inst->obj;
+	struct lwm2m_engine_obj_inst *prev = NULL;
+	struct lwm2m_engine_obj_inst *tmp;
+
+	sys_slist_append(obj_inst_index_bucket(obj->obj_id, obj_inst->obj_inst_id),
+			 &obj_inst->index_node);
+
+	/* Instances are mostly created in increasing ID order */
+	tmp = SYS_SLIST_PEEK_TAIL_CONTAINER(&obj->inst_list, tmp, obj_node);
+	if (tmp && tmp->obj_inst_id < obj_inst->obj_inst_id) {
+		sys_slist_append(&obj->inst_list, &obj_inst->obj_node);
+		return;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&obj->inst_list, tmp, obj_node) {
+		if (tmp->obj_inst_id > obj_inst->obj_inst_id) {
+			break;
+		}
+		prev = tmp;
+	}
+
+	sys_slist_insert(&obj->inst_list, prev ? &prev->obj_node : NULL, &obj_inst->obj_node);
+}
+
+static void obj_inst_index_remove(struct lwm2m_engine_obj_inst *obj_inst)
+{
+	sys_slist_find_and_remove(
+		obj_inst_index_bucket(obj_inst->obj->obj_id, obj_inst->obj_inst_id),
+		&obj_inst->index_node);
+	sys_slist_find_and_remove(&obj_inst->obj->inst_list, &obj_inst->obj_node);
+}
+#endif /* CONFIG_LWM2M_ENGINE_OBJ_INST_INDEX */
+
 static void engine_register_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
 {
 #if defined(CONFIG_LWM2M_ACCESS_CONTROL_ENABLE)
@@ -176,6 +227,9 @@ static void engine_register_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
 #endif /* CONFIG_LWM2M_RD_CLIENT_SUPPORT_BOOTSTRAP */
 #endif /* CONFIG_LWM2M_ACCESS_CONTROL_ENABLE */
 	sys_slist_append(&engine_obj_inst_list, &obj_inst->node);
+#if defined(CONFIG_LWM2M_ENGINE_OBJ_INST_INDEX)
+	obj_inst_index_add(obj_inst);
+#endif
 }
 
 static void engine_unregister_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
@@ -185,8 +239,51 @@ static void engine_unregister_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
 #endif
 	engine_remove_observer_by_id(obj_inst->obj->obj_id, obj_inst->obj_inst_id);
 	sys_slist_find_and_remove(&engine_obj_inst_list, &obj_inst->node);
+#if defined(CONFIG_LWM2M_ENGINE_OBJ_INST_INDEX)
+	obj_inst_index_remove(obj_inst);
+#endif
+}
+
+#if defined(CONFIG_LWM2M_ENGINE_OBJ_INST_INDEX)
+struct lwm2m_engine_obj_inst *get_engine_obj_inst(int obj_id, int obj_inst_id)
+{
+	struct lwm2m_engine_obj_inst *obj_inst;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(obj_inst_index_bucket(obj_id, obj_inst_id), obj_inst,
+				     index_node) {
+		if (obj_inst->obj->obj_id == obj_id && obj_inst->obj_inst_id == obj_inst_id) {
+			return obj_inst;
+		}
+	}
+
+	return NULL;
 }
 
+struct lwm2m_engine_obj_inst *next_engine_obj_inst(int obj_id, int obj_inst_id)
+{
+	struct lwm2m_engine_obj_inst *obj_inst;
+	struct lwm2m_engine_obj *obj;
+
+	/* Iterating over the instances, the next one follows the current one */
+	obj_inst = get_engine_obj_inst(obj_id, obj_inst_id);
+	if (obj_inst) {
+		return SYS_SLIST_PEEK_NEXT_CONTAINER(obj_inst, obj_node);
+	}
+
+	obj = get_engine_obj(obj_id);
+	if (!obj) {
+		return NULL;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&obj->inst_list, obj_inst, obj_node) {
+		if (obj_inst->obj_inst_id > obj_inst_id) {
+			return obj_inst;
+		}
+	}
+
+	return NULL;
+}
+#else
 struct lwm2m_engine_obj_inst *get_engine_obj_inst(int obj_id, int obj_inst_id)
 {
 	struct lwm2m_engine_obj_inst *obj_inst;
@@ -213,6 +310,7 @@ struct lwm2m_engine_obj_inst *next_engine_obj_inst(int obj_id, int obj_inst_id)
 
 	return next;
 }
+#endif /* CONFIG_LWM2M_ENGINE_OBJ_INST_INDEX */
 
 int lwm2m_create_obj_inst(uint16_t obj_id, uint16_t obj_inst_id,
 			  struct lwm2m_engine_obj_inst **obj_inst)
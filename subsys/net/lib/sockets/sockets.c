@@ -710,6 +710,218 @@ fail:
 #include <zephyr/syscalls/zsock_recvmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+/* Like sendmmsg(2) and recvmmsg(2), an error is only reported if it
+ * happened on the first message, otherwise the batch is cut short.
+ */
+static inline int mmsg_result(unsigned int count, ssize_t ret)
+{
+	if (count > 0U) {
+		return count;
+	}
+
+	return ret < 0 ? -1 : 0;
+}
+
+int z_impl_zsock_sendmmsg(int sock, struct net_mmsghdr *msgvec,
+			  unsigned int vlen, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	unsigned int count;
+	ssize_t ret = 0;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable->sendmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	vlen = MIN(vlen, ZSOCK_MMSG_MAX);
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	for (count = 0U; count < vlen; count++) {
+		ret = vtable->sendmsg(obj, &msgvec[count].msg_hdr, flags);
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[count].msg_len = ret;
+		sock_obj_core_update_send_stats(sock, ret);
+	}
+
+	k_mutex_unlock(lock);
+
+	return mmsg_result(count, ret);
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_sendmmsg(int sock, struct net_mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	unsigned int count;
+	unsigned int len;
+	ssize_t ret = 0;
+
+	vlen = MIN(vlen, ZSOCK_MMSG_MAX);
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_WRITE(msgvec, vlen, sizeof(*msgvec)));
+
+	/* Every message needs its own copy in and out of user memory,
+	 * reuse the single message path for that.
+	 */
+	for (count = 0U; count < vlen; count++) {
+		ret = z_vrfy_zsock_sendmsg(sock, &msgvec[count].msg_hdr, flags);
+		if (ret < 0) {
+			break;
+		}
+
+		len = ret;
+		K_OOPS(k_usermode_to_copy(&msgvec[count].msg_len, &len, sizeof(len)));
+	}
+
+	return mmsg_result(count, ret);
+}
+#include <zephyr/syscalls/zsock_sendmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_zsock_recvmmsg(int sock, struct net_mmsghdr *msgvec,
+			  unsigned int vlen, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	bool wait_for_one = (flags & ZSOCK_MSG_WAITFORONE) != 0;
+	struct k_mutex *lock;
+	unsigned int count;
+	ssize_t ret = 0;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable->recvmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	vlen = MIN(vlen, ZSOCK_MMSG_MAX);
+	flags &= ~ZSOCK_MSG_WAITFORONE;
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	for (count = 0U; count < vlen; count++) {
+		ret = vtable->recvmsg(obj, &msgvec[count].msg_hdr, flags);
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[count].msg_len = ret;
+		sock_obj_core_update_recv_stats(sock, ret);
+
+		if (wait_for_one) {
+			flags |= ZSOCK_MSG_DONTWAIT;
+		}
+	}
+
+	k_mutex_unlock(lock);
+
+	return mmsg_result(count, ret);
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_recvmmsg(int sock, struct net_mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	bool wait_for_one = (flags & ZSOCK_MSG_WAITFORONE) != 0;
+	unsigned int count;
+	unsigned int len;
+	ssize_t ret = 0;
+
+	vlen = MIN(vlen, ZSOCK_MMSG_MAX);
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_WRITE(msgvec, vlen, sizeof(*msgvec)));
+
+	flags &= ~ZSOCK_MSG_WAITFORONE;
+
+	for (count = 0U; count < vlen; count++) {
+		ret = z_vrfy_zsock_recvmsg(sock, &msgvec[count].msg_hdr, flags);
+		if (ret < 0) {
+			break;
+		}
+
+		len = ret;
+		K_OOPS(k_usermode_to_copy(&msgvec[count].msg_len, &len, sizeof(len)));
+
+		if (wait_for_one) {
+			flags |= ZSOCK_MSG_DONTWAIT;
+		}
+	}
+
+	return mmsg_result(count, ret);
+}
+#include <zephyr/syscalls/zsock_recvmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+#if defined(CONFIG_NET_SOCKETS_RX_VIEW)
+ssize_t zsock_recv_view(int sock, struct zsock_rx_view *view, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	void *ctx;
+	int ret;
+
+	ctx = get_sock_vtable(sock, &vtable, &lock);
+	if (ctx == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	ret = zvfs_fdtable_call_ioctl((const struct fd_op_vtable *)vtable, ctx,
+				      ZFD_IOCTL_RECV_VIEW, view, flags);
+
+	k_mutex_unlock(lock);
+
+	if (ret < 0) {
+		return -1;
+	}
+
+	sock_obj_core_update_recv_stats(sock, view->len);
+
+	return view->len;
+}
+
+int zsock_recv_view_release(int sock, struct zsock_rx_view *view)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	void *ctx;
+	int ret;
+
+	ctx = get_sock_vtable(sock, &vtable, &lock);
+	if (ctx == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	ret = zvfs_fdtable_call_ioctl((const struct fd_op_vtable *)vtable, ctx,
+				      ZFD_IOCTL_RECV_VIEW_RELEASE, view);
+
+	k_mutex_unlock(lock);
+
+	return ret;
+}
+#endif /* CONFIG_NET_SOCKETS_RX_VIEW */
+
 /* As this is limited function, we don't follow POSIX signature, with
  * "..." instead of last arg.
  */
@@ -1556,6 +1556,208 @@ static ssize_t zsock_recv_stream(struct net_context *ctx, struct net_msghdr *msg
 	return recv_len;
 }
 
+#if defined(CONFIG_NET_SOCKETS_RX_VIEW)
+static void rx_view_fill(struct net_pkt *pkt, struct zsock_rx_view *view)
+{
+	view->iovcnt = net_pkt_remaining_iov(pkt, view->iov, ARRAY_SIZE(view->iov),
+					     &view->len);
+	view->handle = pkt;
+}
+
+static int rx_view_src_addr(struct net_context *ctx, struct net_pkt *pkt,
+			    struct zsock_rx_view *view)
+{
+	struct net_sockaddr *addr = (struct net_sockaddr *)&view->src_addr;
+	int ret;
+
+	if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
+	    net_if_is_ip_offloaded(net_context_get_iface(ctx))) {
+		ret = sock_get_offload_pkt_src_addr(pkt, ctx, addr, sizeof(view->src_addr));
+	} else {
+		ret = sock_get_pkt_src_addr(ctx, pkt, addr, sizeof(view->src_addr));
+	}
+
+	if (ret < 0) {
+		NET_DBG("Cannot get the source address of the view (%d)", ret);
+		return ret;
+	}
+
+	if (addr->sa_family == NET_AF_INET) {
+		view->addrlen = sizeof(struct net_sockaddr_in);
+	} else if (addr->sa_family == NET_AF_INET6) {
+		view->addrlen = sizeof(struct net_sockaddr_in6);
+	} else {
+		return -ENOTSUP;
+	}
+
+	return 0;
+}
+
+static int zsock_recv_view_dgram(struct net_context *ctx,
+				 struct zsock_rx_view *view, int flags)
+{
+	int ret;
+
+	k_timeout_t timeout = K_FOREVER;
+	struct net_pkt *pkt;
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	} else {
+		net_context_get_option(ctx, NET_OPT_RCVTIMEO, &timeout, NULL);
+
+		ret = zsock_wait_data(ctx, &timeout);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	pkt = k_fifo_get(&ctx->recv_q, timeout);
+	if (!pkt) {
+		return -EAGAIN;
+	}
+
+	ret = rx_view_src_addr(ctx, pkt, view);
+	if (ret < 0) {
+		net_pkt_unref(pkt);
+		return ret;
+	}
+
+	rx_view_fill(pkt, view);
+
+	if (view->len < net_pkt_remaining_data(pkt)) {
+		view->flags |= ZSOCK_MSG_TRUNC;
+	}
+
+	return 0;
+}
+
+static int zsock_recv_view_stream(struct net_context *ctx,
+				  struct zsock_rx_view *view, int flags)
+{
+	k_timeout_t timeout = K_FOREVER;
+	struct net_pkt *pkt;
+	k_timepoint_t end;
+	int res;
+
+	if (!net_context_is_used(ctx)) {
+		return -EBADF;
+	}
+
+	if (net_context_get_state(ctx) != NET_CONTEXT_CONNECTED) {
+		return -ENOTCONN;
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	} else if (!sock_is_eof(ctx) && !sock_is_error(ctx)) {
+		net_context_get_option(ctx, NET_OPT_RCVTIMEO, &timeout, NULL);
+	}
+
+	for (end = sys_timepoint_calc(timeout); ; timeout = sys_timepoint_timeout(end)) {
+		if (sock_is_error(ctx)) {
+			return -POINTER_TO_INT(ctx->user_data);
+		}
+
+		pkt = k_fifo_peek_head(&ctx->recv_q);
+		if (pkt != NULL && net_pkt_remaining_data(pkt) == 0) {
+			/* Drop segments already consumed through a view */
+			pkt = k_fifo_get(&ctx->recv_q, K_NO_WAIT);
+			if (net_pkt_eof(pkt)) {
+				sock_set_eof(ctx);
+			}
+
+			net_pkt_unref(pkt);
+			continue;
+		}
+
+		if (pkt != NULL) {
+			break;
+		}
+
+		if (sock_is_eof(ctx)) {
+			/* Empty view, the peer closed the connection */
+			return 0;
+		}
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			return -EAGAIN;
+		}
+
+		res = zsock_wait_data(ctx, &timeout);
+		if (res < 0) {
+			return res;
+		}
+	}
+
+	/* The segment stays queued until the view is released, so that
+	 * any data not covered by the view is returned by the next call.
+	 */
+	net_pkt_ref(pkt);
+	rx_view_fill(pkt, view);
+
+	return 0;
+}
+
+static int zsock_recv_view_ctx(struct net_context *ctx,
+			       struct zsock_rx_view *view, int flags)
+{
+	enum net_sock_type sock_type = net_context_get_type(ctx);
+
+	view->iovcnt = 0;
+	view->len = 0;
+	view->flags = 0;
+	view->addrlen = 0;
+	view->handle = NULL;
+
+	if (sock_type == NET_SOCK_DGRAM) {
+		return zsock_recv_view_dgram(ctx, view, flags);
+	} else if (sock_type == NET_SOCK_STREAM) {
+		return zsock_recv_view_stream(ctx, view, flags);
+	}
+
+	return -ENOTSUP;
+}
+
+static int zsock_recv_view_release_ctx(struct net_context *ctx,
+				       struct zsock_rx_view *view)
+{
+	struct net_pkt *pkt = view->handle;
+
+	if (pkt == NULL) {
+		/* Empty view, nothing was lent */
+		return 0;
+	}
+
+	view->handle = NULL;
+
+	if (net_context_get_type(ctx) == NET_SOCK_STREAM) {
+		if (net_pkt_skip(pkt, view->len) == 0 &&
+		    net_pkt_remaining_data(pkt) == 0 &&
+		    k_fifo_peek_head(&ctx->recv_q) == pkt) {
+			pkt = k_fifo_get(&ctx->recv_q, K_NO_WAIT);
+			if (net_pkt_eof(pkt)) {
+				sock_set_eof(ctx);
+			}
+
+			/* Drop the reference held by the receive queue */
+			net_pkt_unref(pkt);
+		}
+
+		net_context_update_recv_wnd(ctx, view->len);
+	}
+
+	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS) ||
+	    IS_ENABLED(CONFIG_TRACING_NET_CORE)) {
+		net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
+	}
+
+	net_pkt_unref(pkt);
+
+	return 0;
+}
+#endif /* CONFIG_NET_SOCKETS_RX_VIEW */
+
 ssize_t zsock_recvfrom_ctx(struct net_context *ctx, void *buf, size_t max_len,
 			   int flags,
 			   struct net_sockaddr *src_addr, net_socklen_t *addrlen)
@@ -1997,6 +2199,20 @@ int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 				return 0;
 			}
 
+			break;
+
+		case ZSOCK_TCP_CONGESTION:
+			if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)) {
+				ret = net_tcp_get_option(ctx, TCP_OPT_CONGESTION,
+							 optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
 			break;
 		}
 
@@ -2628,6 +2844,20 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 				return 0;
 			}
 
+			break;
+
+		case ZSOCK_TCP_CONGESTION:
+			if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)) {
+				ret = net_tcp_set_option(ctx, TCP_OPT_CONGESTION,
+							 optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
 			break;
 		}
 		break;
@@ -3116,6 +3346,33 @@ static int sock_ioctl_vmeth(void *obj, unsigned int request, va_list args)
 		return 0;
 	}
 
+#if defined(CONFIG_NET_SOCKETS_RX_VIEW)
+	case ZFD_IOCTL_RECV_VIEW: {
+		struct zsock_rx_view *view;
+		int flags;
+		int ret;
+
+		view = va_arg(args, struct zsock_rx_view *);
+		flags = va_arg(args, int);
+
+		ret = zsock_recv_view_ctx(obj, view, flags);
+		if (ret < 0) {
+			errno = -ret;
+			return -1;
+		}
+
+		return 0;
+	}
+
+	case ZFD_IOCTL_RECV_VIEW_RELEASE: {
+		struct zsock_rx_view *view;
+
+		view = va_arg(args, struct zsock_rx_view *);
+
+		return zsock_recv_view_release_ctx(obj, view);
+	}
+#endif /* CONFIG_NET_SOCKETS_RX_VIEW */
+
 	default:
 		errno = EOPNOTSUPP;
 		return -1;
@@ -11,6 +11,9 @@ LOG_MODULE_REGISTER(net_sock_svc, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <zephyr/init.h>
 #include <zephyr/net/socket_service.h>
 #include <zephyr/zvfs/eventfd.h>
+#if defined(CONFIG_NET_SOCKETS_SERVICE_EPOLL)
+#include <zephyr/zvfs/epoll.h>
+#endif
 
 static int init_socket_service(void);
 
@@ -29,12 +32,27 @@ STRUCT_SECTION_START_EXTERN(net_socket_service_desc);
 STRUCT_SECTION_END_EXTERN(net_socket_service_desc);
 
 static struct service {
+#if defined(CONFIG_NET_SOCKETS_SERVICE_EPOLL)
+	/* The sockets stay registered in the epoll instance between waits */
+	struct zvfs_epoll_event events[CONFIG_ZVFS_EPOLL_MAX_FDS];
+	int epfd;
+	int restart_fd;
+#else
 	struct zsock_pollfd events[CONFIG_ZVFS_POLL_MAX];
+#endif
 	int count;
 } ctx;
 
 #define get_idx(svc) (*(svc->idx))
 
+#if defined(CONFIG_NET_SOCKETS_SERVICE_EPOLL)
+#define MAX_FDS_OPTION "CONFIG_ZVFS_EPOLL_MAX_FDS"
+#define get_restart_fd() (ctx.restart_fd)
+#else
+#define MAX_FDS_OPTION "CONFIG_ZVFS_POLL_MAX"
+#define get_restart_fd() (ctx.events[0].fd)
+#endif
+
 void net_socket_service_foreach(net_socket_service_cb_t cb, void *user_data)
 {
 	STRUCT_SECTION_FOREACH(net_socket_service_desc, svc) {
@@ -89,7 +107,7 @@ int z_impl_net_socket_service_register(const struct net_socket_service_desc *svc
 	}
 
 	/* Tell the thread to re-read the variables */
-	zvfs_eventfd_write(ctx.events[0].fd, 1);
+	zvfs_eventfd_write(get_restart_fd(), 1);
 	ret = 0;
 
 out:
@@ -98,6 +116,104 @@ out:
 	return ret;
 }
 
+/* We do not set the user callback to our work struct because we need to
+ * hook into the flow and restore the global poll array so that the next poll
+ * round will not notice it and call the callback again while we are
+ * servicing the callback.
+ */
+void net_socket_service_callback(struct net_socket_service_event *pev)
+{
+	struct net_socket_service_event ev = *pev;
+
+	ev.callback(&ev);
+}
+
+#if defined(CONFIG_NET_SOCKETS_SERVICE_EPOLL)
+/* Register the sockets of all the services in a new epoll instance */
+static int register_sockets(void)
+{
+	struct zvfs_epoll_event ev = {
+		.events = ZVFS_EPOLLIN,
+		.data.ptr = NULL,
+	};
+
+	if (ctx.epfd >= 0) {
+		/* Closing the instance drops the previous registrations */
+		(void)zvfs_close(ctx.epfd);
+	}
+
+	ctx.epfd = zvfs_epoll_create(0);
+	if (ctx.epfd < 0) {
+		return -errno;
+	}
+
+	if (zvfs_epoll_ctl(ctx.epfd, ZVFS_EPOLL_CTL_ADD, ctx.restart_fd, &ev) < 0) {
+		return -errno;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	STRUCT_SECTION_FOREACH(net_socket_service_desc, svc) {
+		for (int i = 0; i < svc->pev_len; i++) {
+			struct net_socket_service_event *event = &svc->pev[i];
+
+			if (event->event.fd < 0) {
+				continue;
+			}
+
+			event->svc = svc;
+			ev.events = (uint16_t)event->event.events;
+			ev.data.ptr = event;
+
+			if (zvfs_epoll_ctl(ctx.epfd, ZVFS_EPOLL_CTL_ADD,
+					   event->event.fd, &ev) < 0) {
+				NET_ERR("Cannot monitor socket %d (%d)",
+					event->event.fd, -errno);
+			}
+		}
+	}
+
+	k_mutex_unlock(&lock);
+
+	return 0;
+}
+
+/* Call the services of the ready sockets until a restart is requested */
+static int process_events(void)
+{
+	struct net_socket_service_event *event;
+	bool restart = false;
+	int ret;
+
+	while (!restart) {
+		ret = zvfs_epoll_wait(ctx.epfd, ctx.events, ARRAY_SIZE(ctx.events), -1);
+		if (ret < 0) {
+			return -errno;
+		}
+
+		for (int i = 0; i < ret; i++) {
+			event = ctx.events[i].data.ptr;
+			if (event == NULL) {
+				restart = true;
+				continue;
+			}
+
+			/* Unregistered by a previous callback */
+			if (event->event.fd < 0) {
+				continue;
+			}
+
+			/* Tell the callback what was actually causing the event */
+			event->event.revents = (short)ctx.events[i].events;
+
+			/* Synchronous call */
+			net_socket_service_callback(event);
+		}
+	}
+
+	return 0;
+}
+#else
 static struct net_socket_service_desc *find_svc_and_event(
 	struct zsock_pollfd *pev,
 	struct net_socket_service_event **event)
@@ -114,18 +230,6 @@ static struct net_socket_service_desc *find_svc_and_event(
 	return NULL;
 }
 
-/* We do not set the user callback to our work struct because we need to
- * hook into the flow and restore the global poll array so that the next poll
- * round will not notice it and call the callback again while we are
- * servicing the callback.
- */
-void net_socket_service_callback(struct net_socket_service_event *pev)
-{
-	struct net_socket_service_event ev = *pev;
-
-	ev.callback(&ev);
-}
-
 static int call_work(struct zsock_pollfd *pev, struct net_socket_service_event *event)
 {
 	int ret = 0;
@@ -165,13 +269,15 @@ static int trigger_work(struct zsock_pollfd *pev)
 	return call_work(pev, event);
 }
 
+#endif /* CONFIG_NET_SOCKETS_SERVICE_EPOLL */
+
 static void socket_service_thread(void *p1, void *p2, void *p3)
 {
 	ARG_UNUSED(p1);
 	ARG_UNUSED(p2);
 	ARG_UNUSED(p3);
 
-	int ret, i, fd, count = 0;
+	int ret, fd, count = 0;
 	zvfs_eventfd_t value;
 
 	STRUCT_SECTION_COUNT(net_socket_service_desc, &ret);
@@ -195,7 +301,7 @@ static void socket_service_thread(void *p1, void *p2, void *p3)
 			"%zd poll entries configured.",
 			count + 1, ARRAY_SIZE(ctx.events));
 		NET_ERR("Please increase value of %s to at least %d",
-			"CONFIG_ZVFS_POLL_MAX", count + 1);
+			MAX_FDS_OPTION, count + 1);
 		goto fail;
 	}
 
@@ -214,6 +320,30 @@ static void socket_service_thread(void *p1, void *p2, void *p3)
 	thread_status = SOCKET_SERVICE_THREAD_RUNNING;
 	k_condvar_broadcast(&wait_start);
 
+#if defined(CONFIG_NET_SOCKETS_SERVICE_EPOLL)
+	ctx.restart_fd = fd;
+	ctx.epfd = -1;
+
+	while (true) {
+		ret = register_sockets();
+		if (ret < 0) {
+			NET_ERR("epoll setup failed (%d)", ret);
+			goto out;
+		}
+
+		ret = process_events();
+		if (ret < 0) {
+			NET_ERR("epoll_wait failed (%d)", ret);
+			goto out;
+		}
+
+		zvfs_eventfd_read(ctx.restart_fd, &value);
+		NET_DBG("Received restart event.");
+	}
+
+#else
+	int i;
+
 	ctx.events[0].fd = fd;
 	ctx.events[0].events = ZSOCK_POLLIN;
 
@@ -268,6 +398,8 @@ restart:
 		}
 	}
 
+#endif
+
 out:
 	NET_DBG("Socket service thread stopped");
 	thread_status = SOCKET_SERVICE_THREAD_STOPPED;
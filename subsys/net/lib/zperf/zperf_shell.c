@@ -107,6 +107,16 @@ static void print_number(const struct shell *sh, uint32_t value,
 	}
 }
 
+/* Packets per second */
+static uint32_t packet_rate(uint32_t packets, uint64_t time_in_us)
+{
+	if (time_in_us == 0U) {
+		return 0U;
+	}
+
+	return (uint32_t)(((uint64_t)packets * USEC_PER_SEC) / time_in_us);
+}
+
 static void print_number_64(const struct shell *sh, uint64_t value,
 			 const uint32_t *divisor_arr, const char **units)
 {
@@ -362,6 +372,9 @@ static void udp_session_cb(enum zperf_status status,
 		print_number(sh, rate_in_kbps, KBPS, KBPS_UNIT);
 		shell_fprintf(sh, SHELL_NORMAL, "\n");
 
+		shell_fprintf(sh, SHELL_NORMAL, " packet rate:\t\t%u pps\n",
+			      packet_rate(result->nb_packets_rcvd, result->time_in_us));
+
 		break;
 	}
 
@@ -534,6 +547,9 @@ static void shell_udp_upload_print_stats(const struct shell *sh,
 			shell_fprintf(sh, SHELL_NORMAL, "Rate:\t\t\t");
 			print_number(sh, client_rate_in_kbps, KBPS, KBPS_UNIT);
 			shell_fprintf(sh, SHELL_NORMAL, "\n");
+			shell_fprintf(sh, SHELL_NORMAL, "Packet rate:\t\t%u pps\n",
+				      packet_rate(results->nb_packets_sent,
+						  results->client_time_in_us));
 		} else {
 			shell_fprintf(sh, SHELL_NORMAL,
 					"Statistics:\t\tserver\t(client)\n");
@@ -565,6 +581,12 @@ static void shell_udp_upload_print_stats(const struct shell *sh,
 			shell_fprintf(sh, SHELL_NORMAL, "\t(");
 			print_number(sh, client_rate_in_kbps, KBPS, KBPS_UNIT);
 			shell_fprintf(sh, SHELL_NORMAL, ")\n");
+
+			shell_fprintf(sh, SHELL_NORMAL, "Packet rate:\t\t%u pps\t(%u pps)\n",
+				      packet_rate(results->nb_packets_rcvd,
+						  results->time_in_us),
+				      packet_rate(results->nb_packets_sent,
+						  results->client_time_in_us));
 		}
 
 #ifdef CONFIG_ZPERF_SESSION_PER_THREAD
@@ -828,6 +850,11 @@ static int execute_upload(const struct shell *sh,
 	print_number(sh, param->rate_kbps, KBPS, KBPS_UNIT);
 	shell_fprintf(sh, SHELL_NORMAL, "\n");
 
+	if (!is_udp && param->options.tcp_congestion[0] != '\0') {
+		shell_fprintf(sh, SHELL_NORMAL, "Congestion:\t%s\n",
+			      param->options.tcp_congestion);
+	}
+
 	if (IS_ENABLED(CONFIG_ZPERF_SESSION_PER_THREAD) &&
 	    COND_CODE_1(CONFIG_ZPERF_SESSION_PER_THREAD,
 			(param->options.wait_for_start), (0))) {
@@ -1018,6 +1045,23 @@ static int shell_cmd_upload(const struct shell *sh, size_t argc,
 			opt_cnt += 1;
 			break;
 
+		case 'Z':
+			if (is_udp) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "UDP does not support -Z option\n");
+				return -ENOEXEC;
+			}
+			i++;
+			if (i >= argc ||
+			    strlen(argv[i]) >= sizeof(param.options.tcp_congestion)) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "-Z <congestion control algorithm>\n");
+				return -ENOEXEC;
+			}
+			strcpy(param.options.tcp_congestion, argv[i]);
+			opt_cnt += 2;
+			break;
+
 #ifdef CONFIG_ZPERF_SESSION_PER_THREAD
 		case 't':
 			param.options.thread_priority = parse_arg(&i, argc, argv);
@@ -1271,6 +1315,23 @@ static int shell_cmd_upload2(const struct shell *sh, size_t argc,
 			opt_cnt += 1;
 			break;
 
+		case 'Z':
+			if (is_udp) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "UDP does not support -Z option\n");
+				return -ENOEXEC;
+			}
+			i++;
+			if (i >= argc ||
+			    strlen(argv[i]) >= sizeof(param.options.tcp_congestion)) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "-Z <congestion control algorithm>\n");
+				return -ENOEXEC;
+			}
+			strcpy(param.options.tcp_congestion, argv[i]);
+			opt_cnt += 2;
+			break;
+
 #ifdef CONFIG_ZPERF_SESSION_PER_THREAD
 		case 't':
 			param.options.thread_priority = parse_arg(&i, argc, argv);
@@ -1922,6 +1983,7 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_tcp,
 		  "-a: Asynchronous call (shell will not block for the upload)\n"
 		  "-i sec: Periodic reporting interval in seconds (async only)\n"
 		  "-n: Disable Nagle's algorithm\n"
+		  "-Z algo: Congestion control algorithm, e.g. reno, cubic or bbr\n"
 #ifdef CONFIG_ZPERF_SESSION_PER_THREAD
 		  "-t: Specify custom thread priority\n"
 		  "-w: Wait for start signal before starting the tests\n"
@@ -1946,6 +2008,7 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_tcp,
 		  "-a: Asynchronous call (shell will not block for the upload)\n"
 		  "-i sec: Periodic reporting interval in seconds (async only)\n"
 		  "-n: Disable Nagle's algorithm\n"
+		  "-Z algo: Congestion control algorithm, e.g. reno, cubic or bbr\n"
 #ifdef CONFIG_ZPERF_SESSION_PER_THREAD
 		  "-t: Specify custom thread priority\n"
 		  "-w: Wait for start signal before starting the tests\n"
@@ -312,14 +312,66 @@ static void udp_receiver_cleanup(void)
 	zperf_session_reset(SESSION_UDP);
 }
 
-static int udp_recv_data(struct net_socket_service_event *pev)
+#if CONFIG_NET_ZPERF_UDP_BATCH == 1
+static int udp_recv_datagrams(int sock)
 {
 	static uint8_t buf[UDP_RECEIVER_BUF_SIZE];
+	struct net_sockaddr addr;
+	net_socklen_t addrlen = sizeof(addr);
+	int ret;
+
+	ret = zsock_recvfrom(sock, buf, sizeof(buf), ZSOCK_MSG_DONTWAIT,
+			     &addr, &addrlen);
+	if (ret < 0) {
+		return ret;
+	}
+
+	udp_received(sock, &addr, buf, ret);
+
+	return 1;
+}
+#else
+/* Receive up to CONFIG_NET_ZPERF_UDP_BATCH datagrams per socket call */
+static int udp_recv_datagrams(int sock)
+{
+	static uint8_t bufs[CONFIG_NET_ZPERF_UDP_BATCH][UDP_RECEIVER_BUF_SIZE];
+	static struct net_sockaddr addrs[CONFIG_NET_ZPERF_UDP_BATCH];
+	static struct net_iovec iov[CONFIG_NET_ZPERF_UDP_BATCH];
+	static struct net_mmsghdr msgs[CONFIG_NET_ZPERF_UDP_BATCH];
+	int ret;
+
+	for (int i = 0; i < ARRAY_SIZE(msgs); i++) {
+		iov[i].iov_base = bufs[i];
+		iov[i].iov_len = sizeof(bufs[i]);
+
+		msgs[i] = (struct net_mmsghdr) {
+			.msg_hdr = {
+				.msg_name = &addrs[i],
+				.msg_namelen = sizeof(addrs[i]),
+				.msg_iov = &iov[i],
+				.msg_iovlen = 1,
+			},
+		};
+	}
+
+	ret = zsock_recvmmsg(sock, msgs, ARRAY_SIZE(msgs), ZSOCK_MSG_DONTWAIT);
+	if (ret < 0) {
+		return ret;
+	}
+
+	for (int i = 0; i < ret; i++) {
+		udp_received(sock, &addrs[i], bufs[i], msgs[i].msg_len);
+	}
+
+	return ret;
+}
+#endif /* CONFIG_NET_ZPERF_UDP_BATCH == 1 */
+
+static int udp_recv_data(struct net_socket_service_event *pev)
+{
 	int ret = 1;
 	int family, sock_error;
-	struct net_sockaddr addr;
 	net_socklen_t optlen = sizeof(int);
-	net_socklen_t addrlen = sizeof(addr);
 
 	if (!udp_server_running) {
 		return -ENOENT;
@@ -342,8 +394,7 @@ static int udp_recv_data(struct net_socket_service_event *pev)
 	}
 
 	while (ret > 0) {
-		ret = zsock_recvfrom(pev->event.fd, buf, sizeof(buf), ZSOCK_MSG_DONTWAIT,
-				     &addr, &addrlen);
+		ret = udp_recv_datagrams(pev->event.fd);
 		if ((ret < 0) && (errno == EAGAIN)) {
 			ret = 0;
 			break;
@@ -357,8 +408,6 @@ static int udp_recv_data(struct net_socket_service_event *pev)
 				family == NET_AF_INET ? 4 : 6, -ret);
 			goto error;
 		}
-
-		udp_received(pev->event.fd, &addr, buf, ret);
 	}
 	return ret;
 
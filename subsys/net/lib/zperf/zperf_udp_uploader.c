@@ -23,6 +23,16 @@ static uint8_t sample_packet[sizeof(struct zperf_udp_datagram) +
 static struct zperf_async_upload_context udp_async_upload_ctx;
 #endif /* CONFIG_ZPERF_SESSION_PER_THREAD */
 
+#define UDP_BATCH CONFIG_NET_ZPERF_UDP_BATCH
+
+#if UDP_BATCH > 1
+/* Each datagram of a batch gets its own header, the payload is shared */
+static uint8_t batch_hdr[UDP_BATCH][sizeof(struct zperf_udp_datagram) +
+				    sizeof(struct zperf_client_hdr_v1)];
+static struct net_iovec batch_iov[UDP_BATCH][2];
+static struct net_mmsghdr batch_msg[UDP_BATCH];
+#endif
+
 static inline void zperf_upload_decode_stat(const uint8_t *data,
 					    size_t datalen,
 					    struct zperf_results *results)
@@ -226,6 +236,58 @@ static int cal_compensate_delay(struct compensate_ctx *ctx, int64_t loop_time, i
 }
 #endif
 
+static void fill_client_hdr(uint8_t *buf, uint32_t id, uint32_t secs,
+			    uint32_t usecs, int port, uint32_t rate_in_kbps,
+			    uint32_t packet_size)
+{
+	struct zperf_udp_datagram *datagram;
+	struct zperf_client_hdr_v1 *hdr;
+
+	datagram = (struct zperf_udp_datagram *)buf;
+
+	datagram->id = net_htonl(id);
+	datagram->tv_sec = net_htonl(secs);
+	datagram->tv_usec = net_htonl(usecs);
+
+	hdr = (struct zperf_client_hdr_v1 *)(buf + sizeof(*datagram));
+	hdr->flags = 0;
+	hdr->num_of_threads = net_htonl(1);
+	hdr->port = net_htonl(port);
+	hdr->buffer_len = sizeof(sample_packet) -
+		sizeof(*datagram) - sizeof(*hdr);
+	hdr->bandwidth = net_htonl(rate_in_kbps);
+	hdr->num_of_bytes = net_htonl(packet_size);
+}
+
+#if UDP_BATCH > 1
+/* Send @a count datagrams with consecutive ids in one socket call */
+static int udp_send_batch(int sock, unsigned int count, uint32_t first_id,
+			  uint32_t secs, uint32_t usecs, int port,
+			  uint32_t rate_in_kbps, uint32_t packet_size)
+{
+	size_t header_size = sizeof(batch_hdr[0]);
+
+	for (unsigned int i = 0; i < count; i++) {
+		fill_client_hdr(batch_hdr[i], first_id + i, secs, usecs, port,
+				rate_in_kbps, packet_size);
+
+		batch_iov[i][0].iov_base = batch_hdr[i];
+		batch_iov[i][0].iov_len = MIN(header_size, packet_size);
+		batch_iov[i][1].iov_base = sample_packet + header_size;
+		batch_iov[i][1].iov_len = packet_size - batch_iov[i][0].iov_len;
+
+		batch_msg[i] = (struct net_mmsghdr) {
+			.msg_hdr = {
+				.msg_iov = batch_iov[i],
+				.msg_iovlen = 2,
+			},
+		};
+	}
+
+	return zsock_sendmmsg(sock, batch_msg, count, 0);
+}
+#endif /* UDP_BATCH > 1 */
+
 static int udp_upload(int sock, int port,
 		      const struct zperf_upload_params *param,
 		      struct zperf_results *results)
@@ -235,8 +297,10 @@ static int udp_upload(int sock, int port,
 	uint32_t duration_in_ms = param->duration_ms;
 	uint32_t packet_size = param->packet_size;
 	uint32_t rate_in_kbps = param->rate_kbps;
+	/* Custom payloads differ for each datagram, so they are not batched */
+	unsigned int batch = param->data_loader == NULL ? UDP_BATCH : 1;
 	uint32_t packet_duration_us = zperf_packet_duration(packet_size, rate_in_kbps);
-	uint32_t packet_duration = k_us_to_ticks_ceil32(packet_duration_us);
+	uint32_t packet_duration = k_us_to_ticks_ceil32(packet_duration_us * batch);
 	uint32_t delay = packet_duration;
 	uint64_t data_offset = 0U;
 	uint32_t nb_packets = 0U;
@@ -275,12 +339,10 @@ static int udp_upload(int sock, int port,
 	/* compensate period, by default 10 ticks */
 	ctx.period = 10;
 	ctx.period_start = -1;
-	ctx.packet_duration_us = packet_duration_us;
+	ctx.packet_duration_us = packet_duration_us * batch;
 #endif
 
 	do {
-		struct zperf_udp_datagram *datagram;
-		struct zperf_client_hdr_v1 *hdr;
 		uint32_t secs, usecs;
 		int64_t loop_time;
 		int32_t adjust;
@@ -317,41 +379,43 @@ static int udp_upload(int sock, int port,
 		secs = usecs64 / USEC_PER_SEC;
 		usecs = usecs64 % USEC_PER_SEC;
 
-		/* Fill the packet header */
-		datagram = (struct zperf_udp_datagram *)sample_packet;
-
-		datagram->id = net_htonl(nb_packets);
-		datagram->tv_sec = net_htonl(secs);
-		datagram->tv_usec = net_htonl(usecs);
-
-		hdr = (struct zperf_client_hdr_v1 *)(sample_packet +
-						     sizeof(*datagram));
-		hdr->flags = 0;
-		hdr->num_of_threads = net_htonl(1);
-		hdr->port = net_htonl(port);
-		hdr->buffer_len = sizeof(sample_packet) -
-			sizeof(*datagram) - sizeof(*hdr);
-		hdr->bandwidth = net_htonl(rate_in_kbps);
-		hdr->num_of_bytes = net_htonl(packet_size);
-
-		/* Load custom data payload if requested */
-		if (param->data_loader != NULL) {
-			ret = param->data_loader(param->data_loader_ctx, data_offset,
-				sample_packet + header_size, packet_size - header_size);
+#if UDP_BATCH > 1
+		if (batch > 1) {
+			ret = udp_send_batch(sock, batch, nb_packets, secs, usecs,
+					     port, rate_in_kbps, packet_size);
 			if (ret < 0) {
-				NET_ERR("Failed to load data for offset %llu", data_offset);
-				return ret;
+				NET_ERR("Failed to send the packets (%d)", errno);
+				return -errno;
 			}
+
+			nb_packets += ret;
 		}
-		data_offset += packet_size - header_size;
+#endif /* UDP_BATCH > 1 */
+
+		if (batch == 1) {
+			/* Fill the packet header */
+			fill_client_hdr(sample_packet, nb_packets, secs, usecs, port,
+					rate_in_kbps, packet_size);
+
+			/* Load custom data payload if requested */
+			if (param->data_loader != NULL) {
+				ret = param->data_loader(param->data_loader_ctx, data_offset,
+					sample_packet + header_size, packet_size - header_size);
+				if (ret < 0) {
+					NET_ERR("Failed to load data for offset %llu", data_offset);
+					return ret;
+				}
+			}
+			data_offset += packet_size - header_size;
 
-		/* Send the packet */
-		ret = zsock_send(sock, sample_packet, packet_size, 0);
-		if (ret < 0) {
-			NET_ERR("Failed to send the packet (%d)", errno);
-			return -errno;
-		} else {
-			nb_packets++;
+			/* Send the packet */
+			ret = zsock_send(sock, sample_packet, packet_size, 0);
+			if (ret < 0) {
+				NET_ERR("Failed to send the packet (%d)", errno);
+				return -errno;
+			} else {
+				nb_packets++;
+			}
 		}
 
 		if (IS_ENABLED(CONFIG_NET_ZPERF_LOG_LEVEL_DBG)) {
@@ -425,7 +489,7 @@ int zperf_udp_upload(const struct zperf_upload_params *param,
 	}
 
 	sock = zperf_prepare_upload_sock(&param->peer_addr, param->options.tos,
-					 param->options.priority, 0,
+					 param->options.priority, 0, NULL,
 					 NET_IPPROTO_UDP);
 	if (sock < 0) {
 		return sock;
@@ -24,7 +24,7 @@ int rtio_init(void)
 
 	STRUCT_SECTION_FOREACH(rtio_cqe_pool, cqe_pool) {
 		for (int i = 0; i < cqe_pool->pool_size; i++) {
-			mpsc_push(&cqe_pool->free_q, &cqe_pool->pool[i].q);
+			atomic_set_bit(cqe_pool->free_mask, i);
 		}
 	}
 
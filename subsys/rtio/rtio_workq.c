@@ -7,6 +7,8 @@
 
 #include <zephyr/rtio/work.h>
 #include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/slist.h>
 
 K_MEM_SLAB_DEFINE_STATIC(rtio_work_items_slab,
 			 sizeof(struct rtio_work_req),
@@ -16,7 +18,37 @@ static K_THREAD_STACK_ARRAY_DEFINE(rtio_workq_threads_stack,
 				   CONFIG_RTIO_WORKQ_THREADS_POOL,
 				   CONFIG_RTIO_WORKQ_THREADS_POOL_STACK_SIZE);
 static struct k_thread rtio_work_threads[CONFIG_RTIO_WORKQ_THREADS_POOL];
+
+#ifdef CONFIG_RTIO_WORKQ_IODEV_QUEUES
+/** Requests of a single iodev, handled in order by one thread at a time */
+struct rtio_workq_iodev_queue {
+	/** IODEV the requests are for */
+	const struct rtio_iodev *iodev;
+	/** Pending requests */
+	sys_slist_t reqs;
+	/** Node in the list of queues ready to be handled */
+	sys_snode_t node;
+	/** A thread is handling the requests of this queue */
+	bool running;
+};
+
+/* A queue is in use while it holds requests or while a thread runs it. The
+ * handled requests are freed before the queue stops running, so besides one
+ * queue per allocated request, each thread may keep an empty queue in use.
+ */
+static struct rtio_workq_iodev_queue
+	rtio_workq_queues[CONFIG_RTIO_WORKQ_POOL_ITEMS + CONFIG_RTIO_WORKQ_THREADS_POOL];
+static sys_slist_t rtio_workq_ready = SYS_SLIST_STATIC_INIT(&rtio_workq_ready);
+static K_SEM_DEFINE(rtio_workq_sem, 0, K_SEM_MAX_LIMIT);
+static struct k_spinlock rtio_workq_lock;
+#else
 static K_QUEUE_DEFINE(rtio_workq);
+#endif /* CONFIG_RTIO_WORKQ_IODEV_QUEUES */
+
+#ifdef CONFIG_RTIO_WORKQ_STATS
+static atomic_t rtio_workq_wakeups;
+static atomic_t rtio_workq_reqs;
+#endif
 
 struct rtio_work_req *rtio_work_req_alloc(void)
 {
@@ -31,6 +63,63 @@ struct rtio_work_req *rtio_work_req_alloc(void)
 	return req;
 }
 
+#ifdef CONFIG_RTIO_WORKQ_IODEV_QUEUES
+static struct rtio_workq_iodev_queue *rtio_workq_queue_get(const struct rtio_iodev *iodev)
+{
+	struct rtio_workq_iodev_queue *free_q = NULL;
+
+	for (size_t i = 0 ; i < ARRAY_SIZE(rtio_workq_queues) ; i++) {
+		struct rtio_workq_iodev_queue *q = &rtio_workq_queues[i];
+		bool in_use = q->running || !sys_slist_is_empty(&q->reqs);
+
+		if (in_use && q->iodev == iodev) {
+			return q;
+		}
+
+		if (!in_use && free_q == NULL) {
+			free_q = q;
+		}
+	}
+
+	__ASSERT(free_q != NULL, "No free RTIO work queue");
+	free_q->iodev = iodev;
+
+	return free_q;
+}
+
+static void rtio_workq_enqueue(struct rtio_work_req *req)
+{
+	struct rtio_workq_iodev_queue *q;
+	bool ready = false;
+	k_spinlock_key_t key = k_spin_lock(&rtio_workq_lock);
+
+	q = rtio_workq_queue_get(req->iodev_sqe->sqe.iodev);
+
+	/* A queue with pending requests which is not running is already ready */
+	if (!q->running && sys_slist_is_empty(&q->reqs)) {
+		sys_slist_append(&rtio_workq_ready, &q->node);
+		ready = true;
+	}
+
+	sys_slist_append(&q->reqs, &req->node);
+
+	k_spin_unlock(&rtio_workq_lock, key);
+
+	if (ready) {
+		k_sem_give(&rtio_workq_sem);
+	}
+}
+#else
+static void rtio_workq_enqueue(struct rtio_work_req *req)
+{
+	/** For now we're simply treating this as a FIFO queue. It may be
+	 * desirable to expand this to handle queue ordering based on RTIO
+	 * SQE priority.
+	 */
+	k_queue_append(&rtio_workq, req);
+}
+#endif /* CONFIG_RTIO_WORKQ_IODEV_QUEUES */
+
 void rtio_work_req_submit(struct rtio_work_req *req,
 			  struct rtio_iodev_sqe *iodev_sqe,
 			  rtio_work_submit_t handler)
@@ -47,11 +136,7 @@ void rtio_work_req_submit(struct rtio_work_req *req,
 	req->iodev_sqe = iodev_sqe;
 	req->handler = handler;
 
-	/** For now we're simply treating this as a FIFO queue. It may be
-	 * desirable to expand this to handle queue ordering based on RTIO
-	 * SQE priority.
-	 */
-	k_queue_append(&rtio_workq, req);
+	rtio_workq_enqueue(req);
 }
 
 uint32_t rtio_work_req_used_count_get(void)
@@ -59,6 +144,82 @@ uint32_t rtio_work_req_used_count_get(void)
 	return k_mem_slab_num_used_get(&rtio_work_items_slab);
 }
 
+#ifdef CONFIG_RTIO_WORKQ_STATS
+void rtio_work_stats_get(struct rtio_work_stats *stats)
+{
+	stats->wakeups = (uint32_t)atomic_get(&rtio_workq_wakeups);
+	stats->reqs = (uint32_t)atomic_get(&rtio_workq_reqs);
+}
+#endif
+
+static void rtio_workq_handle(struct rtio_work_req *req)
+{
+	req->handler(req->iodev_sqe);
+
+	k_mem_slab_free(&rtio_work_items_slab, req);
+
+#ifdef CONFIG_RTIO_WORKQ_STATS
+	atomic_inc(&rtio_workq_reqs);
+#endif
+}
+
+#ifdef CONFIG_RTIO_WORKQ_IODEV_QUEUES
+static void rtio_workq_thread_fn(void *arg1, void *arg2, void *arg3)
+{
+	ARG_UNUSED(arg1);
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	while (true) {
+		struct rtio_workq_iodev_queue *q;
+		k_spinlock_key_t key;
+		bool ready = false;
+
+		k_sem_take(&rtio_workq_sem, K_FOREVER);
+
+#ifdef CONFIG_RTIO_WORKQ_STATS
+		atomic_inc(&rtio_workq_wakeups);
+#endif
+
+		key = k_spin_lock(&rtio_workq_lock);
+
+		q = CONTAINER_OF(sys_slist_get_not_empty(&rtio_workq_ready),
+				 struct rtio_workq_iodev_queue, node);
+		q->running = true;
+
+		/* Handle a batch of requests of this iodev, including the ones
+		 * submitted meanwhile, e.g. the next ones of a chain.
+		 */
+		for (int i = 0 ; i < CONFIG_RTIO_WORKQ_BATCH_SIZE ; i++) {
+			sys_snode_t *node = sys_slist_get(&q->reqs);
+
+			if (node == NULL) {
+				break;
+			}
+
+			k_spin_unlock(&rtio_workq_lock, key);
+
+			rtio_workq_handle(CONTAINER_OF(node, struct rtio_work_req, node));
+
+			key = k_spin_lock(&rtio_workq_lock);
+		}
+
+		q->running = false;
+
+		/* Let the other iodevs run before handling the rest */
+		if (!sys_slist_is_empty(&q->reqs)) {
+			sys_slist_append(&rtio_workq_ready, &q->node);
+			ready = true;
+		}
+
+		k_spin_unlock(&rtio_workq_lock, key);
+
+		if (ready) {
+			k_sem_give(&rtio_workq_sem);
+		}
+	}
+}
+#else
 static void rtio_workq_thread_fn(void *arg1, void *arg2, void *arg3)
 {
 	ARG_UNUSED(arg1);
@@ -69,12 +230,14 @@ static void rtio_workq_thread_fn(void *arg1, void *arg2, void *arg3)
 		struct rtio_work_req *req = k_queue_get(&rtio_workq, K_FOREVER);
 
 		if (req != NULL) {
-			req->handler(req->iodev_sqe);
-
-			k_mem_slab_free(&rtio_work_items_slab, req);
+#ifdef CONFIG_RTIO_WORKQ_STATS
+			atomic_inc(&rtio_workq_wakeups);
+#endif
+			rtio_workq_handle(req);
 		}
 	}
 }
+#endif /* CONFIG_RTIO_WORKQ_IODEV_QUEUES */
 
 static int static_init(void)
 {
@@ -0,0 +1,121 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __SETTINGS_BATCH_H_
+#define __SETTINGS_BATCH_H_
+
+#include <stdbool.h>
+#include <sys/types.h>
+#include <zephyr/settings/settings.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* The NVS and ZMS back-ends store the settings items saved in batches in
+ * records of up to CONFIG_SETTINGS_SAVE_BATCH_BUF_SIZE bytes, each holding
+ * several settings items, rather than in their own entries. These records are
+ * the only copy of their values.
+ *
+ * A batch merges the stored settings items with its own ones in the records
+ * of a second bank, then writes the commit record, which selects the bank
+ * holding the settings items. The records of the other bank are then deleted.
+ * Since the commit record is written last, a reset leaves either the previous
+ * or the new settings items.
+ *
+ * A settings item saved in its own entries after a batch takes precedence
+ * over its value in the records. Such entries are deleted when a later batch
+ * saves the settings item again. Deleting a settings item stored in the
+ * records saves a batch deleting it.
+ */
+
+/* Slot of the n-th record of a bank */
+#define SETTINGS_BATCH_SLOT(bank, n) ((bank) * CONFIG_SETTINGS_SAVE_BATCH_RECORDS + (n))
+/* Slot of the commit record, following the records of both banks */
+#define SETTINGS_BATCH_SLOT_COMMIT (2 * CONFIG_SETTINGS_SAVE_BATCH_RECORDS)
+
+struct settings_batch_store;
+
+/* Storage of the records, implemented by the back-end */
+struct settings_batch_store_itf {
+	/* Read the record at slot, returns its length */
+	ssize_t (*read)(struct settings_batch_store *bs, uint16_t slot, void *buf,
+			size_t len);
+	/* Write the record at slot */
+	int (*write)(struct settings_batch_store *bs, uint16_t slot, const void *buf,
+		     size_t len);
+	/* Delete the record at slot */
+	int (*erase)(struct settings_batch_store *bs, uint16_t slot);
+	/* Tell whether a settings item is stored in its own entries */
+	bool (*item_exists)(struct settings_batch_store *bs, const char *name);
+	/* Delete the own entries of a settings item, if any */
+	int (*item_delete)(struct settings_batch_store *bs, const char *name);
+};
+
+struct settings_batch_store {
+	const struct settings_batch_store_itf *itf;
+	/* Bank holding the stored settings items */
+	uint8_t bank;
+	/* Number of records of the stored settings items, 0 if none */
+	uint16_t records;
+};
+
+/**
+ * Initialize a batch store: find the stored settings items, complete a batch
+ * committed before a reset and delete the records of an uncommitted one.
+ *
+ * @param bs batch store, with its interface set
+ *
+ * @return 0 on success, negative errno code on failure
+ */
+int settings_batch_store_init(struct settings_batch_store *bs);
+
+/**
+ * Call the set handlers of the stored settings items, except those stored in
+ * their own entries.
+ *
+ * @param bs batch store
+ * @param arg load arguments
+ *
+ * @return 0 on success, the first non-zero value returned by a set handler or
+ * a negative errno code on failure
+ */
+int settings_batch_store_load(struct settings_batch_store *bs,
+			      const struct settings_load_arg *arg);
+
+/**
+ * Find the value of a stored settings item.
+ *
+ * @param bs batch store
+ * @param name name of the settings item
+ * @param[out] buf buffer receiving the value, NULL to only get its length
+ * @param buf_len size of <p>buf</p>
+ *
+ * @return length of the value, 0 if the settings item is not stored or a
+ * negative errno code on failure
+ */
+ssize_t settings_batch_store_find(struct settings_batch_store *bs, const char *name,
+				  void *buf, size_t buf_len);
+
+/**
+ * Save a batch of settings items.
+ *
+ * @param bs batch store
+ * @param entries settings items to save, with a NULL value to delete them
+ * @param count number of settings items
+ *
+ * @return 0 on success, -E2BIG if the settings items do not fit in
+ * CONFIG_SETTINGS_SAVE_BATCH_RECORDS records, negative errno code on other
+ * failures
+ */
+int settings_batch_store_save(struct settings_batch_store *bs,
+			      const struct settings_batch_entry *entries, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SETTINGS_BATCH_H_ */
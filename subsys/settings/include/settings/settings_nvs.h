@@ -10,6 +10,9 @@
 
 #include <zephyr/fs/nvs.h>
 #include <zephyr/settings/settings.h>
+#ifdef CONFIG_SETTINGS_SAVE_BATCH_RECORDS
+#include "settings/settings_batch.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -33,11 +36,27 @@ extern "C" {
 #define NVS_NAMECNT_ID 0x8000
 #define NVS_NAME_ID_OFFSET 0x4000
 
+/* The records of the settings saved in batches are stored at the highest name
+ * IDs, from NVS_NAME_ID_END, which are not used for names. The commit record
+ * follows them at NVS_BATCH_ID, which would be the value of NVS_NAMECNT_ID.
+ */
+#define NVS_BATCH_ID (NVS_NAMECNT_ID + NVS_NAME_ID_OFFSET)
+
+#ifdef CONFIG_SETTINGS_SAVE_BATCH_RECORDS
+#define NVS_NAME_ID_END (NVS_BATCH_ID - SETTINGS_BATCH_SLOT_COMMIT)
+#define NVS_BATCH_RECORD_ID(slot) (NVS_NAME_ID_END + (slot))
+#else
+#define NVS_NAME_ID_END NVS_BATCH_ID
+#endif
+
 struct settings_nvs {
 	struct settings_store cf_store;
 	struct nvs_fs cf_nvs;
 	uint16_t last_name_id;
 	const struct device *flash_dev;
+#ifdef CONFIG_SETTINGS_SAVE_BATCH_RECORDS
+	struct settings_batch_store batch;
+#endif
 #if CONFIG_SETTINGS_NVS_NAME_CACHE
 	struct {
 		uint16_t name_hash;
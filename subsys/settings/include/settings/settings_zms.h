@@ -8,6 +8,9 @@
 
 #include <zephyr/fs/zms.h>
 #include <zephyr/settings/settings.h>
+#ifdef CONFIG_SETTINGS_SAVE_BATCH_RECORDS
+#include "settings/settings_batch.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -71,6 +74,11 @@ extern "C" {
 #define ZMS_DATA_ID_FROM_HASH(x) (ZMS_NAME_ID_FROM_HASH(x) + ZMS_DATA_ID_OFFSET)
 #define ZMS_DATA_ID_FROM_NAME(x) (x + ZMS_DATA_ID_OFFSET)
 #define ZMS_DATA_ID_FROM_LL_NODE(x) (ZMS_NAME_ID_FROM_LL_NODE(x) + ZMS_DATA_ID_OFFSET)
+/* Data IDs are always even, the odd ones from ZMS_BATCH_ID store the records of the
+ * settings saved in batches, then their commit record.
+ */
+#define ZMS_BATCH_ID (ZMS_LL_HEAD_HASH_ID + ZMS_DATA_ID_OFFSET + 1)
+#define ZMS_BATCH_RECORD_ID(slot) (ZMS_BATCH_ID + 2 * (slot))
 
 struct settings_hash_linked_list {
 	uint32_t previous_hash;
@@ -81,6 +89,9 @@ struct settings_zms {
 	struct settings_store cf_store;
 	struct zms_fs cf_zms;
 	const struct device *flash_dev;
+#ifdef CONFIG_SETTINGS_SAVE_BATCH_RECORDS
+	struct settings_batch_store batch;
+#endif
 #if CONFIG_SETTINGS_ZMS_LL_CACHE
 	struct settings_hash_linked_list ll_cache[CONFIG_SETTINGS_ZMS_LL_CACHE_SIZE];
 	uint32_t ll_cache_next;
@@ -91,6 +102,9 @@ struct settings_zms {
 	uint8_t hash_collision_num;
 };
 
+/* Initialize a zms backend, completing a batch interrupted by a reset. */
+int settings_zms_backend_init(struct settings_zms *cf);
+
 #ifdef __cplusplus
 }
 #endif
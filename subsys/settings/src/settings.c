@@ -27,6 +27,108 @@ sys_slist_t settings_handlers;
 static K_MUTEX_DEFINE(settings_lock);
 #endif
 
+#if defined(CONFIG_SETTINGS_HANDLER_INDEX)
+/* Static handlers sorted by name, in section order for equal names */
+static const struct settings_handler_static *settings_handler_index[
+	CONFIG_SETTINGS_HANDLER_INDEX_SIZE];
+static size_t settings_handler_index_count;
+static bool settings_handler_index_ready;
+
+static void settings_handler_index_init(void)
+{
+	size_t count;
+
+	STRUCT_SECTION_COUNT(settings_handler_static, &count);
+	if (count > ARRAY_SIZE(settings_handler_index)) {
+		LOG_WRN("%zu static handlers do not fit in the index", count);
+		return;
+	}
+
+	settings_handler_index_count = 0;
+
+	/* Insertion sort, run once and stable */
+	STRUCT_SECTION_FOREACH(settings_handler_static, ch) {
+		size_t i = settings_handler_index_count;
+
+		while ((i > 0) && (strcmp(settings_handler_index[i - 1]->name, ch->name) > 0)) {
+			settings_handler_index[i] = settings_handler_index[i - 1];
+			i--;
+		}
+
+		settings_handler_index[i] = ch;
+		settings_handler_index_count++;
+	}
+
+	settings_handler_index_ready = true;
+}
+
+/* Find the last static handler whose name is the first len characters of name */
+static struct settings_handler_static *settings_handler_index_find(const char *name,
+								  size_t len)
+{
+	const struct settings_handler_static *found = NULL;
+	size_t lo = 0;
+	size_t hi = settings_handler_index_count;
+
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+		const char *hname = settings_handler_index[mid]->name;
+		int rc = strncmp(hname, name, len);
+
+		if ((rc == 0) && (hname[len] != '\0')) {
+			/* name is a strict prefix of hname */
+			rc = 1;
+		}
+
+		if (rc > 0) {
+			hi = mid;
+		} else {
+			if (rc == 0) {
+				found = settings_handler_index[mid];
+			}
+			lo = mid + 1;
+		}
+	}
+
+	return (struct settings_handler_static *)found;
+}
+
+/* Find the static handler matching the most name segments of name */
+static struct settings_handler_static *settings_handler_index_lookup(const char *name,
+								    const char **next)
+{
+	struct settings_handler_static *bestmatch = NULL;
+	struct settings_handler_static *ch;
+	const char *tmpnext;
+	size_t len = 0;
+
+	if (!name) {
+		return NULL;
+	}
+
+	while (1) {
+		len += settings_name_next(&name[len], &tmpnext);
+
+		ch = settings_handler_index_find(name, len);
+		if (ch) {
+			bestmatch = ch;
+			if (next) {
+				*next = tmpnext;
+			}
+		}
+
+		if (!tmpnext) {
+			break;
+		}
+
+		/* skip the separator */
+		len++;
+	}
+
+	return bestmatch;
+}
+#endif /* CONFIG_SETTINGS_HANDLER_INDEX */
+
 void settings_store_init(void);
 
 void settings_init(void)
@@ -34,6 +136,9 @@ void settings_init(void)
 #if defined(CONFIG_SETTINGS_DYNAMIC_HANDLERS)
 	sys_slist_init(&settings_handlers);
 #endif /* CONFIG_SETTINGS_DYNAMIC_HANDLERS */
+#if defined(CONFIG_SETTINGS_HANDLER_INDEX)
+	settings_handler_index_init();
+#endif /* CONFIG_SETTINGS_HANDLER_INDEX */
 	settings_store_init();
 }
 
@@ -143,16 +248,16 @@ int settings_name_next(const char *name, const char **next)
 	return rc;
 }
 
-struct settings_handler_static *settings_parse_and_lookup(const char *name,
-							const char **next)
+/* Find the static handler matching the most name segments of name, by comparing
+ * name with every static handler.
+ */
+static struct settings_handler_static *settings_handler_static_lookup(const char *name,
+								     const char **next)
 {
 	struct settings_handler_static *bestmatch;
 	const char *tmpnext;
 
 	bestmatch = NULL;
-	if (next) {
-		*next = NULL;
-	}
 
 	STRUCT_SECTION_FOREACH(settings_handler_static, ch) {
 		if (!settings_name_steq(name, ch->name, &tmpnext)) {
@@ -173,8 +278,31 @@ struct settings_handler_static *settings_parse_and_lookup(const char *name,
 		}
 	}
 
+	return bestmatch;
+}
+
+struct settings_handler_static *settings_parse_and_lookup(const char *name,
+							const char **next)
+{
+	struct settings_handler_static *bestmatch;
+
+	if (next) {
+		*next = NULL;
+	}
+
+#if defined(CONFIG_SETTINGS_HANDLER_INDEX)
+	if (settings_handler_index_ready) {
+		bestmatch = settings_handler_index_lookup(name, next);
+	} else {
+		bestmatch = settings_handler_static_lookup(name, next);
+	}
+#else
+	bestmatch = settings_handler_static_lookup(name, next);
+#endif /* CONFIG_SETTINGS_HANDLER_INDEX */
+
 #if defined(CONFIG_SETTINGS_DYNAMIC_HANDLERS)
 	struct settings_handler *ch;
+	const char *tmpnext;
 
 	SYS_SLIST_FOR_EACH_CONTAINER(&settings_handlers, ch, node) {
 		if (!settings_name_steq(name, ch->name, &tmpnext)) {
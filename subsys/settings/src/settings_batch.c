@@ -0,0 +1,590 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/settings/settings.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/util.h>
+#include "settings/settings_batch.h"
+#include "settings_priv.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(settings, CONFIG_SETTINGS_LOG_LEVEL);
+
+/* Header of a settings item in a record: length of its name and of its value */
+#define SETTINGS_BATCH_HDR_LEN (2 * sizeof(uint16_t))
+
+/* Commit record: bank, state, number of records and number of settings items
+ * carried over from the previous bank.
+ */
+#define SETTINGS_BATCH_COMMIT_LEN 6
+
+/* The own entries of the settings items of the batch may not be deleted yet */
+#define SETTINGS_BATCH_PURGE_PENDING BIT(0)
+
+/* Buffers protected by the settings lock. Loading uses its own buffer, so
+ * that set handlers can save settings.
+ */
+static uint8_t settings_batch_in[CONFIG_SETTINGS_SAVE_BATCH_BUF_SIZE];
+static uint8_t settings_batch_out[CONFIG_SETTINGS_SAVE_BATCH_BUF_SIZE];
+static uint8_t settings_batch_load_buf[CONFIG_SETTINGS_SAVE_BATCH_BUF_SIZE];
+
+/* Records written by a batch */
+struct settings_batch_writer {
+	struct settings_batch_store *bs;
+	uint8_t bank;
+	/* Only count the records, without writing them */
+	bool dry_run;
+	uint16_t records;
+	uint16_t items;
+	/* Number of settings items which are not deleted */
+	uint16_t values;
+	/* Length of the record being built in settings_batch_out */
+	size_t len;
+};
+
+struct settings_batch_read_fn_arg {
+	const void *value;
+	size_t len;
+};
+
+static ssize_t settings_batch_read_fn(void *back_end, void *data, size_t len)
+{
+	struct settings_batch_read_fn_arg *rd_fn_arg;
+
+	rd_fn_arg = (struct settings_batch_read_fn_arg *)back_end;
+
+	len = MIN(len, rd_fn_arg->len);
+	memcpy(data, rd_fn_arg->value, len);
+
+	return len;
+}
+
+/* Encode a settings item in buf, or only compute its length if buf is NULL */
+static ssize_t settings_batch_encode(const struct settings_batch_entry *entry, uint8_t *buf,
+				     size_t buf_len)
+{
+	size_t name_len = strlen(entry->name) + 1;
+	size_t val_len = (entry->value == NULL) ? 0 : entry->val_len;
+	size_t len = SETTINGS_BATCH_HDR_LEN + name_len + val_len;
+
+	if ((name_len > UINT16_MAX) || (val_len > UINT16_MAX) || (len > buf_len)) {
+		return -E2BIG;
+	}
+
+	if (buf == NULL) {
+		return len;
+	}
+
+	sys_put_le16(name_len, buf);
+	sys_put_le16(val_len, &buf[sizeof(uint16_t)]);
+
+	/* Keep the terminating null character so that decoded names can be used as is */
+	memcpy(&buf[SETTINGS_BATCH_HDR_LEN], entry->name, name_len);
+
+	if (val_len) {
+		memcpy(&buf[SETTINGS_BATCH_HDR_LEN + name_len], entry->value, val_len);
+	}
+
+	return len;
+}
+
+/* Decode the next settings item of a record, whose name and value point into
+ * buf. Returns 1 when a settings item is decoded, 0 at the end of the record.
+ */
+static int settings_batch_decode(const uint8_t *buf, size_t len, size_t *off,
+				 struct settings_batch_entry *entry)
+{
+	size_t name_len;
+	size_t val_len;
+	const char *name;
+
+	if (*off == len) {
+		return 0;
+	}
+
+	if (len - *off < SETTINGS_BATCH_HDR_LEN) {
+		return -EINVAL;
+	}
+
+	name_len = sys_get_le16(&buf[*off]);
+	val_len = sys_get_le16(&buf[*off + sizeof(uint16_t)]);
+	if ((name_len == 0) || (len - *off - SETTINGS_BATCH_HDR_LEN < name_len + val_len)) {
+		return -EINVAL;
+	}
+
+	name = (const char *)&buf[*off + SETTINGS_BATCH_HDR_LEN];
+	if (name[name_len - 1] != '\0') {
+		return -EINVAL;
+	}
+
+	entry->name = name;
+	entry->value = val_len ? &name[name_len] : NULL;
+	entry->val_len = val_len;
+	*off += SETTINGS_BATCH_HDR_LEN + name_len + val_len;
+
+	return 1;
+}
+
+/* Read the n-th record of a bank in buf */
+static ssize_t settings_batch_read(struct settings_batch_store *bs, uint8_t bank, uint16_t n,
+				   uint8_t *buf)
+{
+	ssize_t len;
+
+	len = bs->itf->read(bs, SETTINGS_BATCH_SLOT(bank, n), buf,
+			    CONFIG_SETTINGS_SAVE_BATCH_BUF_SIZE);
+	if (len > CONFIG_SETTINGS_SAVE_BATCH_BUF_SIZE) {
+		return -EINVAL;
+	}
+
+	return len;
+}
+
+static bool settings_batch_has_entry(const struct settings_batch_entry *entries, size_t count,
+				     const char *name)
+{
+	for (size_t i = 0; i < count; i++) {
+		if (strcmp(entries[i].name, name) == 0) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static int settings_batch_flush(struct settings_batch_writer *wr)
+{
+	int rc;
+
+	if (wr->len == 0) {
+		return 0;
+	}
+
+	if (wr->records == CONFIG_SETTINGS_SAVE_BATCH_RECORDS) {
+		return -E2BIG;
+	}
+
+	if (!wr->dry_run) {
+		rc = wr->bs->itf->write(wr->bs, SETTINGS_BATCH_SLOT(wr->bank, wr->records),
+					settings_batch_out, wr->len);
+		if (rc < 0) {
+			return rc;
+		}
+	}
+
+	wr->records++;
+	wr->len = 0;
+
+	return 0;
+}
+
+static int settings_batch_append(struct settings_batch_writer *wr,
+				 const struct settings_batch_entry *entry)
+{
+	uint8_t *buf = wr->dry_run ? NULL : &settings_batch_out[wr->len];
+	ssize_t len;
+	int rc;
+
+	if (wr->items == UINT16_MAX) {
+		return -E2BIG;
+	}
+
+	len = settings_batch_encode(entry, buf, sizeof(settings_batch_out) - wr->len);
+	if ((len == -E2BIG) && (wr->len > 0)) {
+		/* The settings item goes to the next record */
+		rc = settings_batch_flush(wr);
+		if (rc < 0) {
+			return rc;
+		}
+
+		buf = wr->dry_run ? NULL : settings_batch_out;
+		len = settings_batch_encode(entry, buf, sizeof(settings_batch_out));
+	}
+
+	if (len < 0) {
+		return len;
+	}
+
+	wr->len += len;
+	wr->items++;
+	if ((entry->value != NULL) && (entry->val_len > 0)) {
+		wr->values++;
+	}
+
+	return 0;
+}
+
+/* Write the stored settings items which the batch does not save again, then
+ * the settings items of the batch, which are kept even when deleted so that
+ * their own entries can be deleted after a reset.
+ */
+static int settings_batch_merge(struct settings_batch_writer *wr,
+				const struct settings_batch_entry *entries, size_t count,
+				uint16_t *carried)
+{
+	struct settings_batch_store *bs = wr->bs;
+	struct settings_batch_entry item;
+	ssize_t len;
+	size_t off;
+	int rc = 0;
+
+	for (uint16_t n = 0; n < bs->records; n++) {
+		len = settings_batch_read(bs, bs->bank, n, settings_batch_in);
+		if (len < 0) {
+			return len;
+		}
+
+		off = 0;
+		while (1) {
+			rc = settings_batch_decode(settings_batch_in, len, &off, &item);
+			if (rc <= 0) {
+				break;
+			}
+
+			if ((item.val_len == 0) ||
+			    settings_batch_has_entry(entries, count, item.name)) {
+				continue;
+			}
+
+			rc = settings_batch_append(wr, &item);
+			if (rc < 0) {
+				return rc;
+			}
+		}
+
+		if (rc < 0) {
+			return rc;
+		}
+	}
+
+	*carried = wr->items;
+
+	for (size_t i = 0; i < count; i++) {
+		/* Only the last value of a settings item appearing several times is kept */
+		if (settings_batch_has_entry(&entries[i + 1], count - i - 1, entries[i].name)) {
+			continue;
+		}
+
+		rc = settings_batch_append(wr, &entries[i]);
+		if (rc < 0) {
+			return rc;
+		}
+	}
+
+	return settings_batch_flush(wr);
+}
+
+static int settings_batch_commit(struct settings_batch_store *bs, uint16_t carried,
+				 uint8_t state)
+{
+	uint8_t commit[SETTINGS_BATCH_COMMIT_LEN];
+
+	commit[0] = bs->bank;
+	commit[1] = state;
+	sys_put_le16(bs->records, &commit[2]);
+	sys_put_le16(carried, &commit[4]);
+
+	return bs->itf->write(bs, SETTINGS_BATCH_SLOT_COMMIT, commit, sizeof(commit));
+}
+
+/* Delete the records of a bank from the last one, so that a reset leaves the
+ * leading ones, which are found and deleted at initialization.
+ */
+static int settings_batch_erase(struct settings_batch_store *bs, uint8_t bank,
+				uint16_t records)
+{
+	int rc = 0;
+	int rc2;
+
+	while (records > 0) {
+		records--;
+		rc2 = bs->itf->erase(bs, SETTINGS_BATCH_SLOT(bank, records));
+		if ((rc2 < 0) && (rc == 0)) {
+			rc = rc2;
+		}
+	}
+
+	return rc;
+}
+
+/* Delete the records left in a bank, returns their number */
+static int settings_batch_discard(struct settings_batch_store *bs, uint8_t bank)
+{
+	uint16_t records = 0;
+	int rc;
+
+	while ((records < CONFIG_SETTINGS_SAVE_BATCH_RECORDS) &&
+	       (bs->itf->read(bs, SETTINGS_BATCH_SLOT(bank, records), settings_batch_in,
+			      sizeof(settings_batch_in)) >= 0)) {
+		records++;
+	}
+
+	rc = settings_batch_erase(bs, bank, records);
+
+	return (rc < 0) ? rc : records;
+}
+
+/* Delete the own entries of the settings items following the carried ones */
+static int settings_batch_purge(struct settings_batch_store *bs, uint16_t carried)
+{
+	struct settings_batch_entry item;
+	uint16_t items = 0;
+	ssize_t len;
+	size_t off;
+	int rc = 0;
+
+	for (uint16_t n = 0; n < bs->records; n++) {
+		len = settings_batch_read(bs, bs->bank, n, settings_batch_in);
+		if (len < 0) {
+			return len;
+		}
+
+		off = 0;
+		while (1) {
+			rc = settings_batch_decode(settings_batch_in, len, &off, &item);
+			if (rc <= 0) {
+				break;
+			}
+
+			if (items++ < carried) {
+				continue;
+			}
+
+			rc = bs->itf->item_delete(bs, item.name);
+			if (rc < 0) {
+				return rc;
+			}
+		}
+
+		if (rc < 0) {
+			return rc;
+		}
+	}
+
+	return 0;
+}
+
+int settings_batch_store_init(struct settings_batch_store *bs)
+{
+	uint8_t commit[SETTINGS_BATCH_COMMIT_LEN];
+	uint16_t carried;
+	ssize_t len;
+	int rc = 0;
+	int rc2;
+
+	bs->bank = 0;
+	bs->records = 0;
+
+	len = bs->itf->read(bs, SETTINGS_BATCH_SLOT_COMMIT, commit, sizeof(commit));
+	if (len == -ENOENT) {
+		rc = settings_batch_discard(bs, 0);
+		rc2 = settings_batch_discard(bs, 1);
+		if ((rc > 0) || (rc2 > 0)) {
+			LOG_WRN("Discarded interrupted batch");
+		}
+
+		return (rc < 0) ? rc : MIN(rc2, 0);
+	} else if (len < 0) {
+		return len;
+	}
+
+	if ((len != sizeof(commit)) || (commit[0] > 1) || (sys_get_le16(&commit[2]) == 0) ||
+	    (sys_get_le16(&commit[2]) > CONFIG_SETTINGS_SAVE_BATCH_RECORDS)) {
+		LOG_ERR("Batch commit record corrupted");
+		return -EINVAL;
+	}
+
+	bs->bank = commit[0];
+	bs->records = sys_get_le16(&commit[2]);
+	carried = sys_get_le16(&commit[4]);
+
+	if (commit[1] & SETTINGS_BATCH_PURGE_PENDING) {
+		LOG_WRN("Completing interrupted batch");
+		rc = settings_batch_purge(bs, carried);
+	}
+
+	/* The other bank holds the previous settings items of an interrupted
+	 * batch or the records of an uncommitted one.
+	 */
+	if (rc == 0) {
+		rc = MIN(settings_batch_discard(bs, bs->bank ^ 1), 0);
+	}
+
+	if ((rc == 0) && (commit[1] & SETTINGS_BATCH_PURGE_PENDING)) {
+		rc = settings_batch_commit(bs, carried, 0);
+	}
+
+	return rc;
+}
+
+int settings_batch_store_load(struct settings_batch_store *bs,
+			      const struct settings_load_arg *arg)
+{
+	struct settings_batch_read_fn_arg read_fn_arg;
+	struct settings_batch_entry item;
+	uint8_t bank = bs->bank;
+	ssize_t len;
+	size_t off;
+	int rc = 0;
+
+	/* A batch saved by a set handler moves the settings items to the other
+	 * bank, the set handler already knows their values.
+	 */
+	for (uint16_t n = 0; (n < bs->records) && (bs->bank == bank); n++) {
+		len = settings_batch_read(bs, bank, n, settings_batch_load_buf);
+		if (len < 0) {
+			return len;
+		}
+
+		off = 0;
+		while (1) {
+			rc = settings_batch_decode(settings_batch_load_buf, len, &off, &item);
+			if (rc <= 0) {
+				break;
+			}
+
+			/* Skip deleted settings items and those saved in their own
+			 * entries since, which were loaded already.
+			 */
+			if ((item.val_len == 0) ||
+			    (arg && arg->subtree &&
+			     !settings_name_steq(item.name, arg->subtree, NULL)) ||
+			    bs->itf->item_exists(bs, item.name)) {
+				continue;
+			}
+
+			read_fn_arg.value = item.value;
+			read_fn_arg.len = item.val_len;
+
+			rc = settings_call_set_handler(item.name, item.val_len,
+						       settings_batch_read_fn, &read_fn_arg, arg);
+			if (rc) {
+				return rc;
+			}
+		}
+
+		if (rc < 0) {
+			return rc;
+		}
+	}
+
+	return 0;
+}
+
+ssize_t settings_batch_store_find(struct settings_batch_store *bs, const char *name,
+				  void *buf, size_t buf_len)
+{
+	struct settings_batch_entry item;
+	ssize_t len;
+	size_t off;
+	int rc = 0;
+
+	for (uint16_t n = 0; n < bs->records; n++) {
+		len = settings_batch_read(bs, bs->bank, n, settings_batch_in);
+		if (len < 0) {
+			return len;
+		}
+
+		off = 0;
+		while (1) {
+			rc = settings_batch_decode(settings_batch_in, len, &off, &item);
+			if (rc <= 0) {
+				break;
+			}
+
+			if (strcmp(item.name, name) != 0) {
+				continue;
+			}
+
+			if (buf != NULL) {
+				memcpy(buf, item.value, MIN(buf_len, item.val_len));
+			}
+
+			return item.val_len;
+		}
+
+		if (rc < 0) {
+			return rc;
+		}
+	}
+
+	return 0;
+}
+
+int settings_batch_store_save(struct settings_batch_store *bs,
+			      const struct settings_batch_entry *entries, size_t count)
+{
+	struct settings_batch_writer wr = {
+		.bs = bs,
+		.bank = bs->bank ^ 1,
+		.dry_run = true,
+	};
+	uint8_t prev_bank = bs->bank;
+	uint16_t prev_records = bs->records;
+	uint16_t carried;
+	int rc;
+
+	if (count == 0) {
+		return 0;
+	}
+
+	/* Check that the settings items fit before writing anything */
+	rc = settings_batch_merge(&wr, entries, count, &carried);
+	if (rc < 0) {
+		return rc;
+	}
+
+	wr.dry_run = false;
+	wr.records = 0;
+	wr.items = 0;
+	wr.values = 0;
+
+	rc = settings_batch_merge(&wr, entries, count, &carried);
+	if (rc == 0) {
+		bs->bank = wr.bank;
+		bs->records = wr.records;
+		rc = settings_batch_commit(bs, carried, SETTINGS_BATCH_PURGE_PENDING);
+		if (rc < 0) {
+			bs->bank = prev_bank;
+			bs->records = prev_records;
+		}
+	}
+
+	if (rc < 0) {
+		(void)settings_batch_erase(bs, wr.bank, wr.records);
+		return rc;
+	}
+
+	/* Once committed, the batch is completed even if a reset interrupts it */
+	for (size_t i = 0; i < count; i++) {
+		rc = bs->itf->item_delete(bs, entries[i].name);
+		if (rc < 0) {
+			return rc;
+		}
+	}
+
+	rc = settings_batch_erase(bs, prev_bank, prev_records);
+	if (rc < 0) {
+		return rc;
+	}
+
+	if (wr.values > 0) {
+		return settings_batch_commit(bs, carried, 0);
+	}
+
+	/* Only deleted settings items are left, drop the records */
+	rc = bs->itf->erase(bs, SETTINGS_BATCH_SLOT_COMMIT);
+	if (rc < 0) {
+		return rc;
+	}
+
+	bs->records = 0;
+
+	return settings_batch_erase(bs, bs->bank, wr.records);
+}
@@ -33,10 +33,18 @@ static int settings_nvs_load(struct settings_store *cs,
 static int settings_nvs_save(struct settings_store *cs, const char *name,
 			     const char *value, size_t val_len);
 static void *settings_nvs_storage_get(struct settings_store *cs);
+#ifdef CONFIG_SETTINGS_SAVE_BATCH
+static int settings_nvs_save_batch(struct settings_store *cs,
+				   const struct settings_batch_entry *entries,
+				   size_t count);
+#endif
 
 static struct settings_store_itf settings_nvs_itf = {
 	.csi_load = settings_nvs_load,
 	.csi_save = settings_nvs_save,
+#ifdef CONFIG_SETTINGS_SAVE_BATCH
+	.csi_save_batch = settings_nvs_save_batch,
+#endif
 	.csi_storage_get = settings_nvs_storage_get
 };
 
@@ -209,13 +217,22 @@ static int settings_nvs_load(struct settings_store *cs,
 			break;
 		}
 	}
+
+#ifdef CONFIG_SETTINGS_SAVE_BATCH
+	/* Settings items saved in their own entries after a batch were loaded
+	 * first, the batch records do not override them.
+	 */
+	if (ret == 0) {
+		ret = settings_batch_store_load(&cf->batch, arg);
+	}
+#endif
+
 	return ret;
 }
 
-static int settings_nvs_save(struct settings_store *cs, const char *name,
-			     const char *value, size_t val_len)
+static int settings_nvs_write(struct settings_nvs *cf, const char *name,
+			      const char *value, size_t val_len)
 {
-	struct settings_nvs *cf = CONTAINER_OF(cs, struct settings_nvs, cf_store);
 	char rdname[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
 	uint16_t name_id, write_name_id;
 	bool delete, write_name;
@@ -313,7 +330,7 @@ found:
 	}
 
 	/* No free IDs left. */
-	if (write_name_id == NVS_NAMECNT_ID + NVS_NAME_ID_OFFSET) {
+	if (write_name_id == NVS_NAME_ID_END) {
 		return -ENOMEM;
 	}
 
@@ -354,6 +371,120 @@ found:
 	return 0;
 }
 
+static int settings_nvs_save(struct settings_store *cs, const char *name,
+			     const char *value, size_t val_len)
+{
+	struct settings_nvs *cf = CONTAINER_OF(cs, struct settings_nvs, cf_store);
+
+#ifdef CONFIG_SETTINGS_SAVE_BATCH
+	if (name && ((value == NULL) || (val_len == 0))) {
+		struct settings_batch_entry entry = {.name = name};
+		ssize_t rc;
+
+		/* A settings item stored in the batch records is deleted by a batch */
+		rc = settings_batch_store_find(&cf->batch, name, NULL, 0);
+		if (rc < 0) {
+			return rc;
+		} else if (rc > 0) {
+			return settings_batch_store_save(&cf->batch, &entry, 1);
+		}
+	}
+#endif
+
+	return settings_nvs_write(cf, name, value, val_len);
+}
+
+#ifdef CONFIG_SETTINGS_SAVE_BATCH
+static ssize_t settings_nvs_batch_read(struct settings_batch_store *bs, uint16_t slot,
+				       void *buf, size_t len)
+{
+	struct settings_nvs *cf = CONTAINER_OF(bs, struct settings_nvs, batch);
+
+	return nvs_read(&cf->cf_nvs, NVS_BATCH_RECORD_ID(slot), buf, len);
+}
+
+static int settings_nvs_batch_write(struct settings_batch_store *bs, uint16_t slot,
+				    const void *buf, size_t len)
+{
+	struct settings_nvs *cf = CONTAINER_OF(bs, struct settings_nvs, batch);
+	ssize_t rc;
+
+	rc = nvs_write(&cf->cf_nvs, NVS_BATCH_RECORD_ID(slot), buf, len);
+
+	return (rc < 0) ? rc : 0;
+}
+
+static int settings_nvs_batch_erase(struct settings_batch_store *bs, uint16_t slot)
+{
+	struct settings_nvs *cf = CONTAINER_OF(bs, struct settings_nvs, batch);
+
+	return nvs_delete(&cf->cf_nvs, NVS_BATCH_RECORD_ID(slot));
+}
+
+static bool settings_nvs_batch_item_exists(struct settings_batch_store *bs, const char *name)
+{
+	struct settings_nvs *cf = CONTAINER_OF(bs, struct settings_nvs, batch);
+	char rdname[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
+	ssize_t rc;
+
+#if CONFIG_SETTINGS_NVS_NAME_CACHE
+	if (settings_nvs_cache_match(cf, name, rdname, sizeof(rdname)) != NVS_NAMECNT_ID) {
+		return true;
+	}
+
+	/* We can skip reading NVS if we know that the cache wasn't overflowed. */
+	if (cf->loaded && !SETTINGS_NVS_CACHE_OVFL(cf)) {
+		return false;
+	}
+#endif
+
+	for (uint16_t name_id = cf->last_name_id; name_id > NVS_NAMECNT_ID; name_id--) {
+		rc = nvs_read(&cf->cf_nvs, name_id, &rdname, sizeof(rdname));
+		if (rc < 0) {
+			continue;
+		}
+
+		rdname[rc] = '\0';
+
+		if (strcmp(name, rdname) == 0) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static int settings_nvs_batch_item_delete(struct settings_batch_store *bs, const char *name)
+{
+	struct settings_nvs *cf = CONTAINER_OF(bs, struct settings_nvs, batch);
+
+	return settings_nvs_write(cf, name, NULL, 0);
+}
+
+static const struct settings_batch_store_itf settings_nvs_batch_itf = {
+	.read = settings_nvs_batch_read,
+	.write = settings_nvs_batch_write,
+	.erase = settings_nvs_batch_erase,
+	.item_exists = settings_nvs_batch_item_exists,
+	.item_delete = settings_nvs_batch_item_delete,
+};
+
+static int settings_nvs_save_batch(struct settings_store *cs,
+				   const struct settings_batch_entry *entries,
+				   size_t count)
+{
+	struct settings_nvs *cf = CONTAINER_OF(cs, struct settings_nvs, cf_store);
+
+	/* A single settings item is written at once in its own entries */
+	if (count == 1) {
+		return settings_nvs_save(cs, entries[0].name, entries[0].value,
+					 entries[0].val_len);
+	}
+
+	return settings_batch_store_save(&cf->batch, entries, count);
+}
+#endif /* CONFIG_SETTINGS_SAVE_BATCH */
+
 /* Initialize the nvs backend. */
 int settings_nvs_backend_init(struct settings_nvs *cf)
 {
@@ -378,6 +509,14 @@ int settings_nvs_backend_init(struct settings_nvs *cf)
 		cf->last_name_id = last_name_id;
 	}
 
+#ifdef CONFIG_SETTINGS_SAVE_BATCH
+	cf->batch.itf = &settings_nvs_batch_itf;
+	rc = settings_batch_store_init(&cf->batch);
+	if (rc) {
+		LOG_ERR("Failed to initialize batch records: %d", rc);
+	}
+#endif
+
 	LOG_DBG("Initialized");
 	return 0;
 }
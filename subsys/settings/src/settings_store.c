@@ -284,6 +284,51 @@ int settings_save_subtree(const char *subtree)
 	return rc;
 }
 
+#ifdef CONFIG_SETTINGS_SAVE_BATCH
+int settings_save_batch(const struct settings_batch_entry *entries, size_t count)
+{
+	struct settings_store *cs;
+	int rc = 0;
+
+	cs = settings_save_dst;
+	if (!cs) {
+		return -ENOENT;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		if (!entries[i].name) {
+			return -EINVAL;
+		}
+	}
+
+	settings_lock_take();
+
+	if (cs->cs_itf->csi_save_batch) {
+		rc = cs->cs_itf->csi_save_batch(cs, entries, count);
+	} else {
+		if (cs->cs_itf->csi_save_start) {
+			cs->cs_itf->csi_save_start(cs);
+		}
+
+		for (size_t i = 0; i < count; i++) {
+			rc = cs->cs_itf->csi_save(cs, entries[i].name, (char *)entries[i].value,
+						  entries[i].val_len);
+			if (rc < 0) {
+				break;
+			}
+		}
+
+		if (cs->cs_itf->csi_save_end) {
+			cs->cs_itf->csi_save_end(cs);
+		}
+	}
+
+	settings_lock_release();
+
+	return (rc < 0) ? rc : 0;
+}
+#endif /* CONFIG_SETTINGS_SAVE_BATCH */
+
 int settings_storage_get(void **storage)
 {
 	struct settings_store *cs = settings_save_dst;
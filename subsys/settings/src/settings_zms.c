@@ -37,10 +37,17 @@ static int settings_zms_save(struct settings_store *cs, const char *name, const
 static void *settings_zms_storage_get(struct settings_store *cs);
 static int settings_zms_get_last_hash_ids(struct settings_zms *cf);
 static ssize_t settings_zms_get_val_len(struct settings_store *cs, const char *name);
+#ifdef CONFIG_SETTINGS_SAVE_BATCH
+static int settings_zms_save_batch(struct settings_store *cs,
+				   const struct settings_batch_entry *entries, size_t count);
+#endif
 
 static struct settings_store_itf settings_zms_itf = {.csi_load = settings_zms_load,
 						     .csi_load_one = settings_zms_load_one,
 						     .csi_save = settings_zms_save,
+#ifdef CONFIG_SETTINGS_SAVE_BATCH
+						     .csi_save_batch = settings_zms_save_batch,
+#endif
 						     .csi_storage_get = settings_zms_storage_get,
 						     .csi_get_val_len = settings_zms_get_val_len};
 
@@ -270,7 +277,11 @@ static ssize_t settings_zms_load_one(struct settings_store *cs, const char *name
 		return (rc == buf_len) ? zms_get_data_length(&cf->cf_zms, value_id) : rc;
 	}
 
+#ifdef CONFIG_SETTINGS_SAVE_BATCH
+	return settings_batch_store_find(&cf->batch, name, buf, buf_len);
+#else
 	return 0;
+#endif
 }
 
 /* Gets the next linked list node either from cache (if enabled) or from persistent
@@ -394,13 +405,19 @@ static int settings_zms_load(struct settings_store *cs, const struct settings_lo
 		}
 	}
 
+#ifdef CONFIG_SETTINGS_SAVE_BATCH
+	/* Settings items saved in their own entries after a batch were loaded
+	 * first, the batch records do not override them.
+	 */
+	ret = settings_batch_store_load(&cf->batch, arg);
+#endif
+
 	return ret;
 }
 
-static int settings_zms_save(struct settings_store *cs, const char *name, const char *value,
-			     size_t val_len)
+static int settings_zms_write(struct settings_zms *cf, const char *name, const char *value,
+			      size_t val_len)
 {
-	struct settings_zms *cf = CONTAINER_OF(cs, struct settings_zms, cf_store);
 	struct settings_hash_linked_list settings_element;
 	char rdname[SETTINGS_FULL_NAME_LEN];
 	uint32_t name_hash;
@@ -559,6 +576,100 @@ no_ll_update:
 	return 0;
 }
 
+static int settings_zms_save(struct settings_store *cs, const char *name, const char *value,
+			     size_t val_len)
+{
+	struct settings_zms *cf = CONTAINER_OF(cs, struct settings_zms, cf_store);
+
+#ifdef CONFIG_SETTINGS_SAVE_BATCH
+	if (name && ((value == NULL) || (val_len == 0))) {
+		struct settings_batch_entry entry = {.name = name};
+		ssize_t rc;
+
+		/* A settings item stored in the batch records is deleted by a batch */
+		rc = settings_batch_store_find(&cf->batch, name, NULL, 0);
+		if (rc < 0) {
+			return rc;
+		} else if (rc > 0) {
+			return settings_batch_store_save(&cf->batch, &entry, 1);
+		}
+	}
+#endif
+
+	return settings_zms_write(cf, name, value, val_len);
+}
+
+#ifdef CONFIG_SETTINGS_SAVE_BATCH
+static ssize_t settings_zms_batch_read(struct settings_batch_store *bs, uint16_t slot,
+				       void *buf, size_t len)
+{
+	struct settings_zms *cf = CONTAINER_OF(bs, struct settings_zms, batch);
+	ssize_t rc;
+
+	/* Tell the length of a record larger than buf without reading it */
+	rc = zms_get_data_length(&cf->cf_zms, ZMS_BATCH_RECORD_ID(slot));
+	if ((rc < 0) || ((size_t)rc > len)) {
+		return rc;
+	}
+
+	return zms_read(&cf->cf_zms, ZMS_BATCH_RECORD_ID(slot), buf, rc);
+}
+
+static int settings_zms_batch_write(struct settings_batch_store *bs, uint16_t slot,
+				    const void *buf, size_t len)
+{
+	struct settings_zms *cf = CONTAINER_OF(bs, struct settings_zms, batch);
+	ssize_t rc;
+
+	rc = zms_write(&cf->cf_zms, ZMS_BATCH_RECORD_ID(slot), buf, len);
+
+	return (rc < 0) ? rc : 0;
+}
+
+static int settings_zms_batch_erase(struct settings_batch_store *bs, uint16_t slot)
+{
+	struct settings_zms *cf = CONTAINER_OF(bs, struct settings_zms, batch);
+
+	return zms_delete(&cf->cf_zms, ZMS_BATCH_RECORD_ID(slot));
+}
+
+static bool settings_zms_batch_item_exists(struct settings_batch_store *bs, const char *name)
+{
+	struct settings_zms *cf = CONTAINER_OF(bs, struct settings_zms, batch);
+
+	return settings_zms_find_hash_from_name(cf, name) != 0;
+}
+
+static int settings_zms_batch_item_delete(struct settings_batch_store *bs, const char *name)
+{
+	struct settings_zms *cf = CONTAINER_OF(bs, struct settings_zms, batch);
+
+	return settings_zms_write(cf, name, NULL, 0);
+}
+
+static const struct settings_batch_store_itf settings_zms_batch_itf = {
+	.read = settings_zms_batch_read,
+	.write = settings_zms_batch_write,
+	.erase = settings_zms_batch_erase,
+	.item_exists = settings_zms_batch_item_exists,
+	.item_delete = settings_zms_batch_item_delete,
+};
+
+static int settings_zms_save_batch(struct settings_store *cs,
+				   const struct settings_batch_entry *entries, size_t count)
+{
+	struct settings_zms *cf = CONTAINER_OF(cs, struct settings_zms, cf_store);
+
+	/* A single settings item is written at once in its own entries */
+	if (count == 1) {
+		return settings_zms_save(cs, entries[0].name, entries[0].value,
+					 entries[0].val_len);
+	}
+
+	return settings_batch_store_save(&cf->batch, entries, count);
+}
+#endif /* CONFIG_SETTINGS_SAVE_BATCH */
+
 static ssize_t settings_zms_get_val_len(struct settings_store *cs, const char *name)
 {
 	struct settings_zms *cf = CONTAINER_OF(cs, struct settings_zms, cf_store);
@@ -574,7 +685,11 @@ static ssize_t settings_zms_get_val_len(struct settings_store *cs, const char *n
 		return zms_get_data_length(&cf->cf_zms, ZMS_DATA_ID_FROM_HASH(name_hash));
 	}
 
+#ifdef CONFIG_SETTINGS_SAVE_BATCH
+	return settings_batch_store_find(&cf->batch, name, NULL, 0);
+#else
 	return 0;
+#endif
 }
 
 /* This function inits the linked list head if it doesn't exist or recover it
@@ -677,7 +792,7 @@ static int settings_zms_get_last_hash_ids(struct settings_zms *cf)
 }
 
 /* Initialize the zms backend. */
-static int settings_zms_backend_init(struct settings_zms *cf)
+int settings_zms_backend_init(struct settings_zms *cf)
 {
 	int rc;
 
@@ -695,6 +810,17 @@ static int settings_zms_backend_init(struct settings_zms *cf)
 
 	rc = settings_zms_get_last_hash_ids(cf);
 
+#ifdef CONFIG_SETTINGS_SAVE_BATCH
+	if (rc == 0) {
+		cf->batch.itf = &settings_zms_batch_itf;
+		rc = settings_batch_store_init(&cf->batch);
+		if (rc) {
+			LOG_ERR("Failed to initialize batch records: %d", rc);
+			rc = 0;
+		}
+	}
+#endif
+
 	LOG_DBG("ZMS backend initialized");
 	return rc;
 }
@@ -7,6 +7,7 @@
 #include <zephyr/init.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/net_buf.h>
+#include <zephyr/sys/barrier.h>
 #include <zephyr/sys/check.h>
 #include <zephyr/sys/iterable_sections.h>
 #include <zephyr/sys/printk.h>
@@ -53,6 +54,152 @@ static inline struct net_buf *_zbus_create_net_buf(struct net_buf_pool *pool, si
 
 #endif /* CONFIG_ZBUS_MSG_SUBSCRIBER */
 
+static inline const struct zbus_channel *_zbus_chan_at(int idx)
+{
+	const struct zbus_channel *chan;
+
+	STRUCT_SECTION_GET(zbus_channel, idx, &chan);
+
+	return chan;
+}
+
+#if defined(CONFIG_ZBUS_CHANNEL_NAME)
+/* The linker sorts the channel section by the channel variable names, which
+ * are also the channel names. Name lookups rely on that order and fall back to
+ * a linear scan should a toolchain not provide it.
+ */
+#ifdef CONFIG_ZTEST
+bool zbus_chan_names_unsorted;
+#else
+static bool zbus_chan_names_unsorted;
+#endif
+
+/* Compare channel names the way the linker compares their section names,
+ * which end with an underscore: "chan_10" sorts before "chan_1".
+ */
+static inline int _zbus_chan_name_char(const char *name, size_t len, size_t i)
+{
+	if (i < len) {
+		return (unsigned char)name[i];
+	}
+
+	return (i == len) ? '_' : '\0';
+}
+
+static int _zbus_chan_name_cmp(const char *a, const char *b)
+{
+	size_t len_a = strlen(a);
+	size_t len_b = strlen(b);
+
+	for (size_t i = 0;; i++) {
+		int ca = _zbus_chan_name_char(a, len_a, i);
+		int cb = _zbus_chan_name_char(b, len_b, i);
+
+		if ((ca != cb) || (ca == '\0')) {
+			return ca - cb;
+		}
+	}
+}
+
+static void _zbus_chan_names_check(void)
+{
+	int count;
+
+	STRUCT_SECTION_COUNT(zbus_channel, &count);
+
+	for (int i = 1; i < count; i++) {
+		if (_zbus_chan_name_cmp(_zbus_chan_at(i - 1)->name, _zbus_chan_at(i)->name) > 0) {
+			LOG_WRN("Channel section is not sorted by name, using linear lookups");
+			zbus_chan_names_unsorted = true;
+			return;
+		}
+	}
+}
+#endif /* CONFIG_ZBUS_CHANNEL_NAME */
+
+#if defined(CONFIG_ZBUS_CHANNEL_ID_INDEX)
+/* The channels ordered by ID form a permutation of the section indexes. It is
+ * stored in the id_order field of the mutable data of each channel: the channel
+ * with the n-th smallest ID is at section index _zbus_chan_at(n)->data->id_order.
+ */
+static bool chan_id_index_ready;
+
+static inline const struct zbus_channel *_zbus_chan_by_id_rank(int rank)
+{
+	return _zbus_chan_at(_zbus_chan_at(rank)->data->id_order);
+}
+
+static void _zbus_chan_id_rank_swap(int a, int b)
+{
+	struct zbus_channel_data *data_a = _zbus_chan_at(a)->data;
+	struct zbus_channel_data *data_b = _zbus_chan_at(b)->data;
+	uint16_t tmp = data_a->id_order;
+
+	data_a->id_order = data_b->id_order;
+	data_b->id_order = tmp;
+}
+
+static void _zbus_chan_id_sift_down(int root, int count)
+{
+	int child;
+
+	while ((child = 2 * root + 1) < count) {
+		if ((child + 1 < count) &&
+		    (_zbus_chan_by_id_rank(child)->id < _zbus_chan_by_id_rank(child + 1)->id)) {
+			child++;
+		}
+
+		if (_zbus_chan_by_id_rank(root)->id >= _zbus_chan_by_id_rank(child)->id) {
+			return;
+		}
+
+		_zbus_chan_id_rank_swap(root, child);
+		root = child;
+	}
+}
+
+static void _zbus_chan_id_index_build(void)
+{
+	int count;
+
+	STRUCT_SECTION_COUNT(zbus_channel, &count);
+
+	__ASSERT(count <= UINT16_MAX, "Too many channels for the ID index");
+
+	for (int i = 0; i < count; i++) {
+		_zbus_chan_at(i)->data->id_order = i;
+	}
+
+	/* Heapsort, in place and without recursion */
+	for (int i = count / 2 - 1; i >= 0; i--) {
+		_zbus_chan_id_sift_down(i, count);
+	}
+
+	for (int end = count - 1; end > 0; end--) {
+		_zbus_chan_id_rank_swap(0, end);
+		_zbus_chan_id_sift_down(0, end);
+	}
+
+	/* Duplicated IDs are neighbors now */
+	for (int i = 1; i < count; i++) {
+		const struct zbus_channel *chan = _zbus_chan_by_id_rank(i);
+		const struct zbus_channel *chan_prev = _zbus_chan_by_id_rank(i - 1);
+
+		if ((chan->id != ZBUS_CHAN_ID_INVALID) && (chan->id == chan_prev->id)) {
+#if defined(CONFIG_ZBUS_CHANNEL_NAME)
+			LOG_WRN("Channels %s and %s have matching IDs (%d)", chan->name,
+				chan_prev->name, chan->id);
+#else
+			LOG_WRN("Channels %p and %p have matching IDs (%d)", chan,
+				chan_prev, chan->id);
+#endif /* CONFIG_ZBUS_CHANNEL_NAME */
+		}
+	}
+
+	chan_id_index_ready = true;
+}
+#endif /* CONFIG_ZBUS_CHANNEL_ID_INDEX */
+
 int _zbus_init(void)
 {
 
@@ -76,7 +223,13 @@ int _zbus_init(void)
 		++(curr->data->observers_end_idx);
 	}
 
-#if defined(CONFIG_ZBUS_CHANNEL_ID)
+#if defined(CONFIG_ZBUS_CHANNEL_NAME)
+	_zbus_chan_names_check();
+#endif /* CONFIG_ZBUS_CHANNEL_NAME */
+
+#if defined(CONFIG_ZBUS_CHANNEL_ID_INDEX)
+	_zbus_chan_id_index_build();
+#elif defined(CONFIG_ZBUS_CHANNEL_ID)
 	STRUCT_SECTION_FOREACH(zbus_channel, chan) {
 		/* Check for duplicate channel IDs */
 		if (chan->id == ZBUS_CHAN_ID_INVALID) {
@@ -144,6 +297,35 @@ const struct zbus_channel *zbus_chan_from_id(uint32_t channel_id)
 	if (channel_id == ZBUS_CHAN_ID_INVALID) {
 		return NULL;
 	}
+
+#if defined(CONFIG_ZBUS_CHANNEL_ID_INDEX)
+	if (chan_id_index_ready) {
+		int count;
+		int low = 0;
+		int high;
+
+		STRUCT_SECTION_COUNT(zbus_channel, &count);
+		high = count;
+
+		/* Find the first channel with an ID not below channel_id */
+		while (low < high) {
+			int mid = low + (high - low) / 2;
+
+			if (_zbus_chan_by_id_rank(mid)->id < channel_id) {
+				low = mid + 1;
+			} else {
+				high = mid;
+			}
+		}
+
+		if ((low < count) && (_zbus_chan_by_id_rank(low)->id == channel_id)) {
+			return _zbus_chan_by_id_rank(low);
+		}
+
+		return NULL;
+	}
+#endif /* CONFIG_ZBUS_CHANNEL_ID_INDEX */
+
 	STRUCT_SECTION_FOREACH(zbus_channel, chan) {
 		if (chan->id == channel_id) {
 			/* Found matching channel */
@@ -164,6 +346,29 @@ const struct zbus_channel *zbus_chan_from_name(const char *name)
 		return NULL;
 	}
 
+	if (!zbus_chan_names_unsorted) {
+		int low = 0;
+		int high;
+
+		STRUCT_SECTION_COUNT(zbus_channel, &high);
+
+		while (low < high) {
+			int mid = low + (high - low) / 2;
+			const struct zbus_channel *chan = _zbus_chan_at(mid);
+			int cmp = _zbus_chan_name_cmp(chan->name, name);
+
+			if (cmp == 0) {
+				return chan;
+			} else if (cmp < 0) {
+				low = mid + 1;
+			} else {
+				high = mid;
+			}
+		}
+
+		return NULL;
+	}
+
 	STRUCT_SECTION_FOREACH(zbus_channel, chan) {
 		if (strcmp(chan->name, name) == 0) {
 			/* Found matching channel */
@@ -452,6 +657,95 @@ static inline void chan_unlock(const struct zbus_channel *chan, int prio)
 #endif /* CONFIG_ZBUS_PRIORITY_BOOST */
 }
 
+#if defined(CONFIG_ZBUS_CHANNEL_SEQLOCK)
+
+static inline bool chan_is_seqlock(const struct zbus_channel *chan)
+{
+	return chan->data->seqlock;
+}
+
+/* The writers of a lock-free channel hold the channel semaphore, the sequence counter only
+ * tells the readers that the message is being changed.
+ */
+static inline void chan_write_begin(const struct zbus_channel *chan)
+{
+	if (chan_is_seqlock(chan)) {
+		atomic_inc(&chan->data->seq);
+		barrier_dmem_fence_full();
+	}
+}
+
+static inline void chan_write_end(const struct zbus_channel *chan)
+{
+	if (chan_is_seqlock(chan)) {
+		barrier_dmem_fence_full();
+		atomic_inc(&chan->data->seq);
+	}
+}
+
+static int chan_read_seqlock(const struct zbus_channel *chan, void *msg, k_timeout_t timeout)
+{
+	k_timepoint_t end_time = sys_timepoint_calc(timeout);
+	atomic_val_t seq;
+
+	for (;;) {
+		seq = atomic_get(&chan->data->seq);
+
+		if ((seq & 1) == 0) {
+			memcpy(msg, chan->message, chan->message_size);
+			barrier_dmem_fence_full();
+
+			if (atomic_get(&chan->data->seq) == seq) {
+				return 0;
+			}
+
+			/* A publication overlapped the copy, the message is complete again */
+			continue;
+		}
+
+		if (sys_timepoint_expired(end_time)) {
+			return K_TIMEOUT_EQ(timeout, K_NO_WAIT) ? -EBUSY : -EAGAIN;
+		}
+
+		if (!k_is_in_isr() &&
+		    k_sem_take(&chan->data->sem, sys_timepoint_timeout(end_time)) == 0) {
+			/* The writer may have been preempted, wait for it instead of spinning */
+			k_sem_give(&chan->data->sem);
+		}
+	}
+}
+
+#else
+
+static inline bool chan_is_seqlock(const struct zbus_channel *chan)
+{
+	ARG_UNUSED(chan);
+
+	return false;
+}
+
+static inline void chan_write_begin(const struct zbus_channel *chan)
+{
+	ARG_UNUSED(chan);
+}
+
+static inline void chan_write_end(const struct zbus_channel *chan)
+{
+	ARG_UNUSED(chan);
+}
+
+static inline int chan_read_seqlock(const struct zbus_channel *chan, void *msg,
+				    k_timeout_t timeout)
+{
+	ARG_UNUSED(chan);
+	ARG_UNUSED(msg);
+	ARG_UNUSED(timeout);
+
+	return -ENOTSUP;
+}
+
+#endif /* CONFIG_ZBUS_CHANNEL_SEQLOCK */
+
 int zbus_chan_pub(const struct zbus_channel *chan, const void *msg, k_timeout_t timeout)
 {
 	int err;
@@ -483,7 +777,9 @@ int zbus_chan_pub(const struct zbus_channel *chan, const void *msg, k_timeout_t
 	chan->data->publish_count += 1;
 #endif /* CONFIG_ZBUS_CHANNEL_PUBLISH_STATS */
 
+	chan_write_begin(chan);
 	memcpy(chan->message, msg, chan->message_size);
+	chan_write_end(chan);
 
 	err = _zbus_vded_exec(chan, end_time);
 
@@ -503,6 +799,10 @@ int zbus_chan_read(const struct zbus_channel *chan, void *msg, k_timeout_t timeo
 		timeout = K_NO_WAIT;
 	}
 
+	if (chan_is_seqlock(chan)) {
+		return chan_read_seqlock(chan, msg, timeout);
+	}
+
 	int err = k_sem_take(&chan->data->sem, timeout);
 	if (err) {
 		return err;
@@ -559,6 +859,9 @@ int zbus_chan_claim(const struct zbus_channel *chan, k_timeout_t timeout)
 		return err;
 	}
 
+	/* The claimer may change the message in place */
+	chan_write_begin(chan);
+
 	return 0;
 }
 
@@ -566,6 +869,8 @@ int zbus_chan_finish(const struct zbus_channel *chan)
 {
 	_ZBUS_ASSERT(chan != NULL, "chan is required");
 
+	chan_write_end(chan);
+
 	k_sem_give(&chan->data->sem);
 
 	return 0;
@@ -130,6 +130,11 @@ static void test_thread_entry(void *p1, void *p2, void *p3)
 	}
 
 	pipe_test();
+
+	/* The pipe claim API is only available to supervisor threads */
+	if (!skip_mem_and_mbox) {
+		pipe_zero_copy_test();
+	}
 }
 
 /**
@@ -37,6 +37,8 @@
 #define NR_OF_MAP_RUNS 1000
 #define NR_OF_MBOX_RUNS 128
 #define NR_OF_PIPE_RUNS 256
+/* bytes streamed by the pipe throughput test */
+#define PIPE_STREAM_SIZE (MESSAGE_SIZE_PIPE * NR_OF_PIPE_RUNS)
 #define SEMA_WAIT_TIME (5000)
 
 #ifdef CONFIG_USERSPACE
@@ -81,6 +83,7 @@ extern void message_queue_test(void);
 extern void mutex_test(void);
 extern void memorymap_test(void);
 extern void pipe_test(void);
+extern void pipe_zero_copy_test(void);
 
 /* kernel objects needed for benchmarking */
 extern struct k_mutex DEMO_MUTEX;
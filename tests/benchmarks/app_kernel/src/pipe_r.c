@@ -14,6 +14,8 @@
  */
 int pipeget(struct k_pipe *pipe, enum pipe_options option,
 			int size, int count, unsigned int *time);
+int pipeget_stream(struct k_pipe *pipe, bool zero_copy, size_t size,
+		   unsigned int *time);
 
 /*
  * Function declarations.
@@ -121,3 +123,80 @@ int pipeget(struct k_pipe *pipe, enum pipe_options option, int size, int count,
 
 	return 0;
 }
+
+
+/**
+ * @brief Receive task of the pipes streaming throughput test
+ */
+void pipestreamrecvtask(void)
+{
+	int getsize;
+	unsigned int gettime;
+	int zero_copy;
+	int pipe;
+	struct getinfo getinfo;
+
+	for (getsize = 64; getsize <= MESSAGE_SIZE_PIPE; getsize <<= 2) {
+		for (zero_copy = 0; zero_copy < 2; zero_copy++) {
+			/* only the pipes with a ring buffer */
+			for (pipe = 1; pipe < 3; pipe++) {
+				pipeget_stream(test_pipes[pipe], zero_copy,
+					       getsize, &gettime);
+				getinfo.time = gettime;
+				getinfo.size = getsize;
+				getinfo.count = PIPE_STREAM_SIZE / getsize;
+				/* acknowledge to master */
+				k_msgq_put(&CH_COMM, &getinfo, K_FOREVER);
+			}
+		}
+	}
+}
+
+/**
+ * @brief Stream data out of the pipe and measure time
+ *
+ * @return 0 on success, 1 on error
+ *
+ * @param pipe      Pipe to read data from.
+ * @param zero_copy Use the claim/release API instead of k_pipe_read().
+ * @param size      Data chunk size.
+ * @param time      Total read time in usec.
+ */
+int pipeget_stream(struct k_pipe *pipe, bool zero_copy, size_t size,
+		   unsigned int *time)
+{
+	uint64_t t;
+	timing_t  start;
+	timing_t  end;
+	size_t sizexferd_total = 0;
+	uint8_t *region;
+	int sizexferd;
+
+	/* sync with the sender */
+	k_sem_take(&SEM0, K_FOREVER);
+	start = timing_timestamp_get();
+	while (sizexferd_total < PIPE_STREAM_SIZE) {
+		size_t size2xfer = MIN(size, PIPE_STREAM_SIZE - sizexferd_total);
+
+		if (zero_copy) {
+			sizexferd = k_pipe_read_claim(pipe, &region, size2xfer, K_FOREVER);
+			if (sizexferd > 0) {
+				sizexferd = k_pipe_read_release(pipe, sizexferd);
+			}
+		} else {
+			sizexferd = k_pipe_read(pipe, data_recv, size2xfer, K_FOREVER);
+		}
+
+		if (sizexferd < 0) {
+			return 1;
+		}
+
+		sizexferd_total += sizexferd;
+	}
+
+	end = timing_timestamp_get();
+	t = timing_cycles_get(&start, &end);
+	*time = (unsigned int)(timing_cycles_to_ns(t) / NSEC_PER_USEC);
+
+	return 0;
+}
@@ -0,0 +1,209 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains a benchmark that measures the time taken to decode
+ * a JSON document with json_obj_parse(), from a single buffer, and with
+ * the push parser, fed with the document in chunks.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/data/json.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+#define NAME_SIZE 48
+
+struct record {
+	int id;
+	int value;
+	bool active;
+	const char *name;
+};
+
+struct document {
+	struct record records[CONFIG_BENCHMARK_NUM_RECORDS];
+	size_t num_records;
+};
+
+static const struct json_obj_descr record_descr[] = {
+	JSON_OBJ_DESCR_PRIM(struct record, id, JSON_TOK_NUMBER),
+	JSON_OBJ_DESCR_PRIM(struct record, value, JSON_TOK_NUMBER),
+	JSON_OBJ_DESCR_PRIM(struct record, active, JSON_TOK_TRUE),
+	JSON_OBJ_DESCR_PRIM(struct record, name, JSON_TOK_STRING),
+};
+
+static const struct json_obj_descr document_descr[] = {
+	JSON_OBJ_DESCR_OBJ_ARRAY(struct document, records, CONFIG_BENCHMARK_NUM_RECORDS,
+				 num_records, record_descr, ARRAY_SIZE(record_descr)),
+};
+
+static char names[CONFIG_BENCHMARK_NUM_RECORDS][NAME_SIZE];
+static char encoded[CONFIG_BENCHMARK_NUM_RECORDS * (NAME_SIZE + 64)];
+static char payload[sizeof(encoded)];
+/* Holds the decoded names */
+static char push_buf[CONFIG_BENCHMARK_NUM_RECORDS * NAME_SIZE + 64];
+static struct document doc;
+static uint64_t obj_parse_cycles[CONFIG_BENCHMARK_NUM_ITERATIONS];
+static uint64_t push_parse_cycles[CONFIG_BENCHMARK_NUM_ITERATIONS];
+
+static int document_encode(void)
+{
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_RECORDS; i++) {
+		snprintk(names[i], sizeof(names[i]), "reading %u of the outdoor temperature probe", i);
+
+		doc.records[i].id = i;
+		doc.records[i].value = (int)(i * 7919U) - 100000;
+		doc.records[i].active = (i % 3) != 0;
+		doc.records[i].name = names[i];
+	}
+
+	doc.num_records = CONFIG_BENCHMARK_NUM_RECORDS;
+
+	return json_obj_encode_buf(document_descr, ARRAY_SIZE(document_descr), &doc, encoded,
+				   sizeof(encoded));
+}
+
+static int64_t push_parse(size_t len)
+{
+	struct json_push_parser parser;
+	int ret;
+
+	ret = json_push_parser_init(&parser, document_descr, ARRAY_SIZE(document_descr), &doc,
+				    push_buf, sizeof(push_buf));
+	if (ret < 0) {
+		return ret;
+	}
+
+	for (size_t pos = 0; pos < len; pos += CONFIG_BENCHMARK_CHUNK_SIZE) {
+		ret = json_push_parser_feed(&parser, encoded + pos,
+					    MIN(CONFIG_BENCHMARK_CHUNK_SIZE, len - pos));
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return json_push_parser_finish(&parser);
+}
+
+static bool document_check(void)
+{
+	if (doc.num_records != CONFIG_BENCHMARK_NUM_RECORDS) {
+		return false;
+	}
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_RECORDS; i++) {
+		if (doc.records[i].id != (int)i || strcmp(doc.records[i].name, names[i]) != 0) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static int compare(const void *a, const void *b)
+{
+	uint64_t x = *(const uint64_t *)a;
+	uint64_t y = *(const uint64_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+static void report(const char *tag, const char *str, uint64_t cycles, size_t len)
+{
+	uint64_t ns = timing_cycles_to_ns(cycles);
+	uint32_t kib_per_s = (ns > 0) ? (uint32_t)((uint64_t)len * NSEC_PER_SEC / 1024U / ns) : 0;
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	ARG_UNUSED(kib_per_s);
+
+	printk("REC: %s - %s : %7llu cycles , %7u ns :\n", tag, str, cycles, (uint32_t)ns);
+#else
+	ARG_UNUSED(tag);
+
+	printk("    %-16s: %7llu cycles (%7u nsec, %6u KiB/s)\n", str, cycles, (uint32_t)ns,
+	       kib_per_s);
+#endif
+}
+
+int main(void)
+{
+	timing_t start;
+	timing_t finish;
+	int64_t ret;
+	size_t len;
+
+	if (document_encode() < 0) {
+		printk("JSON encoding failed\n");
+		TC_END_REPORT(TC_FAIL);
+		return 0;
+	}
+
+	len = strlen(encoded);
+
+	timing_init();
+
+	printk("Time Measurements for JSON parsing of %u records (%zu bytes)\n",
+	       CONFIG_BENCHMARK_NUM_RECORDS, len);
+	printk("Push parser fed in chunks of %u bytes\n", CONFIG_BENCHMARK_CHUNK_SIZE);
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		/* json_obj_parse() modifies the payload in place */
+		memcpy(payload, encoded, len);
+		memset(&doc, 0, sizeof(doc));
+
+		start = timing_counter_get();
+		ret = json_obj_parse(payload, len, document_descr, ARRAY_SIZE(document_descr),
+				     &doc);
+		finish = timing_counter_get();
+
+		if (ret != BIT(0) || !document_check()) {
+			printk("json_obj_parse failed: %lld\n", ret);
+			TC_END_REPORT(TC_FAIL);
+			return 0;
+		}
+
+		obj_parse_cycles[i] = timing_cycles_get(&start, &finish);
+
+		memset(&doc, 0, sizeof(doc));
+
+		start = timing_counter_get();
+		ret = push_parse(len);
+		finish = timing_counter_get();
+
+		if (ret != BIT(0) || !document_check()) {
+			printk("JSON push parsing failed: %lld\n", ret);
+			TC_END_REPORT(TC_FAIL);
+			return 0;
+		}
+
+		push_parse_cycles[i] = timing_cycles_get(&start, &finish);
+	}
+
+	timing_stop();
+
+	qsort(obj_parse_cycles, ARRAY_SIZE(obj_parse_cycles), sizeof(obj_parse_cycles[0]),
+	      compare);
+	qsort(push_parse_cycles, ARRAY_SIZE(push_parse_cycles), sizeof(push_parse_cycles[0]),
+	      compare);
+
+	printk("------------------------------------\n");
+	printk("Median parsing time\n");
+	report("json.obj_parse", "json_obj_parse",
+	       obj_parse_cycles[ARRAY_SIZE(obj_parse_cycles) / 2], len);
+	report("json.push_parse", "Push parser",
+	       push_parse_cycles[ARRAY_SIZE(push_parse_cycles) / 2], len);
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
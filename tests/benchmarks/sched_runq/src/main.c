@@ -0,0 +1,128 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains a benchmark that measures the rescheduling
+ * throughput of an SMP system: pairs of threads pass semaphores back and
+ * forth on all the CPUs for a fixed time, and the round trips are counted.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+#define NUM_THREADS   (2 * CONFIG_BENCHMARK_NUM_PAIRS)
+#define STACK_SIZE    (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define WORKER_PRIO   K_PRIO_PREEMPT(5)
+
+K_THREAD_STACK_ARRAY_DEFINE(stacks, NUM_THREADS, STACK_SIZE);
+static struct k_thread threads[NUM_THREADS];
+
+static struct k_sem ping[CONFIG_BENCHMARK_NUM_PAIRS];
+static struct k_sem pong[CONFIG_BENCHMARK_NUM_PAIRS];
+static atomic_t round_trips[CONFIG_BENCHMARK_NUM_PAIRS];
+
+static void initiator(void *p1, void *p2, void *p3)
+{
+	unsigned int pair = POINTER_TO_UINT(p1);
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		k_sem_give(&ping[pair]);
+		k_sem_take(&pong[pair], K_FOREVER);
+		atomic_inc(&round_trips[pair]);
+	}
+}
+
+static void responder(void *p1, void *p2, void *p3)
+{
+	unsigned int pair = POINTER_TO_UINT(p1);
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		k_sem_take(&ping[pair], K_FOREVER);
+		k_sem_give(&pong[pair]);
+	}
+}
+
+static void report(const char *tag, const char *str, uint64_t cycles)
+{
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s - %s : %7llu cycles , %7u ns :\n", tag, str, cycles,
+	       (uint32_t)timing_cycles_to_ns(cycles));
+#else
+	ARG_UNUSED(tag);
+
+	printk("    %-12s: %7llu cycles (%7u nsec)\n", str, cycles,
+	       (uint32_t)timing_cycles_to_ns(cycles));
+#endif
+}
+
+int main(void)
+{
+	uint64_t total = 0;
+	uint64_t cycles;
+	timing_t start;
+	timing_t finish;
+
+	timing_init();
+
+	printk("Time Measurements for %s run queues\n",
+	       IS_ENABLED(CONFIG_SCHED_CPU_RUNQ) ? "per-CPU" : "shared");
+	printk("%u CPUs, %u thread pairs, %u ms\n", arch_num_cpus(),
+	       CONFIG_BENCHMARK_NUM_PAIRS, CONFIG_BENCHMARK_DURATION_MS);
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_PAIRS; i++) {
+		k_sem_init(&ping[i], 0, 1);
+		k_sem_init(&pong[i], 0, 1);
+	}
+
+	timing_start();
+	start = timing_counter_get();
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_PAIRS; i++) {
+		k_thread_create(&threads[2 * i], stacks[2 * i], STACK_SIZE, responder,
+				UINT_TO_POINTER(i), NULL, NULL, WORKER_PRIO, 0, K_NO_WAIT);
+		k_thread_create(&threads[2 * i + 1], stacks[2 * i + 1], STACK_SIZE, initiator,
+				UINT_TO_POINTER(i), NULL, NULL, WORKER_PRIO, 0, K_NO_WAIT);
+	}
+
+	k_msleep(CONFIG_BENCHMARK_DURATION_MS);
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_PAIRS; i++) {
+		total += atomic_get(&round_trips[i]);
+	}
+
+	finish = timing_counter_get();
+
+	for (unsigned int i = 0; i < NUM_THREADS; i++) {
+		k_thread_abort(&threads[i]);
+	}
+
+	timing_stop();
+
+	if (total == 0) {
+		printk("No round trip completed\n");
+		TC_END_REPORT(TC_FAIL);
+		return 0;
+	}
+
+	cycles = timing_cycles_get(&start, &finish);
+
+	printk("------------------------------------\n");
+	printk("Semaphore round trips: %llu\n", total);
+	report("sched_runq.round_trip", "Round trip", cycles / total);
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
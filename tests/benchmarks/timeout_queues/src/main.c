@@ -0,0 +1,154 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that measure the time required to add and
+ * abort a timeout while the timeout queue already holds a varying number
+ * of armed timeouts. The timeouts are raw kernel timeouts, which keeps
+ * thread, timer and work queue overhead out of the measurements. Their
+ * delays are far larger than the benchmark duration so none of them
+ * expires while it runs.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <timeout_q.h>
+
+#define BASE_DELAY_TICKS 100000U
+
+static struct _timeout armed[CONFIG_BENCHMARK_MAX_TIMEOUTS];
+static struct _timeout probe;
+
+static uint32_t prng_state = 12345U;
+
+static uint32_t prng(void)
+{
+	/* Numerical Recipes LCG, good enough to scatter the delays */
+	prng_state = (prng_state * 1664525U) + 1013904223U;
+
+	return prng_state >> 8;
+}
+
+static void dummy_fn(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+
+	printk("Timeout %p unexpectedly expired\n", t);
+}
+
+static void arm_timeouts(unsigned int from, unsigned int to)
+{
+	for (unsigned int i = from; i < to; i++) {
+		z_init_timeout(&armed[i]);
+		z_add_timeout(&armed[i], dummy_fn,
+			      K_TICKS(BASE_DELAY_TICKS + (prng() % (16U * BASE_DELAY_TICKS))));
+	}
+}
+
+static void abort_timeouts(unsigned int num_timeouts)
+{
+	for (unsigned int i = 0; i < num_timeouts; i++) {
+		z_abort_timeout(&armed[i]);
+	}
+}
+
+static void report(const char *tag, const char *str, uint64_t minimum,
+		   uint64_t maximum, uint64_t total)
+{
+	uint64_t average = total / CONFIG_BENCHMARK_NUM_ITERATIONS;
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s.min - %s, min. : %7llu cycles , %7u ns :\n", tag, str,
+	       minimum, (uint32_t)timing_cycles_to_ns(minimum));
+	printk("REC: %s.max - %s, max. : %7llu cycles , %7u ns :\n", tag, str,
+	       maximum, (uint32_t)timing_cycles_to_ns(maximum));
+	printk("REC: %s.avg - %s, avg. : %7llu cycles , %7u ns :\n", tag, str,
+	       average, (uint32_t)timing_cycles_to_ns(average));
+#else
+	ARG_UNUSED(tag);
+
+	printk("------------------------------------\n");
+	printk("%s\n", str);
+
+	printk("    Minimum : %7llu cycles (%7u nsec)\n", minimum,
+	       (uint32_t)timing_cycles_to_ns(minimum));
+	printk("    Maximum : %7llu cycles (%7u nsec)\n", maximum,
+	       (uint32_t)timing_cycles_to_ns(maximum));
+	printk("    Average : %7llu cycles (%7u nsec)\n", average,
+	       (uint32_t)timing_cycles_to_ns(average));
+#endif
+}
+
+static void measure(unsigned int num_timeouts)
+{
+	uint64_t add_min = UINT64_MAX, add_max = 0, add_total = 0;
+	uint64_t abort_min = UINT64_MAX, abort_max = 0, abort_total = 0;
+	timing_t start;
+	timing_t finish;
+	uint64_t cycles;
+	char tag[50];
+	char str[80];
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		k_timeout_t delay = K_TICKS(BASE_DELAY_TICKS + (prng() % (16U * BASE_DELAY_TICKS)));
+
+		z_init_timeout(&probe);
+
+		start = timing_counter_get();
+		z_add_timeout(&probe, dummy_fn, delay);
+		finish = timing_counter_get();
+		cycles = timing_cycles_get(&start, &finish);
+		add_min = MIN(add_min, cycles);
+		add_max = MAX(add_max, cycles);
+		add_total += cycles;
+
+		start = timing_counter_get();
+		z_abort_timeout(&probe);
+		finish = timing_counter_get();
+		cycles = timing_cycles_get(&start, &finish);
+		abort_min = MIN(abort_min, cycles);
+		abort_max = MAX(abort_max, cycles);
+		abort_total += cycles;
+	}
+
+	snprintk(tag, sizeof(tag), "timeout.add.%05u.armed", num_timeouts);
+	snprintk(str, sizeof(str), "Add timeout with %u armed timeouts", num_timeouts);
+	report(tag, str, add_min, add_max, add_total);
+
+	snprintk(tag, sizeof(tag), "timeout.abort.%05u.armed", num_timeouts);
+	snprintk(str, sizeof(str), "Abort timeout with %u armed timeouts", num_timeouts);
+	report(tag, str, abort_min, abort_max, abort_total);
+}
+
+int main(void)
+{
+	unsigned int armed_count = 0;
+
+	timing_init();
+
+	printk("Time Measurements for %s timeout queue\n",
+	       IS_ENABLED(CONFIG_TIMEOUT_QUEUE_WHEEL) ? "timing wheel" : "delta list");
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	for (unsigned int n = 10; n <= CONFIG_BENCHMARK_MAX_TIMEOUTS; n *= 10) {
+		arm_timeouts(armed_count, n);
+		armed_count = n;
+
+		measure(n);
+	}
+
+	abort_timeouts(armed_count);
+
+	timing_stop();
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
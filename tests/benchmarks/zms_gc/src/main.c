@@ -0,0 +1,179 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains a benchmark that measures the latency of ZMS writes
+ * while the storage partition is filled and garbage collected several
+ * times over. With CONFIG_ZMS_GC_INCREMENTAL, the garbage collection
+ * started by a write is run by a low priority work item, between the
+ * writes.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/fs/zms.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+#define STORAGE_ID FIXED_PARTITION_ID(storage_partition)
+
+static struct zms_fs fs;
+static uint64_t latencies[CONFIG_BENCHMARK_NUM_WRITES];
+
+#ifdef CONFIG_ZMS_GC_INCREMENTAL
+#define GC_STACK_SIZE 1024
+#define GC_PRIORITY   K_LOWEST_APPLICATION_THREAD_PRIO
+
+K_THREAD_STACK_DEFINE(gc_stack, GC_STACK_SIZE);
+static struct k_work_q gc_work_q;
+static struct k_work gc_work;
+static unsigned int gc_steps;
+
+static void gc_handler(struct k_work *work)
+{
+	int rc = zms_gc_step(&fs, CONFIG_BENCHMARK_GC_STEP_US);
+
+	gc_steps++;
+
+	if (rc > 0) {
+		/* Let the writes through the lock before the next slice */
+		k_work_submit_to_queue(&gc_work_q, work);
+	} else if (rc < 0) {
+		printk("zms_gc_step failed: %d\n", rc);
+	}
+}
+#endif /* CONFIG_ZMS_GC_INCREMENTAL */
+
+static int storage_init(void)
+{
+	const struct flash_area *fa;
+	struct flash_pages_info info;
+	int rc;
+
+	rc = flash_area_open(STORAGE_ID, &fa);
+	if (rc) {
+		return rc;
+	}
+
+	fs.flash_device = flash_area_get_device(fa);
+	fs.offset = fa->fa_off;
+	rc = flash_get_page_info_by_offs(fs.flash_device, fs.offset, &info);
+	if (rc) {
+		return rc;
+	}
+
+	fs.sector_size = info.size;
+	fs.sector_count = fa->fa_size / info.size;
+
+	rc = zms_mount(&fs);
+	if (rc) {
+		return rc;
+	}
+
+	/* Start from an empty storage */
+	rc = zms_clear(&fs);
+	if (rc) {
+		return rc;
+	}
+
+	return zms_mount(&fs);
+}
+
+static int compare(const void *a, const void *b)
+{
+	uint64_t x = *(const uint64_t *)a;
+	uint64_t y = *(const uint64_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+static void report(const char *tag, const char *str, uint64_t cycles)
+{
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s - %s : %7llu cycles , %7u ns :\n", tag, str, cycles,
+	       (uint32_t)timing_cycles_to_ns(cycles));
+#else
+	ARG_UNUSED(tag);
+
+	printk("    %-12s: %7llu cycles (%7u nsec)\n", str, cycles,
+	       (uint32_t)timing_cycles_to_ns(cycles));
+#endif
+}
+
+int main(void)
+{
+	uint8_t data[CONFIG_BENCHMARK_DATA_SIZE];
+	timing_t start;
+	timing_t finish;
+	ssize_t len;
+	int rc;
+
+	rc = storage_init();
+	if (rc) {
+		printk("ZMS initialization failed: %d\n", rc);
+		TC_END_REPORT(TC_FAIL);
+		return 0;
+	}
+
+#ifdef CONFIG_ZMS_GC_INCREMENTAL
+	k_work_queue_start(&gc_work_q, gc_stack, K_THREAD_STACK_SIZEOF(gc_stack), GC_PRIORITY,
+			   NULL);
+	k_work_init(&gc_work, gc_handler);
+#endif
+
+	timing_init();
+
+	printk("Time Measurements for ZMS writes with %s garbage collection\n",
+	       IS_ENABLED(CONFIG_ZMS_GC_INCREMENTAL) ? "incremental" : "synchronous");
+	printk("%u sectors of %u bytes, %u IDs, %u bytes of data\n", fs.sector_count,
+	       fs.sector_size, CONFIG_BENCHMARK_NUM_IDS, CONFIG_BENCHMARK_DATA_SIZE);
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_WRITES; i++) {
+		memset(data, (uint8_t)i, sizeof(data));
+
+		start = timing_counter_get();
+		len = zms_write(&fs, i % CONFIG_BENCHMARK_NUM_IDS, data, sizeof(data));
+		finish = timing_counter_get();
+
+		if (len != sizeof(data)) {
+			printk("zms_write failed: %d\n", (int)len);
+			TC_END_REPORT(TC_FAIL);
+			return 0;
+		}
+
+		latencies[i] = timing_cycles_get(&start, &finish);
+
+#ifdef CONFIG_ZMS_GC_INCREMENTAL
+		k_work_submit_to_queue(&gc_work_q, &gc_work);
+#endif
+		k_msleep(CONFIG_BENCHMARK_WRITE_PERIOD_MS);
+	}
+
+	timing_stop();
+
+	qsort(latencies, ARRAY_SIZE(latencies), sizeof(latencies[0]), compare);
+
+	printk("------------------------------------\n");
+	printk("zms_write() latency\n");
+	report("zms.write.p50", "Median", latencies[ARRAY_SIZE(latencies) / 2]);
+	report("zms.write.p99", "99th perc.", latencies[ARRAY_SIZE(latencies) * 99 / 100]);
+	report("zms.write.max", "Maximum", latencies[ARRAY_SIZE(latencies) - 1]);
+
+#ifdef CONFIG_ZMS_GC_INCREMENTAL
+	printk("Garbage collection steps: %u\n", gc_steps);
+#endif
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
@@ -338,3 +338,153 @@ ZTEST(mslab_api, test_mslab_pending)
 	/* Free memory block */
 	k_mem_slab_free(&kmslab, b);
 }
+
+/**
+ * @brief Verify the per-CPU caches of a memory slab
+ *
+ * @details Allocate a block from an empty per-CPU cache, free it and
+ * allocate it again, then check the number of used blocks and the cache
+ * hits and misses reported by the object core statistics.
+ *
+ * @ingroup kernel_memory_slab_tests
+ */
+ZTEST(mslab_api, test_mslab_percpu_cache)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_MEM_SLAB_PERCPU_CACHE);
+	Z_TEST_SKIP_IFNDEF(CONFIG_OBJ_CORE_STATS_MEM_SLAB);
+
+#if defined(CONFIG_MEM_SLAB_PERCPU_CACHE) && defined(CONFIG_OBJ_CORE_STATS_MEM_SLAB)
+	struct k_mem_slab_info before;
+	struct k_mem_slab_info after;
+	void *b;
+
+	k_mem_slab_init(&mslab, tslab, BLK_SIZE, BLK_NUM);
+
+	zassert_ok(k_obj_core_stats_raw(K_OBJ_CORE(&mslab), &before, sizeof(before)));
+
+	/* The empty cache is refilled from the slab */
+	zassert_ok(k_mem_slab_alloc(&mslab, &b, K_NO_WAIT));
+	zassert_equal(k_mem_slab_num_used_get(&mslab), 1);
+	zassert_equal(k_mem_slab_num_free_get(&mslab), BLK_NUM - 1);
+	k_mem_slab_free(&mslab, b);
+
+	/* The freed block is taken back from the cache */
+	zassert_ok(k_mem_slab_alloc(&mslab, &b, K_NO_WAIT));
+	k_mem_slab_free(&mslab, b);
+
+	zassert_ok(k_obj_core_stats_raw(K_OBJ_CORE(&mslab), &after, sizeof(after)));
+	zassert_equal(after.num_used, 0);
+	zassert_equal(after.cache_misses - before.cache_misses, 1);
+	zassert_equal(after.cache_hits - before.cache_hits, 1);
+
+	/* All the blocks remain available, whatever the cache holds */
+	tmslab_alloc_free(&mslab);
+#endif
+}
+
+#if defined(CONFIG_MEM_SLAB_PERCPU_CACHE) && defined(CONFIG_SCHED_CPU_MASK)
+static K_THREAD_STACK_ARRAY_DEFINE(cpu_stacks, 2, STACKSIZE);
+static struct k_thread cpu_threads[2];
+static void *cpu_blocks[BLK_NUM];
+
+static void cpu_alloc_all(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < BLK_NUM; i++) {
+		zassert_ok(k_mem_slab_alloc(&mslab, &cpu_blocks[i], K_NO_WAIT));
+	}
+}
+
+static void cpu_free_all(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < BLK_NUM; i++) {
+		k_mem_slab_free(&mslab, cpu_blocks[i]);
+	}
+}
+
+static void cpu_alloc_wait(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	zassert_ok(k_mem_slab_alloc(&mslab, p1, K_FOREVER));
+}
+
+static void cpu_free_one(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_mem_slab_free(&mslab, p1);
+}
+
+static void run_on_cpu(int cpu, k_thread_entry_t entry, void *p1)
+{
+	k_thread_create(&cpu_threads[cpu], cpu_stacks[cpu], STACKSIZE, entry, p1, NULL, NULL,
+			K_PRIO_PREEMPT(7), 0, K_FOREVER);
+	zassert_ok(k_thread_cpu_pin(&cpu_threads[cpu], cpu));
+	k_thread_start(&cpu_threads[cpu]);
+}
+#endif
+
+/**
+ * @brief Verify the per-CPU caches of a memory slab across CPUs
+ *
+ * @details Free all the blocks on CPU 1 and check that CPU 0 takes them
+ * back from the cache of CPU 1. Then make a thread on CPU 0 wait for a
+ * block and check that the block freed on CPU 1 is handed over to it.
+ *
+ * @ingroup kernel_memory_slab_tests
+ */
+ZTEST(mslab_api, test_mslab_percpu_cache_smp)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_MEM_SLAB_PERCPU_CACHE);
+	Z_TEST_SKIP_IFNDEF(CONFIG_SCHED_CPU_MASK);
+
+	if (arch_num_cpus() < 2) {
+		ztest_test_skip();
+	}
+
+#if defined(CONFIG_MEM_SLAB_PERCPU_CACHE) && defined(CONFIG_SCHED_CPU_MASK)
+	void *b = NULL;
+
+	k_mem_slab_init(&mslab, tslab, BLK_SIZE, BLK_NUM);
+
+	/* The blocks freed on CPU 1 stay in its cache */
+	run_on_cpu(1, cpu_alloc_all, NULL);
+	k_thread_join(&cpu_threads[1], K_FOREVER);
+	run_on_cpu(1, cpu_free_all, NULL);
+	k_thread_join(&cpu_threads[1], K_FOREVER);
+	zassert_equal(mslab.cpu_cache[1].count, BLK_NUM);
+	zassert_equal(k_mem_slab_num_used_get(&mslab), 0);
+
+	/* CPU 0 takes them back from the cache of CPU 1 */
+	run_on_cpu(0, cpu_alloc_all, NULL);
+	k_thread_join(&cpu_threads[0], K_FOREVER);
+	zassert_equal(mslab.cpu_cache[1].count, 0);
+	zassert_equal(k_mem_slab_num_used_get(&mslab), BLK_NUM);
+
+	/* A thread waiting on CPU 0 gets the block freed on CPU 1 */
+	run_on_cpu(0, cpu_alloc_wait, &b);
+	k_msleep(10);
+	zassert_equal(atomic_get(&mslab.cache_waiters), 1);
+	run_on_cpu(1, cpu_free_one, cpu_blocks[0]);
+	k_thread_join(&cpu_threads[1], K_FOREVER);
+	zassert_ok(k_thread_join(&cpu_threads[0], K_MSEC(TIMEOUT)));
+	zassert_equal(b, cpu_blocks[0]);
+	zassert_equal(mslab.cpu_cache[1].count, 0);
+	zassert_equal(k_mem_slab_num_used_get(&mslab), BLK_NUM);
+
+	cpu_blocks[0] = b;
+	run_on_cpu(0, cpu_free_all, NULL);
+	k_thread_join(&cpu_threads[0], K_FOREVER);
+	zassert_equal(k_mem_slab_num_used_get(&mslab), 0);
+#endif
+}
@@ -0,0 +1,182 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_msgq.h"
+
+#define MANY_LEN 8
+
+K_THREAD_STACK_DECLARE(tstack, STACK_SIZE);
+extern struct k_thread tdata;
+extern k_tid_t tids[2];
+extern struct k_msgq msgq;
+static ZTEST_BMEM char __aligned(4) tbuffer[MSG_SIZE * MANY_LEN];
+static ZTEST_DMEM uint32_t send_buf[MANY_LEN * 2];
+static ZTEST_BMEM uint32_t rec_buf[MANY_LEN * 2];
+
+static void fill_send_buf(void)
+{
+	for (int i = 0; i < ARRAY_SIZE(send_buf); i++) {
+		send_buf[i] = MSG0 + i;
+	}
+}
+
+static void put_many_entry(void *p1, void *p2, void *p3)
+{
+	int ret = k_msgq_put_many((struct k_msgq *)p1, send_buf, 3, K_FOREVER);
+
+	zassert_equal(ret, 3, "k_msgq_put_many() returned %d", ret);
+}
+
+static void get_many_entry(void *p1, void *p2, void *p3)
+{
+	int ret = k_msgq_get_many((struct k_msgq *)p1, rec_buf, MANY_LEN, K_FOREVER);
+
+	zassert_equal(ret, MANY_LEN, "k_msgq_get_many() returned %d", ret);
+}
+
+static void put_get_many(struct k_msgq *q)
+{
+	int ret;
+
+	fill_send_buf();
+
+	zassert_equal(k_msgq_put_many(q, send_buf, 0, K_NO_WAIT), 0);
+	zassert_equal(k_msgq_get_many(q, rec_buf, MANY_LEN, K_NO_WAIT), -ENOMSG);
+
+	/* only the free space is filled */
+	ret = k_msgq_put_many(q, send_buf, MANY_LEN + 2, K_NO_WAIT);
+	zassert_equal(ret, MANY_LEN);
+	zassert_equal(k_msgq_num_used_get(q), MANY_LEN);
+	zassert_equal(k_msgq_put_many(q, send_buf, 1, K_NO_WAIT), -ENOMSG);
+
+	ret = k_msgq_get_many(q, rec_buf, 5, K_NO_WAIT);
+	zassert_equal(ret, 5);
+	zassert_mem_equal(rec_buf, send_buf, 5 * MSG_SIZE);
+
+	/* the next batch wraps around the end of the buffer */
+	ret = k_msgq_put_many(q, &send_buf[MANY_LEN], 5, K_NO_WAIT);
+	zassert_equal(ret, 5);
+
+	ret = k_msgq_get_many(q, rec_buf, ARRAY_SIZE(rec_buf), K_NO_WAIT);
+	zassert_equal(ret, MANY_LEN);
+	zassert_mem_equal(rec_buf, &send_buf[5], MANY_LEN * MSG_SIZE);
+	zassert_equal(k_msgq_num_used_get(q), 0);
+
+	/* single and batch operations interleave in order */
+	zassert_equal(k_msgq_put(q, &send_buf[0], K_NO_WAIT), 0);
+	zassert_equal(k_msgq_put_many(q, &send_buf[1], 2, K_NO_WAIT), 2);
+	zassert_equal(k_msgq_get(q, &rec_buf[0], K_NO_WAIT), 0);
+	zassert_equal(k_msgq_get_many(q, &rec_buf[1], 4, K_NO_WAIT), 2);
+	zassert_mem_equal(rec_buf, send_buf, 3 * MSG_SIZE);
+}
+
+static void get_many_pending(struct k_msgq *q, uint32_t options)
+{
+	int ret;
+
+	fill_send_buf();
+
+	/* a waiting reader gets the first message, then the queued ones */
+	tids[0] = k_thread_create(&tdata, tstack, STACK_SIZE,
+				  get_many_entry, q, NULL, NULL,
+				  K_PRIO_PREEMPT(0), options, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+
+	ret = k_msgq_put_many(q, &send_buf[1], MANY_LEN, K_NO_WAIT);
+	zassert_equal(ret, MANY_LEN);
+	k_thread_join(tids[0], K_FOREVER);
+	tids[0] = NULL;
+
+	zassert_mem_equal(rec_buf, &send_buf[1], MANY_LEN * MSG_SIZE);
+	zassert_equal(k_msgq_num_used_get(q), 0);
+}
+
+static void put_many_pending(struct k_msgq *q, uint32_t options)
+{
+	uint32_t out[MANY_LEN];
+	int ret;
+
+	fill_send_buf();
+
+	zassert_equal(k_msgq_put_many(q, &send_buf[MANY_LEN], MANY_LEN, K_NO_WAIT), MANY_LEN);
+
+	/* a waiting writer queues its first message, then the others */
+	tids[0] = k_thread_create(&tdata, tstack, STACK_SIZE,
+				  put_many_entry, q, NULL, NULL,
+				  K_PRIO_PREEMPT(0), options, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+
+	ret = k_msgq_get_many(q, out, 4, K_NO_WAIT);
+	zassert_equal(ret, 4);
+	zassert_mem_equal(out, &send_buf[MANY_LEN], 4 * MSG_SIZE);
+	k_thread_join(tids[0], K_FOREVER);
+	tids[0] = NULL;
+
+	ret = k_msgq_get_many(q, out, MANY_LEN, K_NO_WAIT);
+	zassert_equal(ret, 7);
+	zassert_mem_equal(out, &send_buf[MANY_LEN + 4], 4 * MSG_SIZE);
+	zassert_mem_equal(&out[4], send_buf, 3 * MSG_SIZE);
+}
+
+/**
+ * @addtogroup kernel_message_queue_tests
+ * @{
+ */
+
+/**
+ * @brief Test batch put and get on a message queue
+ * @see k_msgq_put_many(), k_msgq_get_many()
+ */
+ZTEST(msgq_api, test_msgq_put_get_many)
+{
+	k_msgq_init(&msgq, tbuffer, MSG_SIZE, MANY_LEN);
+
+	put_get_many(&msgq);
+}
+
+/**
+ * @brief Test batch get waiting for a message
+ * @see k_msgq_put_many(), k_msgq_get_many()
+ */
+ZTEST(msgq_api_1cpu, test_msgq_get_many_pending)
+{
+	k_msgq_init(&msgq, tbuffer, MSG_SIZE, MANY_LEN);
+
+	get_many_pending(&msgq, 0);
+}
+
+/**
+ * @brief Test batch put waiting for free space
+ * @see k_msgq_put_many(), k_msgq_get_many()
+ */
+ZTEST(msgq_api_1cpu, test_msgq_put_many_pending)
+{
+	k_msgq_init(&msgq, tbuffer, MSG_SIZE, MANY_LEN);
+
+	put_many_pending(&msgq, 0);
+}
+
+#ifdef CONFIG_USERSPACE
+/**
+ * @brief Test batch put and get on a message queue from user mode
+ * @see k_msgq_put_many(), k_msgq_get_many()
+ */
+ZTEST_USER(msgq_api, test_msgq_user_put_get_many)
+{
+	struct k_msgq *q;
+
+	q = k_object_alloc(K_OBJ_MSGQ);
+	zassert_not_null(q, "couldn't alloc message queue");
+	zassert_false(k_msgq_alloc_init(q, MSG_SIZE, MANY_LEN));
+
+	put_get_many(q);
+	get_many_pending(q, K_USER | K_INHERIT_PERMS);
+}
+#endif
+
+/**
+ * @}
+ */
@@ -0,0 +1,266 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdint.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/random/random.h>
+
+ZTEST_SUITE(k_pipe_claim, NULL, NULL, NULL, NULL, NULL);
+
+#define DUMMY_DATA_SIZE 16
+static struct k_thread thread;
+static K_THREAD_STACK_DEFINE(stack, 1024 + CONFIG_TEST_EXTRA_STACK_SIZE);
+static struct k_pipe pipe;
+
+static void thread_write(void *arg1, void *arg2, void *arg3)
+{
+	uint8_t garbage[DUMMY_DATA_SIZE] = {};
+
+	zassert_true(k_pipe_write((struct k_pipe *)arg1, garbage, sizeof(garbage),
+		K_MSEC(1000)) == sizeof(garbage), "Failed to write to pipe");
+}
+
+static void thread_read_release(void *arg1, void *arg2, void *arg3)
+{
+	uint8_t *region;
+
+	zassert_true(k_pipe_read_claim((struct k_pipe *)arg1, &region, DUMMY_DATA_SIZE,
+		K_MSEC(1000)) == DUMMY_DATA_SIZE, "Failed to claim data");
+	zassert_true(k_pipe_read_release((struct k_pipe *)arg1, DUMMY_DATA_SIZE) ==
+		DUMMY_DATA_SIZE, "Failed to release data");
+}
+
+static uint8_t thread_res[4];
+
+static void thread_read(void *arg1, void *arg2, void *arg3)
+{
+	zassert_true(k_pipe_read((struct k_pipe *)arg1, thread_res, sizeof(thread_res),
+		K_MSEC(1000)) == sizeof(thread_res), "Failed to read from pipe");
+}
+
+ZTEST(k_pipe_claim, test_write_claim_commit)
+{
+	uint8_t buffer[DUMMY_DATA_SIZE];
+	uint8_t input[8];
+	uint8_t res[8];
+	uint8_t *region;
+
+	sys_rand_get(input, sizeof(input));
+	k_pipe_init(&pipe, buffer, sizeof(buffer));
+
+	zassert_true(k_pipe_write_claim(&pipe, &region, sizeof(input), K_NO_WAIT) ==
+		sizeof(input), "Failed to claim space");
+	memcpy(region, input, sizeof(input));
+	zassert_true(k_pipe_read(&pipe, res, sizeof(res), K_NO_WAIT) == -EAGAIN,
+		"Claimed data should not be readable before commit");
+	zassert_true(k_pipe_write_commit(&pipe, sizeof(input)) == sizeof(input),
+		"Failed to commit data");
+	zassert_true(k_pipe_read(&pipe, res, sizeof(res), K_NO_WAIT) == sizeof(res),
+		"Failed to read committed data");
+	zassert_true(memcmp(input, res, sizeof(res)) == 0, "Sequence should be equal");
+	zassert_true(k_pipe_write_commit(&pipe, 0) == -EINVAL,
+		"Commit without claim should fail");
+}
+
+ZTEST(k_pipe_claim, test_read_claim_release)
+{
+	uint8_t buffer[DUMMY_DATA_SIZE];
+	uint8_t input[8];
+	uint8_t res[8];
+	uint8_t *region;
+
+	sys_rand_get(input, sizeof(input));
+	k_pipe_init(&pipe, buffer, sizeof(buffer));
+
+	zassert_true(k_pipe_read_claim(&pipe, &region, 1, K_NO_WAIT) == -EAGAIN,
+		"Should not be able to claim data from empty pipe");
+	zassert_true(k_pipe_write(&pipe, input, sizeof(input), K_NO_WAIT) == sizeof(input),
+		"Failed to write to pipe");
+	zassert_true(k_pipe_read_claim(&pipe, &region, sizeof(res), K_NO_WAIT) == sizeof(res),
+		"Failed to claim data");
+	zassert_true(memcmp(input, region, sizeof(input)) == 0, "Sequence should be equal");
+
+	/* Only consume part of the region, the rest is read next */
+	zassert_true(k_pipe_read_release(&pipe, 3) == 3, "Failed to release data");
+	zassert_true(k_pipe_read(&pipe, res, sizeof(res), K_NO_WAIT) == 5,
+		"Failed to read remaining data");
+	zassert_true(memcmp(&input[3], res, 5) == 0, "Sequence should be equal");
+}
+
+ZTEST(k_pipe_claim, test_claim_wrap_around)
+{
+	uint8_t buffer[DUMMY_DATA_SIZE];
+	uint8_t garbage[12] = {};
+	uint8_t *region;
+
+	k_pipe_init(&pipe, buffer, sizeof(buffer));
+	zassert_true(k_pipe_write(&pipe, garbage, sizeof(garbage), K_NO_WAIT) == sizeof(garbage),
+		"Failed to write to pipe");
+	zassert_true(k_pipe_read(&pipe, garbage, sizeof(garbage), K_NO_WAIT) == sizeof(garbage),
+		"Failed to read from pipe");
+
+	/* The free space wraps around, only the contiguous part is claimed */
+	zassert_true(k_pipe_write_claim(&pipe, &region, DUMMY_DATA_SIZE, K_NO_WAIT) == 4,
+		"Claimed region should end at the end of the buffer");
+	zassert_true(region == &buffer[12], "Claimed region should be in the pipe buffer");
+	zassert_true(k_pipe_write_commit(&pipe, 4) == 4, "Failed to commit data");
+	zassert_true(k_pipe_write_claim(&pipe, &region, DUMMY_DATA_SIZE, K_NO_WAIT) == 12,
+		"Claimed region should start at the start of the buffer");
+	zassert_true(region == &buffer[0], "Claimed region should be in the pipe buffer");
+	zassert_true(k_pipe_write_commit(&pipe, 12) == 12, "Failed to commit data");
+
+	zassert_true(k_pipe_read_claim(&pipe, &region, DUMMY_DATA_SIZE, K_NO_WAIT) == 4,
+		"Claimed region should end at the end of the buffer");
+	zassert_true(k_pipe_read_release(&pipe, 4) == 4, "Failed to release data");
+	zassert_true(k_pipe_read_claim(&pipe, &region, DUMMY_DATA_SIZE, K_NO_WAIT) == 12,
+		"Claimed region should start at the start of the buffer");
+	zassert_true(k_pipe_read_release(&pipe, 12) == 12, "Failed to release data");
+}
+
+ZTEST(k_pipe_claim, test_single_claim)
+{
+	uint8_t buffer[DUMMY_DATA_SIZE];
+	uint8_t garbage[4] = {};
+	uint8_t *region;
+
+	k_pipe_init(&pipe, buffer, sizeof(buffer));
+	zassert_true(k_pipe_write_claim(&pipe, NULL, 0, K_NO_WAIT) == -EINVAL,
+		"Empty claims should be rejected");
+	zassert_true(k_pipe_write_claim(&pipe, &region, 4, K_NO_WAIT) == 4,
+		"Failed to claim space");
+	zassert_true(k_pipe_write_claim(&pipe, &region, 4, K_NO_WAIT) == -EAGAIN,
+		"Only one region can be claimed for writing");
+	zassert_true(k_pipe_write(&pipe, garbage, sizeof(garbage), K_NO_WAIT) == -EAGAIN,
+		"Write should not go through the claimed buffer");
+	zassert_true(k_pipe_write_commit(&pipe, 4) == 4, "Failed to commit data");
+
+	zassert_true(k_pipe_write(&pipe, garbage, sizeof(garbage), K_NO_WAIT) == sizeof(garbage),
+		"Failed to write to pipe");
+	zassert_true(k_pipe_read_claim(&pipe, &region, 4, K_NO_WAIT) == 4,
+		"Failed to claim data");
+	zassert_true(k_pipe_read_claim(&pipe, &region, 4, K_NO_WAIT) == -EAGAIN,
+		"Only one region can be claimed for reading");
+	zassert_true(k_pipe_read(&pipe, garbage, sizeof(garbage), K_NO_WAIT) == -EAGAIN,
+		"Read should not go through the claimed buffer");
+	zassert_true(k_pipe_read_release(&pipe, 4) == 4, "Failed to release data");
+}
+
+ZTEST(k_pipe_claim, test_read_claim_blocking)
+{
+	k_tid_t tid;
+	uint8_t buffer[DUMMY_DATA_SIZE];
+	uint8_t *region;
+
+	k_pipe_init(&pipe, buffer, sizeof(buffer));
+	tid = k_thread_create(&thread, stack, K_THREAD_STACK_SIZEOF(stack),
+		thread_write, &pipe, NULL, NULL, K_PRIO_COOP(0), 0, K_MSEC(100));
+	zassert_true(tid, "k_thread_create failed");
+
+	/* The writer must not copy the data to a waiting claim */
+	zassert_true(k_pipe_read_claim(&pipe, &region, DUMMY_DATA_SIZE, K_MSEC(1000)) ==
+		DUMMY_DATA_SIZE, "Failed to claim written data");
+	zassert_true(k_pipe_read_release(&pipe, DUMMY_DATA_SIZE) == DUMMY_DATA_SIZE,
+		"Failed to release data");
+	k_thread_join(tid, K_FOREVER);
+}
+
+ZTEST(k_pipe_claim, test_read_claim_order)
+{
+	k_tid_t tid;
+	uint8_t buffer[DUMMY_DATA_SIZE];
+	uint8_t first[4] = { 1, 2, 3, 4 };
+	uint8_t second[4] = { 5, 6, 7, 8 };
+	uint8_t *region;
+
+	k_pipe_init(&pipe, buffer, sizeof(buffer));
+	zassert_true(k_pipe_write(&pipe, first, sizeof(first), K_NO_WAIT) == sizeof(first),
+		"Failed to write to pipe");
+	zassert_true(k_pipe_read_claim(&pipe, &region, sizeof(first), K_NO_WAIT) ==
+		sizeof(first), "Failed to claim data");
+
+	tid = k_thread_create(&thread, stack, K_THREAD_STACK_SIZEOF(stack),
+		thread_read, &pipe, NULL, NULL, K_PRIO_COOP(0), 0, K_NO_WAIT);
+	zassert_true(tid, "k_thread_create failed");
+	k_msleep(10);
+
+	/* The claimed data comes first, it must not be overtaken by a direct copy */
+	zassert_true(k_pipe_write(&pipe, second, sizeof(second), K_NO_WAIT) == sizeof(second),
+		"Failed to write to pipe");
+	zassert_true(k_pipe_read_release(&pipe, 0) == 0, "Failed to release nothing");
+	k_thread_join(tid, K_FOREVER);
+	zassert_true(memcmp(first, thread_res, sizeof(first)) == 0,
+		"Unreleased data should be read first");
+}
+
+ZTEST(k_pipe_claim, test_write_claim_blocking)
+{
+	k_tid_t tid;
+	uint8_t buffer[DUMMY_DATA_SIZE];
+	uint8_t garbage[DUMMY_DATA_SIZE] = {};
+	uint8_t *region;
+
+	k_pipe_init(&pipe, buffer, sizeof(buffer));
+	zassert_true(k_pipe_write(&pipe, garbage, sizeof(garbage), K_NO_WAIT) == sizeof(garbage),
+		"Failed to write to pipe");
+
+	tid = k_thread_create(&thread, stack, K_THREAD_STACK_SIZEOF(stack),
+		thread_read_release, &pipe, NULL, NULL, K_PRIO_COOP(0), 0, K_MSEC(100));
+	zassert_true(tid, "k_thread_create failed");
+
+	zassert_true(k_pipe_write_claim(&pipe, &region, DUMMY_DATA_SIZE, K_MSEC(1000)) ==
+		DUMMY_DATA_SIZE, "Failed to claim released space");
+	zassert_true(k_pipe_write_commit(&pipe, 0) == 0, "Failed to commit nothing");
+	k_thread_join(tid, K_FOREVER);
+}
+
+ZTEST(k_pipe_claim, test_claim_close)
+{
+	uint8_t buffer[DUMMY_DATA_SIZE];
+	uint8_t garbage[4] = {};
+	uint8_t *region;
+
+	k_pipe_init(&pipe, buffer, sizeof(buffer));
+	zassert_true(k_pipe_write(&pipe, garbage, sizeof(garbage), K_NO_WAIT) == sizeof(garbage),
+		"Failed to write to pipe");
+	zassert_true(k_pipe_write_claim(&pipe, &region, 4, K_NO_WAIT) == 4,
+		"Failed to claim space");
+	zassert_true(k_pipe_read_claim(&pipe, &region, 4, K_NO_WAIT) == 4,
+		"Failed to claim data");
+	k_pipe_close(&pipe);
+
+	zassert_true(k_pipe_write_commit(&pipe, 4) == -EPIPE,
+		"Claimed space of closed pipe should be discarded");
+	zassert_true(k_pipe_read_release(&pipe, 2) == 2,
+		"Claimed data of closed pipe should be released");
+	zassert_true(k_pipe_read_claim(&pipe, &region, 4, K_NO_WAIT) == 2,
+		"Remaining data of closed pipe should be claimed");
+	zassert_true(k_pipe_read_release(&pipe, 2) == 2, "Failed to release data");
+	zassert_true(k_pipe_read_claim(&pipe, &region, 4, K_NO_WAIT) == -EPIPE,
+		"Closed and empty pipe should return -EPIPE");
+}
+
+ZTEST(k_pipe_claim, test_claim_reset)
+{
+	uint8_t buffer[DUMMY_DATA_SIZE];
+	uint8_t garbage[4] = {};
+	uint8_t *region;
+
+	k_pipe_init(&pipe, buffer, sizeof(buffer));
+	zassert_true(k_pipe_write(&pipe, garbage, sizeof(garbage), K_NO_WAIT) == sizeof(garbage),
+		"Failed to write to pipe");
+	zassert_true(k_pipe_write_claim(&pipe, &region, 4, K_NO_WAIT) == 4,
+		"Failed to claim space");
+	zassert_true(k_pipe_read_claim(&pipe, &region, 4, K_NO_WAIT) == 4,
+		"Failed to claim data");
+	k_pipe_reset(&pipe);
+
+	zassert_true(k_pipe_write_commit(&pipe, 4) == -EINVAL,
+		"Reset should discard the claimed space");
+	zassert_true(k_pipe_read_release(&pipe, 4) == -EINVAL,
+		"Reset should discard the claimed data");
+	zassert_true(k_pipe_write(&pipe, garbage, sizeof(garbage), K_NO_WAIT) == sizeof(garbage),
+		"Failed to write to reset pipe");
+}
@@ -7,6 +7,9 @@
 #include <zephyr/ztest.h>
 #include <zephyr/sys/sys_heap.h>
 #include <zephyr/sys/heap_listener.h>
+#ifdef CONFIG_SYS_HEAP_MAGAZINE
+#include <zephyr/sys/sys_heap_mag.h>
+#endif
 #include <inttypes.h>
 
 /* Guess at a value for heap size based on available memory on the
@@ -485,4 +488,185 @@ ZTEST(lib_heap, test_heap_listeners)
 #endif /* CONFIG_SYS_HEAP_LISTENER */
 }
 
+#define MT_THREADS 4
+#define MT_STACK_SZ (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static K_THREAD_STACK_ARRAY_DEFINE(mt_stacks, MT_THREADS, MT_STACK_SZ);
+static struct k_thread mt_threads[MT_THREADS];
+
+static const struct z_heap_stress_mt_config mt_config = {
+	.threads = mt_threads,
+	.stacks = mt_stacks,
+	.stack_stride = sizeof(mt_stacks[0]),
+	.stack_size = K_THREAD_STACK_SIZEOF(mt_stacks[0]),
+	.num_threads = MT_THREADS,
+};
+
+struct locked_heap {
+	struct sys_heap heap;
+	struct k_spinlock lock;
+#ifdef CONFIG_SYS_HEAP_MAGAZINE
+	struct sys_heap_mag mag;
+	bool use_mag;
+#endif
+};
+
+static void *locked_alloc(void *arg, size_t bytes)
+{
+	struct locked_heap *lh = arg;
+	k_spinlock_key_t key;
+	void *ret;
+
+#ifdef CONFIG_SYS_HEAP_MAGAZINE
+	if (lh->use_mag) {
+		ret = sys_heap_mag_alloc(&lh->mag, bytes);
+		if (ret != NULL) {
+			return ret;
+		}
+		bytes = sys_heap_mag_alloc_size(bytes);
+	}
+#endif
+
+	key = k_spin_lock(&lh->lock);
+	ret = sys_heap_alloc(&lh->heap, bytes);
+	k_spin_unlock(&lh->lock, key);
+
+	return ret;
+}
+
+static void locked_free(void *arg, void *p)
+{
+	struct locked_heap *lh = arg;
+	k_spinlock_key_t key;
+
+#ifdef CONFIG_SYS_HEAP_MAGAZINE
+	if (lh->use_mag && sys_heap_mag_free(&lh->mag, p)) {
+		return;
+	}
+#endif
+
+	key = k_spin_lock(&lh->lock);
+	sys_heap_free(&lh->heap, p);
+	k_spin_unlock(&lh->lock, key);
+}
+
+static uint32_t run_mt_stress(struct locked_heap *lh)
+{
+	struct z_heap_stress_result result;
+
+	sys_heap_init(&lh->heap, heapmem, SMALL_HEAP_SZ);
+	sys_heap_stress_mt(locked_alloc, locked_free, lh,
+			   SMALL_HEAP_SZ, ITERATION_COUNT,
+			   scratchmem, sizeof(scratchmem),
+			   50, &mt_config, &result);
+
+	log_result(SMALL_HEAP_SZ, &result);
+	zassert_true(result.successful_allocs > 0, "");
+	zassert_true(sys_heap_validate(&lh->heap), "");
+
+	return result.elapsed_cycles;
+}
+
+/* Run the stress rig from several threads at once on a shared heap,
+ * and compare throughput with and without magazines when available.
+ */
+ZTEST(lib_heap, test_mt_stress)
+{
+	static struct locked_heap lh;
+	uint32_t cycles;
+
+	TC_PRINT("Testing %d threads on a (%d byte) heap\n",
+		 MT_THREADS, (int) SMALL_HEAP_SZ);
+
+	cycles = run_mt_stress(&lh);
+	TC_PRINT("locked heap: %u cycles\n", cycles);
+
+#ifdef CONFIG_SYS_HEAP_MAGAZINE
+	struct sys_heap_mag_stats stats;
+
+	lh.use_mag = true;
+	sys_heap_mag_init(&lh.mag, &lh.heap);
+	cycles = run_mt_stress(&lh);
+	sys_heap_mag_stats_get(&lh.mag, &stats);
+	TC_PRINT("magazines: %u cycles, %u hits, %u misses\n",
+		 cycles, stats.hits, stats.misses);
+	sys_heap_mag_flush(&lh.mag);
+	zassert_true(sys_heap_validate(&lh.heap), "");
+	lh.use_mag = false;
+#endif
+}
+
+ZTEST(lib_heap, test_magazine)
+{
+#ifdef CONFIG_SYS_HEAP_MAGAZINE
+	struct sys_heap heap;
+	struct sys_heap_mag mag;
+	struct sys_heap_mag_stats mstats;
+	struct sys_memory_stats before, stats;
+	void *p, *q;
+
+	sys_heap_init(&heap, heapmem, SMALL_HEAP_SZ);
+	sys_heap_mag_init(&mag, &heap);
+	zassert_ok(sys_heap_runtime_stats_get(&heap, &before), "");
+
+	/* Empty magazines miss, the block is allocated rounded up to
+	 * its size class
+	 */
+	zassert_is_null(sys_heap_mag_alloc(&mag, 20), "");
+	zassert_equal(sys_heap_mag_alloc_size(20), 32, "");
+	zassert_equal(sys_heap_mag_alloc_size(0), 0, "");
+	zassert_equal(sys_heap_mag_alloc_size(SYS_HEAP_MAG_MAX_BYTES + 1),
+		      SYS_HEAP_MAG_MAX_BYTES + 1, "");
+	p = sys_heap_alloc(&heap, sys_heap_mag_alloc_size(20));
+	zassert_not_null(p, "");
+
+	/* Freed to the magazine, the heap still sees it allocated but
+	 * the statistics through the magazine report it as free
+	 */
+	zassert_true(sys_heap_mag_free(&mag, p), "");
+	zassert_true(sys_heap_validate(&heap), "");
+	zassert_ok(sys_heap_mag_runtime_stats_get(&mag, &stats), "");
+	zassert_equal(stats.allocated_bytes, before.allocated_bytes, "");
+	zassert_equal(stats.free_bytes, before.free_bytes, "");
+
+	/* Any request of the same class is served from the magazine */
+	q = sys_heap_mag_alloc(&mag, 30);
+	zassert_equal(p, q, "expected cached block %p, got %p", p, q);
+	zassert_is_null(sys_heap_mag_alloc(&mag, 30), "");
+
+	/* Large blocks are never cached */
+	p = sys_heap_alloc(&heap, 4 * SYS_HEAP_MAG_MAX_BYTES);
+	zassert_not_null(p, "");
+	zassert_false(sys_heap_mag_free(&mag, p), "");
+	sys_heap_free(&heap, p);
+
+	/* Fill a magazine, the next free has to go to the heap */
+	void *blocks[CONFIG_SYS_HEAP_MAGAZINE_DEPTH + 1];
+
+	for (int i = 0; i < ARRAY_SIZE(blocks); i++) {
+		blocks[i] = sys_heap_alloc(&heap, 32);
+		zassert_not_null(blocks[i], "");
+	}
+	for (int i = 0; i < ARRAY_SIZE(blocks) - 1; i++) {
+		zassert_true(sys_heap_mag_free(&mag, blocks[i]), "");
+	}
+	zassert_false(sys_heap_mag_free(&mag, blocks[ARRAY_SIZE(blocks) - 1]), "");
+	sys_heap_free(&heap, blocks[ARRAY_SIZE(blocks) - 1]);
+
+	sys_heap_mag_stats_get(&mag, &mstats);
+	zassert_true(mstats.cached_bytes > 0, "");
+
+	/* Flushing gives everything back */
+	sys_heap_free(&heap, q);
+	sys_heap_mag_flush(&mag);
+	sys_heap_mag_stats_get(&mag, &mstats);
+	zassert_equal(mstats.cached_bytes, 0, "");
+	zassert_true(sys_heap_validate(&heap), "");
+	zassert_ok(sys_heap_runtime_stats_get(&heap, &stats), "");
+	zassert_equal(stats.allocated_bytes, before.allocated_bytes, "");
+#else
+	ztest_test_skip();
+#endif /* CONFIG_SYS_HEAP_MAGAZINE */
+}
+
 ZTEST_SUITE(lib_heap, NULL, NULL, NULL, NULL, NULL);
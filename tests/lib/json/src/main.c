@@ -2927,4 +2927,189 @@ ZTEST(lib_json_test, test_debug_string_types)
 	zassert_str_equal(decoded.string_buf, "buffer\ttab", "string_buf not unescaped");
 }
 
+#ifdef CONFIG_JSON_PUSH_PARSER
+static int64_t push_parse(const char *encoded, size_t len, size_t chunk,
+			  const struct json_obj_descr *descr, size_t descr_len, void *val,
+			  char *buf, size_t buf_size)
+{
+	struct json_push_parser parser;
+	int ret;
+
+	ret = json_push_parser_init(&parser, descr, descr_len, val, buf, buf_size);
+	zassert_equal(ret, 0, "Push parser not initialized");
+
+	for (size_t pos = 0; pos < len; pos += chunk) {
+		ret = json_push_parser_feed(&parser, encoded + pos, MIN(chunk, len - pos));
+		if (ret < 0) {
+			zassert_equal(json_push_parser_finish(&parser), ret,
+				      "Error not kept by the push parser");
+			return ret;
+		}
+	}
+
+	return json_push_parser_finish(&parser);
+}
+
+ZTEST(lib_json_test, test_json_push_parser_decoding)
+{
+	const char encoded[] = "{\"some_string\":\"zephyr 123\\uABCD456\","
+		"\"some_string_buf\":\"z\\uABCD\","
+		"\"some_int\":\t42\n,"
+		"\"some_int16\":\t16\n,"
+		"\"some_bool\":true    \t  \n\r   ,"
+		"\"some_int64\":-4611686018427387904,"
+		"\"another_int64\":-2147483648,"
+		"\"some_uint64\":18446744073709551615,"
+		"\"another_uint64\":0,"
+		"\"some_nested_struct\":{    "
+		"\"nested_int\":-1234,\n\n"
+		"\"nested_bool\":false,\t"
+		"\"nested_string\":\"this should be escaped: \\t\","
+		"\"nested_string_buf\":\"esc: \\t\","
+		"\"nested_int8\":123,"
+		"\"nested_int64\":9223372036854775807,"
+		"\"extra_nested_array\":[0,-1]},"
+		"\"extra_struct\":{\"nested_bool\":false,"
+		"\"nested_array\":[null,{\"nested_string\":\"skipped \\\" string\"}]},"
+		"\"extra_bool\":true,"
+		"\"some_array\":[11,22, 33,\t45,\n299],"
+		"\"another_b!@l\":true,"
+		"\"if\":false,"
+		"\"another-array\":[2,3,5,7],"
+		"\"4nother_ne$+\":{\"nested_int\":1234,"
+		"\"nested_bool\":true,"
+		"\"nested_string\":\"no escape necessary\","
+		"\"nested_string_buf\":\"no escape\","
+		"\"nested_int8\":-123,"
+		"\"nested_int64\":-9223372036854775806},"
+		"\"nested_obj_array\":["
+		"{\"nested_int\":1,\"nested_bool\":true,\"nested_string\":\"true\","
+		"\"nested_string_buf\":\"true\"},"
+		"{\"nested_int\":0,\"nested_bool\":false,\"nested_string\":\"false\","
+		"\"nested_string_buf\":\"false\"}]"
+		"}\n";
+	const size_t chunks[] = { 1, 7, sizeof(encoded) - 1 };
+	const int expected_array[] = { 11, 22, 33, 45, 299 };
+	const int expected_other_array[] = { 2, 3, 5, 7 };
+	struct test_struct ts;
+	char buf[128];
+	int64_t ret;
+
+	ARRAY_FOR_EACH(chunks, i) {
+		memset(&ts, 0, sizeof(ts));
+
+		ret = push_parse(encoded, sizeof(encoded) - 1, chunks[i], test_descr,
+				 ARRAY_SIZE(test_descr), &ts, buf, sizeof(buf));
+
+		zassert_equal(ret, (1 << ARRAY_SIZE(test_descr)) - 1,
+			      "Not all fields decoded correctly in chunks of %zu", chunks[i]);
+
+		zassert_str_equal(ts.some_string, "zephyr 123\\uABCD456",
+				  "String not decoded correctly");
+		zassert_str_equal(ts.some_string_buf, "z\\uABCD",
+				  "String (array) not decoded correctly");
+		zassert_equal(ts.some_int, 42, "Positive integer not decoded correctly");
+		zassert_equal(ts.some_int16, 16, "Positive integer not decoded correctly");
+		zassert_equal(ts.some_bool, true, "Boolean not decoded correctly");
+		zassert_equal(ts.some_int64, -4611686018427387904,
+			      "int64 not decoded correctly");
+		zassert_equal(ts.some_nested_struct.nested_int, -1234,
+			      "Nested negative integer not decoded correctly");
+		zassert_equal(ts.some_nested_struct.nested_int64, 9223372036854775807,
+			      "Nested int64 not decoded correctly");
+		zassert_str_equal(ts.some_nested_struct.nested_string,
+				  "this should be escaped: \\t",
+				  "Nested string not decoded correctly");
+		zassert_str_equal(ts.some_nested_struct.nested_string_buf, "esc: \t",
+				  "Nested string-array not decoded correctly");
+		zassert_equal(ts.some_array_len, 5,
+			      "Array doesn't have correct number of items");
+		zassert_mem_equal(ts.some_array, expected_array, sizeof(expected_array),
+				  "Array not decoded with expected values");
+		zassert_true(ts.another_bxxl,
+			     "Named boolean (special chars) not decoded correctly");
+		zassert_false(ts.if_,
+			      "Named boolean (reserved word) not decoded correctly");
+		zassert_equal(ts.another_array_len, 4,
+			      "Named array does not have correct number of items");
+		zassert_mem_equal(ts.another_array, expected_other_array,
+				  sizeof(expected_other_array),
+				  "Decoded named array not with expected values");
+		zassert_equal(ts.xnother_nexx.nested_int8, -123,
+			      "Named nested int8 not decoded correctly");
+		zassert_str_equal(ts.xnother_nexx.nested_string, "no escape necessary",
+				  "Named nested string not decoded correctly");
+		zassert_equal(ts.obj_array_len, 2,
+			      "Array of objects does not have correct number of items");
+		zassert_str_equal(ts.nested_obj_array[0].nested_string, "true",
+				  "String in first object array element not decoded correctly");
+		zassert_equal(ts.nested_obj_array[1].nested_bool, false,
+			      "Boolean value in second object array element not decoded correctly");
+		zassert_str_equal(ts.nested_obj_array[1].nested_string_buf, "false",
+				  "String buffer in second object array element not decoded correctly");
+	}
+}
+
+ZTEST(lib_json_test, test_json_push_parser_errors)
+{
+	const char *invalid[] = {
+		"[1]",
+		"{\"some_int\" 1}",
+		"{\"some_int\":\"1\"}",
+		"{\"some_int\":tru}",
+		"{\"some_string\":\"\\q\"}",
+		"{,}",
+	};
+	const char too_long[] = "{\"some_array\":[1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17]}";
+	const char incomplete[] = "{\"some_int\":42";
+	const char long_key[] = "{\"some_int\":42}";
+	struct test_struct ts;
+	char buf[128];
+	int64_t ret;
+
+	ARRAY_FOR_EACH(invalid, i) {
+		ret = push_parse(invalid[i], strlen(invalid[i]), 1, test_descr,
+				 ARRAY_SIZE(test_descr), &ts, buf, sizeof(buf));
+		zassert_equal(ret, -EINVAL, "Invalid object %zu not rejected", i);
+	}
+
+	ret = push_parse(too_long, sizeof(too_long) - 1, 3, test_descr, ARRAY_SIZE(test_descr),
+			 &ts, buf, sizeof(buf));
+	zassert_equal(ret, -ENOSPC, "Array overflow not detected");
+
+	ret = push_parse(incomplete, sizeof(incomplete) - 1, 3, test_descr,
+			 ARRAY_SIZE(test_descr), &ts, buf, sizeof(buf));
+	zassert_equal(ret, -EINVAL, "Incomplete object not detected");
+
+	/* The names of the fields do not fit the buffer */
+	ret = push_parse(long_key, sizeof(long_key) - 1, 3, test_descr, ARRAY_SIZE(test_descr),
+			 &ts, buf, 8);
+	zassert_equal(ret, -ENOSPC, "Buffer overflow not detected");
+}
+
+ZTEST(lib_json_test, test_json_push_parser_skip_full_buffer)
+{
+	const char encoded[] = "{\"name\":\"abcdefgh\",\"extra\":true,"
+		"\"more\":[false,null,-12.5e3,{\"x\":true}],\"last\":null}";
+	const char invalid[] = "{\"name\":\"abcdefgh\",\"extra\":nul}";
+	const size_t chunks[] = { 1, 7, sizeof(encoded) - 1 };
+	struct elt elt;
+	/* Only fits the decoded name, the skipped literals are not kept */
+	char buf[sizeof("abcdefgh")];
+	int64_t ret;
+
+	ARRAY_FOR_EACH(chunks, i) {
+		memset(&elt, 0, sizeof(elt));
+
+		ret = push_parse(encoded, sizeof(encoded) - 1, chunks[i], elt_descr, 1, &elt,
+				 buf, sizeof(buf));
+		zassert_equal(ret, 1, "Skipped values not parsed in chunks of %zu", chunks[i]);
+		zassert_str_equal(elt.name, "abcdefgh", "String not decoded correctly");
+	}
+
+	ret = push_parse(invalid, sizeof(invalid) - 1, 1, elt_descr, 1, &elt, buf, sizeof(buf));
+	zassert_equal(ret, -EINVAL, "Invalid skipped literal not rejected");
+}
+#endif /* CONFIG_JSON_PUSH_PARSER */
+
 ZTEST_SUITE(lib_json_test, NULL, NULL, NULL, NULL, NULL);
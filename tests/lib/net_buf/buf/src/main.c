@@ -506,6 +506,48 @@ ZTEST(net_buf_tests, test_net_buf_clone_reference_counted_zero_sized_buffer)
 	net_buf_unref(buf);
 }
 
+static int ext_released;
+
+static void ext_release(struct net_buf_ext *ext)
+{
+	ext_released++;
+}
+
+ZTEST(net_buf_tests, test_net_buf_ext)
+{
+	static const uint8_t data[] = {0x11, 0x22, 0x33, 0x44};
+	struct net_buf *buf, *clone;
+	struct net_buf_ext ext;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_BUF_EXTERNAL_REF);
+
+#if defined(CONFIG_NET_BUF_EXTERNAL_REF)
+	destroy_called = 0;
+	ext_released = 0;
+
+	net_buf_ext_init(&ext, ext_release);
+
+	buf = net_buf_alloc_with_ext(&fixed_pool, &ext, data, sizeof(data), K_NO_WAIT);
+	zassert_not_null(buf, "Failed to get buffer");
+	zassert_equal(buf->data, data, "Data not referenced");
+	zassert_equal(buf->len, sizeof(data), "Incorrect buffer length");
+
+	/* Clones share the external memory */
+	clone = net_buf_clone(buf, K_NO_WAIT);
+	zassert_not_null(clone, "Failed to get clone buffer");
+	zassert_equal(clone->data, data, "Data copied by clone");
+
+	/* The owner reference is dropped, the buffers keep the memory */
+	net_buf_ext_unref(&ext);
+	net_buf_unref(buf);
+	zassert_equal(ext_released, 0, "External memory released too early");
+
+	net_buf_unref(clone);
+	zassert_equal(ext_released, 1, "External memory not released");
+	zassert_equal(destroy_called, 2, "Incorrect destroy callback count");
+#endif
+}
+
 ZTEST(net_buf_tests, test_net_buf_clone_user_data)
 {
 	struct net_buf *original, *clone;
@@ -1163,4 +1205,69 @@ ZTEST(net_buf_tests, test_net_buf_var_pool_aligned)
 	zassert_equal(destroy_called, 3, "Incorrect destroy callback count");
 }
 
+#if defined(CONFIG_NET_BUF_POOL_PERCPU_CACHE)
+static K_THREAD_STACK_DEFINE(waiter_stack, 1024 + CONFIG_TEST_EXTRA_STACK_SIZE);
+static struct k_thread waiter_thread;
+static struct net_buf *waiter_buf;
+
+static void waiter(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	waiter_buf = net_buf_alloc(&fixed_pool, K_FOREVER);
+}
+#endif
+
+ZTEST(net_buf_tests, test_net_buf_pool_percpu_cache)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_BUF_POOL_PERCPU_CACHE);
+
+#if defined(CONFIG_NET_BUF_POOL_PERCPU_CACHE)
+	struct net_buf *bufs[10];
+
+	zassert_equal(ARRAY_SIZE(bufs), fixed_pool.buf_count);
+
+	destroy_called = 0;
+
+	/* All the buffers remain available, whatever the caches hold */
+	for (int round = 0; round < 2; round++) {
+		for (int i = 0; i < ARRAY_SIZE(bufs); i++) {
+			bufs[i] = net_buf_alloc(&fixed_pool, K_NO_WAIT);
+			zassert_not_null(bufs[i], "Failed to get buffer");
+		}
+
+		zassert_is_null(net_buf_alloc(&fixed_pool, K_NO_WAIT), "Got buffer from empty pool");
+
+		for (int i = 0; i < ARRAY_SIZE(bufs); i++) {
+			net_buf_unref(bufs[i]);
+		}
+	}
+
+	zassert_equal(destroy_called, 2 * ARRAY_SIZE(bufs), "Incorrect destroy callback count");
+
+	/* A thread waiting for a buffer is handed the freed one */
+	for (int i = 0; i < ARRAY_SIZE(bufs); i++) {
+		bufs[i] = net_buf_alloc(&fixed_pool, K_NO_WAIT);
+		zassert_not_null(bufs[i], "Failed to get buffer");
+	}
+
+	k_thread_create(&waiter_thread, waiter_stack, K_THREAD_STACK_SIZEOF(waiter_stack),
+			waiter, NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(10);
+	zassert_equal(atomic_get(&fixed_pool.cache_waiters), 1, "Waiter not registered");
+
+	net_buf_unref(bufs[0]);
+	zassert_ok(k_thread_join(&waiter_thread, TEST_TIMEOUT));
+	zassert_equal_ptr(waiter_buf, bufs[0], "Waiter not handed the freed buffer");
+	zassert_equal(atomic_get(&fixed_pool.cache_waiters), 0, "Waiter still registered");
+
+	/* The first buffer is now owned through waiter_buf */
+	for (int i = 0; i < ARRAY_SIZE(bufs); i++) {
+		net_buf_unref(bufs[i]);
+	}
+#endif
+}
+
 ZTEST_SUITE(net_buf_tests, NULL, NULL, NULL, NULL, NULL);
@@ -95,25 +95,37 @@ ZTEST(net_dns_cache_test, test_fill_cache_to_small)
 	zassert_equal(NET_AF_INET, info_read[TEST_DNS_CACHE_SIZE - 2].ai_family);
 }
 
-ZTEST(net_dns_cache_test, test_closest_expiry_removed)
+ZTEST(net_dns_cache_test, test_recently_used_closest_expiry_kept)
 {
 	struct dns_addrinfo info_write = {.ai_family = NET_AF_INET};
 	struct dns_addrinfo info_read = {0};
 	const char *closest_expiry = "example.com";
 	enum dns_query_type query_type = DNS_QUERY_TYPE_A;
+	char query[sizeof("example00.com")];
 
 	zassert_ok(dns_cache_add(&test_dns_cache, closest_expiry, &info_write,
 				 TEST_DNS_CACHE_DEFAULT_TTL),
 		   "Cache entry adding should work.");
-	k_sleep(K_MSEC(1));
-	for (size_t i = 0; i < TEST_DNS_CACHE_SIZE; i++) {
-		zassert_ok(dns_cache_add(&test_dns_cache, "example2.com", &info_write,
-					 TEST_DNS_CACHE_DEFAULT_TTL),
+	for (size_t i = 0; i < TEST_DNS_CACHE_SIZE - 1; i++) {
+		snprintk(query, sizeof(query), "example%02zu.com", i);
+		zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write,
+					 TEST_DNS_CACHE_DEFAULT_TTL * 2),
 			   "Cache entry adding should work.");
 	}
-	zassert_equal(0,
+
+	/* The entry expiring first is used, so the least recently used one gets replaced */
+	zassert_equal(1,
 		      dns_cache_find(&test_dns_cache, closest_expiry, query_type, &info_read, 1));
-	zassert_equal(0, info_read.ai_family);
+	zassert_ok(dns_cache_add(&test_dns_cache, "example2.com", &info_write,
+				 TEST_DNS_CACHE_DEFAULT_TTL * 2),
+		   "Cache entry adding should work.");
+	zassert_equal(1,
+		      dns_cache_find(&test_dns_cache, closest_expiry, query_type, &info_read, 1));
+	zassert_equal(NET_AF_INET, info_read.ai_family);
+	zassert_equal(0, dns_cache_find(&test_dns_cache, "example00.com", query_type, &info_read,
+					1));
+	zassert_equal(1, dns_cache_find(&test_dns_cache, "example2.com", query_type, &info_read,
+					1));
 }
 
 ZTEST(net_dns_cache_test, test_expired_entries_removed)
@@ -267,3 +279,88 @@ ZTEST(net_dns_cache_test, test_remove_null_parameters)
 	zassert_equal(-EINVAL, dns_cache_remove(&test_dns_cache, NULL),
 		      "NULL query should return error.");
 }
+
+ZTEST(net_dns_cache_test, test_least_recently_used_removed)
+{
+	struct dns_addrinfo info_write = {.ai_family = NET_AF_INET};
+	struct dns_addrinfo info_read = {0};
+	enum dns_query_type query_type = DNS_QUERY_TYPE_A;
+	char query[sizeof("example00.com")];
+
+	for (size_t i = 0; i < TEST_DNS_CACHE_SIZE; i++) {
+		snprintk(query, sizeof(query), "example%02zu.com", i);
+		zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write,
+					 TEST_DNS_CACHE_DEFAULT_TTL),
+			   "Cache entry adding should work.");
+	}
+
+	/* The first entry is used, so the second one gets replaced */
+	zassert_equal(1, dns_cache_find(&test_dns_cache, "example00.com", query_type, &info_read,
+					1));
+	zassert_ok(dns_cache_add(&test_dns_cache, "example.com", &info_write,
+				 TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Cache entry adding should work.");
+	zassert_equal(1, dns_cache_find(&test_dns_cache, "example00.com", query_type, &info_read,
+					1));
+	zassert_equal(0, dns_cache_find(&test_dns_cache, "example01.com", query_type, &info_read,
+					1));
+	zassert_equal(1, dns_cache_find(&test_dns_cache, "example.com", query_type, &info_read, 1));
+}
+
+ZTEST(net_dns_cache_test, test_replaced_entries_expired)
+{
+	struct dns_addrinfo info_write = {.ai_family = NET_AF_INET};
+	struct dns_addrinfo info_read = {0};
+	enum dns_query_type query_type = DNS_QUERY_TYPE_A;
+	char query[sizeof("example00.com")];
+
+	/* Replace more entries than the expiry heap holds nodes */
+	for (size_t i = 0; i < 4 * TEST_DNS_CACHE_SIZE; i++) {
+		snprintk(query, sizeof(query), "example%02zu.com", i);
+		zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write,
+					 TEST_DNS_CACHE_DEFAULT_TTL),
+			   "Cache entry adding should work.");
+	}
+
+	for (size_t i = 0; i < 4 * TEST_DNS_CACHE_SIZE; i++) {
+		snprintk(query, sizeof(query), "example%02zu.com", i);
+		zassert_equal(i >= 3 * TEST_DNS_CACHE_SIZE ? 1 : 0,
+			      dns_cache_find(&test_dns_cache, query, query_type, &info_read, 1));
+	}
+
+	k_sleep(K_MSEC(TEST_DNS_CACHE_DEFAULT_TTL * 1000 + 1));
+
+	for (size_t i = 3 * TEST_DNS_CACHE_SIZE; i < 4 * TEST_DNS_CACHE_SIZE; i++) {
+		snprintk(query, sizeof(query), "example%02zu.com", i);
+		zassert_equal(0, dns_cache_find(&test_dns_cache, query, query_type, &info_read, 1));
+	}
+}
+
+ZTEST(net_dns_cache_test, test_nxdomain)
+{
+	struct dns_addrinfo info_write = {.ai_family = NET_AF_INET};
+	struct dns_addrinfo info_read = {0};
+	const char *query = "example.com";
+	enum dns_query_type query_type = DNS_QUERY_TYPE_A;
+
+	zassert_ok(dns_cache_add_nxdomain(&test_dns_cache, query, TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Cache entry adding should work.");
+	zassert_equal(-ENOENT, dns_cache_find(&test_dns_cache, query, DNS_QUERY_TYPE_A,
+					      &info_read, 1));
+	zassert_equal(-ENOENT, dns_cache_find(&test_dns_cache, query, DNS_QUERY_TYPE_AAAA,
+					      &info_read, 1));
+	zassert_equal(0, info_read.ai_family);
+
+	/* An answer replaces the non-existent entry, and the other way around */
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write, TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Cache entry adding should work.");
+	zassert_equal(1, dns_cache_find(&test_dns_cache, query, query_type, &info_read, 1));
+	zassert_equal(NET_AF_INET, info_read.ai_family);
+
+	zassert_ok(dns_cache_add_nxdomain(&test_dns_cache, query, TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Cache entry adding should work.");
+	zassert_equal(-ENOENT, dns_cache_find(&test_dns_cache, query, query_type, &info_read, 1));
+
+	k_sleep(K_MSEC(TEST_DNS_CACHE_DEFAULT_TTL * 1000 + 1));
+	zassert_equal(0, dns_cache_find(&test_dns_cache, query, query_type, &info_read, 1));
+}
@@ -571,6 +571,39 @@ ZTEST(lwm2m_registry, test_next_engine_obj_inst)
 	zassert_is_null(lwm2m_engine_get_obj_inst(&LWM2M_OBJ(3303, 1)));
 }
 
+ZTEST(lwm2m_registry, test_next_engine_obj_inst_order)
+{
+	struct lwm2m_engine_obj_inst *oi;
+
+	/* Instances created out of order are iterated in ID order */
+	zassert_equal(lwm2m_create_object_inst(&LWM2M_OBJ(3303, 3)), 0);
+	zassert_equal(lwm2m_create_object_inst(&LWM2M_OBJ(3303, 1)), 0);
+	zassert_equal(lwm2m_create_object_inst(&LWM2M_OBJ(3303, 2)), 0);
+
+	oi = next_engine_obj_inst(3303, -1);
+	zassert_not_null(oi);
+	zassert_equal(oi->obj_inst_id, 1);
+	oi = next_engine_obj_inst(3303, oi->obj_inst_id);
+	zassert_not_null(oi);
+	zassert_equal(oi->obj_inst_id, 2);
+	oi = next_engine_obj_inst(3303, oi->obj_inst_id);
+	zassert_not_null(oi);
+	zassert_equal(oi->obj_inst_id, 3);
+	zassert_is_null(next_engine_obj_inst(3303, oi->obj_inst_id));
+
+	/* The iteration goes on from a deleted instance */
+	zassert_equal(lwm2m_delete_object_inst(&LWM2M_OBJ(3303, 2)), 0);
+	oi = next_engine_obj_inst(3303, 2);
+	zassert_not_null(oi);
+	zassert_equal(oi->obj_inst_id, 3);
+	zassert_equal(lwm2m_engine_get_obj_inst(&LWM2M_OBJ(3303, 1)),
+		      next_engine_obj_inst(3303, 0));
+
+	zassert_equal(lwm2m_delete_object_inst(&LWM2M_OBJ(3303, 1)), 0);
+	zassert_equal(lwm2m_delete_object_inst(&LWM2M_OBJ(3303, 3)), 0);
+	zassert_is_null(next_engine_obj_inst(3303, -1));
+}
+
 ZTEST(lwm2m_registry, test_null_strings)
 {
 	int ret;
@@ -1333,6 +1333,52 @@ ZTEST(net_socket_tcp, test_so_protocol)
 	test_context_cleanup();
 }
 
+ZTEST(net_socket_tcp, test_tcp_congestion)
+{
+	struct net_sockaddr_in bind_addr4;
+	char name[ZSOCK_TCP_CA_NAME_MAX];
+	net_socklen_t optlen = sizeof(name);
+	int sock, rv;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_TCP_CONGESTION_AVOIDANCE);
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &sock, &bind_addr4);
+
+	rv = zsock_getsockopt(sock, NET_IPPROTO_TCP, ZSOCK_TCP_CONGESTION, name, &optlen);
+	zassert_equal(rv, 0, "getsockopt failed (%d)", errno);
+	zassert_equal(optlen, strlen(name) + 1, "getsockopt got invalid size");
+
+	rv = zsock_setsockopt(sock, NET_IPPROTO_TCP, ZSOCK_TCP_CONGESTION,
+			      "reno", strlen("reno"));
+	zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+
+	optlen = sizeof(name);
+	rv = zsock_getsockopt(sock, NET_IPPROTO_TCP, ZSOCK_TCP_CONGESTION, name, &optlen);
+	zassert_equal(rv, 0, "getsockopt failed (%d)", errno);
+	zassert_str_equal(name, "reno", "getsockopt got invalid algorithm");
+
+	rv = zsock_setsockopt(sock, NET_IPPROTO_TCP, ZSOCK_TCP_CONGESTION,
+			      "no-such-algo", strlen("no-such-algo"));
+	zassert_equal(rv, -1, "setsockopt should fail");
+	zassert_equal(errno, ENOENT, "setsockopt returned invalid errno (%d)", errno);
+
+	if (IS_ENABLED(CONFIG_NET_TCP_CA_CUBIC)) {
+		rv = zsock_setsockopt(sock, NET_IPPROTO_TCP, ZSOCK_TCP_CONGESTION,
+				      "cubic", sizeof("cubic"));
+		zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+	}
+
+	if (IS_ENABLED(CONFIG_NET_TCP_CA_BBR)) {
+		rv = zsock_setsockopt(sock, NET_IPPROTO_TCP, ZSOCK_TCP_CONGESTION,
+				      "bbr", sizeof("bbr"));
+		zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+	}
+
+	test_close(sock);
+
+	test_context_cleanup();
+}
+
 ZTEST(net_socket_tcp, test_so_rcvbuf)
 {
 	struct net_sockaddr_in bind_addr4;
@@ -1767,6 +1813,69 @@ ZTEST(net_socket_tcp, test_v6_so_sndtimeo)
 	test_context_cleanup();
 }
 
+ZTEST(net_socket_tcp, test_v6_sendmsg_zerocopy)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_CONTEXT_SENDMSG_ZEROCOPY);
+
+#if defined(CONFIG_NET_CONTEXT_SENDMSG_ZEROCOPY)
+	static uint8_t tx_buf[2][CONFIG_NET_CONTEXT_SENDMSG_ZEROCOPY_THRESHOLD];
+	static uint8_t rx_buf[sizeof(tx_buf)];
+	int rv;
+	int c_sock;
+	int s_sock;
+	int new_sock;
+	struct net_sockaddr_in6 c_saddr;
+	struct net_sockaddr_in6 s_saddr;
+	struct net_sockaddr addr;
+	net_socklen_t addrlen = sizeof(addr);
+	struct net_msghdr msg;
+	struct net_iovec io_vector[ARRAY_SIZE(tx_buf)];
+
+	prepare_sock_tcp_v6(MY_IPV6_ADDR, ANY_PORT, &c_sock, &c_saddr);
+	prepare_sock_tcp_v6(MY_IPV6_ADDR, SERVER_PORT, &s_sock, &s_saddr);
+
+	test_bind(s_sock, (struct net_sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	test_connect(c_sock, (struct net_sockaddr *)&s_saddr, sizeof(s_saddr));
+
+	test_accept(s_sock, &new_sock, &addr, &addrlen);
+	zassert_equal(addrlen, sizeof(struct net_sockaddr_in6), "wrong addrlen");
+
+	ARRAY_FOR_EACH(tx_buf, i) {
+		memset(tx_buf[i], 0xa0 + i, sizeof(tx_buf[i]));
+		io_vector[i].iov_base = tx_buf[i];
+		io_vector[i].iov_len = sizeof(tx_buf[i]);
+	}
+
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_iov = io_vector;
+	msg.msg_iovlen = ARRAY_SIZE(io_vector);
+
+	rv = zsock_sendmsg(c_sock, &msg, 0);
+	zassert_equal(rv, sizeof(tx_buf), "sendmsg failed (%d)", -errno);
+
+	/* The call returns once the data is acknowledged, so the iovecs may
+	 * be reused and the peer has already queued the data.
+	 */
+	memset(tx_buf, 0, sizeof(tx_buf));
+
+	rv = zsock_recv(new_sock, rx_buf, sizeof(rx_buf), ZSOCK_MSG_DONTWAIT);
+	zassert_equal(rv, sizeof(rx_buf), "Data not acknowledged before returning (%d)",
+		      rv < 0 ? -errno : rv);
+
+	for (size_t i = 0; i < sizeof(rx_buf); i++) {
+		zassert_equal(rx_buf[i], 0xa0 + i / sizeof(tx_buf[0]), "Invalid data at %zu", i);
+	}
+
+	test_close(c_sock);
+	test_close(new_sock);
+	test_close(s_sock);
+
+	test_context_cleanup();
+#endif
+}
+
 struct test_msg_waitall_data {
 	struct k_work_delayable tx_work;
 	int sock;
@@ -963,6 +963,13 @@ static struct net_linkaddr server_link_addr = {
 #define WAIT_TIME K_MSEC(250)
 #define WAIT_TIME_LONG K_MSEC(1000)
 
+#if defined(CONFIG_NET_CONTEXT_SENDMSG_ZEROCOPY)
+/* Data sent by the zero-copy test, the driver checks it is not copied */
+static uint8_t zerocopy_data[CONFIG_NET_CONTEXT_SENDMSG_ZEROCOPY_THRESHOLD];
+static bool zerocopy_started;
+static bool zerocopy_found;
+#endif
+
 static void eth_fake_iface_init(struct net_if *iface)
 {
 	const struct device *dev = net_if_get_device(iface);
@@ -984,6 +991,20 @@ static int eth_fake_send(const struct device *dev, struct net_pkt *pkt)
 	ARG_UNUSED(dev);
 	ARG_UNUSED(pkt);
 
+#if defined(CONFIG_NET_CONTEXT_SENDMSG_ZEROCOPY)
+	if (zerocopy_started) {
+		for (struct net_buf *buf = pkt->buffer; buf != NULL; buf = buf->frags) {
+			if (buf->data == zerocopy_data) {
+				zerocopy_found = true;
+			}
+		}
+
+		(void)sys_sem_give(&wait_data);
+
+		return 0;
+	}
+#endif
+
 	if (!test_started) {
 		return 0;
 	}
@@ -1091,6 +1112,137 @@ ZTEST_USER(net_socket_udp, test_v6_sendmsg_with_txtime)
 	test_started = false;
 }
 
+ZTEST(net_socket_udp, test_v6_sendmsg_zerocopy)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_CONTEXT_SENDMSG_ZEROCOPY);
+
+#if defined(CONFIG_NET_CONTEXT_SENDMSG_ZEROCOPY)
+	int rv;
+	int client_sock;
+	struct net_sockaddr_in6 client_addr;
+	struct net_msghdr msg;
+	struct net_iovec io_vector[1];
+	struct timeval optval = {
+		.tv_sec = 1,
+		.tv_usec = 0,
+	};
+
+	/* Just flush the semaphore */
+	(void)sys_sem_take(&wait_data, K_NO_WAIT);
+
+	prepare_sock_udp_v6(MY_IPV6_ADDR_ETH, ANY_PORT, &client_sock, &client_addr);
+
+	rv = zsock_bind(client_sock, (struct net_sockaddr *)&client_addr, sizeof(client_addr));
+	zassert_equal(rv, 0, "client bind failed");
+
+	memset(zerocopy_data, 0x5a, sizeof(zerocopy_data));
+	io_vector[0].iov_base = zerocopy_data;
+	io_vector[0].iov_len = sizeof(zerocopy_data);
+
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_iov = io_vector;
+	msg.msg_iovlen = 1;
+	msg.msg_name = &udp_server_addr;
+	msg.msg_namelen = sizeof(udp_server_addr);
+
+	zerocopy_found = false;
+	zerocopy_started = true;
+
+	rv = zsock_sendmsg(client_sock, &msg, 0);
+	zassert_equal(rv, sizeof(zerocopy_data), "sendmsg failed (%d)", -errno);
+
+	/* The call returns once the packet referencing the iovec was released */
+	zassert_ok(sys_sem_take(&wait_data, K_NO_WAIT),
+		   "sendmsg returned before the packet was sent");
+
+	zerocopy_started = false;
+
+	zassert_true(zerocopy_found, "The iovec was copied");
+
+	/* With a send timeout the call cannot wait for the release, the
+	 * iovec is copied.
+	 */
+	rv = zsock_setsockopt(client_sock, ZSOCK_SOL_SOCKET, ZSOCK_SO_SNDTIMEO, &optval,
+			      sizeof(optval));
+	zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+
+	(void)sys_sem_take(&wait_data, K_NO_WAIT);
+
+	zerocopy_found = false;
+	zerocopy_started = true;
+
+	rv = zsock_sendmsg(client_sock, &msg, 0);
+	zassert_equal(rv, sizeof(zerocopy_data), "sendmsg failed (%d)", -errno);
+
+	zassert_ok(sys_sem_take(&wait_data, K_MSEC(100)), "Packet not sent");
+
+	zerocopy_started = false;
+
+	zassert_false(zerocopy_found, "The iovec was attached despite the timeout");
+
+	rv = zsock_close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+#endif
+}
+
+ZTEST(net_socket_udp, test_v6_sendmsg_zerocopy_to_self)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_CONTEXT_SENDMSG_ZEROCOPY);
+
+#if defined(CONFIG_NET_CONTEXT_SENDMSG_ZEROCOPY)
+	const char *addrs[] = { MY_IPV6_ADDR, MY_IPV6_ADDR_ETH };
+	static uint8_t recv_buf[sizeof(zerocopy_data)];
+
+	ARRAY_FOR_EACH(addrs, i) {
+		int rv;
+		int client_sock;
+		int server_sock;
+		struct net_sockaddr_in6 client_addr;
+		struct net_sockaddr_in6 server_addr;
+		struct net_msghdr msg;
+		struct net_iovec io_vector[1];
+
+		prepare_sock_udp_v6(addrs[i], ANY_PORT, &client_sock, &client_addr);
+		prepare_sock_udp_v6(addrs[i], SERVER_PORT, &server_sock, &server_addr);
+
+		rv = zsock_bind(server_sock, (struct net_sockaddr *)&server_addr,
+				sizeof(server_addr));
+		zassert_equal(rv, 0, "server bind failed");
+
+		memset(zerocopy_data, 0x5a + i, sizeof(zerocopy_data));
+		io_vector[0].iov_base = zerocopy_data;
+		io_vector[0].iov_len = sizeof(zerocopy_data);
+
+		memset(&msg, 0, sizeof(msg));
+		msg.msg_iov = io_vector;
+		msg.msg_iovlen = 1;
+		msg.msg_name = &server_addr;
+		msg.msg_namelen = sizeof(server_addr);
+
+		/* The datagram is looped back to the receiving socket, the
+		 * call must not wait for it to be read.
+		 */
+		rv = zsock_sendmsg(client_sock, &msg, 0);
+		zassert_equal(rv, sizeof(zerocopy_data), "sendmsg failed (%d)", -errno);
+
+		/* Overwriting the iovec does not change the queued data */
+		memset(zerocopy_data, 0, sizeof(zerocopy_data));
+
+		rv = zsock_recv(server_sock, recv_buf, sizeof(recv_buf), ZSOCK_MSG_DONTWAIT);
+		zassert_equal(rv, sizeof(recv_buf), "recv failed (%d)", -errno);
+
+		for (size_t j = 0; j < sizeof(recv_buf); j++) {
+			zassert_equal(recv_buf[j], 0x5a + i, "Invalid data at %zu", j);
+		}
+
+		rv = zsock_close(client_sock);
+		zassert_equal(rv, 0, "close failed");
+		rv = zsock_close(server_sock);
+		zassert_equal(rv, 0, "close failed");
+	}
+#endif
+}
+
 void test_msg_trunc(int sock_c, int sock_s, struct net_sockaddr *addr_c,
 		    net_socklen_t addrlen_c, struct net_sockaddr *addr_s,
 		    net_socklen_t addrlen_s)
@@ -3758,6 +3910,159 @@ ZTEST(net_socket_udp, test_v6_rebinding)
 	test_rebinding_common(NET_AF_INET6);
 }
 
+#define MMSG_COUNT 3
+
+static ZTEST_BMEM char mmsg_rx_buf[MMSG_COUNT][sizeof(TEST_STR_SMALL)];
+static ZTEST_BMEM struct net_iovec mmsg_iov[MMSG_COUNT];
+static ZTEST_BMEM struct net_mmsghdr mmsg[MMSG_COUNT];
+
+ZTEST_USER(net_socket_udp, test_v4_sendmmsg_recvmmsg)
+{
+	int rv;
+	int client_sock;
+	int server_sock;
+	struct net_sockaddr_in client_addr;
+	struct net_sockaddr_in server_addr;
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, ANY_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = zsock_bind(server_sock,
+			(struct net_sockaddr *)&server_addr,
+			sizeof(server_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	(void)memset(mmsg, 0, sizeof(mmsg));
+
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		mmsg_iov[i].iov_base = TEST_STR_SMALL;
+		mmsg_iov[i].iov_len = STRLEN(TEST_STR_SMALL) - i;
+		mmsg[i].msg_hdr.msg_name = &server_addr;
+		mmsg[i].msg_hdr.msg_namelen = sizeof(server_addr);
+		mmsg[i].msg_hdr.msg_iov = &mmsg_iov[i];
+		mmsg[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	rv = zsock_sendmmsg(client_sock, mmsg, MMSG_COUNT, 0);
+	zassert_equal(rv, MMSG_COUNT, "sendmmsg failed (%d)", errno);
+
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		zassert_equal(mmsg[i].msg_len, STRLEN(TEST_STR_SMALL) - i,
+			      "wrong msg_len for message %d", i);
+	}
+
+	(void)memset(mmsg, 0, sizeof(mmsg));
+	(void)memset(mmsg_rx_buf, 0, sizeof(mmsg_rx_buf));
+
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		mmsg_iov[i].iov_base = mmsg_rx_buf[i];
+		mmsg_iov[i].iov_len = sizeof(mmsg_rx_buf[i]);
+		mmsg[i].msg_hdr.msg_iov = &mmsg_iov[i];
+		mmsg[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	/* Loopback delivery is synchronous, so all datagrams are queued */
+	rv = zsock_recvmmsg(server_sock, mmsg, MMSG_COUNT, ZSOCK_MSG_WAITFORONE);
+	zassert_equal(rv, MMSG_COUNT, "recvmmsg failed (%d)", errno);
+
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		zassert_equal(mmsg[i].msg_len, STRLEN(TEST_STR_SMALL) - i,
+			      "wrong msg_len for message %d", i);
+		zassert_mem_equal(mmsg_rx_buf[i], TEST_STR_SMALL, mmsg[i].msg_len,
+				  "wrong data in message %d", i);
+	}
+
+	/* Nothing is left in the receive queue */
+	rv = zsock_recvmmsg(server_sock, mmsg, 1, ZSOCK_MSG_DONTWAIT);
+	zassert_equal(rv, -1, "recvmmsg should fail");
+	zassert_equal(errno, EAGAIN, "unexpected errno (%d)", errno);
+
+	rv = zsock_close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = zsock_close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
+ZTEST(net_socket_udp, test_v4_recv_view)
+{
+	int rv;
+	int client_sock;
+	int server_sock;
+	size_t offset = 0;
+	struct zsock_rx_view view;
+	struct net_sockaddr_in client_addr;
+	struct net_sockaddr_in server_addr;
+	struct net_sockaddr_in *src_addr;
+	net_socklen_t addrlen = sizeof(client_addr);
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, ANY_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = zsock_bind(server_sock,
+			(struct net_sockaddr *)&server_addr,
+			sizeof(server_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	rv = zsock_bind(client_sock,
+			(struct net_sockaddr *)&client_addr,
+			sizeof(client_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	rv = zsock_getsockname(client_sock, (struct net_sockaddr *)&client_addr, &addrlen);
+	zassert_equal(rv, 0, "getsockname failed");
+
+	rv = zsock_recv_view(server_sock, &view, ZSOCK_MSG_DONTWAIT);
+	zassert_equal(rv, -1, "recv_view should fail");
+	zassert_equal(errno, EAGAIN, "unexpected errno (%d)", errno);
+
+	rv = zsock_sendto(client_sock, BUF_AND_SIZE(TEST_STR2), 0,
+			  (struct net_sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(rv, STRLEN(TEST_STR2), "sendto failed");
+
+	rv = zsock_recv_view(server_sock, &view, 0);
+	zassert_equal(rv, STRLEN(TEST_STR2), "recv_view failed (%d)", errno);
+	zassert_equal(view.len, STRLEN(TEST_STR2), "wrong view length");
+	zassert_equal(view.flags, 0, "view unexpectedly truncated");
+
+	/* The datagram is larger than one net_buf, so it is fragmented */
+	zassert_true(view.iovcnt > 1, "expected several fragments");
+
+	for (size_t i = 0; i < view.iovcnt; i++) {
+		zassert_mem_equal(view.iov[i].iov_base, TEST_STR2 + offset,
+				  view.iov[i].iov_len, "wrong data in fragment %zu", i);
+		offset += view.iov[i].iov_len;
+	}
+
+	/* The view tells where the datagram came from */
+	src_addr = (struct net_sockaddr_in *)&view.src_addr;
+	zassert_equal(view.addrlen, sizeof(struct net_sockaddr_in), "wrong address length");
+	zassert_equal(src_addr->sin_family, NET_AF_INET, "wrong address family");
+	zassert_equal(src_addr->sin_port, client_addr.sin_port, "wrong source port");
+	zassert_true(net_ipv4_addr_cmp(&src_addr->sin_addr, &client_addr.sin_addr),
+		     "wrong source address");
+
+	rv = zsock_recv_view_release(server_sock, &view);
+	zassert_equal(rv, 0, "recv_view_release failed");
+
+	rv = zsock_recv(server_sock, rx_buf, sizeof(rx_buf), ZSOCK_MSG_DONTWAIT);
+	zassert_equal(rv, -1, "datagram was not consumed");
+	zassert_equal(errno, EAGAIN, "unexpected errno (%d)", errno);
+
+	/* Reply to the source address of the view */
+	rv = zsock_sendto(server_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0,
+			  (struct net_sockaddr *)&view.src_addr, view.addrlen);
+	zassert_equal(rv, STRLEN(TEST_STR_SMALL), "sendto failed");
+
+	rv = zsock_recv(client_sock, rx_buf, sizeof(rx_buf), 0);
+	zassert_equal(rv, STRLEN(TEST_STR_SMALL), "reply not received");
+	zassert_mem_equal(rx_buf, TEST_STR_SMALL, STRLEN(TEST_STR_SMALL), "wrong reply");
+
+	rv = zsock_close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = zsock_close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
 static void after(void *arg)
 {
 	ARG_UNUSED(arg);
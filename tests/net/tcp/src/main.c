@@ -240,6 +240,11 @@ static uint8_t tcp_options[20] = {
 	0x01, /* NOP */
 	0x03, 0x03, 0x07 /* Win scale*/ };
 
+/* Carried by the other segments, must not affect the SYN options */
+static uint8_t tcp_sack_option[12] = {
+	0x01, 0x01, /* NOP */
+	0x05, 0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 /* SACK */ };
+
 static struct net_pkt *tester_prepare_tcp_pkt(net_sa_family_t af,
 					      uint16_t src_port,
 					      uint16_t dst_port,
@@ -253,8 +258,8 @@ static struct net_pkt *tester_prepare_tcp_pkt(net_sa_family_t af,
 	uint8_t opts_len = 0;
 	int ret = -EINVAL;
 
-	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
-		opts_len = sizeof(tcp_options);
+	if (test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) {
+		opts_len = (flags & SYN) ? sizeof(tcp_options) : sizeof(tcp_sack_option);
 	}
 
 	/* Allocate buffer */
@@ -289,11 +294,7 @@ static struct net_pkt *tester_prepare_tcp_pkt(net_sa_family_t af,
 	th->th_sport = src_port;
 	th->th_dport = dst_port;
 
-	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
-		th->th_off = 10U;
-	} else {
-		th->th_off = 5U;
-	}
+	th->th_off = 5U + opts_len / 4U;
 
 	th->th_flags = flags;
 	th->th_win = net_htons(NET_IPV6_MTU);
@@ -308,9 +309,10 @@ static struct net_pkt *tester_prepare_tcp_pkt(net_sa_family_t af,
 		goto fail;
 	}
 
-	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
+	if (opts_len > 0) {
 		/* Add TCP Options */
-		ret = net_pkt_write(pkt, tcp_options, opts_len);
+		ret = net_pkt_write(pkt, (flags & SYN) ? tcp_options : tcp_sack_option,
+				    opts_len);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -904,6 +906,7 @@ ZTEST(net_tcp, test_server_ipv4)
 ZTEST(net_tcp, test_server_with_options_ipv4)
 {
 	struct net_context *ctx;
+	struct tcp *conn;
 	int ret;
 
 	t_state = T_SYN;
@@ -941,6 +944,11 @@ ZTEST(net_tcp, test_server_with_options_ipv4)
 	 */
 	test_sem_take(K_MSEC(100), __LINE__);
 
+	/* The SACK option of the handshake ACK must keep the MSS of the SYN */
+	conn = accepted_ctx->tcp;
+	zassert_true(conn->recv_options.mss_found, "MSS option lost");
+	zassert_equal(conn->recv_options.mss, 1460, "Wrong MSS %u", conn->recv_options.mss);
+
 	/* Trigger the peer to send DATA  */
 	k_work_reschedule(&test_server, K_NO_WAIT);
 
@@ -2095,7 +2103,7 @@ static struct out_of_order_check_struct out_of_order_check_list[] = {
 	{ 30, 10, 0, 0}, /* First packet will be out-of-order */
 	{ 20, 12, 0, 0},
 	{ 10,  9, 0, 0}, /* Section with a gap */
-	{ 0,  10, 10, 0},
+	{ 0,  10, 19, 0}, /* Data up to the gap delivered */
 	{ 10, 10, 40, 0}, /* First sequence complete */
 	{ 32,  6, 40, 0}, /* Invalid seqnum (old) */
 	{ 30, 16, 46, 0}, /* Partial data valid */
@@ -3209,4 +3217,141 @@ ZTEST(net_tcp, test_server_fin_ack_after_data)
 	k_sleep(K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY));
 }
 
+#if defined(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)
+static struct tcp *ca_conn_get(const char *name, struct net_context **ctx)
+{
+	const struct tcp_ca_ops *ca_ops = NULL;
+	struct tcp *conn;
+	int ret;
+
+	STRUCT_SECTION_FOREACH(tcp_ca_ops, ops) {
+		if (strcmp(ops->name, name) == 0) {
+			ca_ops = ops;
+		}
+	}
+
+	zassert_not_null(ca_ops, "No %s congestion control", name);
+
+	ret = net_context_get(NET_AF_INET, NET_SOCK_STREAM, NET_IPPROTO_TCP, ctx);
+	zassert_ok(ret, "Failed to get net_context");
+
+	ret = net_context_bind(*ctx, (struct net_sockaddr *)&my_addr_s,
+			       sizeof(struct net_sockaddr_in));
+	zassert_ok(ret, "Failed to bind net_context");
+
+	conn = (*ctx)->tcp;
+	conn->recv_options.mss = 1000;
+	conn->recv_options.mss_found = true;
+	conn->ca.ops = ca_ops;
+	conn->ca.ops->init(conn);
+
+	return conn;
+}
+
+/* Test that New Reno keeps its initial window of one segment, only the
+ * CUBIC and BBR modules start at 10 segments.
+ */
+ZTEST(net_tcp, test_ca_reno_initial_window)
+{
+	struct net_context *ctx;
+	struct tcp *conn;
+
+	conn = ca_conn_get("reno", &ctx);
+
+	zassert_equal(conn->ca.cwnd, conn_mss(conn),
+		      "Wrong initial window %u", conn->ca.cwnd);
+
+	net_context_put(ctx);
+}
+#endif /* CONFIG_NET_TCP_CONGESTION_AVOIDANCE */
+
+#if defined(CONFIG_NET_TCP_CA_CUBIC)
+/* Test the window growth of the CUBIC congestion control:
+ *   the window starts at 10 segments (RFC 6928),
+ *   grows by a segment per ACK in slow start, past 64 KiB,
+ *   grows slower than slow start in congestion avoidance,
+ *   is not deflated below a segment in fast recovery.
+ */
+ZTEST(net_tcp, test_ca_cubic_window)
+{
+	struct net_context *ctx;
+	struct tcp *conn;
+	uint32_t mss;
+	uint32_t cwnd;
+
+	conn = ca_conn_get("cubic", &ctx);
+	mss = conn_mss(conn);
+
+	zassert_equal(conn->ca.cwnd, MIN(10 * mss, MAX(2 * mss, 14600)),
+		      "Wrong initial window %u", conn->ca.cwnd);
+
+	conn->ca.ssthresh = UINT32_MAX;
+	conn->ca.cwnd = UINT16_MAX - mss / 2;
+	conn->ca.ops->pkts_acked(conn, mss);
+	zassert_equal(conn->ca.cwnd, UINT16_MAX - mss / 2 + mss,
+		      "Window %u did not grow past 64 KiB", conn->ca.cwnd);
+
+	conn->ca.ssthresh = conn->ca.cwnd;
+	cwnd = conn->ca.cwnd;
+
+	for (int i = 0; i < 10; i++) {
+		conn->ca.ops->pkts_acked(conn, mss);
+	}
+
+	zassert_true(conn->ca.cwnd > cwnd, "Window %u did not grow", conn->ca.cwnd);
+	zassert_true(conn->ca.cwnd < cwnd + 10 * mss, "Window %u grew like slow start",
+		     conn->ca.cwnd);
+
+	/* Partial ACKs in fast recovery with a window below a segment */
+	conn->ca.pending_fast_retransmit_bytes = 10 * mss;
+	conn->ca.cwnd = mss / 2;
+	conn->ca.ops->pkts_acked(conn, mss);
+	zassert_equal(conn->ca.cwnd, mss / 2, "Window %u underflowed", conn->ca.cwnd);
+
+	net_context_put(ctx);
+}
+#endif /* CONFIG_NET_TCP_CA_CUBIC */
+
+#if defined(CONFIG_NET_TCP_CA_BBR)
+/* Test the window growth of the BBR congestion control:
+ *   the window starts at 10 segments (RFC 6928),
+ *   grows by the acked bytes, past 64 KiB, until the model is available,
+ *   does not grow past the bandwidth-delay product once it is available.
+ */
+ZTEST(net_tcp, test_ca_bbr_window)
+{
+	struct net_context *ctx;
+	struct tcp *conn;
+	uint32_t mss;
+	uint32_t cwnd;
+
+	conn = ca_conn_get("bbr", &ctx);
+	mss = conn_mss(conn);
+	cwnd = conn->ca.cwnd;
+
+	zassert_equal(cwnd, MIN(10 * mss, MAX(2 * mss, 14600)),
+		      "Wrong initial window %u", cwnd);
+
+	for (int i = 0; i < 100; i++) {
+		conn->ca.ops->pkts_acked(conn, mss);
+	}
+
+	zassert_equal(conn->ca.cwnd, cwnd + 100 * mss, "Window %u did not grow",
+		      conn->ca.cwnd);
+	zassert_true(conn->ca.cwnd > UINT16_MAX, "Window %u limited to 64 KiB",
+		     conn->ca.cwnd);
+
+	/* 1 MB/s and 10 ms make a bandwidth-delay product of 10 kB */
+	conn->ca.bbr.btl_bw = 1000000;
+	conn->ca.bbr.min_rtt_us = 10000;
+	conn->ca.bbr.round_start = k_cycle_get_32();
+	conn->ca.cwnd = 40000;
+	conn->ca.ops->pkts_acked(conn, mss);
+	zassert_equal(conn->ca.cwnd, 40000, "Window %u grew past the model",
+		      conn->ca.cwnd);
+
+	net_context_put(ctx);
+}
+#endif /* CONFIG_NET_TCP_CA_BBR */
+
 ZTEST_SUITE(net_tcp, NULL, presetup, NULL, NULL, NULL);
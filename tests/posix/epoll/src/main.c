@@ -0,0 +1,291 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/posix/sys/epoll.h>
+#include <zephyr/posix/sys/eventfd.h>
+#include <zephyr/posix/unistd.h>
+#include <zephyr/ztest.h>
+
+#define NUM_FDS     4
+#define STACK_SIZE  (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define DELAY_MS    100
+
+struct epoll_fixture {
+	int epfd;
+	int fds[NUM_FDS];
+};
+
+static struct epoll_fixture test_fixture;
+
+static K_THREAD_STACK_DEFINE(helper_stack, STACK_SIZE);
+static struct k_thread helper_thread;
+
+static void add_fd(int epfd, int fd, uint32_t events)
+{
+	struct epoll_event ev = {
+		.events = events,
+		.data.fd = fd,
+	};
+
+	zassert_ok(epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev), "errno %d", errno);
+}
+
+static void signal_fd(int fd)
+{
+	zassert_ok(eventfd_write(fd, 1));
+}
+
+static void drain_fd(int fd)
+{
+	eventfd_t val;
+
+	zassert_ok(eventfd_read(fd, &val));
+}
+
+ZTEST_F(epoll, test_ctl_errors)
+{
+	struct epoll_event ev = {
+		.events = EPOLLIN,
+	};
+
+	add_fd(fixture->epfd, fixture->fds[0], EPOLLIN);
+
+	zassert_equal(epoll_ctl(fixture->epfd, EPOLL_CTL_ADD, fixture->fds[0], &ev), -1);
+	zassert_equal(errno, EEXIST);
+
+	zassert_equal(epoll_ctl(fixture->epfd, EPOLL_CTL_MOD, fixture->fds[1], &ev), -1);
+	zassert_equal(errno, ENOENT);
+
+	zassert_equal(epoll_ctl(fixture->epfd, EPOLL_CTL_DEL, fixture->fds[1], NULL), -1);
+	zassert_equal(errno, ENOENT);
+
+	zassert_equal(epoll_ctl(fixture->epfd, EPOLL_CTL_ADD, fixture->epfd, &ev), -1);
+	zassert_equal(errno, EINVAL);
+
+	zassert_equal(epoll_ctl(fixture->epfd, EPOLL_CTL_ADD, -1, &ev), -1);
+	zassert_equal(errno, EBADF);
+
+	zassert_equal(epoll_ctl(fixture->fds[1], EPOLL_CTL_ADD, fixture->fds[0], &ev), -1);
+	zassert_equal(errno, EINVAL);
+
+	zassert_equal(epoll_ctl(fixture->epfd, EPOLL_CTL_ADD, fixture->fds[1], NULL), -1);
+	zassert_equal(errno, EFAULT);
+
+	zassert_equal(epoll_wait(fixture->epfd, &ev, 0, 0), -1);
+	zassert_equal(errno, EINVAL);
+
+	zassert_ok(epoll_ctl(fixture->epfd, EPOLL_CTL_DEL, fixture->fds[0], NULL));
+}
+
+ZTEST_F(epoll, test_only_ready_fds)
+{
+	struct epoll_event events[NUM_FDS];
+	int ret;
+
+	for (int i = 0; i < NUM_FDS; i++) {
+		add_fd(fixture->epfd, fixture->fds[i], EPOLLIN);
+	}
+
+	ret = epoll_wait(fixture->epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(ret, 0, "ret %d", ret);
+
+	signal_fd(fixture->fds[2]);
+
+	ret = epoll_wait(fixture->epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(ret, 1, "ret %d", ret);
+	zassert_equal(events[0].data.fd, fixture->fds[2]);
+	zassert_equal(events[0].events, EPOLLIN);
+
+	/* Level-triggered, reported until the data is consumed */
+	ret = epoll_wait(fixture->epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(ret, 1, "ret %d", ret);
+
+	drain_fd(fixture->fds[2]);
+
+	ret = epoll_wait(fixture->epfd, events, ARRAY_SIZE(events), DELAY_MS);
+	zassert_equal(ret, 0, "ret %d", ret);
+
+	signal_fd(fixture->fds[0]);
+	signal_fd(fixture->fds[3]);
+
+	/* The registrations survive, and a short array gets one at a time */
+	ret = epoll_wait(fixture->epfd, events, 1, 0);
+	zassert_equal(ret, 1, "ret %d", ret);
+
+	ret = epoll_wait(fixture->epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(ret, 2, "ret %d", ret);
+}
+
+ZTEST_F(epoll, test_edge_triggered)
+{
+	struct epoll_event events[NUM_FDS];
+	int ret;
+
+	add_fd(fixture->epfd, fixture->fds[0], EPOLLIN | EPOLLET);
+
+	signal_fd(fixture->fds[0]);
+
+	ret = epoll_wait(fixture->epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(ret, 1, "ret %d", ret);
+
+	/* Still readable, but not a new edge */
+	ret = epoll_wait(fixture->epfd, events, ARRAY_SIZE(events), DELAY_MS);
+	zassert_equal(ret, 0, "ret %d", ret);
+
+	drain_fd(fixture->fds[0]);
+
+	ret = epoll_wait(fixture->epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(ret, 0, "ret %d", ret);
+
+	signal_fd(fixture->fds[0]);
+
+	ret = epoll_wait(fixture->epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(ret, 1, "ret %d", ret);
+	zassert_equal(events[0].data.fd, fixture->fds[0]);
+}
+
+ZTEST_F(epoll, test_oneshot)
+{
+	struct epoll_event events[NUM_FDS];
+	struct epoll_event ev = {
+		.events = EPOLLIN | EPOLLONESHOT,
+		.data.u32 = 42,
+	};
+	int ret;
+
+	zassert_ok(epoll_ctl(fixture->epfd, EPOLL_CTL_ADD, fixture->fds[1], &ev));
+
+	signal_fd(fixture->fds[1]);
+
+	ret = epoll_wait(fixture->epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(ret, 1, "ret %d", ret);
+	zassert_equal(events[0].data.u32, 42);
+
+	drain_fd(fixture->fds[1]);
+	signal_fd(fixture->fds[1]);
+
+	ret = epoll_wait(fixture->epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(ret, 0, "ret %d", ret);
+
+	/* Re-armed */
+	zassert_ok(epoll_ctl(fixture->epfd, EPOLL_CTL_MOD, fixture->fds[1], &ev));
+
+	ret = epoll_wait(fixture->epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(ret, 1, "ret %d", ret);
+}
+
+static void delayed_write(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_msleep(DELAY_MS);
+	signal_fd(POINTER_TO_INT(p1));
+}
+
+ZTEST_F(epoll, test_blocking_wait)
+{
+	struct epoll_event events[NUM_FDS];
+	int ret;
+
+	for (int i = 0; i < NUM_FDS; i++) {
+		add_fd(fixture->epfd, fixture->fds[i], EPOLLIN);
+	}
+
+	k_thread_create(&helper_thread, helper_stack, K_THREAD_STACK_SIZEOF(helper_stack),
+			delayed_write, INT_TO_POINTER(fixture->fds[1]), NULL, NULL,
+			K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+
+	ret = epoll_wait(fixture->epfd, events, ARRAY_SIZE(events), -1);
+	zassert_equal(ret, 1, "ret %d", ret);
+	zassert_equal(events[0].data.fd, fixture->fds[1]);
+
+	zassert_ok(k_thread_join(&helper_thread, K_FOREVER));
+}
+
+static void delayed_add(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p3);
+
+	k_msleep(DELAY_MS);
+	add_fd(POINTER_TO_INT(p1), POINTER_TO_INT(p2), EPOLLIN);
+}
+
+ZTEST_F(epoll, test_ctl_while_waiting)
+{
+	struct epoll_event events[NUM_FDS];
+	int ret;
+
+	add_fd(fixture->epfd, fixture->fds[0], EPOLLIN);
+	signal_fd(fixture->fds[3]);
+
+	k_thread_create(&helper_thread, helper_stack, K_THREAD_STACK_SIZEOF(helper_stack),
+			delayed_add, INT_TO_POINTER(fixture->epfd),
+			INT_TO_POINTER(fixture->fds[3]), NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+
+	ret = epoll_wait(fixture->epfd, events, ARRAY_SIZE(events), 10 * DELAY_MS);
+	zassert_equal(ret, 1, "ret %d", ret);
+	zassert_equal(events[0].data.fd, fixture->fds[3]);
+
+	zassert_ok(k_thread_join(&helper_thread, K_FOREVER));
+}
+
+ZTEST_F(epoll, test_closed_fd_is_dropped)
+{
+	struct epoll_event events[NUM_FDS];
+	int ret;
+
+	add_fd(fixture->epfd, fixture->fds[0], EPOLLIN);
+	signal_fd(fixture->fds[0]);
+
+	zassert_ok(close(fixture->fds[0]));
+	fixture->fds[0] = -1;
+
+	ret = epoll_wait(fixture->epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(ret, 0, "ret %d", ret);
+
+	fixture->fds[0] = eventfd(0, 0);
+	zassert_true(fixture->fds[0] >= 0);
+
+	/* The descriptor number may be reused, it is a new registration */
+	add_fd(fixture->epfd, fixture->fds[0], EPOLLIN);
+}
+
+static void *setup(void)
+{
+	return &test_fixture;
+}
+
+static void before(void *arg)
+{
+	struct epoll_fixture *fixture = arg;
+
+	fixture->epfd = epoll_create1(0);
+	zassert_true(fixture->epfd >= 0, "errno %d", errno);
+
+	for (int i = 0; i < NUM_FDS; i++) {
+		fixture->fds[i] = eventfd(0, EFD_NONBLOCK);
+		zassert_true(fixture->fds[i] >= 0, "errno %d", errno);
+	}
+}
+
+static void after(void *arg)
+{
+	struct epoll_fixture *fixture = arg;
+
+	for (int i = 0; i < NUM_FDS; i++) {
+		if (fixture->fds[i] >= 0) {
+			close(fixture->fds[i]);
+		}
+	}
+
+	close(fixture->epfd);
+}
+
+ZTEST_SUITE(epoll, NULL, setup, before, after, NULL);
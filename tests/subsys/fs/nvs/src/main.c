@@ -981,6 +981,219 @@ ZTEST_F(nvs, test_nvs_cache_hash_quality)
 #endif
 }
 
+#ifdef CONFIG_NVS_ATE_INDEX
+static uint32_t ate_index_addr_get(struct nvs_fs *fs, uint16_t id)
+{
+	for (size_t i = 0; i < CONFIG_NVS_ATE_INDEX_SIZE; i++) {
+		if (fs->ate_index_addr[i] != NVS_LOOKUP_CACHE_NO_ADDR && fs->ate_index_id[i] == id) {
+			return fs->ate_index_addr[i];
+		}
+	}
+
+	return NVS_LOOKUP_CACHE_NO_ADDR;
+}
+
+static size_t num_ate_index_entries_in_sector(struct nvs_fs *fs, uint32_t sector)
+{
+	size_t num = 0;
+
+	for (size_t i = 0; i < CONFIG_NVS_ATE_INDEX_SIZE; i++) {
+		if (fs->ate_index_addr[i] != NVS_LOOKUP_CACHE_NO_ADDR &&
+		    (fs->ate_index_addr[i] >> ADDR_SECT_SHIFT) == sector) {
+			num++;
+		}
+	}
+
+	return num;
+}
+
+#ifdef CONFIG_TEST_NVS_SIMULATOR
+static int flash_sim_read_calls_find(struct stats_hdr *hdr, void *arg,
+				     const char *name, uint16_t off)
+{
+	if (!strcmp(name, "flash_read_calls")) {
+		uint32_t **flash_read_stat = (uint32_t **) arg;
+		*flash_read_stat = (uint32_t *)((uint8_t *)hdr + off);
+	}
+
+	return 0;
+}
+#endif /* CONFIG_TEST_NVS_SIMULATOR */
+#endif /* CONFIG_NVS_ATE_INDEX */
+
+/*
+ * Test that the NVS ATE index is rebuilt on nvs_mount() and follows the writes.
+ */
+ZTEST_F(nvs, test_nvs_ate_index_init)
+{
+#ifdef CONFIG_NVS_ATE_INDEX
+	int err;
+	uint32_t ate_addr;
+	uint8_t data = 0;
+
+	fixture->fs.sector_count = 3;
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+	zassert_equal(fixture->fs.ate_index_count, 0, "uninitialized index");
+
+	ate_addr = fixture->fs.ate_wra;
+	err = nvs_write(&fixture->fs, 1, &data, sizeof(data));
+	zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	zassert_equal(fixture->fs.ate_index_count, 1, "index not updated after write");
+	zassert_equal(ate_index_addr_get(&fixture->fs, 1), ate_addr,
+		      "invalid index entry after write");
+
+	/* A new ATE of the same ID replaces the entry */
+	data++;
+	ate_addr = fixture->fs.ate_wra;
+	err = nvs_write(&fixture->fs, 1, &data, sizeof(data));
+	zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	zassert_equal(fixture->fs.ate_index_count, 1, "duplicate index entry");
+	zassert_equal(ate_index_addr_get(&fixture->fs, 1), ate_addr,
+		      "invalid index entry after update");
+
+	memset(fixture->fs.ate_index_addr, 0xAA, sizeof(fixture->fs.ate_index_addr));
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+	zassert_equal(fixture->fs.ate_index_count, 1, "uninitialized index after restart");
+	zassert_equal(ate_index_addr_get(&fixture->fs, 1), ate_addr,
+		      "invalid index entry after restart");
+#endif
+}
+
+/*
+ * Test that IDs are found when there are more of them than the index holds.
+ */
+ZTEST_F(nvs, test_nvs_ate_index_full)
+{
+#ifdef CONFIG_NVS_ATE_INDEX
+	const uint16_t num_ids = CONFIG_NVS_ATE_INDEX_SIZE;
+	int err;
+	uint16_t id;
+	uint16_t data;
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	for (id = 0; id < num_ids; id++) {
+		data = id;
+		err = nvs_write(&fixture->fs, id, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	}
+
+	zassert_true(fixture->fs.ate_index_full, "index should be full");
+
+	for (id = 0; id < num_ids; id++) {
+		err = nvs_read(&fixture->fs, id, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_read call failure: %d", err);
+		zassert_equal(data, id, "incorrect data read");
+	}
+
+	err = nvs_read(&fixture->fs, num_ids, &data, sizeof(data));
+	zassert_equal(err, -ENOENT, "missing ID found");
+
+	/* Deleting an ID left out of the index must be seen after a restart */
+	err = nvs_delete(&fixture->fs, num_ids - 1);
+	zassert_equal(err, 0, "nvs_delete call failure: %d", err);
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	err = nvs_read(&fixture->fs, num_ids - 1, &data, sizeof(data));
+	zassert_equal(err, -ENOENT, "deleted ID found");
+	err = nvs_read(&fixture->fs, 0, &data, sizeof(data));
+	zassert_equal(err, sizeof(data), "nvs_read call failure: %d", err);
+#endif
+}
+
+/*
+ * Test that the NVS ATE index does not point to a gc-ed sector and that the
+ * moved IDs are still found.
+ */
+ZTEST_F(nvs, test_nvs_ate_index_gc)
+{
+#ifdef CONFIG_NVS_ATE_INDEX
+	int err;
+	uint16_t data = 0;
+
+	fixture->fs.sector_count = 3;
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	/* ID 3 is only written once, then deleted, it must not survive the gc */
+	err = nvs_write(&fixture->fs, 3, &data, sizeof(data));
+	zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	err = nvs_delete(&fixture->fs, 3);
+	zassert_equal(err, 0, "nvs_delete call failure: %d", err);
+
+	/* Fill the first sector with writes of ID 1 */
+	while (fixture->fs.data_wra + sizeof(data) + sizeof(struct nvs_ate)
+	       <= fixture->fs.ate_wra) {
+		++data;
+		err = nvs_write(&fixture->fs, 1, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	}
+
+	zassert_equal(num_ate_index_entries_in_sector(&fixture->fs, 0), 2,
+		      "invalid index content after filling sector 0");
+
+	/* Fill the second sector with writes of ID 2 */
+	while ((fixture->fs.ate_wra >> ADDR_SECT_SHIFT) != 2) {
+		err = nvs_write(&fixture->fs, 2, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+		++data;
+	}
+
+	/* Sector 0 was gc-ed, ID 1 was moved to sector 2 and ID 3 dropped */
+	zassert_equal(num_ate_index_entries_in_sector(&fixture->fs, 0), 0,
+		      "index entries not invalidated after gc");
+	zassert_equal(num_ate_index_entries_in_sector(&fixture->fs, 2), 2,
+		      "invalid index content after gc");
+	zassert_equal(ate_index_addr_get(&fixture->fs, 3), NVS_LOOKUP_CACHE_NO_ADDR,
+		      "deleted ID still indexed after gc");
+
+	err = nvs_read(&fixture->fs, 1, &data, sizeof(data));
+	zassert_equal(err, sizeof(data), "nvs_read call failure: %d", err);
+	err = nvs_read(&fixture->fs, 3, &data, sizeof(data));
+	zassert_equal(err, -ENOENT, "deleted ID found after gc");
+#endif
+}
+
+/*
+ * Test that looking up an ID never written does not read the flash.
+ */
+ZTEST_F(nvs, test_nvs_ate_index_bloom)
+{
+#if defined(CONFIG_NVS_ATE_INDEX) && defined(CONFIG_TEST_NVS_SIMULATOR)
+	int err;
+	uint16_t data = 0;
+	uint32_t *flash_read_stat;
+	uint32_t reads;
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	for (uint16_t id = 0; id < 8; id++) {
+		err = nvs_write(&fixture->fs, id, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	}
+
+	stats_walk(fixture->sim_stats, flash_sim_read_calls_find, &flash_read_stat);
+
+	/* Only one ATE is read for a stored ID */
+	reads = *flash_read_stat;
+	err = nvs_read(&fixture->fs, 5, &data, sizeof(data));
+	zassert_equal(err, sizeof(data), "nvs_read call failure: %d", err);
+	zassert_true(*flash_read_stat - reads <= 2, "too many flash reads: %u",
+		     *flash_read_stat - reads);
+
+	reads = *flash_read_stat;
+	err = nvs_read(&fixture->fs, 0x1234, &data, sizeof(data));
+	zassert_equal(err, -ENOENT, "missing ID found");
+	zassert_equal(*flash_read_stat, reads, "flash read for a missing ID");
+#endif
+}
+
 #ifdef CONFIG_TEST_NVS_SIMULATOR
 /*
  * Test NVS bad region initialization recovery.
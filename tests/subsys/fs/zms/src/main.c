@@ -909,6 +909,404 @@ ZTEST_F(zms, test_zms_cache_hash_quality)
 #endif
 }
 
+#ifdef CONFIG_ZMS_ATE_INDEX
+static uint64_t ate_index_addr_get(struct zms_fs *fs, zms_id_t id)
+{
+	for (int i = 0; i < CONFIG_ZMS_ATE_INDEX_SIZE; i++) {
+		if (fs->ate_index_addr[i] != ZMS_LOOKUP_CACHE_NO_ADDR && fs->ate_index_id[i] == id) {
+			return fs->ate_index_addr[i];
+		}
+	}
+
+	return ZMS_LOOKUP_CACHE_NO_ADDR;
+}
+
+static size_t num_ate_index_entries_in_sector(uint64_t sector, struct zms_fs *fs)
+{
+	size_t num = 0;
+
+	for (int i = 0; i < CONFIG_ZMS_ATE_INDEX_SIZE; i++) {
+		if (fs->ate_index_addr[i] != ZMS_LOOKUP_CACHE_NO_ADDR &&
+		    (fs->ate_index_addr[i] >> ADDR_SECT_SHIFT) == sector) {
+			num++;
+		}
+	}
+
+	return num;
+}
+
+#ifdef CONFIG_TEST_ZMS_SIMULATOR
+static int flash_sim_read_calls_find(struct stats_hdr *hdr, void *arg, const char *name,
+				     uint16_t off)
+{
+	if (!strcmp(name, "flash_read_calls")) {
+		uint32_t **flash_read_stat = (uint32_t **)arg;
+		*flash_read_stat = (uint32_t *)((uint8_t *)hdr + off);
+	}
+
+	return 0;
+}
+#endif /* CONFIG_TEST_ZMS_SIMULATOR */
+#endif /* CONFIG_ZMS_ATE_INDEX */
+
+/*
+ * Test that ZMS ATE index is rebuilt on zms_mount() and follows the writes.
+ */
+ZTEST_F(zms, test_zms_ate_index_init)
+{
+#ifdef CONFIG_ZMS_ATE_INDEX
+	int err;
+	uint64_t ate_addr;
+	uint8_t data = 0;
+
+	fixture->fs.sector_count = 3;
+	err = zms_mount(&fixture->fs);
+	zassert_true(err == 0, "zms_mount call failure: %d", err);
+	zassert_equal(fixture->fs.ate_index_count, 0, "uninitialized index");
+
+	ate_addr = fixture->fs.ate_wra;
+	err = zms_write(&fixture->fs, 1, &data, sizeof(data));
+	zassert_equal(err, sizeof(data), "zms_write call failure: %d", err);
+	zassert_equal(fixture->fs.ate_index_count, 1, "index not updated after write");
+	zassert_equal(ate_index_addr_get(&fixture->fs, 1), ate_addr,
+		      "invalid index entry after write");
+
+	/* A new ATE of the same ID replaces the entry */
+	data++;
+	ate_addr = fixture->fs.ate_wra;
+	err = zms_write(&fixture->fs, 1, &data, sizeof(data));
+	zassert_equal(err, sizeof(data), "zms_write call failure: %d", err);
+	zassert_equal(fixture->fs.ate_index_count, 1, "duplicate index entry");
+	zassert_equal(ate_index_addr_get(&fixture->fs, 1), ate_addr,
+		      "invalid index entry after update");
+
+	memset(fixture->fs.ate_index_addr, 0xAA, sizeof(fixture->fs.ate_index_addr));
+	err = zms_mount(&fixture->fs);
+	zassert_true(err == 0, "zms_mount call failure: %d", err);
+	zassert_equal(fixture->fs.ate_index_count, 1, "uninitialized index after restart");
+	zassert_equal(ate_index_addr_get(&fixture->fs, 1), ate_addr,
+		      "invalid index entry after restart");
+#else
+	ztest_test_skip();
+#endif
+}
+
+/*
+ * Test that ZMS IDs are found when there are more of them than the ATE index holds.
+ */
+ZTEST_F(zms, test_zms_ate_index_full)
+{
+#ifdef CONFIG_ZMS_ATE_INDEX
+	const uint32_t num_ids = CONFIG_ZMS_ATE_INDEX_SIZE;
+	int err;
+	uint32_t data;
+
+	fixture->fs.sector_count = 4;
+	err = zms_mount(&fixture->fs);
+	zassert_true(err == 0, "zms_mount call failure: %d", err);
+
+	for (uint32_t id = 0; id < num_ids; id++) {
+		data = id;
+		err = zms_write(&fixture->fs, id, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "zms_write call failure: %d", err);
+	}
+
+	zassert_true(fixture->fs.ate_index_full, "index should be full");
+
+	for (uint32_t id = 0; id < num_ids; id++) {
+		err = zms_read(&fixture->fs, id, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "zms_read call failure: %d", err);
+		zassert_equal(data, id, "incorrect data read");
+	}
+
+	err = zms_read(&fixture->fs, num_ids, &data, sizeof(data));
+	zassert_equal(err, -ENOENT, "missing ID found");
+
+	/* Deleting an ID left out of the index must be seen after a restart */
+	err = zms_delete(&fixture->fs, num_ids - 1);
+	zassert_equal(err, 0, "zms_delete call failure: %d", err);
+
+	err = zms_mount(&fixture->fs);
+	zassert_true(err == 0, "zms_mount call failure: %d", err);
+
+	err = zms_read(&fixture->fs, num_ids - 1, &data, sizeof(data));
+	zassert_equal(err, -ENOENT, "deleted ID found");
+	err = zms_read(&fixture->fs, 0, &data, sizeof(data));
+	zassert_equal(err, sizeof(data), "zms_read call failure: %d", err);
+#else
+	ztest_test_skip();
+#endif
+}
+
+/*
+ * Test that ZMS ATE index does not contain any address from gc-ed sector
+ */
+ZTEST_F(zms, test_zms_ate_index_gc)
+{
+#ifdef CONFIG_ZMS_ATE_INDEX
+	int err;
+	uint16_t data = 0;
+
+	fixture->fs.sector_count = 3;
+	err = zms_mount(&fixture->fs);
+	zassert_true(err == 0, "zms_mount call failure: %d", err);
+
+	/* Fill the first sector with writes of ID 1 */
+
+	while (fixture->fs.data_wra + sizeof(data) + sizeof(struct zms_ate) <=
+	       fixture->fs.ate_wra) {
+		++data;
+		err = zms_write(&fixture->fs, 1, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "zms_write call failure: %d", err);
+	}
+
+	zassert_equal(num_ate_index_entries_in_sector(0, &fixture->fs), 1,
+		      "invalid index content after filling sector 0");
+
+	/* Fill the second sector with writes of ID 2 */
+
+	while ((fixture->fs.ate_wra >> ADDR_SECT_SHIFT) != 2) {
+		++data;
+		err = zms_write(&fixture->fs, 2, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "zms_write call failure: %d", err);
+	}
+
+	/* Sector 0 should have been gc-ed and ID 1 moved to sector 2 */
+
+	zassert_equal(num_ate_index_entries_in_sector(0, &fixture->fs), 0,
+		      "index entries not invalidated after gc");
+	zassert_equal(num_ate_index_entries_in_sector(2, &fixture->fs), 2,
+		      "invalid index content after gc");
+
+	err = zms_read(&fixture->fs, 1, &data, sizeof(data));
+	zassert_equal(err, sizeof(data), "zms_read call failure: %d", err);
+#else
+	ztest_test_skip();
+#endif
+}
+
+/*
+ * Test that looking up a ZMS ID never written does not read the flash.
+ */
+ZTEST_F(zms, test_zms_ate_index_bloom)
+{
+#if defined(CONFIG_ZMS_ATE_INDEX) && defined(CONFIG_TEST_ZMS_SIMULATOR)
+	int err;
+	uint16_t data = 0;
+	uint32_t *flash_read_stat;
+	uint32_t reads;
+
+	err = zms_mount(&fixture->fs);
+	zassert_true(err == 0, "zms_mount call failure: %d", err);
+
+	for (uint32_t id = 0; id < 8; id++) {
+		err = zms_write(&fixture->fs, id, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "zms_write call failure: %d", err);
+	}
+
+	stats_walk(fixture->sim_stats, flash_sim_read_calls_find, &flash_read_stat);
+
+	reads = *flash_read_stat;
+	err = zms_read(&fixture->fs, 0x1234, &data, sizeof(data));
+	zassert_equal(err, -ENOENT, "missing ID found");
+	zassert_equal(*flash_read_stat, reads, "flash read for a missing ID");
+#else
+	ztest_test_skip();
+#endif
+}
+
+#ifdef CONFIG_ZMS_GC_INCREMENTAL
+/* Fill the first two sectors, the last write starts the gc of sector 0 */
+static void start_incremental_gc(struct zms_fs *fs)
+{
+	int err;
+	uint16_t data = 0;
+
+	while (fs->data_wra + sizeof(data) + sizeof(struct zms_ate) <= fs->ate_wra) {
+		++data;
+		err = zms_write(fs, 1, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "zms_write call failure: %d", err);
+	}
+
+	while ((fs->ate_wra >> ADDR_SECT_SHIFT) != 2) {
+		++data;
+		err = zms_write(fs, 2, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "zms_write call failure: %d", err);
+	}
+}
+#endif
+
+/*
+ * Test that the gc started by a write is run by zms_gc_step() in several slices
+ * while the entries stay readable and writable.
+ */
+ZTEST_F(zms, test_zms_gc_incremental)
+{
+#if defined(CONFIG_ZMS_GC_INCREMENTAL) && !defined(CONFIG_ZMS_GC_WORKQUEUE)
+	int err;
+	int steps = 0;
+	uint16_t data;
+	uint16_t last_1;
+	uint16_t last_2;
+
+	fixture->fs.sector_count = 3;
+	err = zms_mount(&fixture->fs);
+	zassert_true(err == 0, "zms_mount call failure: %d", err);
+
+	start_incremental_gc(&fixture->fs);
+	zassert_equal(fixture->fs.gc_state, ZMS_GC_STATE_MOVE, "gc should be pending");
+	zassert_true(fixture->fs.gc_reserved > 0, "no space reserved for the gc");
+
+	err = zms_read(&fixture->fs, 1, &last_1, sizeof(last_1));
+	zassert_equal(err, sizeof(last_1), "zms_read call failure: %d", err);
+	err = zms_read(&fixture->fs, 2, &last_2, sizeof(last_2));
+	zassert_equal(err, sizeof(last_2), "zms_read call failure: %d", err);
+
+	data = 0x55aa;
+	err = zms_write(&fixture->fs, 3, &data, sizeof(data));
+	zassert_equal(err, sizeof(data), "zms_write call failure: %d", err);
+
+	do {
+		err = zms_gc_step(&fixture->fs, 1);
+		zassert_true(err >= 0, "zms_gc_step call failure: %d", err);
+		steps++;
+	} while (err > 0);
+
+	zassert_true(steps > 1, "gc not split in steps");
+	zassert_equal(fixture->fs.gc_state, ZMS_GC_STATE_IDLE, "gc still pending");
+	zassert_equal(fixture->fs.gc_reserved, 0, "space still reserved");
+
+	err = zms_gc_step(&fixture->fs, 1);
+	zassert_equal(err, 0, "no gc should be pending");
+
+	err = zms_mount(&fixture->fs);
+	zassert_true(err == 0, "zms_mount call failure: %d", err);
+
+	err = zms_read(&fixture->fs, 1, &data, sizeof(data));
+	zassert_equal(err, sizeof(data), "zms_read call failure: %d", err);
+	zassert_equal(data, last_1, "incorrect data read");
+	err = zms_read(&fixture->fs, 2, &data, sizeof(data));
+	zassert_equal(err, sizeof(data), "zms_read call failure: %d", err);
+	zassert_equal(data, last_2, "incorrect data read");
+	err = zms_read(&fixture->fs, 3, &data, sizeof(data));
+	zassert_equal(err, sizeof(data), "zms_read call failure: %d", err);
+	zassert_equal(data, 0x55aa, "incorrect data read");
+#else
+	ztest_test_skip();
+#endif
+}
+
+/*
+ * Test that a gc interrupted with entries written next to it is resumed on mount.
+ */
+ZTEST_F(zms, test_zms_gc_incremental_resume)
+{
+#if defined(CONFIG_ZMS_GC_INCREMENTAL) && !defined(CONFIG_ZMS_GC_WORKQUEUE)
+	int err;
+	uint16_t data;
+	uint16_t last_1;
+
+	fixture->fs.sector_count = 3;
+	err = zms_mount(&fixture->fs);
+	zassert_true(err == 0, "zms_mount call failure: %d", err);
+
+	start_incremental_gc(&fixture->fs);
+	err = zms_read(&fixture->fs, 1, &last_1, sizeof(last_1));
+	zassert_equal(err, sizeof(last_1), "zms_read call failure: %d", err);
+
+	err = zms_gc_step(&fixture->fs, 1);
+	zassert_equal(err, 1, "gc should be pending");
+
+	data = 0x55aa;
+	err = zms_write(&fixture->fs, 3, &data, sizeof(data));
+	zassert_equal(err, sizeof(data), "zms_write call failure: %d", err);
+
+	/* Mount as after a reset, the pending gc state is lost */
+	err = zms_mount(&fixture->fs);
+	zassert_true(err == 0, "zms_mount call failure: %d", err);
+	zassert_equal(fixture->fs.gc_state, ZMS_GC_STATE_IDLE, "gc not completed on mount");
+
+	err = zms_read(&fixture->fs, 1, &data, sizeof(data));
+	zassert_equal(err, sizeof(data), "zms_read call failure: %d", err);
+	zassert_equal(data, last_1, "incorrect data read");
+	err = zms_read(&fixture->fs, 3, &data, sizeof(data));
+	zassert_equal(err, sizeof(data), "zms_read call failure: %d", err);
+	zassert_equal(data, 0x55aa, "incorrect data read");
+#else
+	ztest_test_skip();
+#endif
+}
+
+/*
+ * Test that writes complete the pending gc when the active sector is full.
+ */
+ZTEST_F(zms, test_zms_gc_incremental_fallback)
+{
+#if defined(CONFIG_ZMS_GC_INCREMENTAL) && !defined(CONFIG_ZMS_GC_WORKQUEUE)
+	int err;
+	uint16_t data = 0;
+	uint16_t last_1;
+
+	fixture->fs.sector_count = 3;
+	err = zms_mount(&fixture->fs);
+	zassert_true(err == 0, "zms_mount call failure: %d", err);
+
+	start_incremental_gc(&fixture->fs);
+	err = zms_read(&fixture->fs, 1, &last_1, sizeof(last_1));
+	zassert_equal(err, sizeof(last_1), "zms_read call failure: %d", err);
+
+	/* Fill the active sector without ever calling zms_gc_step() */
+	while ((fixture->fs.ate_wra >> ADDR_SECT_SHIFT) == 2) {
+		++data;
+		err = zms_write(&fixture->fs, 3, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "zms_write call failure: %d", err);
+	}
+
+	err = zms_read(&fixture->fs, 1, &data, sizeof(data));
+	zassert_equal(err, sizeof(data), "zms_read call failure: %d", err);
+	zassert_equal(data, last_1, "incorrect data read");
+#else
+	ztest_test_skip();
+#endif
+}
+
+/*
+ * Test that the gc started by a write is run in the background by the ZMS work queue.
+ */
+ZTEST_F(zms, test_zms_gc_workqueue)
+{
+#ifdef CONFIG_ZMS_GC_WORKQUEUE
+	int err;
+	uint16_t data;
+	uint16_t last_1;
+
+	fixture->fs.sector_count = 3;
+	err = zms_mount(&fixture->fs);
+	zassert_true(err == 0, "zms_mount call failure: %d", err);
+
+	start_incremental_gc(&fixture->fs);
+	err = zms_read(&fixture->fs, 1, &last_1, sizeof(last_1));
+	zassert_equal(err, sizeof(last_1), "zms_read call failure: %d", err);
+
+	/* The work queue has the lowest priority, let it run */
+	for (int i = 0; i < 100 && fixture->fs.gc_state != ZMS_GC_STATE_IDLE; i++) {
+		k_msleep(10);
+	}
+
+	zassert_equal(fixture->fs.gc_state, ZMS_GC_STATE_IDLE, "gc still pending");
+	zassert_equal(fixture->fs.gc_reserved, 0, "space still reserved");
+
+	err = zms_gc_step(&fixture->fs, 1);
+	zassert_equal(err, 0, "no gc should be pending");
+
+	err = zms_read(&fixture->fs, 1, &data, sizeof(data));
+	zassert_equal(err, sizeof(data), "zms_read call failure: %d", err);
+	zassert_equal(data, last_1, "incorrect data read");
+#else
+	ztest_test_skip();
+#endif
+}
+
 ZTEST_F(zms, test_zms_input_validation)
 {
 	int err;
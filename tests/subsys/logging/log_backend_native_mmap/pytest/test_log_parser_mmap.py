@@ -0,0 +1,85 @@
+#
+# Copyright The Zephyr Project Contributors
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+
+'''
+Pytest harness to test the decoding of the ring file written by the
+memory-mapped dictionary logging backend of the native simulator.
+'''
+
+import logging
+import os
+import re
+import shlex
+import struct
+import subprocess
+import sys
+
+from twister_harness import DeviceAdapter
+
+ZEPHYR_BASE = os.getenv("ZEPHYR_BASE")
+PARSER_DIR = os.path.join(ZEPHYR_BASE, "scripts", "logging", "dictionary")
+
+sys.path.insert(0, PARSER_DIR)
+
+import log_parser_mmap  # noqa: E402
+
+logger = logging.getLogger(__name__)
+
+NUM_MSGS = 200
+
+
+def test_read_ring_wrap(tmp_path):
+    '''
+    Unroll a ring whose oldest frame starts near its end and wraps around.
+    '''
+    size = 16
+    frames = [b"abcde", b"fghijk"]
+    data = b"".join(struct.pack("<H", len(f)) + f for f in frames)
+    tail = 3 * size + 10
+    head = tail + len(data)
+
+    ring = bytearray(size)
+    for i, byte in enumerate(data):
+        ring[(tail + i) % size] = byte
+
+    hdr = struct.pack(log_parser_mmap.LOG_MMAP_HDR_FMT, log_parser_mmap.LOG_MMAP_MAGIC,
+                      log_parser_mmap.LOG_MMAP_VERSION, size, head, tail, 3, 0)
+    ring_file = tmp_path / "ring.mmap"
+    ring_file.write_bytes(hdr + ring)
+
+    assert log_parser_mmap.read_ring(str(ring_file)) == b"".join(frames)
+
+
+def test_log_parser_mmap(dut: DeviceAdapter):
+    '''
+    Decode the ring file captured from the run of the test application.
+    '''
+    build_dir = dut.device_config.app_build_dir
+
+    # The ring file holds all the messages once the tests are done
+    dut.readlines_until(regex='PROJECT EXECUTION SUCCESSFUL', timeout=60.0)
+
+    parser_script = os.path.join(PARSER_DIR, "log_parser_mmap.py")
+    dictionary_json = os.path.join(build_dir, "zephyr", "log_dictionary.json")
+    ring_file = os.path.join(build_dir, "log_dict.mmap")
+    assert os.path.isfile(dictionary_json)
+    assert os.path.isfile(ring_file)
+
+    cmd = [parser_script, dictionary_json, ring_file]
+    logger.info(f'Running parser script: {shlex.join(cmd)}')
+    result = subprocess.run(cmd, capture_output=True, text=True, check=True)
+    assert result.returncode == 0
+
+    decoded_logs = result.stdout
+    logger.info(f'Decoded logs: {decoded_logs}')
+
+    # Only the most recent messages are left, oldest first
+    numbers = [int(n) for n in re.findall(rf'<inf> test_mmap: message ([0-9]+) of {NUM_MSGS}',
+                                          decoded_logs)]
+    assert numbers
+    assert numbers == list(range(numbers[0], NUM_MSGS))
+    assert numbers[0] > 0
+    assert re.search(r'--- [0-9]+ oldest messages were overwritten ---', result.stderr)
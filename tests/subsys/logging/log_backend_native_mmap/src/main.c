@@ -0,0 +1,85 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/ztest.h>
+
+LOG_MODULE_REGISTER(test_mmap, LOG_LEVEL_INF);
+
+#define RING_SIZE CONFIG_LOG_BACKEND_NATIVE_MMAP_SIZE
+#define NUM_MSGS  200
+
+/* Keep in sync with struct log_mmap_hdr in log_backend_native_mmap.c */
+struct log_mmap_hdr {
+	char magic[8];
+	uint32_t version;
+	uint32_t size;
+	uint64_t head;
+	uint64_t tail;
+	uint32_t overwritten;
+	uint32_t discarded;
+};
+
+extern struct log_mmap_hdr *log_mmap;
+
+static uint16_t frame_len(const uint8_t *ring, uint64_t pos)
+{
+	uint8_t len[sizeof(uint16_t)];
+
+	for (size_t i = 0; i < sizeof(len); i++) {
+		len[i] = ring[(pos + i) % RING_SIZE];
+	}
+
+	return UNALIGNED_GET((uint16_t *)len);
+}
+
+/* Count the frames from the tail, they must end exactly at the head */
+static uint32_t frames_count(void)
+{
+	const uint8_t *ring = (const uint8_t *)(log_mmap + 1);
+	uint64_t pos = log_mmap->tail;
+	uint32_t count = 0;
+
+	while (pos < log_mmap->head) {
+		pos += sizeof(uint16_t) + frame_len(ring, pos);
+		count++;
+	}
+
+	zassert_equal(pos, log_mmap->head, "Frames do not end at the head");
+
+	return count;
+}
+
+ZTEST(log_backend_native_mmap, test_header)
+{
+	zassert_not_null(log_mmap, "Ring file not mapped");
+	zassert_mem_equal(log_mmap->magic, "ZLOGMMAP", sizeof(log_mmap->magic));
+	zassert_equal(log_mmap->version, 1);
+	zassert_equal(log_mmap->size, RING_SIZE);
+}
+
+ZTEST(log_backend_native_mmap, test_wrap)
+{
+	uint32_t frames = frames_count() + log_mmap->overwritten;
+	uint64_t head = log_mmap->head;
+
+	for (int i = 0; i < NUM_MSGS; i++) {
+		LOG_INF("message %d of %d", i, NUM_MSGS);
+	}
+
+	/* The ring wrapped and the oldest frames were dropped to make room */
+	zassert_true(log_mmap->head - head > RING_SIZE, "Ring did not wrap");
+	zassert_true(log_mmap->overwritten > 0, "No frame overwritten");
+	zassert_true(log_mmap->head - log_mmap->tail <= RING_SIZE, "Ring overflow");
+	zassert_equal(log_mmap->discarded, 0, "Frames discarded");
+	zassert_equal(frames_count() + log_mmap->overwritten, frames + NUM_MSGS,
+		      "Frames lost");
+}
+
+ZTEST_SUITE(log_backend_native_mmap, NULL, NULL, NULL, NULL, NULL);
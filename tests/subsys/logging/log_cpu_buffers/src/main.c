@@ -0,0 +1,110 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Test merging of per-CPU log message buffers
+ */
+
+#include <zephyr/logging/log_msg.h>
+#include <zephyr/logging/log_internal.h>
+#include <zephyr/logging/log_ctrl.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#define NUM_CPUS 2
+#define MSGS_PER_CPU 16
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static atomic_t timestamp;
+static struct k_thread threads[NUM_CPUS];
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, NUM_CPUS, STACK_SIZE);
+static struct k_sem start_sem;
+
+static log_timestamp_t timestamp_get_inc(void)
+{
+	return (log_timestamp_t)atomic_inc(&timestamp);
+}
+
+static void producer(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_sem_take(&start_sem, K_FOREVER);
+
+	for (int i = 0; i < MSGS_PER_CPU; i++) {
+		z_log_msg_runtime_create(0, p1, LOG_LEVEL_INF, NULL, 0, 0, "test %d", i);
+	}
+}
+
+static void log_from_all_cpus(void)
+{
+	for (int cpu = 0; cpu < NUM_CPUS; cpu++) {
+		k_thread_create(&threads[cpu], stacks[cpu], STACK_SIZE, producer,
+				(void *)(uintptr_t)(cpu + 1), NULL, NULL,
+				K_PRIO_PREEMPT(1), 0, K_FOREVER);
+		zassert_ok(k_thread_cpu_pin(&threads[cpu], cpu));
+		k_thread_start(&threads[cpu]);
+	}
+
+	/* Release the producers together so that they log concurrently */
+	for (int cpu = 0; cpu < NUM_CPUS; cpu++) {
+		k_sem_give(&start_sem);
+	}
+
+	for (int cpu = 0; cpu < NUM_CPUS; cpu++) {
+		k_thread_join(&threads[cpu], K_FOREVER);
+	}
+}
+
+ZTEST(log_cpu_buffers, test_claim_in_timestamp_order)
+{
+	union log_msg_generic *msg;
+	int count[NUM_CPUS] = {};
+	log_timestamp_t t;
+
+	k_sem_init(&start_sem, 0, NUM_CPUS);
+	atomic_set(&timestamp, 0);
+	log_set_timestamp_func(timestamp_get_inc, 0);
+
+	log_from_all_cpus();
+
+	zassert_equal(z_log_dropped_read_and_clear(), 0, "No dropped messages");
+	zassert_true(z_log_msg_pending(), "Messages should be pending");
+
+	/* Each CPU buffer is ordered, the merge must give the global order */
+	for (int i = 0; i < NUM_CPUS * MSGS_PER_CPU; i++) {
+		msg = z_log_msg_claim(NULL);
+		zassert_not_null(msg, "Missing message %d", i);
+
+		t = log_msg_get_timestamp(&msg->log);
+		zassert_equal(t, i, "Unexpected timestamp %u for message %d", (uint32_t)t, i);
+
+		count[(uintptr_t)log_msg_get_source(&msg->log) - 1]++;
+		z_log_msg_free(msg);
+	}
+
+	for (int cpu = 0; cpu < NUM_CPUS; cpu++) {
+		zassert_equal(count[cpu], MSGS_PER_CPU, "Messages from CPU %d lost", cpu);
+	}
+
+	zassert_is_null(z_log_msg_claim(NULL), "Expected no pending messages");
+	zassert_false(z_log_msg_pending(), "Expected no pending messages");
+}
+
+ZTEST(log_cpu_buffers, test_buffers_are_separate)
+{
+	uint32_t buf_size;
+	uint32_t usage;
+
+	zassert_ok(log_mem_get_usage(&buf_size, &usage));
+	zassert_true(buf_size >= NUM_CPUS * (CONFIG_LOG_BUFFER_SIZE - sizeof(int)),
+		     "Each CPU should have its own buffer");
+}
+
+ZTEST_SUITE(log_cpu_buffers, NULL, NULL, NULL, NULL, NULL);
@@ -47,6 +47,44 @@ RTIO_DEFINE(r_test, 3, 3);
 RTIO_DEFINE(r_test_2, 3, 3);
 RTIO_DEFINE(r_test_3, 3, 3);
 
+/** Completes on several work threads at once, into the same RTIO context */
+#define STRESS_ROUNDS 200
+#define STRESS_IODEVS 3
+
+static atomic_t stress_completed;
+
+static void stress_handler(struct rtio_iodev_sqe *iodev_sqe)
+{
+	/** Give the other work threads a chance to reach their completion too */
+	k_yield();
+
+	atomic_inc(&stress_completed);
+	rtio_executor_ok(iodev_sqe, (int)(uintptr_t)iodev_sqe->sqe.userdata);
+}
+
+static void stress_submit(struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct rtio_work_req *req = rtio_work_req_alloc();
+
+	rtio_work_req_submit(req, iodev_sqe, stress_handler);
+}
+
+struct rtio_iodev_api r_iodev_stress_api = {
+	.submit = stress_submit,
+};
+
+RTIO_IODEV_DEFINE(stress_iodev_1, &r_iodev_stress_api, NULL);
+RTIO_IODEV_DEFINE(stress_iodev_2, &r_iodev_stress_api, NULL);
+RTIO_IODEV_DEFINE(stress_iodev_3, &r_iodev_stress_api, NULL);
+
+static const struct rtio_iodev *stress_iodevs[STRESS_IODEVS] = {
+	&stress_iodev_1,
+	&stress_iodev_2,
+	&stress_iodev_3,
+};
+
+RTIO_DEFINE(r_stress, STRESS_IODEVS, STRESS_IODEVS);
+
 static void before(void *unused)
 {
 	rtio_sqe_drop_all(&r_test);
@@ -64,7 +102,13 @@ static void after(void *unused)
 {
 }
 
-ZTEST_SUITE(rtio_work, NULL, NULL, before, after, NULL);
+/** The flow checks rely on the work threads preempting the test thread on a single CPU */
+static bool single_cpu(const void *global_state)
+{
+	return arch_num_cpus() == 1;
+}
+
+ZTEST_SUITE(rtio_work, single_cpu, NULL, before, after, NULL);
 
 ZTEST(rtio_work, test_work_decouples_submission)
 {
@@ -203,6 +247,73 @@ ZTEST(rtio_work, test_work_supports_preempting_on_higher_prio_submissions)
 	rtio_cqe_release(&r_test_3, cqe);
 }
 
+ZTEST(rtio_work, test_work_serializes_items_of_same_iodev)
+{
+	struct rtio_sqe *sqe_a;
+	struct rtio_sqe *sqe_b;
+	struct rtio_cqe *cqe;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_RTIO_WORKQ_IODEV_QUEUES);
+
+	sqe_a = rtio_sqe_acquire(&r_test);
+	rtio_sqe_prep_nop(sqe_a, &dummy_iodev, &work_handler_sem_1);
+	sqe_a->prio = RTIO_PRIO_NORM;
+
+	sqe_b = rtio_sqe_acquire(&r_test_2);
+	rtio_sqe_prep_nop(sqe_b, &dummy_iodev, &work_handler_sem_2);
+	sqe_b->prio = RTIO_PRIO_NORM;
+
+	zassert_ok(rtio_submit(&r_test, 0));
+	zassert_ok(rtio_submit(&r_test_2, 0));
+
+	/** The second item waits for the first one, despite idle threads */
+	zassert_equal(1, work_handler_called);
+	zassert_equal(2, rtio_work_req_used_count_get());
+
+	k_sem_give(&work_handler_sem_1);
+
+	zassert_equal(2, work_handler_called);
+	zassert_equal(1, rtio_work_req_used_count_get());
+
+	k_sem_give(&work_handler_sem_2);
+
+	zassert_equal(2, work_handler_called);
+	zassert_equal(0, rtio_work_req_used_count_get());
+
+	/** Clean-up */
+	cqe = rtio_cqe_consume_block(&r_test);
+	rtio_cqe_release(&r_test, cqe);
+	cqe = rtio_cqe_consume_block(&r_test_2);
+	rtio_cqe_release(&r_test_2, cqe);
+}
+
+ZTEST(rtio_work, test_stats_count_wakeups_and_items)
+{
+	struct rtio_work_stats before;
+	struct rtio_work_stats after;
+	struct rtio_sqe *sqe;
+	struct rtio_cqe *cqe;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_RTIO_WORKQ_STATS);
+
+	rtio_work_stats_get(&before);
+
+	sqe = rtio_sqe_acquire(&r_test);
+	rtio_sqe_prep_nop(sqe, &dummy_iodev, &work_handler_sem_1);
+	sqe->prio = RTIO_PRIO_NORM;
+
+	zassert_ok(rtio_submit(&r_test, 0));
+	k_sem_give(&work_handler_sem_1);
+
+	rtio_work_stats_get(&after);
+	zassert_equal(1, after.wakeups - before.wakeups);
+	zassert_equal(1, after.reqs - before.reqs);
+
+	/** Clean-up */
+	cqe = rtio_cqe_consume_block(&r_test);
+	rtio_cqe_release(&r_test, cqe);
+}
+
 ZTEST(rtio_work, test_used_count_keeps_track_of_alloc_items)
 {
 	struct rtio_work_req *req_a = NULL;
@@ -248,3 +359,43 @@ ZTEST(rtio_work, test_used_count_keeps_track_of_alloc_items)
 	rtio_work_req_submit(req_d, NULL, NULL);
 	zassert_equal(0, rtio_work_req_used_count_get());
 }
+
+ZTEST_SUITE(rtio_work_stress, NULL, NULL, NULL, NULL, NULL);
+
+ZTEST(rtio_work_stress, test_work_completes_concurrently_into_same_context)
+{
+	struct rtio_sqe *sqe;
+	struct rtio_cqe *cqe;
+
+	atomic_clear(&stress_completed);
+
+	for (int round = 0; round < STRESS_ROUNDS; round++) {
+		uint32_t seen = 0;
+
+		for (int i = 0; i < STRESS_IODEVS; i++) {
+			sqe = rtio_sqe_acquire(&r_stress);
+			zassert_not_null(sqe);
+			rtio_sqe_prep_nop(sqe, stress_iodevs[i], (void *)(uintptr_t)i);
+			sqe->prio = RTIO_PRIO_NORM;
+		}
+
+		zassert_ok(rtio_submit(&r_stress, STRESS_IODEVS));
+
+		/** Every completion got its own CQE, none was lost or handed out twice */
+		for (int i = 0; i < STRESS_IODEVS; i++) {
+			cqe = rtio_cqe_consume(&r_stress);
+			zassert_not_null(cqe, "round %d lost a completion", round);
+			zassert_equal((uintptr_t)cqe->userdata, cqe->result);
+			zassert_false(seen & BIT(cqe->result), "round %d completed %d twice",
+				      round, cqe->result);
+			seen |= BIT(cqe->result);
+			rtio_cqe_release(&r_stress, cqe);
+		}
+
+		zassert_equal(BIT_MASK(STRESS_IODEVS), seen);
+		zassert_is_null(rtio_cqe_consume(&r_stress));
+	}
+
+	zassert_equal(STRESS_ROUNDS * STRESS_IODEVS, atomic_get(&stress_completed));
+	zassert_equal(r_stress.cqe_pool->pool_size, atomic_get(&r_stress.cqe_pool->pool_free));
+}
@@ -6,6 +6,7 @@
 #include <errno.h>
 #include <zephyr/settings/settings.h>
 #include <zephyr/fs/nvs.h>
+#include <settings/settings_nvs.h>
 
 ZTEST(settings_functional, test_setting_storage_get)
 {
@@ -23,4 +24,103 @@ ZTEST(settings_functional, test_setting_storage_get)
 
 	zassert_true(nvs_rc >= 0, "Can't read nvs record (err=%d).", rc);
 }
+
+ZTEST(settings_functional, test_save_batch_recover)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_SETTINGS_SAVE_BATCH);
+
+#if defined(CONFIG_SETTINGS_SAVE_BATCH)
+	/* Record of the second bank: name length, value length, name and value
+	 * of each settings item.
+	 */
+	static const uint8_t record[] = {
+		9, 0, 1, 0, 'b', 'a', 't', 'c', 'h', '/', 'r', '1', '\0', 0x5a,
+		9, 0, 2, 0, 'b', 'a', 't', 'c', 'h', '/', 'r', '2', '\0', 0xa5, 0x5a,
+	};
+	/* Commit record: bank, state (own entries not deleted yet), number of
+	 * records, number of settings items carried over from the previous bank.
+	 */
+	static const uint8_t commit[] = {1, 1, 1, 0, 0, 0};
+	static const struct settings_batch_entry deletes[] = {
+		{.name = "batch/r1"},
+		{.name = "batch/r2"},
+	};
+	struct settings_nvs *cf;
+	uint8_t rd_val[sizeof(commit)];
+	uint8_t val = 0x11;
+	void *storage;
+	ssize_t len;
+	int rc;
+
+	settings_subsys_init();
+
+	rc = settings_storage_get(&storage);
+	zassert_equal(0, rc, "Can't fetch storage reference (err=%d)", rc);
+
+	cf = CONTAINER_OF(storage, struct settings_nvs, cf_nvs);
+
+	/* Without its commit record, the record is discarded */
+	rc = nvs_write((struct nvs_fs *)storage, NVS_BATCH_RECORD_ID(SETTINGS_BATCH_SLOT(1, 0)),
+		       record, sizeof(record));
+	zassert_true(rc >= 0, "Can't write the record (err=%d)", rc);
+
+	rc = settings_nvs_backend_init(cf);
+	zassert_equal(0, rc, "Can't initialize the back-end (err=%d)", rc);
+
+	len = settings_get_val_len("batch/r1");
+	zassert_equal(len, 0, "Item of an uncommitted batch was saved");
+
+	len = nvs_read((struct nvs_fs *)storage, NVS_BATCH_RECORD_ID(SETTINGS_BATCH_SLOT(1, 0)),
+		       rd_val, sizeof(rd_val));
+	zassert_equal(len, -ENOENT, "Record not deleted (err=%d)", (int)len);
+
+	/* A reset interrupted the batch after its commit, before the older own
+	 * entry of batch/r2 was deleted.
+	 */
+	rc = settings_save_one("batch/r2", &val, sizeof(val));
+	zassert_equal(rc, 0);
+
+	rc = nvs_write((struct nvs_fs *)storage, NVS_BATCH_RECORD_ID(SETTINGS_BATCH_SLOT(1, 0)),
+		       record, sizeof(record));
+	zassert_true(rc >= 0, "Can't write the record (err=%d)", rc);
+
+	rc = nvs_write((struct nvs_fs *)storage, NVS_BATCH_RECORD_ID(SETTINGS_BATCH_SLOT_COMMIT),
+		       commit, sizeof(commit));
+	zassert_true(rc >= 0, "Can't write the commit record (err=%d)", rc);
+
+	/* The batch is completed when the back-end is initialized again */
+	rc = settings_nvs_backend_init(cf);
+	zassert_equal(0, rc, "Can't initialize the back-end (err=%d)", rc);
+
+	len = settings_load_one("batch/r1", rd_val, sizeof(rd_val));
+	zassert_equal(len, 1);
+	zassert_equal(rd_val[0], 0x5a);
+
+	len = settings_load_one("batch/r2", rd_val, sizeof(rd_val));
+	zassert_equal(len, 2, "Older own entry not deleted");
+	zassert_equal(rd_val[0], 0xa5);
+	zassert_equal(rd_val[1], 0x5a);
+
+	len = nvs_read((struct nvs_fs *)storage, NVS_BATCH_RECORD_ID(SETTINGS_BATCH_SLOT_COMMIT),
+		       rd_val, sizeof(rd_val));
+	zassert_equal(len, sizeof(commit));
+	zassert_equal(rd_val[1], 0, "Commit record not completed");
+
+	/* Deleting all the items drops the records */
+	rc = settings_save_batch(deletes, ARRAY_SIZE(deletes));
+	zassert_equal(rc, 0, "Can't delete a batch (err=%d)", rc);
+
+	len = settings_get_val_len("batch/r2");
+	zassert_equal(len, 0, "Deleted item still exists");
+
+	len = nvs_read((struct nvs_fs *)storage, NVS_BATCH_RECORD_ID(SETTINGS_BATCH_SLOT_COMMIT),
+		       rd_val, sizeof(rd_val));
+	zassert_equal(len, -ENOENT, "Commit record not deleted (err=%d)", (int)len);
+
+	len = nvs_read((struct nvs_fs *)storage, NVS_BATCH_RECORD_ID(SETTINGS_BATCH_SLOT(0, 0)),
+		       rd_val, sizeof(rd_val));
+	zassert_equal(len, -ENOENT, "Record not deleted (err=%d)", (int)len);
+#endif
+}
+
 ZTEST_SUITE(settings_functional, NULL, NULL, NULL, NULL, NULL);
@@ -1326,3 +1326,205 @@ ZTEST(settings_functional, test_single_save)
 	settings_deregister(&first_settings);
 #endif
 }
+
+ZTEST(settings_functional, test_save_batch)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_SETTINGS_SAVE_BATCH);
+
+#if defined(CONFIG_SETTINGS_SAVE_BATCH)
+	uint8_t val[4] = {0x11, 0x22, 0x33, 0x44};
+	uint8_t rd_val[sizeof(val)];
+	ssize_t len;
+	int rc;
+
+	struct settings_batch_entry entries[] = {
+		{.name = "batch/val1", .value = &val[0], .val_len = 1},
+		{.name = "batch/val2", .value = &val[0], .val_len = 2},
+		{.name = "batch/val3", .value = &val[0], .val_len = 3},
+		{.name = "batch/val2", .value = &val[1], .val_len = 3},
+	};
+	struct settings_batch_entry update[] = {
+		{.name = "batch/val1", .value = &val[3], .val_len = 1},
+		{.name = "batch/val3", .value = NULL, .val_len = 0},
+		{.name = "batch/val4", .value = &val[2], .val_len = 2},
+	};
+
+	settings_subsys_init();
+
+	rc = settings_save_batch(entries, 0);
+	zassert_equal(rc, 0, "Can't save an empty batch (err=%d)", rc);
+
+	rc = settings_save_batch(entries, ARRAY_SIZE(entries));
+	zassert_equal(rc, 0, "Can't save batch (err=%d)", rc);
+
+	len = settings_load_one("batch/val1", rd_val, sizeof(rd_val));
+	zassert_equal(len, 1);
+	zassert_equal(rd_val[0], 0x11);
+
+	/* The last value of an item appearing several times is kept */
+	len = settings_load_one("batch/val2", rd_val, sizeof(rd_val));
+	zassert_equal(len, 3);
+	zassert_mem_equal(rd_val, &val[1], 3);
+
+	len = settings_load_one("batch/val3", rd_val, sizeof(rd_val));
+	zassert_equal(len, 3);
+	zassert_mem_equal(rd_val, &val[0], 3);
+
+	rc = settings_save_batch(update, ARRAY_SIZE(update));
+	zassert_equal(rc, 0, "Can't save batch (err=%d)", rc);
+
+	len = settings_load_one("batch/val1", rd_val, sizeof(rd_val));
+	zassert_equal(len, 1);
+	zassert_equal(rd_val[0], 0x44);
+
+	len = settings_get_val_len("batch/val3");
+	zassert_equal(len, 0, "Deleted item still exists");
+
+	len = settings_load_one("batch/val4", rd_val, sizeof(rd_val));
+	zassert_equal(len, 2);
+	zassert_mem_equal(rd_val, &val[2], 2);
+
+	/* Items saved in a batch can be deleted one by one */
+	rc = settings_delete("batch/val1");
+	zassert_equal(rc, 0);
+	rc = settings_delete("batch/val2");
+	zassert_equal(rc, 0);
+	rc = settings_delete("batch/val4");
+	zassert_equal(rc, 0);
+
+	len = settings_get_val_len("batch/val2");
+	zassert_equal(len, 0, "Deleted item still exists");
+
+#if defined(CONFIG_SETTINGS_SAVE_BATCH_RECORDS)
+	static uint8_t big_val[CONFIG_SETTINGS_SAVE_BATCH_BUF_SIZE];
+	struct settings_batch_entry too_big[] = {
+		{.name = "batch/big", .value = big_val, .val_len = sizeof(big_val)},
+		{.name = "batch/val1", .value = &val[0], .val_len = 1},
+	};
+
+	rc = settings_save_batch(too_big, ARRAY_SIZE(too_big));
+	zassert_equal(rc, -E2BIG, "Item larger than a record was saved (err=%d)", rc);
+
+	len = settings_get_val_len("batch/big");
+	zassert_equal(len, 0, "Item of a rejected batch was saved");
+
+	/* Each item takes 16 bytes, a batch of a few hundred items fits in the
+	 * default records.
+	 */
+	static char names[300][12];
+	static struct settings_batch_entry many[ARRAY_SIZE(names)];
+
+	BUILD_ASSERT(CONFIG_SETTINGS_SAVE_BATCH_RECORDS *
+		     (CONFIG_SETTINGS_SAVE_BATCH_BUF_SIZE / 16) >= ARRAY_SIZE(names));
+
+	for (size_t i = 0; i < ARRAY_SIZE(many); i++) {
+		snprintk(names[i], sizeof(names[i]), "batch/c%03u", (unsigned int)i);
+		many[i].name = names[i];
+		many[i].value = &val[i % sizeof(val)];
+		many[i].val_len = 1;
+	}
+
+	rc = settings_save_batch(many, ARRAY_SIZE(many));
+	zassert_equal(rc, 0, "Can't save a batch of %zu items (err=%d)", ARRAY_SIZE(many), rc);
+
+	for (size_t i = 0; i < ARRAY_SIZE(many); i++) {
+		len = settings_load_one(names[i], rd_val, sizeof(rd_val));
+		zassert_equal(len, 1, "Item %s not saved", names[i]);
+		zassert_equal(rd_val[0], val[i % sizeof(val)]);
+	}
+
+	/* One item per record, one more than the records: nothing is written
+	 * and the stored items are kept.
+	 */
+	static char big_names[CONFIG_SETTINGS_SAVE_BATCH_RECORDS + 1][12];
+	static struct settings_batch_entry bigs[ARRAY_SIZE(big_names)];
+
+	for (size_t i = 0; i < ARRAY_SIZE(bigs); i++) {
+		snprintk(big_names[i], sizeof(big_names[i]), "batch/b%02u", (unsigned int)i);
+		bigs[i].name = big_names[i];
+		bigs[i].value = big_val;
+		bigs[i].val_len = sizeof(big_val) - 32;
+	}
+
+	rc = settings_save_batch(bigs, ARRAY_SIZE(bigs));
+	zassert_equal(rc, -E2BIG, "Batch larger than the records was saved (err=%d)", rc);
+
+	len = settings_get_val_len(big_names[0]);
+	zassert_equal(len, 0, "Item of a rejected batch was saved");
+
+	len = settings_load_one(names[0], rd_val, sizeof(rd_val));
+	zassert_equal(len, 1, "Item of a previous batch lost");
+	zassert_equal(rd_val[0], val[0]);
+
+	/* An item saved on its own takes precedence over the records, also
+	 * after a later batch.
+	 */
+	rc = settings_save_one(names[0], &val[3], 1);
+	zassert_equal(rc, 0);
+
+	rc = settings_save_batch(&many[1], 2);
+	zassert_equal(rc, 0, "Can't save batch (err=%d)", rc);
+
+	len = settings_load_one(names[0], rd_val, sizeof(rd_val));
+	zassert_equal(len, 1);
+	zassert_equal(rd_val[0], val[3]);
+
+	/* A single batch deletes all the items, including their own entries */
+	for (size_t i = 0; i < ARRAY_SIZE(many); i++) {
+		many[i].value = NULL;
+		many[i].val_len = 0;
+	}
+
+	rc = settings_save_batch(many, ARRAY_SIZE(many));
+	zassert_equal(rc, 0, "Can't delete a batch (err=%d)", rc);
+
+	for (size_t i = 0; i < ARRAY_SIZE(many); i++) {
+		len = settings_get_val_len(names[i]);
+		zassert_equal(len, 0, "Deleted item %s still exists", names[i]);
+	}
+#endif
+#endif
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(lookup_root, "lookup", NULL, NULL, NULL, NULL);
+SETTINGS_STATIC_HANDLER_DEFINE(lookup_leaf, "lookup/leaf", NULL, NULL, NULL, NULL);
+SETTINGS_STATIC_HANDLER_DEFINE(lookup_deep, "lookup/leaf/deep", NULL, NULL, NULL, NULL);
+SETTINGS_STATIC_HANDLER_DEFINE(lookup_other, "lookupx", NULL, NULL, NULL, NULL);
+
+static void check_lookup(const char *name, const char *handler, const char *next)
+{
+	struct settings_handler_static *ch;
+	const char *ch_next;
+
+	ch = settings_parse_and_lookup(name, &ch_next);
+	if (!handler) {
+		zassert_is_null(ch, "Unexpected handler for %s", name);
+		return;
+	}
+
+	zassert_not_null(ch, "No handler for %s", name);
+	zassert_str_equal(ch->name, handler, "Wrong handler %s for %s", ch->name, name);
+	if (!next) {
+		zassert_is_null(ch_next, "Unexpected next for %s", name);
+	} else {
+		zassert_not_null(ch_next, "No next for %s", name);
+		zassert_str_equal(ch_next, next, "Wrong next %s for %s", ch_next, name);
+	}
+}
+
+ZTEST(settings_functional, test_handler_lookup)
+{
+	settings_subsys_init();
+
+	check_lookup("lookup", "lookup", NULL);
+	check_lookup("lookup/1", "lookup", "1");
+	check_lookup("lookup/lea/1", "lookup", "lea/1");
+	check_lookup("lookup/leaf", "lookup/leaf", NULL);
+	check_lookup("lookup/leaf=1", "lookup/leaf", NULL);
+	check_lookup("lookup/leaf/1/2", "lookup/leaf", "1/2");
+	check_lookup("lookup/leaf/deep/1", "lookup/leaf/deep", "1");
+	check_lookup("lookup/leafy/1", "lookup", "leafy/1");
+	check_lookup("lookupx/1", "lookupx", "1");
+	check_lookup("lookupy/1", NULL, NULL);
+	check_lookup("look", NULL, NULL);
+}
@@ -51,4 +51,30 @@ ZTEST(channel_id, test_channel_retrieval)
 		     (&chan_d == zbus_chan_from_id(CHAN_B)));
 }
 
+static bool check_channel_by_id(const struct zbus_channel *chan)
+{
+	const struct zbus_channel *found;
+
+	if (chan->id == ZBUS_CHAN_ID_INVALID) {
+		return true;
+	}
+
+	found = zbus_chan_from_id(chan->id);
+	zassert_not_null(found);
+	zassert_equal(chan->id, found->id);
+
+	return true;
+}
+
+ZTEST(channel_id, test_channel_retrieval_all)
+{
+	/* IDs between and around the defined ones */
+	zassert_is_null(zbus_chan_from_id(0));
+	zassert_is_null(zbus_chan_from_id(CHAN_A + 1));
+	zassert_is_null(zbus_chan_from_id(CHAN_F - 1));
+	zassert_is_null(zbus_chan_from_id(CHAN_C + 1));
+
+	zassert_true(zbus_iterate_over_channels(check_channel_by_id));
+}
+
 ZTEST_SUITE(channel_id, NULL, NULL, NULL, NULL, NULL);
@@ -21,6 +21,15 @@ struct msg {
 
 LISTIFY(CHANNEL_COUNT, DEFINE_TEST_CHANNELS, (;))
 
+/* The section names end with an underscore, so that chan_10 is placed before
+ * chan_1 by the linker.
+ */
+ZBUS_CHAN_DEFINE(chan_1, struct msg, NULL, NULL, ZBUS_OBSERVERS_EMPTY, ZBUS_MSG_INIT(0));
+ZBUS_CHAN_DEFINE(chan_10, struct msg, NULL, NULL, ZBUS_OBSERVERS_EMPTY, ZBUS_MSG_INIT(0));
+
+/* Set by zbus when the channel section order cannot be used for lookups */
+extern bool zbus_chan_names_unsorted;
+
 ZTEST(channel_name, test_channel_retrieval)
 {
 	/* invalid cases */
@@ -35,4 +44,34 @@ ZTEST(channel_name, test_channel_retrieval)
 	zexpect_equal_ptr(&test_chan_9, zbus_chan_from_name("test_chan_9"));
 }
 
+static bool check_channel_by_name(const struct zbus_channel *chan)
+{
+	zexpect_equal_ptr(chan, zbus_chan_from_name(zbus_chan_name(chan)));
+
+	return true;
+}
+
+ZTEST(channel_name, test_channel_retrieval_all)
+{
+	/* Names sorting right before, between and after the defined ones */
+	zexpect_is_null(zbus_chan_from_name("test_chan_"));
+	zexpect_is_null(zbus_chan_from_name("test_chan_10"));
+	zexpect_is_null(zbus_chan_from_name("test_chan_9_"));
+	zexpect_is_null(zbus_chan_from_name("a"));
+	zexpect_is_null(zbus_chan_from_name("z"));
+
+	zexpect_true(zbus_iterate_over_channels(check_channel_by_name));
+}
+
+ZTEST(channel_name, test_channel_retrieval_prefix)
+{
+	zassert_false(zbus_chan_names_unsorted, "Name lookups fell back to the linear scan");
+
+	zexpect_equal_ptr(&chan_1, zbus_chan_from_name("chan_1"));
+	zexpect_equal_ptr(&chan_10, zbus_chan_from_name("chan_10"));
+	zexpect_is_null(zbus_chan_from_name("chan_"));
+	zexpect_is_null(zbus_chan_from_name("chan_100"));
+	zexpect_is_null(zbus_chan_from_name("chan_1_"));
+}
+
 ZTEST_SUITE(channel_name, NULL, NULL, NULL, NULL, NULL);
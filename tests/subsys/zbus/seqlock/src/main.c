@@ -0,0 +1,212 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/ztest.h>
+
+#define READERS_COUNT 3
+#define PUBLISH_TIME_MS 200
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+/* The reader can tell a torn message because every field carries the same sequence */
+struct sample_msg {
+	uint32_t seq;
+	uint32_t values[15];
+	uint32_t check;
+};
+
+static atomic_t listener_count;
+static uint32_t listener_last_seq;
+
+static void sample_listener_cb(const struct zbus_channel *chan)
+{
+	const struct sample_msg *msg = zbus_chan_const_msg(chan);
+
+	listener_last_seq = msg->seq;
+	atomic_inc(&listener_count);
+}
+
+ZBUS_LISTENER_DEFINE(sample_lis, sample_listener_cb);
+
+ZBUS_SUBSCRIBER_DEFINE(sample_sub, 4);
+
+ZBUS_CHAN_DEFINE_SEQLOCK(sample_chan,	    /* Name */
+			 struct sample_msg, /* Message type */
+
+			 NULL,				       /* Validator */
+			 NULL,				       /* User data */
+			 ZBUS_OBSERVERS(sample_lis, sample_sub), /* observers */
+			 ZBUS_MSG_INIT(0)		       /* Initial value */
+);
+
+ZBUS_CHAN_DEFINE(regular_chan,	    /* Name */
+		 struct sample_msg, /* Message type */
+
+		 NULL,		       /* Validator */
+		 NULL,		       /* User data */
+		 ZBUS_OBSERVERS_EMPTY, /* observers */
+		 ZBUS_MSG_INIT(0)      /* Initial value */
+);
+
+static void sample_fill(struct sample_msg *msg, uint32_t seq)
+{
+	msg->seq = seq;
+
+	for (int i = 0; i < ARRAY_SIZE(msg->values); i++) {
+		msg->values[i] = seq;
+	}
+
+	msg->check = ~seq;
+}
+
+static bool sample_is_consistent(const struct sample_msg *msg)
+{
+	for (int i = 0; i < ARRAY_SIZE(msg->values); i++) {
+		if (msg->values[i] != msg->seq) {
+			return false;
+		}
+	}
+
+	return msg->check == ~msg->seq;
+}
+
+K_THREAD_STACK_ARRAY_DEFINE(reader_stacks, READERS_COUNT, STACK_SIZE);
+static struct k_thread reader_threads[READERS_COUNT];
+static atomic_t reader_torn;
+static atomic_t reader_reads;
+static volatile bool readers_stop;
+
+static void reader_thread(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	struct sample_msg msg;
+	uint32_t last_seq = 0;
+
+	while (!readers_stop) {
+		if (zbus_chan_read(&sample_chan, &msg, K_MSEC(100)) != 0) {
+			continue;
+		}
+
+		/* A single publisher only makes the sequence go forward */
+		if (!sample_is_consistent(&msg) || msg.seq < last_seq) {
+			atomic_inc(&reader_torn);
+		}
+
+		last_seq = msg.seq;
+		atomic_inc(&reader_reads);
+
+		/* Wake up again in the middle of the publications */
+		k_msleep(1);
+	}
+}
+
+ZTEST(seqlock, test_concurrent_readers)
+{
+	struct sample_msg msg;
+	const struct zbus_channel *chan;
+	int64_t start = k_uptime_get();
+	uint32_t seq = 0;
+
+	atomic_clear(&reader_torn);
+	atomic_clear(&reader_reads);
+	atomic_clear(&listener_count);
+	readers_stop = false;
+
+	/* The readers preempt the publisher */
+	k_thread_priority_set(k_current_get(), K_PRIO_PREEMPT(10));
+
+	for (int i = 0; i < READERS_COUNT; i++) {
+		k_thread_create(&reader_threads[i], reader_stacks[i], STACK_SIZE, reader_thread,
+				NULL, NULL, NULL, K_PRIO_PREEMPT(5), 0, K_NO_WAIT);
+	}
+
+	while (k_uptime_get() - start < PUBLISH_TIME_MS) {
+		sample_fill(&msg, ++seq);
+		zassert_ok(zbus_chan_pub(&sample_chan, &msg, K_MSEC(100)));
+
+		/* The subscriber queue is only drained to keep the notifications flowing */
+		while (k_msgq_get(sample_sub.queue, &chan, K_NO_WAIT) == 0) {
+			zassert_equal_ptr(chan, &sample_chan);
+		}
+	}
+
+	readers_stop = true;
+
+	for (int i = 0; i < READERS_COUNT; i++) {
+		zassert_ok(k_thread_join(&reader_threads[i], K_SECONDS(1)));
+	}
+
+	zassert_equal(atomic_get(&reader_torn), 0, "Readers got a torn message");
+	zassert_true(atomic_get(&reader_reads) > 0);
+
+	/* Observers are notified for every publication, as on regular channels */
+	zassert_equal(atomic_get(&listener_count), seq);
+	zassert_equal(listener_last_seq, seq);
+
+	zassert_ok(zbus_chan_read(&sample_chan, &msg, K_NO_WAIT));
+	zassert_equal(msg.seq, seq);
+	zassert_true(sample_is_consistent(&msg));
+}
+
+ZTEST(seqlock, test_read_does_not_lock)
+{
+	struct sample_msg msg;
+
+	sample_fill(&msg, 7);
+	zassert_ok(zbus_chan_pub(&regular_chan, &msg, K_NO_WAIT));
+
+	/* Regular channels keep the semaphore semantics */
+	zassert_ok(zbus_chan_claim(&regular_chan, K_NO_WAIT));
+	zassert_equal(zbus_chan_read(&regular_chan, &msg, K_NO_WAIT), -EBUSY);
+	zassert_ok(zbus_chan_finish(&regular_chan));
+
+	sample_fill(&msg, 8);
+	zassert_ok(zbus_chan_pub(&sample_chan, &msg, K_NO_WAIT));
+
+	/* Holding the semaphore for a notification does not stop the readers */
+	zassert_ok(k_sem_take(&sample_chan.data->sem, K_NO_WAIT));
+	memset(&msg, 0, sizeof(msg));
+	zassert_ok(zbus_chan_read(&sample_chan, &msg, K_NO_WAIT));
+	zassert_equal(msg.seq, 8);
+	k_sem_give(&sample_chan.data->sem);
+}
+
+ZTEST(seqlock, test_claim_is_a_write)
+{
+	struct sample_msg msg;
+	struct sample_msg *claimed;
+
+	zassert_ok(zbus_chan_claim(&sample_chan, K_NO_WAIT));
+
+	claimed = zbus_chan_msg(&sample_chan);
+	sample_fill(claimed, 42);
+
+	zassert_equal(zbus_chan_read(&sample_chan, &msg, K_NO_WAIT), -EBUSY);
+	zassert_equal(zbus_chan_read(&sample_chan, &msg, K_MSEC(10)), -EAGAIN);
+
+	zassert_ok(zbus_chan_finish(&sample_chan));
+
+	zassert_ok(zbus_chan_read(&sample_chan, &msg, K_NO_WAIT));
+	zassert_equal(msg.seq, 42);
+	zassert_true(sample_is_consistent(&msg));
+}
+
+static void seqlock_before(void *fixture)
+{
+	struct sample_msg msg;
+
+	ARG_UNUSED(fixture);
+
+	sample_fill(&msg, 0);
+	zbus_chan_pub(&sample_chan, &msg, K_NO_WAIT);
+	k_msgq_purge(sample_sub.queue);
+}
+
+ZTEST_SUITE(seqlock, NULL, NULL, seqlock_before, NULL, NULL);